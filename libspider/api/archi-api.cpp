@@ -41,6 +41,7 @@
 #include <archi/Platform.h>
 #include <archi/Cluster.h>
 #include <archi/PE.h>
+#include <archi/NUMATopology.h>
 
 /* === Methods implementation === */
 
@@ -53,6 +54,11 @@ spider::Platform *&spider::archi::platform() {
 
 spider::Platform *spider::api::createPlatform(size_t clusterCount, size_t totalPECount) {
     auto *&platform = archi::platform();
+#ifdef _SPIDER_SINGLE_CLUSTER
+    if (clusterCount > 1) {
+        throwSpiderException("spider was built for single cluster platforms (SINGLE_CLUSTER_PLATFORM).");
+    }
+#endif
     if (!platform) {
         platform = make<Platform, StackID::ARCHI>(clusterCount, totalPECount);
     } else {
@@ -87,6 +93,31 @@ void spider::api::setMemoryInterfaceDeallocateRoutine(MemoryInterface *interface
     }
 }
 
+void spider::api::enableMemoryInterfacePool(MemoryInterface *interface,
+                                            uint64_t maxRetainedSize,
+                                            uint64_t reservedSize,
+                                            MemoryBacking backing) {
+    if (interface) {
+        interface->enablePool(maxRetainedSize, reservedSize, backing);
+    }
+}
+
+void spider::api::disableMemoryInterfacePool(MemoryInterface *interface) {
+    if (interface) {
+        interface->disablePool();
+    }
+}
+
+void spider::api::setMemoryInterfaceNUMANode(MemoryInterface *interface, int32_t node) {
+    if (node >= static_cast<int32_t>(numa::nodeIndexBound())) {
+        throwSpiderException("invalid NUMA node %d, node indexes of the machine are below %zu.", node,
+                             numa::nodeIndexBound());
+    }
+    if (interface) {
+        interface->setNUMANode(node < 0 ? -1 : node);
+    }
+}
+
 spider::MemoryBus *spider::api::createMemoryBus(MemoryBusRoutine sendRoutine, MemoryBusRoutine receiveRoutine) {
     auto *bus = make<MemoryBus, StackID::ARCHI>();
     if (bus) {
@@ -107,6 +107,40 @@ namespace spider {
          */
         void setMemoryInterfaceDeallocateRoutine(MemoryInterface *interface, MemoryDeallocateRoutine routine);
 
+        /**
+         * @brief Enable the size-class buffer pool of a given @refitem MemoryInterface.
+         * @remark Freed buffers are kept and given back to the next allocation of the same size class instead of
+         *         calling the deallocate / allocate routines. Hit rate and retained bytes are printed on exit.
+         * @remark A region of reservedSize bytes may be allocated up-front with the given backing. Misses of the pool
+         *         are served from this region first, moving the page faults of the FIFOs out of the iterations.
+         * @param interface        Pointer to the @refitem MemoryInterface.
+         * @param maxRetainedSize  Maximum number of bytes kept by the pool (buffers above are freed).
+         * @param reservedSize     Size in bytes of the region reserved when the pool is enabled (0 for none).
+         * @param backing          Backing store of the reserved region (see @refitem MemoryBacking).
+         */
+        void enableMemoryInterfacePool(MemoryInterface *interface,
+                                       uint64_t maxRetainedSize = UINT64_MAX,
+                                       uint64_t reservedSize = 0,
+                                       MemoryBacking backing = MemoryBacking::MALLOC);
+
+        /**
+         * @brief Disable the size-class buffer pool of a given @refitem MemoryInterface (retained buffers are freed).
+         * @param interface  Pointer to the @refitem MemoryInterface.
+         */
+        void disableMemoryInterfacePool(MemoryInterface *interface);
+
+        /**
+         * @brief Set the NUMA node on which the memory of a given @refitem MemoryInterface should be placed.
+         * @remark The reserved region of the pool is then first-touched by a runner of the cluster of the interface
+         *         and runners without affinity are bound to the node.
+         * @remark Should be called before @refitem enableMemoryInterfacePool. If not set, the node is deduced from
+         *         the affinity of the PEs of the cluster on machines with several NUMA nodes.
+         * @param interface  Pointer to the @refitem MemoryInterface.
+         * @param node       NUMA node (-1 for none).
+         * @throws spider::Exception if node is not a NUMA node of the machine.
+         */
+        void setMemoryInterfaceNUMANode(MemoryInterface *interface, int32_t node);
+
         /**
          * @brief Creates a new @refitem MemoryBus.
          * @param sendRoutine     Routine used for sending data on this bus.
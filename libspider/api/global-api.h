@@ -176,6 +176,7 @@ namespace spider {
     enum class SchedulingPolicy {
         LIST,        /*!< List-based algorithm using critical path based heuristic */
         GREEDY,      /*!< Greedy scheduling algorithm with no heuristics */
+        HEFT,        /*!< List-based algorithm using the upward rank (average cost over hardware types) heuristic */
     };
 
     /**
@@ -184,6 +185,9 @@ namespace spider {
     enum class MappingPolicy {
         BEST_FIT,        /*!< Map actors according to a best fit policy */
         ROUND_ROBIN,     /*!< Map actors according to a round robin policy */
+        INSERTION,       /*!< Map actors according to a best fit policy, placing them in idle slots if possible */
+        LOOKAHEAD,       /*!< Map actors according to a best fit policy, accounting for the communications forced onto
+                              *   their successors on multi cluster platforms */
     };
 
     /**
@@ -192,7 +196,8 @@ namespace spider {
     enum class FifoAllocatorType {
         DEFAULT,        /*!< Default Fifo allocator */
         DEFAULT_NOSYNC, /*!< Default Fifo allocator with Fork/Duplicate/Extern_IN no-sync optimization */
-        ARCHI_AWARE,    /*!< Architecture aware Fifo allocator */
+        ARCHI_AWARE,    /*!< Fifo allocator placing buffers in the memory of the cluster of their only consumer */
+        LIFETIME_AWARE, /*!< Default Fifo allocator reusing the virtual addresses of dead Fifos */
     };
 
     /**
@@ -203,6 +208,15 @@ namespace spider {
         DELAYED,    /*!< Delayed execution policy: wait for all jobs to be scheduled to send them. */
     };
 
+    /**
+     * @brief Policy used by the runners when a job is waiting for a job of another runner.
+     */
+    enum class RunnerWaitPolicy {
+        BLOCKING,       /*!< Park the runner on its notification queue right away */
+        SPIN_THEN_PARK, /*!< Poll the notification queue for a given budget of iterations, then park */
+        BUSY_POLL,      /*!< Never park, poll the notification queue until the dependency is met (one core per runner) */
+    };
+
     /**
      * @brief Spider Processing Element types.
      */
@@ -236,8 +250,23 @@ namespace spider {
         FREELIST_FIND_BEST,          /*!< (Dynamic) FreeList with FIND_BEST policy allocator policy */
         GENERIC,                     /*!< (Dynamic) Generic allocator policy (=malloc) */
         LINEAR_STATIC,               /*!< (Static) Linear allocator policy */
+        ARENA,                       /*!< (Dynamic) Monotonic arena allocator policy, released at iteration boundaries (SRDAG based runtimes) */
+        TLSF,                        /*!< (Dynamic) Two-Level Segregated Fit allocator policy (O(1) alloc / free) */
         First = FREELIST_FIND_FIRST, /*!< Sentry for EnumIterator::begin */
-        Last = LINEAR_STATIC,        /*!< Sentry for EnumIterator::end */
+        Last = TLSF,                 /*!< Sentry for EnumIterator::end */
+    };
+
+    /**
+     * @brief Backing store of the static buffers of the stacks and of the reserved region of memory interface pools.
+     * @remark mmap based backings pre-fault the buffers when they are created so that no page fault happens during
+     *         the iterations. They fall back to MALLOC on platforms without mmap.
+     */
+    enum class MemoryBacking {
+        MALLOC,             /*!< Buffers are allocated with std::malloc (default) */
+        MMAP,               /*!< Buffers are mmap'ed, advised for transparent huge pages and pre-faulted */
+        HUGE_PAGES,         /*!< Buffers are mmap'ed with MAP_HUGETLB and MAP_POPULATE (falls back to MMAP) */
+        First = MALLOC,     /*!< Sentry for EnumIterator::begin */
+        Last = HUGE_PAGES,  /*!< Sentry for EnumIterator::end */
     };
 
     /* === Structure(s) === */
@@ -39,6 +39,8 @@
 #include <archi/Platform.h>
 #include <archi/Cluster.h>
 #include <archi/PE.h>
+#include <archi/MemoryInterface.h>
+#include <archi/NUMATopology.h>
 #include <graphs/pisdf/Vertex.h>
 #include <graphs/pisdf/Param.h>
 #include <graphs/pisdf/Graph.h>
@@ -115,6 +117,22 @@ void spider::api::createThreadRTPlatform() {
     auto *communicator = make<ThreadRTCommunicator, StackID::RUNTIME>(platform->LRTCount());
     rtPlatform->setCommunicator(communicator);
 
+    /* == Deduce the NUMA node of the memory interfaces from the affinity of the PEs (no-op on single node) == */
+    if (numa::nodeIndexBound() > 1) {
+        for (auto *cluster : platform->clusters()) {
+            auto *interface = cluster->memoryInterface();
+            if (interface->numaNode() >= 0) {
+                continue;
+            }
+            for (const auto *pe : cluster->peArray()) {
+                if (pe->isLRT() && pe->affinity() >= 0) {
+                    interface->setNUMANode(numa::nodeOfCPU(pe->affinity()));
+                    break;
+                }
+            }
+        }
+    }
+
     /* == Create the runtime runners == */
     size_t runnerIx = 0;
     for (auto &pe : platform->peArray()) {
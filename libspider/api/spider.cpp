@@ -36,7 +36,9 @@
 
 #include <api/spider.h>
 #include <memory/Stack.h>
+#include <memory/PageMap.h>
 #include <memory/memory.h>
+#include <archi/NUMATopology.h>
 #include <common/Logger.h>
 #include <runtime/platform/RTPlatform.h>
 #include <graphs/pisdf/Graph.h>
@@ -128,20 +130,29 @@ void spider::api::setStackAllocatorPolicy(StackID stackId,
                                           AllocatorPolicy policy,
                                           size_t alignment,
                                           size_t size,
-                                          void *externBuffer) {
+                                          void *externBuffer,
+                                          MemoryBacking backing) {
     auto *stack = stackArray()[static_cast<size_t>(stackId)];
     switch (policy) {
         case AllocatorPolicy::FREELIST_FIND_FIRST:
-            stack->setPolicy(new FreeListAllocatorPolicy(size, externBuffer, FreeListPolicy::FIND_FIRST, alignment));
+            stack->setPolicy(new FreeListAllocatorPolicy(size, externBuffer, FreeListPolicy::FIND_FIRST, alignment,
+                                                         backing));
             break;
         case AllocatorPolicy::FREELIST_FIND_BEST:
-            stack->setPolicy(new FreeListAllocatorPolicy(size, externBuffer, FreeListPolicy::FIND_BEST, alignment));
+            stack->setPolicy(new FreeListAllocatorPolicy(size, externBuffer, FreeListPolicy::FIND_BEST, alignment,
+                                                         backing));
             break;
         case AllocatorPolicy::GENERIC:
             stack->setPolicy(new GenericAllocatorPolicy(alignment));
             break;
         case AllocatorPolicy::LINEAR_STATIC:
-            stack->setPolicy(new LinearStaticAllocator(size, externBuffer, alignment));
+            stack->setPolicy(new LinearStaticAllocator(size, externBuffer, alignment, backing));
+            break;
+        case AllocatorPolicy::ARENA:
+            stack->setPolicy(new ArenaAllocatorPolicy(size, externBuffer, alignment));
+            break;
+        case AllocatorPolicy::TLSF:
+            stack->setPolicy(new TLSFAllocatorPolicy(size, externBuffer, alignment, backing));
             break;
     }
 }
@@ -168,7 +179,8 @@ void spider::start(const StartUpConfig &cfg) {
                                      cfg.generalStackAllocatorPolicy_,
                                      cfg.generalStackAlignment_,
                                      cfg.generalStackSize_,
-                                     cfg.generalStackExternAddress_);
+                                     cfg.generalStackExternAddress_,
+                                     cfg.generalStackBacking_);
     }
 
     /* == Init the Logger and enable the GENERAL Logger == */
@@ -233,6 +245,8 @@ spider::RuntimeContext spider::createRuntimeContext(pisdf::Graph *graph, Runtime
     if (!context.algorithm_) {
         throwSpiderException("could not create runtime algorithm.");
     }
+    /* == Set the wait policy of the runners == */
+    rt::platform()->sendWaitPolicyToRunners(config.waitPolicy_, config.spinCount_);
     context.loopSize_ = config.loopCount_;
     context.mode_ = config.mode_;
     context.graph_ = graph;
@@ -285,6 +299,7 @@ void spider::quit() {
 
     /* == Destroy the Platform == */
     destroy(archi::platform());
+    numa::clear();
 
     /* == Clear the stacks == */
     uint64_t totalUsage = 0;
@@ -292,6 +307,7 @@ void spider::quit() {
     uint64_t totalPeak = 0;
     for (auto &stack : stackArray()) {
         if (stack) {
+            stack->flushCaches();
             totalUsage += stack->usage();
             totalAverage += stack->average();
             totalPeak += stack->peak();
@@ -300,6 +316,11 @@ void spider::quit() {
     }
     Stack::print("Total", totalPeak, totalAverage, 1, totalUsage);
 
+    /* == Release the page map once no stack owns a page any more == */
+    if (!detail::releasePageMap()) {
+        log::warning("%zu page(s) are still owned after the stacks were destroyed.\n", detail::setPageCount());
+    }
+
     /* == Reset start flag == */
     startFlag = false;
 #if defined(__linux__) && defined(_SPIDER_JIT_EXPRESSION)
@@ -62,6 +62,7 @@ namespace spider {
         size_t generalStackAlignment_ = sizeof(int64_t);
         size_t generalStackSize_ = SIZE_MAX;
         void *generalStackExternAddress_ = nullptr;
+        MemoryBacking generalStackBacking_ = MemoryBacking::MALLOC; /* = Backing store of the general stack = */
     };
 
     struct RuntimeContext {
@@ -79,6 +80,10 @@ namespace spider {
         MappingPolicy mapPolicy_ = MappingPolicy::BEST_FIT;        /*!< Mapping policy to use: default is BEST_FIT */
         FifoAllocatorType allocType_ = FifoAllocatorType::DEFAULT; /*!< Allocator type to use */
         size_t loopCount_ = 1000U;                                 /*!< Number of loop to perform (only used in LOOP mode) */
+        RunnerWaitPolicy waitPolicy_ = RunnerWaitPolicy::BLOCKING; /*!< Wait policy of the runners on unmet dependencies */
+        size_t spinCount_ = 4096U;                                 /*!< Spin budget (only used with SPIN_THEN_PARK) */
+        bool pipelineIterations_ = false;                          /*!< Schedule next iteration while current one runs (LOOP and INFINITE modes with DELAYED policy only) */
+        size_t scheduleCacheCapacity_ = 0U;                        /*!< Number of iterations of dynamic graphs kept in the schedule cache, 0 to disable it (JITMS only) */
 
         RuntimeConfig() = default;
 
@@ -118,6 +123,9 @@ namespace spider {
 
         explicit RuntimeConfig(size_t loopCount) : loopCount_{ loopCount } { };
 
+        explicit RuntimeConfig(RunnerWaitPolicy policy, size_t spinCount = 4096U) : waitPolicy_{ policy },
+                                                                                    spinCount_{ spinCount } { };
+
     };
 
     /**
@@ -172,11 +180,23 @@ namespace spider {
 
     namespace api {
 
+        /**
+         * @brief Set the allocator policy of a given stack.
+         * @remark backing is only used by the policies owning a static buffer (LINEAR_STATIC, FREELIST_*, TLSF)
+         *         when no external buffer is given.
+         * @param stackId       Stack to set.
+         * @param policy        Allocator policy.
+         * @param alignment     Alignment of the allocations.
+         * @param size          Size of the static buffer of the policy.
+         * @param externBuffer  External buffer to use as static buffer (may be nullptr).
+         * @param backing       Backing store of the static buffer (see @refitem MemoryBacking).
+         */
         void setStackAllocatorPolicy(StackID stackId,
                                      AllocatorPolicy policy,
                                      size_t alignment = sizeof(uint64_t),
                                      size_t size = 0,
-                                     void *externBuffer = nullptr);
+                                     void *externBuffer = nullptr,
+                                     MemoryBacking backing = MemoryBacking::MALLOC);
     }
 
 }
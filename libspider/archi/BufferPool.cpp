@@ -0,0 +1,211 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <archi/BufferPool.h>
+#include <memory/MappedMemory.h>
+#include <common/Logger.h>
+#include <cinttypes>
+
+/* === Method(s) implementation === */
+
+spider::BufferPool::BufferPool(uint64_t maxRetainedSize,
+                               uint64_t reservedSize,
+                               MemoryBacking backing,
+                               bool populate) :
+        maxRetainedSize_{ maxRetainedSize }, regionBacking_{ backing } {
+    if (reservedSize) {
+        region_ = reinterpret_cast<char *>(detail::allocateMappedBuffer(static_cast<size_t>(reservedSize),
+                                                                        regionBacking_, populate));
+        regionSize_ = region_ ? static_cast<size_t>(reservedSize) : 0;
+    }
+    regionTouched_.store(populate, std::memory_order_relaxed);
+    regionReady_.store(populate, std::memory_order_relaxed);
+}
+
+spider::BufferPool::~BufferPool() {
+    detail::deallocateMappedBuffer(region_, regionSize_, regionBacking_);
+}
+
+void *spider::BufferPool::allocate(size_t size, const MemoryAllocateRoutine &routine) {
+    size_t classSize = 0;
+    auto &freeList = freeLists_[sizeClass(size, classSize)];
+    requestCount_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lockGuard{ freeList.lock_ };
+        if (!freeList.buffers_.empty()) {
+            auto *buffer = freeList.buffers_.back();
+            freeList.buffers_.pop_back();
+            hitCount_.fetch_add(1, std::memory_order_relaxed);
+            retainedSize_.fetch_sub(classSize, std::memory_order_relaxed);
+            if (isInRegion(buffer)) {
+                regionLiveCount_.fetch_add(1U, std::memory_order_relaxed);
+            }
+            return buffer;
+        }
+    }
+    auto *buffer = allocateFromRegion(classSize);
+    if (buffer) {
+        regionLiveCount_.fetch_add(1U, std::memory_order_relaxed);
+    } else {
+        buffer = routine(classSize);
+        if (buffer) {
+            std::lock_guard<std::mutex> lockGuard{ freeList.lock_ };
+            freeList.owned_.emplace(buffer);
+        }
+    }
+    return buffer;
+}
+
+void spider::BufferPool::deallocate(void *buffer, size_t size, const MemoryDeallocateRoutine &routine) {
+    if (!buffer) {
+        return;
+    }
+    size_t classSize = 0;
+    auto &freeList = freeLists_[sizeClass(size, classSize)];
+    std::lock_guard<std::mutex> lockGuard{ freeList.lock_ };
+    const auto inRegion = isInRegion(buffer);
+    const auto it = inRegion ? freeList.owned_.end() : freeList.owned_.find(buffer);
+    if (!inRegion && (it == freeList.owned_.end())) {
+        /* == Buffer was not allocated by the pool, it may be smaller than its class == */
+        routine(buffer);
+        return;
+    } else if (inRegion) {
+        regionLiveCount_.fetch_sub(1U, std::memory_order_relaxed);
+    }
+    const auto retained = retainedSize_.fetch_add(classSize, std::memory_order_relaxed) + classSize;
+    if ((retained > maxRetainedSize_) && !inRegion) {
+        retainedSize_.fetch_sub(classSize, std::memory_order_relaxed);
+        freeList.owned_.erase(it);
+        routine(buffer);
+        return;
+    }
+    auto peak = peakRetainedSize_.load(std::memory_order_relaxed);
+    while ((retained > peak) && !peakRetainedSize_.compare_exchange_weak(peak, retained, std::memory_order_relaxed)) { }
+    freeList.buffers_.emplace_back(buffer);
+}
+
+void spider::BufferPool::release(const MemoryDeallocateRoutine &routine) {
+    u64 regionRetainedSize = 0U;
+    for (size_t ix = 0; ix < SIZE_CLASS_COUNT; ++ix) {
+        auto &freeList = freeLists_[ix];
+        std::lock_guard<std::mutex> lockGuard{ freeList.lock_ };
+        /* == Buffers of the reserved region can not be freed on their own, they stay in the pool == */
+        auto &buffers = freeList.buffers_;
+        size_t keptCount = 0;
+        for (auto *buffer : buffers) {
+            if (isInRegion(buffer)) {
+                buffers[keptCount++] = buffer;
+            } else {
+                freeList.owned_.erase(buffer);
+                routine(buffer);
+            }
+        }
+        buffers.resize(keptCount);
+        regionRetainedSize += keptCount * classSizeOf(ix);
+    }
+    retainedSize_.store(regionRetainedSize, std::memory_order_relaxed);
+}
+
+void spider::BufferPool::touchRegion() {
+    if (regionTouched_.load(std::memory_order_relaxed) || regionTouched_.exchange(true)) {
+        return;
+    }
+    /* == No buffer of the region was given yet, nobody else is writing in it == */
+    constexpr size_t TOUCH_STRIDE = 4096;
+    auto *bytes = reinterpret_cast<volatile char *>(region_);
+    for (size_t offset = 0; offset < regionSize_; offset += TOUCH_STRIDE) {
+        bytes[offset] = 0;
+    }
+    regionReady_.store(true, std::memory_order_release);
+}
+
+void spider::BufferPool::print() const {
+    const auto poolStats = stats();
+    log::info("---------------------------\n");
+    log::info("BufferPool: [%p]\n", reinterpret_cast<const void *>(this));
+    log::info("        ==>      hit rate: %.1lf %% (%" PRIu64" / %" PRIu64")\n", 100. * poolStats.hitRate(),
+              poolStats.hitCount_, poolStats.requestCount_);
+    log::info("        ==>      retained: %" PRIu64" B\n", poolStats.retainedSize_);
+    log::info("        ==> peak retained: %" PRIu64" B\n", poolStats.peakRetainedSize_);
+    log::info("---------------------------\n");
+}
+
+spider::BufferPoolStats spider::BufferPool::stats() const {
+    BufferPoolStats poolStats;
+    poolStats.requestCount_ = requestCount_.load(std::memory_order_relaxed);
+    poolStats.hitCount_ = hitCount_.load(std::memory_order_relaxed);
+    poolStats.retainedSize_ = retainedSize_.load(std::memory_order_relaxed);
+    poolStats.peakRetainedSize_ = peakRetainedSize_.load(std::memory_order_relaxed);
+    return poolStats;
+}
+
+/* === Private method(s) === */
+
+void *spider::BufferPool::allocateFromRegion(size_t size) {
+    if (!region_ || !regionReady_.load(std::memory_order_acquire) ||
+        (regionOffset_.load(std::memory_order_relaxed) + size > regionSize_)) {
+        return nullptr;
+    }
+    const auto offset = regionOffset_.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > regionSize_) {
+        return nullptr;
+    }
+    return region_ + offset;
+}
+
+size_t spider::BufferPool::sizeClass(size_t size, size_t &classSize) {
+    if (size <= MIN_CLASS_SIZE) {
+        classSize = MIN_CLASS_SIZE;
+        return 0;
+    }
+    /* == floor(log2(size - 1)), greater or equal to 6 == */
+    size_t log2 = 0;
+    for (auto value = size - 1; value > 1; value >>= 1) {
+        log2++;
+    }
+    const auto shift = log2 - 2;
+    const auto step = size_t{ 1 } << shift;
+    classSize = (size + step - 1) & ~(step - 1);
+    return 1 + CLASS_PER_POW2 * (log2 - 6) + (((classSize - 1) >> shift) - CLASS_PER_POW2);
+}
+
+size_t spider::BufferPool::classSizeOf(size_t ix) {
+    if (!ix) {
+        return MIN_CLASS_SIZE;
+    }
+    const auto log2 = 6 + (ix - 1) / CLASS_PER_POW2;
+    return (CLASS_PER_POW2 + 1 + (ix - 1) % CLASS_PER_POW2) << (log2 - 2);
+}
@@ -0,0 +1,225 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_BUFFERPOOL_H
+#define SPIDER2_BUFFERPOOL_H
+
+/* === Include(s) === */
+
+#include <containers/vector.h>
+#include <containers/unordered_set.h>
+#include <api/global-api.h>
+#include <common/Types.h>
+#include <atomic>
+#include <mutex>
+
+namespace spider {
+
+    /* === Struct definition === */
+
+    /**
+     * @brief Statistics of a @refitem BufferPool.
+     */
+    struct BufferPoolStats {
+        u64 requestCount_ = 0U;       /*!< Number of allocation requests */
+        u64 hitCount_ = 0U;           /*!< Number of requests served by a retained buffer */
+        u64 retainedSize_ = 0U;       /*!< Bytes currently retained in the free lists */
+        u64 peakRetainedSize_ = 0U;   /*!< Peak of retained bytes */
+
+        inline double hitRate() const {
+            return requestCount_ ? static_cast<double>(hitCount_) / static_cast<double>(requestCount_) : 0.;
+        }
+    };
+
+    /* === Class definition === */
+
+    /**
+     * @brief Pool of physical buffers sorted in size classes (4 classes per power of two, 64 bytes minimum).
+     * @remark Freed buffers are kept in the free list of their class and given back to the next request of the
+     *         same class. Since FIFO sizes repeat from one iteration to the other, most allocations after the
+     *         first iteration are served without calling the allocation routine of the MemoryInterface.
+     * @remark Free lists are not intrusive, the pool never writes in the buffers it keeps.
+     * @remark Only buffers allocated by the pool (at the size of their class) are retained, the pool keeps track of
+     *         the ones it got from the allocation routine. Other buffers (allocated before the pool was enabled) are
+     *         freed right away as they may be smaller than their class.
+     * @remark An optional region can be reserved (and pre-faulted, see @refitem MemoryBacking) when the pool is
+     *         created. Misses are then carved out of the region before falling back to the allocation routine.
+     *         Buffers of the region are always retained and only given back when the pool is destroyed.
+     * @remark If the region is not populated when the pool is created, it is only used once it has been
+     *         first-touched with @refitem BufferPool::touchRegion (by a thread running on the right NUMA node).
+     */
+    class BufferPool {
+    public:
+        explicit BufferPool(uint64_t maxRetainedSize = UINT64_MAX,
+                            uint64_t reservedSize = 0,
+                            MemoryBacking backing = MemoryBacking::MALLOC,
+                            bool populate = true);
+
+        ~BufferPool();
+
+        BufferPool(const BufferPool &) = delete;
+
+        BufferPool(BufferPool &&) = delete;
+
+        BufferPool &operator=(const BufferPool &) = delete;
+
+        BufferPool &operator=(BufferPool &&) = delete;
+
+        /* === Method(s) === */
+
+        /**
+         * @brief Get a buffer of at least size bytes.
+         * @param size     Size in bytes of the buffer.
+         * @param routine  Routine used on a miss.
+         * @return pointer to the buffer, nullptr if routine failed.
+         */
+        void *allocate(size_t size, const MemoryAllocateRoutine &routine);
+
+        /**
+         * @brief Give back a buffer obtained with @refitem BufferPool::allocate.
+         * @remark If the pool already retains maxRetainedSize bytes, or if the buffer was not allocated by the pool,
+         *         the buffer is freed with routine.
+         * @param buffer   Buffer to release.
+         * @param size     Size in bytes requested when the buffer was allocated.
+         * @param routine  Routine used if the buffer can not be retained.
+         */
+        void deallocate(void *buffer, size_t size, const MemoryDeallocateRoutine &routine);
+
+        /**
+         * @brief Free every retained buffer.
+         * @param routine Routine used to free the buffers.
+         */
+        void release(const MemoryDeallocateRoutine &routine);
+
+        /**
+         * @brief Write every page of the reserved region so that they are backed by the memory of the NUMA node of
+         *        the calling thread, then let the pool use the region.
+         * @remark Only the first call does something, following calls (or calls on a populated region) return
+         *         immediately.
+         */
+        void touchRegion();
+
+        /**
+         * @brief Forget the buffers of the reserved region in use, their owner dropped them without deallocating
+         *        them (see @refitem MemoryInterface::clear).
+         */
+        inline void forgetRegionBuffers() {
+            regionLiveCount_.store(0U, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Print the statistics of the pool.
+         */
+        void print() const;
+
+        /* === Getter(s) === */
+
+        /**
+         * @brief Get current statistics of the pool.
+         * @return @refitem BufferPoolStats.
+         */
+        BufferPoolStats stats() const;
+
+        /**
+         * @brief Get the number of buffers of the reserved region given by the pool and not deallocated yet.
+         * @remark The region is unmapped when the pool is destroyed: it should be 0 by then.
+         * @return number of buffers of the region in use.
+         */
+        inline size_t regionLiveCount() const {
+            return regionLiveCount_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t MIN_CLASS_SIZE = 64;
+        static constexpr size_t CLASS_PER_POW2 = 4;
+        static constexpr size_t SIZE_CLASS_COUNT = 1 + CLASS_PER_POW2 * (64 - 6);
+
+        struct freelist_t {
+            spider::vector<void *> buffers_;
+            spider::unordered_set<void *> owned_; /* = Buffers of the class allocated with the allocation routine = */
+            std::mutex lock_;
+        };
+
+        freelist_t freeLists_[SIZE_CLASS_COUNT];
+        std::atomic<u64> requestCount_{ 0U };
+        std::atomic<u64> hitCount_{ 0U };
+        std::atomic<u64> retainedSize_{ 0U };
+        std::atomic<u64> peakRetainedSize_{ 0U };
+        u64 maxRetainedSize_ = UINT64_MAX;
+        /* = Reserved region = */
+        char *region_ = nullptr;
+        size_t regionSize_ = 0;
+        std::atomic<size_t> regionOffset_{ 0U };
+        MemoryBacking regionBacking_ = MemoryBacking::MALLOC;
+        std::atomic<bool> regionTouched_{ false };
+        std::atomic<bool> regionReady_{ false };
+        std::atomic<size_t> regionLiveCount_{ 0U };
+
+        /* === Private method(s) === */
+
+        /**
+         * @brief Get the size class of a given size.
+         * @param size       Size in bytes.
+         * @param classSize  Size in bytes of the class (set by the function).
+         * @return index of the size class.
+         */
+        static size_t sizeClass(size_t size, size_t &classSize);
+
+        /**
+         * @brief Get the size in bytes of a given size class (inverse of @refitem BufferPool::sizeClass).
+         * @param ix  Index of the size class.
+         * @return size in bytes of the class.
+         */
+        static size_t classSizeOf(size_t ix);
+
+        /**
+         * @brief Carve a buffer out of the reserved region.
+         * @param size  Size in bytes of the buffer.
+         * @return pointer to the buffer, nullptr if the region is exhausted (or was not reserved).
+         */
+        void *allocateFromRegion(size_t size);
+
+        /**
+         * @brief Check if a buffer was carved out of the reserved region.
+         * @param buffer Buffer to check.
+         * @return true if buffer belongs to the region, false else.
+         */
+        inline bool isInRegion(const void *buffer) const {
+            const auto *address = reinterpret_cast<const char *>(buffer);
+            return region_ && (address >= region_) && (address < (region_ + regionSize_));
+        }
+    };
+}
+
+#endif //SPIDER2_BUFFERPOOL_H
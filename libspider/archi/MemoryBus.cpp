@@ -144,7 +144,7 @@ void spider::MemoryBus::receive(const int64_t *paramsIN, const int64_t *, void *
     auto *clusterB = archi::platform()->cluster(static_cast<size_t>(paramsIN[1])); /* = target = */
     const auto address = static_cast<uint64_t>(paramsIN[3]);
     const auto size = paramsIN[2];
-    auto *input = clusterA->memoryInterface()->read(address);
+    auto *input = reinterpret_cast<char *>(clusterA->memoryInterface()->read(address)) + paramsIN[4];
     auto *bus = archi::platform()->getClusterToClusterMemoryBus(clusterA, clusterB);
     bus->dataReceive(size, input, out[0]);
     clusterA->memoryInterface()->deallocate(address, static_cast<size_t>(size));
@@ -39,130 +39,362 @@
 
 /* === Method(s) implementation === */
 
-spider::MemoryInterface::MemoryInterface(uint64_t size) : size_{ size }, used_{ 0 } {
+spider::MemoryInterface::MemoryInterface(uint64_t size) : size_{ size } {
     /* == Default routines == */
     allocateRoutine_ = [](u64 sizeAlloc) -> void * { return std::malloc(static_cast<size_t>(sizeAlloc)); };
     deallocateRoutine_ = [](void *addr) -> void { std::free(addr); };
+    for (auto &shard : shards_) {
+        shard.table_.store(createTable(SHARD_INITIAL_CAPACITY), std::memory_order_relaxed);
+    }
 }
 
 spider::MemoryInterface::~MemoryInterface() {
 #ifndef NDEBUG
     if (log::enabled<log::MEMORY>()) {
-        for (const auto &buff : virtual2Phys_) {
-            if (buff.second.count_) {
-                log::print<log::MEMORY>(log::yellow, "INFO",
-                                        "PHYSICAL: [%p] remaining: %zu bytes at address %zu with count: %u.\n", this,
-                                        buff.second.size_,
-                                        buff.first,
-                                        buff.second.count_);
+        for (const auto &shard : shards_) {
+            const auto *table = shard.table_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < table->capacity_; ++i) {
+                const auto *buff = table->slots_[i].load(std::memory_order_relaxed);
+                if (buff && buff->count_.load(std::memory_order_relaxed)) {
+                    log::print<log::MEMORY>(log::yellow, "INFO",
+                                            "PHYSICAL: [%p] remaining: %zu bytes at address %zu with count: %u.\n",
+                                            this,
+                                            buff->size_.load(std::memory_order_relaxed),
+                                            buff->address_,
+                                            buff->count_.load(std::memory_order_relaxed));
+                }
             }
         }
     }
 #endif
+    if (pool_) {
+        if (log::enabled()) {
+            pool_->print();
+        }
+        releasePool();
+        destroy(pool_);
+    }
+    release();
+    if (region_) {
+        deallocateRoutine_(region_);
+    }
 }
 
 void *spider::MemoryInterface::read(uint64_t address, i32 count) {
-    std::lock_guard<std::mutex> lockGuard{ lock_ };
     auto *buffer = retrieveBuffer(address);
-    buffer->count_ += count;
-    return buffer->buffer_;
+    if (!buffer) {
+        return nullptr;
+    }
+    if (count) {
+        buffer->count_.fetch_add(count, std::memory_order_relaxed);
+    }
+    return buffer->buffer_.load(std::memory_order_acquire);
 }
 
 void spider::MemoryInterface::update(uint64_t address, i32 count) {
-    std::lock_guard<std::mutex> lockGuard{ lock_ };
     auto *buffer = retrieveBuffer(address);
-    buffer->count_ += count;
+    if (buffer) {
+        buffer->count_.fetch_add(count, std::memory_order_relaxed);
+    }
 }
 
 void *spider::MemoryInterface::allocate(uint64_t address, size_t size, i32 count) {
     if (!size) {
         return nullptr;
     }
-    std::lock_guard<std::mutex> lockGuard{ lock_ };
     if (log::enabled<log::MEMORY>()) {
         log::print<log::MEMORY>(log::yellow, "INFO", "PHYSICAL: [%p] allocating: %zu bytes at address %zu.\n", this,
                                 size,
                                 address);
     }
-    uint64_t res = UINT64_MAX;
-    if (size <= available()) {
-        used_ += size;
-        res = size;
+    std::lock_guard<std::mutex> lockGuard{ shard(hash(address)).lock_ };
+    return allocateLocked(address, size, count);
+}
+
+void *spider::MemoryInterface::acquire(uint64_t address, size_t size, i32 count) {
+    if (!size) {
+        return nullptr;
     }
-    if (res != size) {
-        throwSpiderException("failed to allocate %zu bytes.", size);
+    const auto hashValue = hash(address);
+    auto &memShard = shard(hashValue);
+    std::lock_guard<std::mutex> lockGuard{ memShard.lock_ };
+    auto *buffer = find(memShard.table_.load(std::memory_order_relaxed), hashValue, address);
+    if (buffer) {
+        /* == Region is still in use: share it, unless its last user releases it concurrently == */
+        auto current = buffer->count_.load(std::memory_order_acquire);
+        while (current > 0) {
+            if (buffer->count_.compare_exchange_weak(current, current + count, std::memory_order_acq_rel)) {
+                return buffer->buffer_.load(std::memory_order_acquire);
+            }
+        }
     }
-    auto *physicalAddress = allocateRoutine_(size);
-    if (!physicalAddress) {
-        return nullptr;
+    if (log::enabled<log::MEMORY>()) {
+        log::print<log::MEMORY>(log::yellow, "INFO", "PHYSICAL: [%p] allocating: %zu bytes at address %zu.\n", this,
+                                size,
+                                address);
     }
-    registerPhysicalAddress(address, physicalAddress, size, count);
-    return physicalAddress;
+    return allocateLocked(address, size, count);
 }
 
 void spider::MemoryInterface::deallocate(uint64_t virtualAddress, size_t size) {
     if (!size) {
         return;
     }
-    std::lock_guard<std::mutex> lockGuard{ lock_ };
     auto *buffer = retrieveBuffer(virtualAddress);
-    buffer->count_ -= 1;
+    if (!buffer) {
+        return;
+    }
+    /* == Once the counter reaches 0, the buffer may be re-allocated by acquire() before we free it == */
+    auto *physicalAddress = buffer->buffer_.load(std::memory_order_acquire);
+    const auto physicalSize = buffer->size_.load(std::memory_order_relaxed);
+    const auto count = buffer->count_.fetch_sub(1, std::memory_order_acq_rel) - 1;
 #ifndef NDEBUG
-    if (buffer->size_ > used_) {
+    if (physicalSize > used()) {
         throwSpiderException("Deallocating more memory than used.");
     }
-    if (buffer->count_ < 0) {
+    if (count < 0) {
         throwSpiderException("Double free of a buffer.");
     }
 #endif
-    if (!buffer->count_) {
+    if (!count) {
         if (log::enabled<log::MEMORY>()) {
             log::print<log::MEMORY>(log::green, "INFO", "PHYSICAL: [%p] deallocating: %zu bytes at address %zu.\n",
-                                    this, buffer->size_, virtualAddress);
+                                    this, physicalSize, virtualAddress);
         }
-        used_ -= buffer->size_;
-        deallocateRoutine_(buffer->buffer_);
+        auto &memShard = shard(hash(virtualAddress));
+        std::lock_guard<std::mutex> lockGuard{ memShard.lock_ };
+        used_.fetch_sub(physicalSize, std::memory_order_relaxed);
+        deallocatePhysical(physicalAddress, physicalSize);
     }
 }
 
 void spider::MemoryInterface::clear() {
-    std::lock_guard<std::mutex> lockGuard{ lock_ };
-    virtual2Phys_.clear();
+    for (auto &shard : shards_) {
+        shard.lock_.lock();
+    }
+    release();
+    for (auto &shard : shards_) {
+        shard.table_.store(createTable(SHARD_INITIAL_CAPACITY), std::memory_order_release);
+        shard.lock_.unlock();
+    }
 }
 
 void spider::MemoryInterface::collect() {
-    std::lock_guard<std::mutex> lockGuard{ lock_ };
-    for (auto &elt : virtual2Phys_) {
-        auto &buffer = elt.second;
-        if (buffer.count_ < 0) {
-            used_ -= buffer.size_;
-            deallocateRoutine_(buffer.buffer_);
-            buffer.count_ = 0;
-            buffer.buffer_ = nullptr;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lockGuard{ shard.lock_ };
+        const auto *table = shard.table_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < table->capacity_; ++i) {
+            auto *buffer = table->slots_[i].load(std::memory_order_relaxed);
+            if (buffer && (buffer->count_.load(std::memory_order_relaxed) < 0)) {
+                const auto size = buffer->size_.load(std::memory_order_relaxed);
+                used_.fetch_sub(size, std::memory_order_relaxed);
+                deallocatePhysical(buffer->buffer_.load(std::memory_order_relaxed), size);
+                buffer->count_.store(0, std::memory_order_relaxed);
+                buffer->buffer_.store(nullptr, std::memory_order_release);
+            }
         }
     }
 }
 
+void spider::MemoryInterface::enablePool(uint64_t maxRetainedSize, uint64_t reservedSize, MemoryBacking backing) {
+    disablePool();
+    pool_ = make<BufferPool, StackID::ARCHI>(maxRetainedSize, reservedSize, backing, numaNode_ < 0);
+}
+
+void spider::MemoryInterface::reserveRegion(uint64_t base, uint64_t size) {
+    for (auto &shard : shards_) {
+        shard.lock_.lock();
+    }
+    const auto grows = (base != regionBase_) || (size > regionSize_);
+    if (grows && size && !regionCount_.load(std::memory_order_relaxed)) {
+        if (region_) {
+            deallocateRoutine_(region_);
+        }
+        region_ = reinterpret_cast<char *>(allocateRoutine_(size));
+        regionBase_ = base;
+        regionSize_ = region_ ? size : 0;
+        allocatedSize_.fetch_add(regionSize_, std::memory_order_relaxed);
+        if (log::enabled<log::MEMORY>()) {
+            log::print<log::MEMORY>(log::green, "INFO", "PHYSICAL: [%p] region of %zu bytes at address %zu.\n",
+                                    this, size, base);
+        }
+    }
+    for (auto &shard : shards_) {
+        shard.lock_.unlock();
+    }
+}
+
+void spider::MemoryInterface::firstTouch() {
+    if (pool_) {
+        pool_->touchRegion();
+    }
+}
+
+void spider::MemoryInterface::disablePool() {
+    if (pool_ && pool_->regionLiveCount()) {
+        /* == The region is unmapped with the pool, its buffers can not be given to the deallocation routine == */
+        throwSpiderException("can not disable the pool of the memory interface while its region is in use.");
+    }
+    releasePool();
+    destroy(pool_);
+}
+
 /* === Private method(s) === */
 
+void spider::MemoryInterface::releasePool() {
+    if (pool_) {
+        pool_->release(deallocateRoutine_);
+    }
+}
+
+void spider::MemoryInterface::releaseRegion() {
+    if (!region_) {
+        return;
+    } else if (regionCount_.load(std::memory_order_relaxed)) {
+        throwSpiderException("can not release the region of the memory interface while its buffers are in use.");
+    }
+    deallocateRoutine_(region_);
+    region_ = nullptr;
+    regionSize_ = 0;
+}
+
+spider::MemoryInterface::table_t *spider::MemoryInterface::createTable(size_t capacity) {
+    auto *table = make<table_t, StackID::ARCHI>();
+    table->slots_ = spider::allocate<std::atomic<buffer_t *>, StackID::ARCHI>(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        new(&table->slots_[i]) std::atomic<buffer_t *>{ nullptr };
+    }
+    table->capacity_ = capacity;
+    table->retired_ = nullptr;
+    return table;
+}
+
+void spider::MemoryInterface::destroyTables(table_t *table) {
+    while (table) {
+        auto *retired = table->retired_;
+        spider::deallocate(table->slots_);
+        destroy(table);
+        table = retired;
+    }
+}
+
+spider::MemoryInterface::buffer_t *
+spider::MemoryInterface::find(const table_t *table, uint64_t hashValue, uint64_t address) {
+    const auto mask = table->capacity_ - 1;
+    auto ix = static_cast<size_t>(hashValue / SHARD_COUNT) & mask;
+    for (;;) {
+        auto *buffer = table->slots_[ix].load(std::memory_order_acquire);
+        if (!buffer || buffer->address_ == address) {
+            return buffer;
+        }
+        ix = (ix + 1) & mask;
+    }
+}
+
+void spider::MemoryInterface::insert(shard_t &shard, uint64_t hashValue, buffer_t *buffer) {
+    auto *table = shard.table_.load(std::memory_order_relaxed);
+    if (2 * (shard.count_ + 1) > table->capacity_) {
+        /* == Grow the table, the old one stays alive for readers that may still be probing it == */
+        auto *newTable = createTable(2 * table->capacity_);
+        for (size_t i = 0; i < table->capacity_; ++i) {
+            auto *elt = table->slots_[i].load(std::memory_order_relaxed);
+            if (elt) {
+                const auto mask = newTable->capacity_ - 1;
+                auto ix = static_cast<size_t>(hash(elt->address_) / SHARD_COUNT) & mask;
+                while (newTable->slots_[ix].load(std::memory_order_relaxed)) {
+                    ix = (ix + 1) & mask;
+                }
+                newTable->slots_[ix].store(elt, std::memory_order_relaxed);
+            }
+        }
+        newTable->retired_ = table;
+        shard.table_.store(newTable, std::memory_order_release);
+        table = newTable;
+    }
+    const auto mask = table->capacity_ - 1;
+    auto ix = static_cast<size_t>(hashValue / SHARD_COUNT) & mask;
+    while (table->slots_[ix].load(std::memory_order_relaxed)) {
+        ix = (ix + 1) & mask;
+    }
+    table->slots_[ix].store(buffer, std::memory_order_release);
+    shard.count_++;
+}
+
+void *spider::MemoryInterface::allocateLocked(uint64_t address, size_t size, i32 count) {
+    auto used = used_.load(std::memory_order_relaxed);
+    do {
+        if (size > (size_ - used)) {
+            throwSpiderException("failed to allocate %zu bytes.", size);
+        }
+    } while (!used_.compare_exchange_weak(used, used + size, std::memory_order_relaxed));
+    void *physicalAddress = nullptr;
+    if (region_ && (address >= regionBase_) && (address + size <= regionBase_ + regionSize_)) {
+        physicalAddress = region_ + (address - regionBase_);
+        regionCount_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        physicalAddress = allocatePhysical(size);
+    }
+    if (!physicalAddress) {
+        used_.fetch_sub(size, std::memory_order_relaxed);
+        return nullptr;
+    }
+    registerPhysicalAddress(address, physicalAddress, size, count);
+    return physicalAddress;
+}
+
 void spider::MemoryInterface::registerPhysicalAddress(uint64_t virtAddress, void *phyAddress, size_t size, i32 count) {
-    /* == Apply offset to virtual address to get the corresponding address associated to attached MemoryUnit == */
-    virtual2Phys_[virtAddress] = buffer_t{ phyAddress, size, count };
+    const auto hashValue = hash(virtAddress);
+    auto &memShard = shard(hashValue);
+    auto *buffer = find(memShard.table_.load(std::memory_order_relaxed), hashValue, virtAddress);
+    if (buffer) {
+        /* == Virtual address is reused (new iteration or same address in a new round) == */
+        /* == Lock-free readers may load the fields concurrently, size is published before the buffer == */
+        buffer->size_.store(size, std::memory_order_relaxed);
+        buffer->buffer_.store(phyAddress, std::memory_order_release);
+        buffer->count_.store(count, std::memory_order_release);
+        return;
+    }
+    buffer = make<buffer_t, StackID::ARCHI>();
+    buffer->address_ = virtAddress;
+    buffer->buffer_.store(phyAddress, std::memory_order_relaxed);
+    buffer->size_.store(size, std::memory_order_relaxed);
+    buffer->count_.store(count, std::memory_order_relaxed);
+    insert(memShard, hashValue, buffer);
 }
 
 spider::MemoryInterface::buffer_t *spider::MemoryInterface::retrieveBuffer(uint64_t virtualAddress) {
     if (log::enabled<log::MEMORY>()) {
         log::print<log::MEMORY>(log::red, "INFO", "PHYSICAL: [%p] fetching address: %zu.\n", this, virtualAddress);
     }
+    const auto hashValue = hash(virtualAddress);
+    auto *buffer = find(shard(hashValue).table_.load(std::memory_order_acquire), hashValue, virtualAddress);
 #ifndef NDEBUG
-    try {
-        return &virtual2Phys_.at(virtualAddress);
-    } catch (const std::out_of_range &) {
+    if (!buffer) {
         log::print<log::MEMORY>(log::red, "ERROR", " [%p] accessing bad memory address.\n",
                                 reinterpret_cast<void *>(this));
-        throw;
+        throwSpiderException("accessing bad memory address %zu.", virtualAddress);
     }
-#else
-    return &virtual2Phys_[virtualAddress];
 #endif
+    return buffer;
+}
+
+void spider::MemoryInterface::release() {
+    for (auto &shard : shards_) {
+        auto *table = shard.table_.load(std::memory_order_relaxed);
+        if (!table) {
+            continue;
+        }
+        for (size_t i = 0; i < table->capacity_; ++i) {
+            auto *buffer = table->slots_[i].load(std::memory_order_relaxed);
+            destroy(buffer);
+        }
+        destroyTables(table);
+        shard.table_.store(nullptr, std::memory_order_relaxed);
+        shard.count_ = 0;
+    }
+    /* == Buffers are forgotten, so are the ones of the regions == */
+    regionCount_.store(0, std::memory_order_relaxed);
+    if (pool_) {
+        pool_->forgetRegionBuffers();
+    }
 }
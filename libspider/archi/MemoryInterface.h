@@ -37,14 +37,24 @@
 
 /* === Include(s) === */
 
-#include <containers/unordered_map.h>
+#include <memory/memory.h>
+#include <archi/BufferPool.h>
 #include <api/global-api.h>
 #include <common/Exception.h>
+#include <atomic>
+#include <mutex>
 
 namespace spider {
 
     /* === Class definition === */
 
+    /**
+     * @brief Map virtual addresses (given by the FifoAllocator) to physical buffers with a use counter.
+     * @remark Virtual addresses are spread over SHARD_COUNT open addressing tables. Look-ups and counter updates are
+     *         lock-free, only the allocation / release of a physical buffer takes the lock of its shard.
+     * @remark A range of virtual addresses may be backed by a single physical region (see reserveRegion): buffers of
+     *         the range are located at their virtual offset in the region instead of being allocated one by one.
+     */
     class MemoryInterface {
     public:
         explicit MemoryInterface(uint64_t size = 0);
@@ -78,6 +88,17 @@ namespace spider {
          */
         void *allocate(uint64_t address, size_t size, i32 count = 1);
 
+        /**
+         * @brief Share the memory of the given virtual address if it is in use, allocate it otherwise.
+         * @remark Used by producers writing in a common memory region, the first one to run allocates it and the
+         *         others only add their use count.
+         * @param address  Virtual address to evaluate.
+         * @param size     Size of the memory region.
+         * @param count    Number of use of the region to add.
+         * @return physical address of the region.
+         */
+        void *acquire(uint64_t address, size_t size, i32 count = 1);
+
         /**
          * @brief Deallocate memory from the given virtual address.
          * @param virtualAddress  Virtual address to evaluate.
@@ -95,6 +116,46 @@ namespace spider {
          */
         void clear();
 
+        /**
+         * @brief Serve physical allocations from a size-class @refitem BufferPool instead of calling the
+         *        allocation routines every time.
+         * @warning Should not be called while runners are using the memory interface.
+         * @param maxRetainedSize  Maximum number of bytes kept in the free lists of the pool.
+         * @param reservedSize     Size in bytes of the region reserved up-front for the pool (0 for none).
+         * @param backing          Backing store of the reserved region.
+         * @remark If a NUMA node is set, the reserved region is not populated here but first-touched by a runner of
+         *         the node (see @refitem MemoryInterface::firstTouch).
+         * @throws spider::Exception if a pool is already enabled and buffers of its region are in use.
+         */
+        void enablePool(uint64_t maxRetainedSize = UINT64_MAX,
+                        uint64_t reservedSize = 0,
+                        MemoryBacking backing = MemoryBacking::MALLOC);
+
+        /**
+         * @brief Free every buffer retained by the pool and go back to calling the allocation routines directly.
+         * @remark Buffers allocated by the pool outside of its region may still be in use, they are given to the
+         *         deallocation routine when deallocated.
+         * @warning Should not be called while runners are using the memory interface.
+         * @throws spider::Exception if buffers of the reserved region of the pool are in use.
+         */
+        void disablePool();
+
+        /**
+         * @brief Back the virtual addresses [base, base + size) with a single physical region.
+         * @remark Used by the lifetime aware FifoAllocator: virtual ranges it reuses then map to the same physical
+         *         bytes. Buffers that do not fit in the region are still allocated one by one.
+         * @remark The region only grows, and it is only replaced while none of its buffers is in use (the call is
+         *         ignored otherwise).
+         * @param base  First virtual address of the region.
+         * @param size  Size in bytes of the region.
+         */
+        void reserveRegion(uint64_t base, uint64_t size);
+
+        /**
+         * @brief First-touch the reserved region of the pool (if any) from the calling thread.
+         * @remark Called by the runners of the cluster so that the pages are placed on their NUMA node.
+         */
+        void firstTouch();
 
         /* === Getter(s) === */
 
@@ -111,7 +172,7 @@ namespace spider {
          * @return total current memory usage.
          */
         inline uint64_t used() const {
-            return used_;
+            return used_.load(std::memory_order_relaxed);
         }
 
         /**
@@ -119,7 +180,33 @@ namespace spider {
          * @return size() - used().
          */
         inline uint64_t available() const {
-            return size_ - used_;
+            return size_ - used();
+        }
+
+        /**
+         * @brief Get the total size of the physical memory allocated by the interface since its creation.
+         * @remark Buffers located in the region of @refitem MemoryInterface::reserveRegion are not accounted, the
+         *         region itself is.
+         * @return cumulated size in bytes.
+         */
+        inline uint64_t allocatedSize() const {
+            return allocatedSize_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the statistics of the buffer pool (hit rate, retained bytes).
+         * @return @refitem BufferPoolStats, zeroed if the pool is not enabled.
+         */
+        inline BufferPoolStats poolStats() const {
+            return pool_ ? pool_->stats() : BufferPoolStats{ };
+        }
+
+        /**
+         * @brief Get the NUMA node of the memory interface.
+         * @return NUMA node, -1 if not set.
+         */
+        inline i32 numaNode() const {
+            return numaNode_;
         }
 
         /* === Setter(s) === */
@@ -130,6 +217,8 @@ namespace spider {
          * @param routine  Routine to set.
          */
         inline void setAllocateRoutine(MemoryAllocateRoutine routine) {
+            releasePool();
+            releaseRegion();
             allocateRoutine_ = std::move(routine);
         }
 
@@ -139,22 +228,64 @@ namespace spider {
          * @param routine  Routine to set.
          */
         inline void setDeallocateRoutine(MemoryDeallocateRoutine routine) {
+            releasePool();
+            releaseRegion();
             deallocateRoutine_ = std::move(routine);
         }
 
+        /**
+         * @brief Set the NUMA node the memory of the interface should be placed on.
+         * @remark Should be set before calling @refitem MemoryInterface::enablePool.
+         * @param node  NUMA node (-1 for none).
+         */
+        inline void setNUMANode(i32 node) {
+            numaNode_ = node;
+        }
+
     private:
+        static constexpr size_t SHARD_COUNT = 16;
+        static constexpr size_t SHARD_INITIAL_CAPACITY = 64;
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        /* = Only address_ is constant, other fields are updated when the virtual address is reused = */
         struct buffer_t {
-            void *buffer_;
-            size_t size_;
-            i32 count_;
+            uint64_t address_;
+            std::atomic<void *> buffer_;
+            std::atomic<size_t> size_;
+            std::atomic<i32> count_;
+        };
+
+        /* = Open addressing table (linear probing), slots are never removed until clear() = */
+        struct table_t {
+            std::atomic<buffer_t *> *slots_;
+            size_t capacity_;
+            table_t *retired_; /* = Previous (smaller) table, kept alive for concurrent readers = */
+        };
+
+        struct shard_t {
+            std::atomic<table_t *> table_{ nullptr };
+            size_t count_ = 0;
+            std::mutex lock_;
+            char padding_[CACHE_LINE_SIZE]{ };
         };
-        /* = Map associating virtual address to physical ones = */
-        spider::unordered_map<uint64_t, buffer_t> virtual2Phys_;
-        std::mutex lock_;
+
+        shard_t shards_[SHARD_COUNT];
         /* = Total size of the MemoryUnit = */
         uint64_t size_ = 0;
         /* = Currently used memory (strictly less or equal to size_) = */
-        uint64_t used_ = 0;
+        std::atomic<uint64_t> used_{ 0 };
+        /* = Total size of the physical memory allocated = */
+        std::atomic<uint64_t> allocatedSize_{ 0 };
+        /* = Pool of freed physical buffers (nullptr if disabled) = */
+        BufferPool *pool_ = nullptr;
+        /* = Physical region backing the virtual addresses [regionBase_, regionBase_ + regionSize_) = */
+        char *region_ = nullptr;
+        uint64_t regionBase_ = 0;
+        uint64_t regionSize_ = 0;
+        /* = Number of buffers of the region in use (only updated with the lock of a shard) = */
+        std::atomic<size_t> regionCount_{ 0 };
+        /* = NUMA node of the memory (-1 if unknown) = */
+        i32 numaNode_ = -1;
 
         /* === Allocation routines === */
 
@@ -163,8 +294,57 @@ namespace spider {
 
         /* === Private method(s) === */
 
+        /**
+         * @brief Mix the bits of a virtual address.
+         * @param address Virtual address to hash.
+         * @return hash value (lower bits select the shard, upper ones the slot).
+         */
+        static inline uint64_t hash(uint64_t address) {
+            address ^= address >> 33U;
+            address *= 0xff51afd7ed558ccdULL;
+            address ^= address >> 33U;
+            return address;
+        }
+
+        inline shard_t &shard(uint64_t hashValue) {
+            return shards_[hashValue & (SHARD_COUNT - 1)];
+        }
+
+        static table_t *createTable(size_t capacity);
+
+        static void destroyTables(table_t *table);
+
+        /**
+         * @brief Find the buffer associated with a virtual address in a given table.
+         * @param table       Table to search into.
+         * @param hashValue   Hash of the virtual address.
+         * @param address     Virtual address to search.
+         * @return pointer to the buffer, nullptr if not found.
+         */
+        static buffer_t *find(const table_t *table, uint64_t hashValue, uint64_t address);
+
+        /**
+         * @brief Insert a buffer in a shard, growing its table if needed.
+         * @warning Should be called with the lock of the shard.
+         * @param shard       Shard to update.
+         * @param hashValue   Hash of the virtual address of the buffer.
+         * @param buffer      Buffer to insert.
+         */
+        static void insert(shard_t &shard, uint64_t hashValue, buffer_t *buffer);
+
+        /**
+         * @brief Allocate physical memory and register it to the given virtual address.
+         * @warning Should be called with the lock of the shard.
+         * @param address  Virtual address to evaluate.
+         * @param size     Size of the memory to allocate.
+         * @param count    Number of use of the buffer to set.
+         * @return physical memory addressed allocated.
+         */
+        void *allocateLocked(uint64_t address, size_t size, i32 count);
+
         /**
          * @brief Register a physical address associated with a given virtual address.
+         * @warning Should be called with the lock of the shard.
          * @param virtAddress Virtual address to evaluate.
          * @param phyAddress  Physical address to register.
          * @param size        Size of the memory to allocate.
@@ -178,6 +358,58 @@ namespace spider {
          * @return corresponding physical address, nullptr if not found.
          */
         buffer_t *retrieveBuffer(uint64_t virtualAddress);
+
+        /**
+         * @brief Get a physical buffer from the pool if enabled, from the allocation routine else.
+         * @param size Size in bytes of the buffer.
+         * @return physical address of the buffer.
+         */
+        inline void *allocatePhysical(size_t size) {
+            allocatedSize_.fetch_add(size, std::memory_order_relaxed);
+            return pool_ ? pool_->allocate(size, allocateRoutine_) : allocateRoutine_(size);
+        }
+
+        /**
+         * @brief Give a physical buffer back to the pool if enabled, to the deallocation routine else.
+         * @param buffer Physical address of the buffer.
+         * @param size   Size in bytes of the buffer.
+         */
+        inline void deallocatePhysical(void *buffer, size_t size) {
+            if (inRegion(buffer)) {
+                regionCount_.fetch_sub(1, std::memory_order_relaxed);
+            } else if (pool_) {
+                pool_->deallocate(buffer, size, deallocateRoutine_);
+            } else {
+                deallocateRoutine_(buffer);
+            }
+        }
+
+        /**
+         * @brief Check if a physical address belongs to the region of @refitem MemoryInterface::reserveRegion.
+         * @param buffer Physical address.
+         * @return true if buffer is in the region, false else.
+         */
+        inline bool inRegion(const void *buffer) const {
+            const auto *address = reinterpret_cast<const char *>(buffer);
+            return region_ && (address >= region_) && (address < region_ + regionSize_);
+        }
+
+        /**
+         * @brief Free the buffers retained by the pool (if any) with current deallocation routine.
+         */
+        void releasePool();
+
+        /**
+         * @brief Free the region of @refitem MemoryInterface::reserveRegion (if any) with current deallocation routine.
+         * @throws spider::Exception if buffers of the region are still in use.
+         */
+        void releaseRegion();
+
+        /**
+         * @brief Release every buffer and table of every shards.
+         * @warning Should be called with the lock of every shard.
+         */
+        void release();
     };
 }
 
@@ -0,0 +1,170 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <archi/NUMATopology.h>
+#include <containers/vector.h>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__linux__) && !defined(ANDROID)
+
+#include <pthread.h>
+#include <sched.h>
+
+#endif
+
+/* === Static function(s) === */
+
+namespace {
+    using topology_t = spider::vector<spider::vector<i32>>;
+
+    /**
+     * @brief Parse a sysfs list (for instance "0-3,8,10-11") into its values.
+     */
+    spider::vector<i32> parseList(const char *list) {
+        auto values = spider::factory::vector<i32>(StackID::ARCHI);
+        auto *cursor = list;
+        while (*cursor) {
+            char *end = nullptr;
+            const auto first = std::strtol(cursor, &end, 10);
+            if (end == cursor) {
+                break;
+            }
+            auto last = first;
+            cursor = end;
+            if (*cursor == '-') {
+                last = std::strtol(cursor + 1, &end, 10);
+                cursor = end;
+            }
+            for (auto value = first; value <= last; ++value) {
+                values.emplace_back(static_cast<i32>(value));
+            }
+            while (*cursor == ',' || *cursor == '\n') {
+                cursor++;
+            }
+        }
+        return values;
+    }
+
+    /**
+     * @brief Read a sysfs list from a file (empty if the file can not be read).
+     */
+    spider::vector<i32> readList(const char *path) {
+        auto *file = std::fopen(path, "r");
+        if (!file) {
+            return spider::factory::vector<i32>(StackID::ARCHI);
+        }
+        char buffer[4096] = { };
+        const auto count = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+        std::fclose(file);
+        buffer[count] = '\0';
+        return parseList(buffer);
+    }
+
+    /**
+     * @brief Get the topology discovered so far (nullptr before first use or after @refitem spider::numa::clear).
+     */
+    topology_t *&topologyPtr() {
+        static topology_t *nodes = nullptr;
+        return nodes;
+    }
+
+    /**
+     * @brief Get the cpus of every online node (indexed by node, empty for offline nodes).
+     * @remark Discovered on first use, from the thread creating the runtime platform before any runner is started.
+     */
+    const topology_t &topology() {
+        auto *&nodes = topologyPtr();
+        if (!nodes) {
+            nodes = spider::make<topology_t, StackID::ARCHI>(
+                    spider::factory::vector<spider::vector<i32>>(StackID::ARCHI));
+            for (const auto node : readList("/sys/devices/system/node/online")) {
+                if (node < 0) {
+                    continue;
+                }
+                char path[128];
+                std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+                if (nodes->size() <= static_cast<size_t>(node)) {
+                    nodes->resize(static_cast<size_t>(node) + 1, spider::factory::vector<i32>(StackID::ARCHI));
+                }
+                (*nodes)[static_cast<size_t>(node)] = readList(path);
+            }
+        }
+        return *nodes;
+    }
+}
+
+/* === Function(s) definition === */
+
+size_t spider::numa::nodeIndexBound() {
+    const auto bound = topology().size();
+    return bound ? bound : 1;
+}
+
+i32 spider::numa::nodeOfCPU(i32 cpu) {
+    const auto &nodes = topology();
+    for (size_t node = 0; node < nodes.size(); ++node) {
+        for (const auto nodeCPU : nodes[node]) {
+            if (nodeCPU == cpu) {
+                return static_cast<i32>(node);
+            }
+        }
+    }
+    return -1;
+}
+
+bool spider::numa::bindThreadToNode(i32 node) {
+    const auto &nodes = topology();
+    if ((node < 0) || (static_cast<size_t>(node) >= nodes.size()) || nodes[static_cast<size_t>(node)].empty()) {
+        return false;
+    }
+#if defined(__linux__) && !defined(ANDROID)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const auto cpu : nodes[static_cast<size_t>(node)]) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+    return false;
+#endif
+}
+
+void spider::numa::clear() {
+    destroy(topologyPtr());
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_NUMATOPOLOGY_H
+#define SPIDER2_NUMATOPOLOGY_H
+
+/* === Include(s) === */
+
+#include <common/Types.h>
+#include <cstddef>
+
+namespace spider {
+    namespace numa {
+
+        /* === Function(s) prototype === */
+
+        /**
+         * @brief Get the upper bound of the NUMA node indexes of the machine (highest online node index + 1).
+         * @remark Online nodes may be sparse: an index below the bound is not necessarily an online node.
+         * @remark Nodes are discovered once from /sys/devices/system/node, 1 is returned if it is not available.
+         * @return upper bound of the node indexes.
+         */
+        size_t nodeIndexBound();
+
+        /**
+         * @brief Get the NUMA node of a given cpu.
+         * @param cpu  Index of the cpu (as used for thread affinity).
+         * @return index of the node, -1 if unknown.
+         */
+        i32 nodeOfCPU(i32 cpu);
+
+        /**
+         * @brief Pin the calling thread on the cpus of a given NUMA node.
+         * @param node  Index of the node.
+         * @return true on success, false if the node is unknown or if the affinity could not be set.
+         */
+        bool bindThreadToNode(i32 node);
+
+        /**
+         * @brief Release the discovered topology (called by spider::quit before the stacks are destroyed).
+         */
+        void clear();
+    }
+}
+
+#endif //SPIDER2_NUMATOPOLOGY_H
@@ -60,8 +60,8 @@ namespace spider {
         }
 
         template<class Key, class Compare = std::less<Key>>
-        inline spider::set<Key, Compare> set(spider::map<Key, Compare> &&other, StackID stack = StackID::GENERAL) {
-            return spider::set<Key, Compare>(other, spider::allocator<Key>(stack));
+        inline spider::set<Key, Compare> set(spider::set<Key, Compare> &&other, StackID stack = StackID::GENERAL) {
+            return spider::set<Key, Compare>(std::move(other), spider::allocator<Key>(stack));
         }
     }
 }
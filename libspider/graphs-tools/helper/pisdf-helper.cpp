@@ -47,17 +47,17 @@
  * @brief Creates an array with parameters needed for the runtime exec of a normal vertex.
  * @param vertex Pointer to the vertex.
  * @param params Parameters to use for the rates evaluation. (should contain the same parameters as the graphs)
- * @return array of int_least_64_t.
+ * @param result Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildDefaultVertexRuntimeParameters(const spider::pisdf::Vertex *vertex,
-                                                                   const spider::vector<std::shared_ptr<spider::pisdf::Param>> &params) {
+static void buildDefaultVertexRuntimeParameters(const spider::pisdf::Vertex *vertex,
+                                                const spider::vector<std::shared_ptr<spider::pisdf::Param>> &params,
+                                                spider::vector<i64> &result) {
     const auto &refinementParamIx = vertex->refinementParamIxVector();
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(refinementParamIx.size()));
-    std::transform(std::begin(refinementParamIx), std::end(refinementParamIx), result.get(),
+    result.resize(refinementParamIx.size());
+    std::transform(std::begin(refinementParamIx), std::end(refinementParamIx), result.data(),
                    [&params](u32 ix) {
                        return params[ix]->value();
                    });
-    return result;
 }
 
 /**
@@ -65,19 +65,19 @@ static spider::unique_ptr<i64> buildDefaultVertexRuntimeParameters(const spider:
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildForkRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                               const spider::pisdf::GraphFiring *handler) {
+static void buildForkRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                            const spider::pisdf::GraphFiring *handler,
+                                            spider::vector<i64> &result) {
     const auto &outputEdges = vertex->outputEdges();
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(outputEdges.size() + 2));
+    result.resize(outputEdges.size() + 2);
     result[0] = handler->getSnkRate(vertex->inputEdge(0));
     result[1] = static_cast<i64>(outputEdges.size());
-    std::transform(std::begin(outputEdges), std::end(outputEdges), std::next(result.get(), 2),
+    std::transform(std::begin(outputEdges), std::end(outputEdges), std::next(result.data(), 2),
                    [handler](const spider::pisdf::Edge *edge) {
                        return handler->getSrcRate(edge);
                    });
-    return result;
 }
 
 /**
@@ -85,19 +85,19 @@ static spider::unique_ptr<i64> buildForkRuntimeInputParameters(const spider::pis
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildJoinRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                               const spider::pisdf::GraphFiring *handler) {
+static void buildJoinRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                            const spider::pisdf::GraphFiring *handler,
+                                            spider::vector<i64> &result) {
     const auto &inputEdges = vertex->inputEdges();
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputEdges.size() + 2));
+    result.resize(inputEdges.size() + 2);
     result[0] = handler->getSrcRate(vertex->outputEdge(0));
     result[1] = static_cast<i64>(inputEdges.size());
-    std::transform(std::begin(inputEdges), std::end(inputEdges), std::next(result.get(), 2),
+    std::transform(std::begin(inputEdges), std::end(inputEdges), std::next(result.data(), 2),
                    [handler](const spider::pisdf::Edge *edge) {
                        return handler->getSnkRate(edge);
                    });
-    return result;
 }
 
 /**
@@ -105,10 +105,11 @@ static spider::unique_ptr<i64> buildJoinRuntimeInputParameters(const spider::pis
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildTailRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                               const spider::pisdf::GraphFiring *handler) {
+static void buildTailRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                            const spider::pisdf::GraphFiring *handler,
+                                            spider::vector<i64> &result) {
     size_t inputCount = 1;
     auto rate = handler->getSrcRate(vertex->outputEdge(0));
     const auto inputEdges = vertex->inputEdges();
@@ -122,7 +123,7 @@ static spider::unique_ptr<i64> buildTailRuntimeInputParameters(const spider::pis
         rate -= inRate;
         inputCount++;
     }
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputCount + 4u));
+    result.resize(inputCount + 4u);
     /* = Number of input = */
     result[0] = static_cast<i64>(inputEdges.size());
     /* = First input to be considered = */
@@ -136,7 +137,6 @@ static spider::unique_ptr<i64> buildTailRuntimeInputParameters(const spider::pis
         result[i] = handler->getSnkRate(*it);
         i++;
     }
-    return result;
 }
 
 /**
@@ -144,10 +144,11 @@ static spider::unique_ptr<i64> buildTailRuntimeInputParameters(const spider::pis
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildHeadRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                               const spider::pisdf::GraphFiring *handler) {
+static void buildHeadRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                            const spider::pisdf::GraphFiring *handler,
+                                            spider::vector<i64> &result) {
     size_t inputCount = 1;
     auto rate = handler->getSrcRate(vertex->outputEdge(0));
     for (auto &edge : vertex->inputEdges()) {
@@ -158,7 +159,7 @@ static spider::unique_ptr<i64> buildHeadRuntimeInputParameters(const spider::pis
         rate -= inRate;
         inputCount++;
     }
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputCount + 1u));
+    result.resize(inputCount + 1u);
     result[0] = static_cast<i64>(inputCount);
     rate = handler->getSnkRate(vertex->outputEdge(0));
     for (size_t i = 0; i < inputCount; ++i) {
@@ -166,7 +167,6 @@ static spider::unique_ptr<i64> buildHeadRuntimeInputParameters(const spider::pis
         result[i + 1] = std::min(inRate, rate);
         rate -= inRate;
     }
-    return result;
 }
 
 /**
@@ -174,14 +174,14 @@ static spider::unique_ptr<i64> buildHeadRuntimeInputParameters(const spider::pis
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildRepeatRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                                 const spider::pisdf::GraphFiring *handler) {
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(2u));
+static void buildRepeatRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                              const spider::pisdf::GraphFiring *handler,
+                                              spider::vector<i64> &result) {
+    result.resize(2u);
     result[0] = handler->getSnkRate(vertex->inputEdge(0));
     result[1] = handler->getSrcRate(vertex->outputEdge(0));
-    return result;
 }
 
 /**
@@ -189,23 +189,24 @@ static spider::unique_ptr<i64> buildRepeatRuntimeInputParameters(const spider::p
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildDuplicateRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                                    const spider::pisdf::GraphFiring *handler) {
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(2u));
+static void buildDuplicateRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                                 const spider::pisdf::GraphFiring *handler,
+                                                 spider::vector<i64> &result) {
+    result.resize(2u);
     result[0] = static_cast<i64>(vertex->outputEdgeCount());
     result[1] = handler->getSnkRate(vertex->inputEdge(0));
-    return result;
 }
 
 /**
  * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::INIT special vertex.
  * @param vertex Pointer to the @refitem pisdf::Vertex associated with the delay.
- * @return array of int_least_64_t.
+ * @param result Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildInitRuntimeInputParameters(const spider::pisdf::Vertex *vertex) {
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(3u));
+static void buildInitRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                            spider::vector<i64> &result) {
+    result.resize(3u);
     const auto *sink = vertex->outputEdge(0u)->sink();
     if (sink->subtype() == spider::pisdf::VertexType::DELAY) {
         const auto *delayVertex = sink->convertTo<spider::pisdf::DelayVertex>();
@@ -218,16 +219,16 @@ static spider::unique_ptr<i64> buildInitRuntimeInputParameters(const spider::pis
         result[1] = 0;
         result[2] = 0;
     }
-    return result;
 }
 
 /**
  * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::END special vertex.
  * @param vertex Pointer to the @refitem pisdf::Vertex associated with the delay.
- * @return array of int_least_64_t.
+ * @param result Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildEndRuntimeInputParameters(const spider::pisdf::Vertex *vertex) {
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(3u));
+static void buildEndRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                           spider::vector<i64> &result) {
+    result.resize(3u);
     const auto *source = vertex->inputEdge(0u)->source();
     if (source->subtype() == spider::pisdf::VertexType::DELAY) {
         const auto *delayVertex = source->convertTo<spider::pisdf::DelayVertex>();
@@ -240,7 +241,6 @@ static spider::unique_ptr<i64> buildEndRuntimeInputParameters(const spider::pisd
         result[1] = 0;
         result[2] = 0;
     }
-    return result;
 }
 
 /**
@@ -248,15 +248,15 @@ static spider::unique_ptr<i64> buildEndRuntimeInputParameters(const spider::pisd
  *        special vertex.
  * @param vertex  Pointer to the vertex.
  * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
- * @return array of int_least_64_t.
+ * @param result  Vector filled with the parameters (resized as needed).
  */
-static spider::unique_ptr<i64> buildExternOutRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
-                                                                    const spider::pisdf::GraphFiring *handler) {
-    auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(2u));
+static void buildExternOutRuntimeInputParameters(const spider::pisdf::Vertex *vertex,
+                                                 const spider::pisdf::GraphFiring *handler,
+                                                 spider::vector<i64> &result) {
+    result.resize(2u);
     const auto *reference = vertex->convertTo<spider::pisdf::ExternInterface>();
     result[0] = static_cast<i64>(reference->address());
     result[1] = handler->getSnkRate(vertex->inputEdge(0));
-    return result;
 }
 
 /* === Function(s) definition === */
@@ -446,29 +446,40 @@ void spider::pisdf::recursiveSplitDynamicGraph(Graph *graph) {
     }
 }
 
-spider::unique_ptr<i64>
-spider::pisdf::buildVertexRuntimeInputParameters(const Vertex *vertex, const GraphFiring *handler) {
+void spider::pisdf::buildVertexRuntimeInputParameters(const Vertex *vertex,
+                                                      const GraphFiring *handler,
+                                                      spider::vector<i64> &params) {
     switch (vertex->subtype()) {
         case VertexType::FORK:
-            return buildForkRuntimeInputParameters(vertex, handler);
+            buildForkRuntimeInputParameters(vertex, handler, params);
+            break;
         case VertexType::JOIN:
-            return buildJoinRuntimeInputParameters(vertex, handler);
+            buildJoinRuntimeInputParameters(vertex, handler, params);
+            break;
         case VertexType::TAIL:
-            return buildTailRuntimeInputParameters(vertex, handler);
+            buildTailRuntimeInputParameters(vertex, handler, params);
+            break;
         case VertexType::HEAD:
-            return buildHeadRuntimeInputParameters(vertex, handler);
+            buildHeadRuntimeInputParameters(vertex, handler, params);
+            break;
         case VertexType::REPEAT:
-            return buildRepeatRuntimeInputParameters(vertex, handler);
+            buildRepeatRuntimeInputParameters(vertex, handler, params);
+            break;
         case VertexType::DUPLICATE:
-            return buildDuplicateRuntimeInputParameters(vertex, handler);
+            buildDuplicateRuntimeInputParameters(vertex, handler, params);
+            break;
         case VertexType::INIT:
-            return buildInitRuntimeInputParameters(vertex);
+            buildInitRuntimeInputParameters(vertex, params);
+            break;
         case VertexType::END:
-            return buildEndRuntimeInputParameters(vertex);
+            buildEndRuntimeInputParameters(vertex, params);
+            break;
         case VertexType::EXTERN_OUT:
-            return buildExternOutRuntimeInputParameters(vertex, handler);
+            buildExternOutRuntimeInputParameters(vertex, handler, params);
+            break;
         default:
-            return buildDefaultVertexRuntimeParameters(vertex, handler->getParams());
+            buildDefaultVertexRuntimeParameters(vertex, handler->getParams(), params);
+            break;
     }
 }
 
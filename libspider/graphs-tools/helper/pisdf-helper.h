@@ -85,10 +85,11 @@ namespace spider {
          * @brief Creates an array with parameters needed for the runtime exec of a vertex.
          * @param vertex  Pointer to the vertex.
          * @param handler Pointer to the @refitem spider::pisdf::GraphFiring managing this particular vertex instance.
-         * @return array of int_least_64_t.
+         * @param params  Vector filled with the parameters (resized as needed, capacity is kept between calls).
          */
-        spider::unique_ptr<i64>
-        buildVertexRuntimeInputParameters(const pisdf::Vertex *vertex, const GraphFiring *handler);
+        void buildVertexRuntimeInputParameters(const pisdf::Vertex *vertex,
+                                               const GraphFiring *handler,
+                                               spider::vector<i64> &params);
 
         /**
          * @brief Get the source of the vertex across interfaces.
@@ -51,61 +51,62 @@ namespace spider {
         /**
          * @brief Creates an array with parameters needed for the runtime exec of a normal vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildDefaultVertexRuntimeParameters(const srdag::Vertex *vertex) {
+        void buildDefaultVertexRuntimeParameters(const srdag::Vertex *vertex,
+                                                 spider::vector<i64> &result) {
             const auto &inputParams = vertex->refinementParamVector();
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputParams.size()));
-            std::transform(std::begin(inputParams), std::end(inputParams), result.get(),
+            result.resize(inputParams.size());
+            std::transform(std::begin(inputParams), std::end(inputParams), result.data(),
                            [](const std::shared_ptr<spider::pisdf::Param> &param) {
                                return param->value();
                            });
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::FORK
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildForkRuntimeInputParameters(const srdag::Vertex *vertex) {
+        void buildForkRuntimeInputParameters(const srdag::Vertex *vertex,
+                                             spider::vector<i64> &result) {
             const auto &outputEdges = vertex->outputEdges();
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(outputEdges.size() + 2));
+            result.resize(outputEdges.size() + 2);
             result[0] = vertex->inputEdge(0)->sinkRateValue();
             result[1] = static_cast<i64>(outputEdges.size());
-            std::transform(std::begin(outputEdges), std::end(outputEdges), std::next(result.get(), 2),
+            std::transform(std::begin(outputEdges), std::end(outputEdges), std::next(result.data(), 2),
                            [](const spider::srdag::Edge *edge) {
                                return edge->sourceRateValue();
                            });
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::JOIN
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildJoinRuntimeInputParameters(const srdag::Vertex *vertex) {
+        void buildJoinRuntimeInputParameters(const srdag::Vertex *vertex,
+                                             spider::vector<i64> &result) {
             const auto &inputEdges = vertex->inputEdges();
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputEdges.size() + 2));
+            result.resize(inputEdges.size() + 2);
             result[0] = vertex->outputEdge(0)->sourceRateValue();
             result[1] = static_cast<i64>(inputEdges.size());
-            std::transform(std::begin(inputEdges), std::end(inputEdges), std::next(result.get(), 2),
+            std::transform(std::begin(inputEdges), std::end(inputEdges), std::next(result.data(), 2),
                            [](const srdag::Edge *edge) {
                                return edge->sinkRateValue();
                            });
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::TAIL
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildTailRuntimeInputParameters(const srdag::Vertex *vertex) {
+        void buildTailRuntimeInputParameters(const srdag::Vertex *vertex,
+                                             spider::vector<i64> &result) {
             size_t inputCount = 1;
             auto rate = vertex->outputEdge(0)->sourceRateValue();
             const auto inputEdges = vertex->inputEdges();
@@ -119,7 +120,7 @@ namespace spider {
                 rate -= inRate;
                 inputCount++;
             }
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputCount + 4u));
+            result.resize(inputCount + 4u);
             /* = Number of input = */
             result[0] = static_cast<i64>(inputEdges.size());
             /* = First input to be considered = */
@@ -133,16 +134,16 @@ namespace spider {
             for (auto it = itRBegin; it != itREnd - static_cast<long>(inputCount) + 1; --it) {
                 result[i++] = (*it)->sinkRateValue();
             }
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::HEAD
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildHeadRuntimeInputParameters(const srdag::Vertex *vertex) {
+        void buildHeadRuntimeInputParameters(const srdag::Vertex *vertex,
+                                             spider::vector<i64> &result) {
             size_t inputCount = 1;
             auto rate = vertex->outputEdge(0)->sourceRateValue();
             for (auto &edge : vertex->inputEdges()) {
@@ -153,7 +154,7 @@ namespace spider {
                 rate -= inRate;
                 inputCount++;
             }
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(inputCount + 1u));
+            result.resize(inputCount + 1u);
             result[0] = static_cast<i64>(inputCount);
             rate = vertex->outputEdge(0)->sourceRateValue();
             for (size_t i = 0; i < inputCount; ++i) {
@@ -161,42 +162,42 @@ namespace spider {
                 result[i + 1] = std::min(inRate, rate);
                 rate -= inRate;
             }
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::REPEAT
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildRepeatRuntimeInputParameters(const srdag::Vertex *vertex) {
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(2u));
+        void buildRepeatRuntimeInputParameters(const srdag::Vertex *vertex,
+                                               spider::vector<i64> &result) {
+            result.resize(2u);
             result[0] = vertex->inputEdge(0)->sinkRateValue();
             result[1] = vertex->outputEdge(0)->sourceRateValue();
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::DUPLICATE
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildDuplicateRuntimeInputParameters(const srdag::Vertex *vertex) {
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(2u));
+        void buildDuplicateRuntimeInputParameters(const srdag::Vertex *vertex,
+                                                  spider::vector<i64> &result) {
+            result.resize(2u);
             result[0] = static_cast<i64>(vertex->outputEdgeCount());
             result[1] = vertex->inputEdge(0)->sinkRateValue();
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::INIT special vertex.
          * @param vertex Pointer to the @refitem pisdf::Vertex associated with the delay.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildInitRuntimeInputParameters(const srdag::Vertex *vertex) {
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(3u));
+        void buildInitRuntimeInputParameters(const srdag::Vertex *vertex,
+                                             spider::vector<i64> &result) {
+            result.resize(3u);
             const auto *reference = vertex->reference();
             const auto *sink = reference->outputEdge(0u)->sink();
             if (sink->subtype() == pisdf::VertexType::DELAY) {
@@ -210,16 +211,16 @@ namespace spider {
                 result[1] = 0;
                 result[2] = 0;
             }
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::END special vertex.
          * @param vertex Pointer to the @refitem pisdf::Vertex associated with the delay.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildEndRuntimeInputParameters(const srdag::Vertex *vertex) {
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(3u));
+        void buildEndRuntimeInputParameters(const srdag::Vertex *vertex,
+                                            spider::vector<i64> &result) {
+            result.resize(3u);
             const auto *reference = vertex->reference();
             const auto *source = reference->inputEdge(0u)->source();
             if (source->subtype() == pisdf::VertexType::DELAY) {
@@ -233,50 +234,59 @@ namespace spider {
                 result[1] = 0;
                 result[2] = 0;
             }
-            return result;
         }
 
         /**
          * @brief Creates an array with parameters needed for the runtime exec of @refitem pisdf::VertexType::EXTERN_OUT
          *        special vertex.
          * @param vertex Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param result Vector filled with the parameters (resized as needed).
          */
-        spider::unique_ptr<i64> buildExternOutRuntimeInputParameters(const srdag::Vertex *vertex) {
-            auto result = spider::make_unique(spider::allocate<i64, StackID::RUNTIME>(2u));
+        void buildExternOutRuntimeInputParameters(const srdag::Vertex *vertex,
+                                                  spider::vector<i64> &result) {
+            result.resize(2u);
             const auto *reference = vertex->reference()->convertTo<spider::pisdf::ExternInterface>();
             const auto *inputEdge = vertex->inputEdge(0);
             result[0] = static_cast<i64>(reference->address());
             result[1] = inputEdge->sinkRateValue();
-            return result;
         }
     }
 }
 
 /* === Function(s) definition === */
 
-spider::unique_ptr<i64> spider::srdag::buildVertexRuntimeInputParameters(const srdag::Vertex *vertex) {
+void spider::srdag::buildVertexRuntimeInputParameters(const srdag::Vertex *vertex, spider::vector<i64> &params) {
     switch (vertex->subtype()) {
         case pisdf::VertexType::FORK:
-            return buildForkRuntimeInputParameters(vertex);
+            buildForkRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::JOIN:
-            return buildJoinRuntimeInputParameters(vertex);
+            buildJoinRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::TAIL:
-            return buildTailRuntimeInputParameters(vertex);
+            buildTailRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::HEAD:
-            return buildHeadRuntimeInputParameters(vertex);
+            buildHeadRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::REPEAT:
-            return buildRepeatRuntimeInputParameters(vertex);
+            buildRepeatRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::DUPLICATE:
-            return buildDuplicateRuntimeInputParameters(vertex);
+            buildDuplicateRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::INIT:
-            return buildInitRuntimeInputParameters(vertex);
+            buildInitRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::END:
-            return buildEndRuntimeInputParameters(vertex);
+            buildEndRuntimeInputParameters(vertex, params);
+            break;
         case pisdf::VertexType::EXTERN_OUT:
-            return buildExternOutRuntimeInputParameters(vertex);;
+            buildExternOutRuntimeInputParameters(vertex, params);
+            break;
         default:
-            return buildDefaultVertexRuntimeParameters(vertex);
+            buildDefaultVertexRuntimeParameters(vertex, params);
+            break;
     }
 }
 
@@ -40,7 +40,7 @@
 /* === Include(s) === */
 
 #include <common/Types.h>
-#include <memory/unique_ptr.h>
+#include <containers/vector.h>
 
 /* === Function(s) prototype === */
 
@@ -51,9 +51,9 @@ namespace spider {
         /**
          * @brief Creates an array with parameters needed for the runtime exec of a vertex.
          * @param vertex  Pointer to the vertex.
-         * @return array of int_least_64_t.
+         * @param params  Vector filled with the parameters (resized as needed, capacity is kept between calls).
          */
-        spider::unique_ptr<i64> buildVertexRuntimeInputParameters(const srdag::Vertex *vertex);
+        void buildVertexRuntimeInputParameters(const srdag::Vertex *vertex, spider::vector<i64> &params);
     }
 }
 #endif
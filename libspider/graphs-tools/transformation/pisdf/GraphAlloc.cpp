@@ -44,9 +44,9 @@
 /* === Function(s) definition === */
 
 spider::pisdf::GraphAlloc::GraphAlloc(const Graph *graph) {
-    taskIxArray_ = spider::make_unique(make_n<u32 *, StackID::SCHEDULE>(graph->vertexCount(), nullptr));
-    tasksArray_ = spider::make_unique(make_n<sched::PiSDFTask *, StackID::SCHEDULE>(graph->vertexCount(), nullptr));
-    edgeAllocArray_ = spider::make_unique(make_n<FifoAlloc *, StackID::SCHEDULE>(graph->edgeCount(), nullptr));
+    taskIxArray_ = spider::make_unique(make_n<u32 *, StackID::GENERAL>(graph->vertexCount(), nullptr));
+    tasksArray_ = spider::make_unique(make_n<sched::PiSDFTask *, StackID::GENERAL>(graph->vertexCount(), nullptr));
+    edgeAllocArray_ = spider::make_unique(make_n<FifoAlloc *, StackID::GENERAL>(graph->edgeCount(), nullptr));
 }
 
 void spider::pisdf::GraphAlloc::clear(const Graph *graph) {
@@ -92,17 +92,17 @@ void spider::pisdf::GraphAlloc::initialize(GraphFiring *handler, const Vertex *v
     const auto ix = vertex->ix();
     destroy(tasksArray_[ix]);
     if (rv > 1) {
-        tasksArray_[ix] = spider::make<sched::VectPiSDFTask, StackID::SCHEDULE>(handler, vertex);
+        tasksArray_[ix] = spider::make<sched::VectPiSDFTask, StackID::GENERAL>(handler, vertex);
     } else {
-        tasksArray_[ix] = spider::make<sched::UniPiSDFTask, StackID::SCHEDULE>(handler, vertex);
+        tasksArray_[ix] = spider::make<sched::UniPiSDFTask, StackID::GENERAL>(handler, vertex);
     }
     deallocate(taskIxArray_[ix]);
-    taskIxArray_[ix] = spider::make_n<u32, StackID::SCHEDULE>(rv, UINT32_MAX);
+    taskIxArray_[ix] = spider::make_n<u32, StackID::GENERAL>(rv, UINT32_MAX);
     const auto isSpecial = vertex->subtype() == VertexType::FORK || vertex->subtype() == VertexType::DUPLICATE;
     const auto size = isSpecial ? rv : 1;
     for (const auto *edge : vertex->outputEdges()) {
         deallocate(edgeAllocArray_[edge->ix()]);
-        edgeAllocArray_[edge->ix()] = spider::make_n<FifoAlloc, StackID::SCHEDULE>(size, { SIZE_MAX, 0 });
+        edgeAllocArray_[edge->ix()] = spider::make_n<FifoAlloc, StackID::GENERAL>(size, { SIZE_MAX, 0 });
     }
 }
 
@@ -48,7 +48,7 @@
 spider::pisdf::GraphFiring::GraphFiring(const GraphHandler *parent,
                                         const spider::vector<std::shared_ptr<pisdf::Param>> &params,
                                         u32 firing) :
-        params_{ factory::vector<std::shared_ptr<pisdf::Param>>(StackID::TRANSFO) },
+        params_{ factory::vector<std::shared_ptr<pisdf::Param>>(StackID::GENERAL) },
         parent_{ parent },
         firing_{ firing },
         resolved_{ false } {
@@ -56,8 +56,8 @@ spider::pisdf::GraphFiring::GraphFiring(const GraphHandler *parent,
         throwNullptrException();
     }
     const auto *graph = parent->graph();
-    brvArray_ = spider::make_unique(make_n<u32, StackID::TRANSFO>(graph->vertexCount(), UINT32_MAX));
-    ratesArray_ = spider::make_unique(make_n<EdgeRate, StackID::TRANSFO>(graph->edgeCount(), { 0, 0 }));
+    brvArray_ = spider::make_unique(make_n<u32, StackID::GENERAL>(graph->vertexCount(), UINT32_MAX));
+    ratesArray_ = spider::make_unique(make_n<EdgeRate, StackID::GENERAL>(graph->edgeCount(), { 0, 0 }));
     /* == copy parameters == */
     params_.reserve(params.size());
     dynamicParamCount_ = 0;
@@ -65,9 +65,9 @@ spider::pisdf::GraphFiring::GraphFiring(const GraphHandler *parent,
         dynamicParamCount_ += param->type() == pisdf::ParamType::DYNAMIC;
         params_.emplace_back(copyParameter(param));
     }
-    depsCountArray_ = spider::make_unique(make_n<u32 *, StackID::TRANSFO>(graph->vertexCount(), nullptr));
-    subgraphHandlers_ = spider::make_unique(make_n<GraphHandler *, StackID::TRANSFO>(graph->subgraphCount(), nullptr));
-    alloc_ = spider::make_unique(make<GraphAlloc, StackID::SCHEDULE>(parent->graph()));
+    depsCountArray_ = spider::make_unique(make_n<u32 *, StackID::GENERAL>(graph->vertexCount(), nullptr));
+    subgraphHandlers_ = spider::make_unique(make_n<GraphHandler *, StackID::GENERAL>(graph->subgraphCount(), nullptr));
+    alloc_ = spider::make_unique(make<GraphAlloc, StackID::GENERAL>(parent->graph()));
 }
 
 spider::pisdf::GraphFiring::~GraphFiring() {
@@ -319,14 +319,14 @@ void spider::pisdf::GraphFiring::updateFromRV(const pisdf::Vertex *vertex, u32 r
         brvArray_[ix] = rv;
         alloc_->initialize(this, vertex, rv);
         deallocate(depsCountArray_[ix]);
-        depsCountArray_[ix] = make_n<u32, StackID::TRANSFO>(count, 0);
+        depsCountArray_[ix] = make_n<u32, StackID::GENERAL>(count, 0);
         if (parent_->isStatic()) {
             const auto parentRV = parent_->repetitionCount();
             for (u32 k = 1; k < parentRV; ++k) {
                 auto *graphFiring = parent_->firing(k);
                 graphFiring->alloc_->initialize(graphFiring, vertex, rv);
                 deallocate(graphFiring->depsCountArray_[ix]);
-                graphFiring->depsCountArray_[ix] = make_n<u32, StackID::TRANSFO>(count, 0);
+                graphFiring->depsCountArray_[ix] = make_n<u32, StackID::GENERAL>(count, 0);
             }
         }
     } else {
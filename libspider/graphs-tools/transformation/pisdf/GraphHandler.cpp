@@ -51,7 +51,7 @@ spider::pisdf::GraphHandler::GraphHandler(const spider::pisdf::Graph *graph,
         handler_{ handler },
         graph_{ graph },
         repetitionCount_{ repetitionCount } {
-    firings_ = spider::make_unique(spider::make_n<GraphFiring *, StackID::TRANSFO>(repetitionCount, nullptr));
+    firings_ = spider::make_unique(spider::make_n<GraphFiring *, StackID::GENERAL>(repetitionCount, nullptr));
     static_ = true;
     const auto *upperGraph = graph_->graph();
     if (upperGraph && upperGraph->configVertexCount()) {
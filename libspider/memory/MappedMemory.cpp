@@ -0,0 +1,134 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <memory/MappedMemory.h>
+#include <cstdlib>
+
+#ifdef __linux__
+
+#include <sys/mman.h>
+
+/* === Static variable(s) === */
+
+static constexpr size_t SMALL_PAGE_SIZE = 4096;
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/* === Static function(s) === */
+
+static size_t roundUp(size_t size, size_t pageSize) {
+    return (size + pageSize - 1) & ~(pageSize - 1);
+}
+
+static void *mapHugePages(size_t size, bool populate) {
+#ifdef MAP_HUGETLB
+    auto *buffer = mmap(nullptr, roundUp(size, HUGE_PAGE_SIZE), PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (populate ? MAP_POPULATE : 0), -1, 0);
+    return buffer == MAP_FAILED ? nullptr : buffer;
+#else
+    (void) size;
+    (void) populate;
+    return nullptr;
+#endif
+}
+
+static void *mapPages(size_t size, bool populate) {
+    const auto mappedSize = roundUp(size, SMALL_PAGE_SIZE);
+    auto *buffer = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+        return nullptr;
+    }
+#ifdef MADV_HUGEPAGE
+    /* == Advice has to be given before the first touch for the kernel to back the range with huge pages == */
+    madvise(buffer, mappedSize, MADV_HUGEPAGE);
+#endif
+    /* == Pre-fault every page now instead of during the first iteration == */
+    if (populate) {
+        auto *bytes = reinterpret_cast<volatile char *>(buffer);
+        for (size_t offset = 0; offset < mappedSize; offset += SMALL_PAGE_SIZE) {
+            bytes[offset] = 0;
+        }
+    }
+    return buffer;
+}
+
+#endif
+
+/* === Function(s) definition === */
+
+void *spider::detail::allocateMappedBuffer(size_t size, MemoryBacking &backing, bool populate) {
+    if (!size) {
+        return nullptr;
+    }
+#ifdef __linux__
+    if (backing == MemoryBacking::HUGE_PAGES) {
+        auto *buffer = mapHugePages(size, populate);
+        if (buffer) {
+            return buffer;
+        }
+        backing = MemoryBacking::MMAP;
+    }
+    if (backing == MemoryBacking::MMAP) {
+        auto *buffer = mapPages(size, populate);
+        if (buffer) {
+            return buffer;
+        }
+    }
+#else
+    (void) populate;
+#endif
+    backing = MemoryBacking::MALLOC;
+    return std::malloc(size);
+}
+
+void spider::detail::deallocateMappedBuffer(void *buffer, size_t size, MemoryBacking backing) {
+    if (!buffer) {
+        return;
+    }
+    switch (backing) {
+#ifdef __linux__
+        case MemoryBacking::HUGE_PAGES:
+            munmap(buffer, roundUp(size, HUGE_PAGE_SIZE));
+            break;
+        case MemoryBacking::MMAP:
+            munmap(buffer, roundUp(size, SMALL_PAGE_SIZE));
+            break;
+#endif
+        default:
+            (void) size;
+            std::free(buffer);
+            break;
+    }
+}
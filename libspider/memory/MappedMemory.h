@@ -0,0 +1,69 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_MAPPEDMEMORY_H
+#define SPIDER2_MAPPEDMEMORY_H
+
+/* === Include(s) === */
+
+#include <cstddef>
+#include <api/global-api.h>
+
+namespace spider {
+    namespace detail {
+
+        /* === Function(s) prototype === */
+
+        /**
+         * @brief Allocate a large buffer living for the whole application with a given backing store.
+         * @remark If the requested backing is not available (no huge page reserved, no mmap), the next one is
+         *         tried (HUGE_PAGES -> MMAP -> MALLOC) and backing is updated accordingly.
+         * @param size      Size in bytes of the buffer.
+         * @param backing   Requested backing, set to the backing actually used.
+         * @param populate  Pre-fault the pages of mmap'ed buffers (they are first-touched by the caller else).
+         * @return pointer to the buffer, nullptr on failure.
+         */
+        void *allocateMappedBuffer(size_t size, MemoryBacking &backing, bool populate = true);
+
+        /**
+         * @brief Free a buffer obtained with @refitem spider::detail::allocateMappedBuffer.
+         * @param buffer   Pointer to the buffer.
+         * @param size     Size in bytes requested for the buffer.
+         * @param backing  Backing returned by the allocation.
+         */
+        void deallocateMappedBuffer(void *buffer, size_t size, MemoryBacking backing);
+    }
+}
+
+#endif //SPIDER2_MAPPEDMEMORY_H
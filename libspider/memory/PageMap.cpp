@@ -0,0 +1,169 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <memory/PageMap.h>
+#include <common/Exception.h>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+/* === Static variable(s) === */
+
+/* == Three level radix tree over page indices, covers 48 bits of virtual address space == */
+static constexpr size_t LEVEL_BITS = 12;
+static constexpr size_t LEVEL_SIZE = size_t{ 1 } << LEVEL_BITS;
+static constexpr size_t LEVEL_MASK = LEVEL_SIZE - 1;
+static constexpr uint64_t MAX_PAGE_INDEX = uint64_t{ 1 } << (3 * LEVEL_BITS);
+
+namespace {
+    struct Leaf {
+        std::atomic<uintptr_t> values_[LEVEL_SIZE];
+    };
+
+    struct Node {
+        std::atomic<Leaf *> leaves_[LEVEL_SIZE];
+    };
+
+    std::atomic<Node *> root[LEVEL_SIZE];
+
+    std::atomic<size_t> setCount{ 0 };
+
+    std::atomic<size_t> levelCount{ 0 };
+
+    std::mutex &growMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    template<class T>
+    T *getOrCreate(std::atomic<T *> &slot) {
+        auto *value = slot.load(std::memory_order_acquire);
+        if (!value) {
+            std::lock_guard<std::mutex> lock{ growMutex() };
+            value = slot.load(std::memory_order_relaxed);
+            if (!value) {
+                /* == Zeroed memory is a valid state for arrays of atomic integers / pointers == */
+                value = static_cast<T *>(std::calloc(1, sizeof(T)));
+                if (!value) {
+                    throwSpiderException("failed to allocate page map level.");
+                }
+                slot.store(value, std::memory_order_release);
+                levelCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return value;
+    }
+}
+
+/* === Function(s) definition === */
+
+void spider::detail::setPages(uintptr_t base, size_t count, uintptr_t value) {
+    if (base & (PAGE_SIZE - 1)) {
+        throwSpiderException("page map: address %p is not page aligned.", reinterpret_cast<void *>(base));
+    }
+    auto page = static_cast<uint64_t>(base) >> PAGE_SHIFT;
+    if (page + count > MAX_PAGE_INDEX) {
+        throwSpiderException("page map: address %p is out of the supported range.", reinterpret_cast<void *>(base));
+    }
+    size_t newlySet = 0;
+    size_t newlyCleared = 0;
+    for (size_t i = 0; i < count; ++i, ++page) {
+        Leaf *leaf = nullptr;
+        if (value) {
+            auto *node = getOrCreate(root[(page >> (2 * LEVEL_BITS)) & LEVEL_MASK]);
+            leaf = getOrCreate(node->leaves_[(page >> LEVEL_BITS) & LEVEL_MASK]);
+        } else {
+            /* == Clearing a page that was never set does not need to create its levels == */
+            auto *node = root[(page >> (2 * LEVEL_BITS)) & LEVEL_MASK].load(std::memory_order_acquire);
+            leaf = node ? node->leaves_[(page >> LEVEL_BITS) & LEVEL_MASK].load(std::memory_order_acquire) : nullptr;
+            if (!leaf) {
+                continue;
+            }
+        }
+        const auto previous = leaf->values_[page & LEVEL_MASK].exchange(value, std::memory_order_acq_rel);
+        newlySet += (value && !previous);
+        newlyCleared += (!value && previous);
+    }
+    if (newlySet) {
+        setCount.fetch_add(newlySet, std::memory_order_relaxed);
+    }
+    if (newlyCleared) {
+        setCount.fetch_sub(newlyCleared, std::memory_order_relaxed);
+    }
+}
+
+uintptr_t spider::detail::lookupPage(const void *ptr) noexcept {
+    const auto page = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> PAGE_SHIFT;
+    if (page >= MAX_PAGE_INDEX) {
+        return 0;
+    }
+    const auto *node = root[(page >> (2 * LEVEL_BITS)) & LEVEL_MASK].load(std::memory_order_acquire);
+    if (!node) {
+        return 0;
+    }
+    const auto *leaf = node->leaves_[(page >> LEVEL_BITS) & LEVEL_MASK].load(std::memory_order_acquire);
+    if (!leaf) {
+        return 0;
+    }
+    return leaf->values_[page & LEVEL_MASK].load(std::memory_order_acquire);
+}
+
+bool spider::detail::releasePageMap() noexcept {
+    std::lock_guard<std::mutex> lock{ growMutex() };
+    if (setCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+    for (auto &slot : root) {
+        auto *node = slot.exchange(nullptr, std::memory_order_acq_rel);
+        if (!node) {
+            continue;
+        }
+        for (auto &leaf : node->leaves_) {
+            std::free(leaf.exchange(nullptr, std::memory_order_relaxed));
+        }
+        std::free(node);
+    }
+    levelCount.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+size_t spider::detail::setPageCount() noexcept {
+    return setCount.load(std::memory_order_relaxed);
+}
+
+size_t spider::detail::pageMapLevelCount() noexcept {
+    return levelCount.load(std::memory_order_relaxed);
+}
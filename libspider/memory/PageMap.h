@@ -0,0 +1,92 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_PAGEMAP_H
+#define SPIDER2_PAGEMAP_H
+
+/* === Include(s) === */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spider {
+    namespace detail {
+
+        /* === Constant(s) === */
+
+        constexpr size_t PAGE_SHIFT = 12;
+        constexpr size_t PAGE_SIZE = size_t{ 1 } << PAGE_SHIFT;
+
+        /* === Function(s) prototype === */
+
+        /**
+         * @brief Set the value associated to count consecutive pages starting at base.
+         * @remark Value 0 means the page is not owned by any stack.
+         * @remark Writers should be serialized per page range, readers may run concurrently.
+         * @param base   Page aligned address of the first page.
+         * @param count  Number of pages.
+         * @param value  Value to store (tagged pointer), 0 to clear.
+         * @throws spider::Exception if base is not page aligned or outside of the supported address range.
+         */
+        void setPages(uintptr_t base, size_t count, uintptr_t value);
+
+        /**
+         * @brief Get the value associated to the page containing ptr.
+         * @param ptr Address to look for.
+         * @return value set with @refitem spider::detail::setPages, 0 if the page was never set.
+         */
+        uintptr_t lookupPage(const void *ptr) noexcept;
+
+        /**
+         * @brief Free the levels of the page map if no page is set any more.
+         * @warning Must not be called while other threads may look pages up (it is called by @refitem spider::quit).
+         * @return true if the page map was empty (and is now released), false else.
+         */
+        bool releasePageMap() noexcept;
+
+        /**
+         * @brief Get the number of pages currently set to a non zero value.
+         * @return number of set pages.
+         */
+        size_t setPageCount() noexcept;
+
+        /**
+         * @brief Get the number of levels (nodes and leaves) currently allocated by the page map.
+         * @return number of allocated levels.
+         */
+        size_t pageMapLevelCount() noexcept;
+    }
+}
+
+#endif //SPIDER2_PAGEMAP_H
@@ -0,0 +1,532 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <memory/Stack.h>
+#include <memory/PageMap.h>
+#include <new>
+
+/* === Static variable(s) === */
+
+namespace spider {
+    namespace detail {
+
+        /**
+         * @brief Per-thread cache of a given stack.
+         * @remark Free lists are intrusive: the first bytes of a cached block store the next block.
+         */
+        struct StackCacheEntry {
+            Stack *stack_ = nullptr;
+            StackCacheEntry *next_ = nullptr;
+            void *freeLists_[Stack::CACHE_CLASS_COUNT] = { };
+            u32 counts_[Stack::CACHE_CLASS_COUNT] = { };
+        };
+
+        struct StackThreadCache {
+            StackThreadCache() = default;
+
+            StackThreadCache(const StackThreadCache &) = delete;
+
+            StackThreadCache &operator=(const StackThreadCache &) = delete;
+
+            ~StackThreadCache();
+
+            StackCacheEntry entries_[STACK_COUNT];
+        };
+
+        /**
+         * @brief Header of a slab, stored at the beginning of its first page.
+         * @remark Every page of the slab is tagged with the address of this header in the page map.
+         *         Blocks never handed out yet are taken after bump_, freed ones are kept in an intrusive free list.
+         */
+        struct Slab {
+            Stack *stack_ = nullptr;
+            Slab *prev_ = nullptr;
+            Slab *next_ = nullptr;
+            void *memory_ = nullptr;    /* = Pointer returned by the policy = */
+            void *freeList_ = nullptr;
+            u32 class_ = 0;
+            u32 capacity_ = 0;
+            u32 live_ = 0;
+            u32 bump_ = 0;
+            u32 pages_ = 0;
+        };
+
+        /**
+         * @brief Descriptor of a large allocation, allocated in a slab of the same stack.
+         * @remark The page of buffer_ is tagged with the address of this descriptor (with LARGE_TAG set).
+         */
+        struct LargeBlock {
+            Stack *stack_ = nullptr;
+            LargeBlock *prev_ = nullptr;
+            LargeBlock *next_ = nullptr;
+            void *memory_ = nullptr;    /* = Pointer returned by the policy = */
+            void *buffer_ = nullptr;    /* = Aligned pointer returned to the user = */
+            u64 footprint_ = 0;
+        };
+
+        static_assert(sizeof(Slab) <= Stack::SLAB_HEADER_SIZE, "slab header does not fit in SLAB_HEADER_SIZE.");
+
+        static_assert(Stack::SLAB_MAX_SIZE >= PAGE_SIZE, "large buffers should not be smaller than a page.");
+    }
+}
+
+static constexpr uintptr_t LARGE_TAG = 1;
+static constexpr uintptr_t DIRECT_TAG = 2;
+static constexpr size_t SLAB_MIN_BYTES = 2 * spider::detail::PAGE_SIZE;
+static constexpr size_t SLAB_MAX_BYTES = 16 * spider::detail::PAGE_SIZE;
+static constexpr size_t SLAB_MIN_BLOCKS = 32;
+
+static inline uintptr_t alignUp(uintptr_t address, size_t alignment) {
+    return (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+
+static inline uintptr_t alignDown(uintptr_t address, size_t alignment) {
+    return address & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+
+static size_t slabPageCount(size_t blockSize) {
+    const auto bytes = std::min(std::max(blockSize * SLAB_MIN_BLOCKS, SLAB_MIN_BYTES), SLAB_MAX_BYTES);
+    return (bytes + spider::detail::PAGE_SIZE - 1) / spider::detail::PAGE_SIZE;
+}
+
+static inline spider::detail::Slab *slabOf(const void *ptr) {
+    return reinterpret_cast<spider::detail::Slab *>(spider::detail::lookupPage(ptr));
+}
+
+static std::mutex &registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static spider::detail::StackThreadCache &threadCache() {
+    static thread_local spider::detail::StackThreadCache cache;
+    return cache;
+}
+
+spider::detail::StackThreadCache::~StackThreadCache() {
+    std::lock_guard<std::mutex> registryLock{ registryMutex() };
+    for (auto &entry : entries_) {
+        if (entry.stack_) {
+            auto *stack = entry.stack_;
+            stack->drain(entry);
+            stack->detach(entry);
+        }
+    }
+}
+
+/* === Method(s) implementation === */
+
+spider::Stack::~Stack() {
+    {
+        std::lock_guard<std::mutex> registryLock{ registryMutex() };
+        while (entries_) {
+            auto &entry = *entries_;
+            drain(entry);
+            detach(entry);
+        }
+    }
+    print(stackNamesArray()[static_cast<size_t>(stack_)], peak(), total_.load(), sampleCount_.load(), usage());
+    {
+        /* == Give back leaked buffers too, so that no page stays tagged with this stack == */
+        std::lock_guard<std::mutex> lockGuard{ lock_ };
+        while (largeBlocks_) {
+            largeDeallocate(largeBlocks_);
+        }
+        for (auto &slab : slabs_) {
+            while (slab) {
+                releaseSlab(slab);
+            }
+        }
+    }
+    delete policy_;
+}
+
+void *spider::Stack::allocate(size_t size) {
+    if (!size) {
+        return nullptr;
+    }
+    if (directAlignment_) {
+        return directAllocate(size);
+    }
+    if (size > SLAB_MAX_SIZE) {
+        std::pair<void *, uint64_t> result;
+        {
+            std::lock_guard<std::mutex> lockGuard{ lock_ };
+            result = largeAllocate(size);
+        }
+        recordAllocation(result.second);
+        return result.first;
+    }
+    const auto ix = sizeClass(size);
+    if (ix < CACHE_CLASS_COUNT) {
+        auto &entry = localEntry();
+        auto *block = entry.freeLists_[ix];
+        if (block) {
+            /* == Fast path: reuse a block freed by this thread == */
+            entry.freeLists_[ix] = *reinterpret_cast<void **>(block);
+            entry.counts_[ix]--;
+            recordAllocation(classSize(ix));
+            return block;
+        }
+    }
+    void *block = nullptr;
+    {
+        std::lock_guard<std::mutex> lockGuard{ lock_ };
+        block = slabAllocate(ix);
+    }
+    recordAllocation(classSize(ix));
+    return block;
+}
+
+void spider::Stack::deallocate(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    const auto value = detail::lookupPage(ptr);
+    if (value & DIRECT_TAG) {
+        if (reinterpret_cast<Stack *>(value & ~DIRECT_TAG) != this) {
+            throwSpiderException("bad memory free: address %p was not allocated by stack [%s].", ptr,
+                                 stackNamesArray()[static_cast<size_t>(stack_)]);
+        }
+        uint64_t footprint = 0;
+        {
+            std::lock_guard<std::mutex> lockGuard{ lock_ };
+            footprint = policy_->deallocate(ptr);
+        }
+        recordDeallocation(footprint);
+        return;
+    } else if (value & LARGE_TAG) {
+        auto *block = reinterpret_cast<detail::LargeBlock *>(value & ~LARGE_TAG);
+        if ((block->stack_ != this) || (block->buffer_ != ptr)) {
+            throwSpiderException("bad memory free: address %p was not allocated by stack [%s].", ptr,
+                                 stackNamesArray()[static_cast<size_t>(stack_)]);
+        }
+        uint64_t footprint = 0;
+        {
+            std::lock_guard<std::mutex> lockGuard{ lock_ };
+            footprint = largeDeallocate(block);
+        }
+        recordDeallocation(footprint);
+        return;
+    }
+    auto *slab = reinterpret_cast<detail::Slab *>(value);
+    if (!slab || (slab->stack_ != this)) {
+        throwSpiderException("bad memory free: address %p was not allocated by stack [%s].", ptr,
+                             stackNamesArray()[static_cast<size_t>(stack_)]);
+    }
+    auto &entry = localEntry();
+    const auto ix = static_cast<size_t>(slab->class_);
+    if ((ix < CACHE_CLASS_COUNT) && (entry.counts_[ix] < CACHE_DEPTH)) {
+        *reinterpret_cast<void **>(ptr) = entry.freeLists_[ix];
+        entry.freeLists_[ix] = ptr;
+        entry.counts_[ix]++;
+        recordDeallocation(classSize(ix));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard{ lock_ };
+        slabDeallocate(slab, ptr);
+    }
+    recordDeallocation(classSize(ix));
+}
+
+void spider::Stack::flushCaches() {
+    std::lock_guard<std::mutex> registryLock{ registryMutex() };
+    for (auto *entry = entries_; entry; entry = entry->next_) {
+        drain(*entry);
+    }
+    std::lock_guard<std::mutex> lockGuard{ lock_ };
+    releaseEmptySlabs();
+}
+
+uint64_t spider::Stack::reset() {
+    flushCaches();
+    {
+        std::lock_guard<std::mutex> lockGuard{ lock_ };
+        policy_->reset();
+    }
+    return usage();
+}
+
+spider::Stack *spider::Stack::owner(const void *ptr) noexcept {
+    const auto value = detail::lookupPage(ptr);
+    if (value & DIRECT_TAG) {
+        return reinterpret_cast<Stack *>(value & ~DIRECT_TAG);
+    } else if (value & LARGE_TAG) {
+        return reinterpret_cast<detail::LargeBlock *>(value & ~LARGE_TAG)->stack_;
+    } else if (value) {
+        return reinterpret_cast<detail::Slab *>(value)->stack_;
+    }
+    return nullptr;
+}
+
+bool spider::Stack::setPolicy(AbstractAllocatorPolicy *policy) {
+    if (!policy) {
+        return false;
+    }
+    flushCaches();
+    if (policy_->usage()) {
+        return false;
+    }
+    delete policy_;
+    policy_ = policy;
+    const auto alignment = std::max(policy_->alignment(), size_t{ 16 });
+    directAlignment_ = policy_->tagPages(reinterpret_cast<uintptr_t>(this) | DIRECT_TAG) ? alignment : 0;
+    return true;
+}
+
+/* === Private method(s) implementation === */
+
+spider::detail::StackCacheEntry &spider::Stack::localEntry() {
+    auto &entry = threadCache().entries_[static_cast<size_t>(stack_)];
+    if (entry.stack_ != this) {
+        attach(entry);
+    }
+    return entry;
+}
+
+void spider::Stack::attach(detail::StackCacheEntry &entry) {
+    std::lock_guard<std::mutex> registryLock{ registryMutex() };
+    entry = detail::StackCacheEntry{ };
+    entry.stack_ = this;
+    entry.next_ = entries_;
+    entries_ = &entry;
+}
+
+void spider::Stack::drain(detail::StackCacheEntry &entry) {
+    std::lock_guard<std::mutex> lockGuard{ lock_ };
+    for (size_t ix = 0; ix < CACHE_CLASS_COUNT; ++ix) {
+        auto *block = entry.freeLists_[ix];
+        while (block) {
+            auto *next = *reinterpret_cast<void **>(block);
+            slabDeallocate(slabOf(block), block);
+            block = next;
+        }
+        entry.freeLists_[ix] = nullptr;
+        entry.counts_[ix] = 0;
+    }
+}
+
+void spider::Stack::detach(detail::StackCacheEntry &entry) {
+    auto **it = &entries_;
+    while (*it && (*it != &entry)) {
+        it = &((*it)->next_);
+    }
+    if (*it) {
+        *it = entry.next_;
+    }
+    entry.stack_ = nullptr;
+    entry.next_ = nullptr;
+}
+
+void spider::Stack::recordAllocation(uint64_t size) {
+    const auto usage = usage_.fetch_add(size, std::memory_order_relaxed) + size;
+    total_.fetch_add(usage, std::memory_order_relaxed);
+    sampleCount_.fetch_add(1, std::memory_order_relaxed);
+    auto peak = peak_.load(std::memory_order_relaxed);
+    while ((usage > peak) && !peak_.compare_exchange_weak(peak, usage, std::memory_order_relaxed)) { }
+}
+
+void spider::Stack::recordDeallocation(uint64_t size) {
+    usage_.fetch_sub(size, std::memory_order_relaxed);
+    releaseCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void *spider::Stack::slabAllocate(size_t ix) {
+    auto *slab = slabs_[ix];
+    if (!slab || (slab->live_ == slab->capacity_)) {
+        slab = createSlab(ix);
+    }
+    void *block = nullptr;
+    if (slab->freeList_) {
+        block = slab->freeList_;
+        slab->freeList_ = *reinterpret_cast<void **>(block);
+    } else {
+        const auto offset = SLAB_HEADER_SIZE + static_cast<size_t>(slab->bump_++) * classSize(ix);
+        block = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(slab) + offset);
+    }
+    if ((++slab->live_ == slab->capacity_) && (slab->next_ != slab)) {
+        /* == Slab is the head of a circular list, moving the head makes it the tail == */
+        slabs_[ix] = slab->next_;
+    }
+    return block;
+}
+
+void spider::Stack::slabDeallocate(detail::Slab *slab, void *ptr) {
+    *reinterpret_cast<void **>(ptr) = slab->freeList_;
+    slab->freeList_ = ptr;
+    const auto wasFull = slab->live_ == slab->capacity_;
+    slab->live_--;
+    auto *&head = slabs_[slab->class_];
+    if (head == slab) {
+        /* == An empty head is kept to avoid creating / releasing a slab at every allocation == */
+        return;
+    } else if (!slab->live_) {
+        releaseSlab(slab);
+    } else if (wasFull) {
+        /* == Move the slab in front of the full ones == */
+        slab->prev_->next_ = slab->next_;
+        slab->next_->prev_ = slab->prev_;
+        slab->next_ = head;
+        slab->prev_ = head->prev_;
+        head->prev_->next_ = slab;
+        head->prev_ = slab;
+        head = slab;
+    }
+}
+
+spider::detail::Slab *spider::Stack::createSlab(size_t ix) {
+    const auto blockSize = classSize(ix);
+    const auto pageCount = slabPageCount(blockSize);
+    auto *memory = policy_->allocate(pageCount * detail::PAGE_SIZE + detail::PAGE_SIZE - 1);
+    if (!memory) {
+        throwSpiderException("failed to allocate a slab of %zu pages on stack [%s].", pageCount,
+                             stackNamesArray()[static_cast<size_t>(stack_)]);
+    }
+    const auto base = alignUp(reinterpret_cast<uintptr_t>(memory), detail::PAGE_SIZE);
+    auto *slab = new(reinterpret_cast<void *>(base)) detail::Slab{ };
+    slab->stack_ = this;
+    slab->memory_ = memory;
+    slab->class_ = static_cast<u32>(ix);
+    slab->capacity_ = static_cast<u32>((pageCount * detail::PAGE_SIZE - SLAB_HEADER_SIZE) / blockSize);
+    slab->pages_ = static_cast<u32>(pageCount);
+    detail::setPages(base, pageCount, reinterpret_cast<uintptr_t>(slab));
+    auto *&head = slabs_[ix];
+    if (head) {
+        slab->next_ = head;
+        slab->prev_ = head->prev_;
+        head->prev_->next_ = slab;
+        head->prev_ = slab;
+    } else {
+        slab->next_ = slab;
+        slab->prev_ = slab;
+    }
+    head = slab;
+    return slab;
+}
+
+void spider::Stack::releaseSlab(detail::Slab *slab) {
+    detail::setPages(reinterpret_cast<uintptr_t>(slab), slab->pages_, 0);
+    auto *&head = slabs_[slab->class_];
+    if (slab->next_ == slab) {
+        head = nullptr;
+    } else {
+        slab->prev_->next_ = slab->next_;
+        slab->next_->prev_ = slab->prev_;
+        if (head == slab) {
+            head = slab->next_;
+        }
+    }
+    policy_->deallocate(slab->memory_);
+}
+
+void spider::Stack::releaseEmptySlabs() {
+    for (auto &head : slabs_) {
+        if (!head) {
+            continue;
+        }
+        auto *last = head->prev_;
+        auto *slab = head;
+        auto done = false;
+        while (!done) {
+            done = slab == last;
+            auto *next = slab->next_;
+            if (!slab->live_) {
+                releaseSlab(slab);
+            }
+            slab = next;
+        }
+    }
+}
+
+std::pair<void *, uint64_t> spider::Stack::largeAllocate(size_t size) {
+    auto *memory = policy_->allocate(size + LARGE_ALIGNMENT - 1);
+    if (!memory) {
+        throwSpiderException("failed to allocate %zu bytes on stack [%s].", size,
+                             stackNamesArray()[static_cast<size_t>(stack_)]);
+    }
+    const auto footprint = static_cast<uint64_t>(policy_->lastAllocatedSize());
+    const auto buffer = alignUp(reinterpret_cast<uintptr_t>(memory), LARGE_ALIGNMENT);
+    auto *block = new(slabAllocate(sizeClass(sizeof(detail::LargeBlock)))) detail::LargeBlock{ };
+    block->stack_ = this;
+    block->memory_ = memory;
+    block->buffer_ = reinterpret_cast<void *>(buffer);
+    block->footprint_ = footprint;
+    block->next_ = largeBlocks_;
+    if (largeBlocks_) {
+        largeBlocks_->prev_ = block;
+    }
+    largeBlocks_ = block;
+    /* == Large buffers are bigger than a page so no other buffer can start in the same page == */
+    detail::setPages(alignDown(buffer, detail::PAGE_SIZE), 1, reinterpret_cast<uintptr_t>(block) | LARGE_TAG);
+    return std::make_pair(block->buffer_, footprint);
+}
+
+uint64_t spider::Stack::largeDeallocate(detail::LargeBlock *block) {
+    detail::setPages(alignDown(reinterpret_cast<uintptr_t>(block->buffer_), detail::PAGE_SIZE), 1, 0);
+    if (block->prev_) {
+        block->prev_->next_ = block->next_;
+    } else {
+        largeBlocks_ = block->next_;
+    }
+    if (block->next_) {
+        block->next_->prev_ = block->prev_;
+    }
+    policy_->deallocate(block->memory_);
+    const auto footprint = block->footprint_;
+    slabDeallocate(slabOf(block), block);
+    return footprint;
+}
+
+void *spider::Stack::directAllocate(size_t size) {
+    /* == Keep the alignment guarantees of the slabs == */
+    const auto alignment = ((size > SLAB_MAX_SIZE) || !(classSize(sizeClass(size)) % LARGE_ALIGNMENT)) ?
+                           LARGE_ALIGNMENT : size_t{ 16 };
+    void *buffer = nullptr;
+    uint64_t footprint = 0;
+    {
+        std::lock_guard<std::mutex> lockGuard{ lock_ };
+        policy_->setAllocationAlignment(std::max(alignment, directAlignment_));
+        buffer = policy_->allocate(size);
+        footprint = static_cast<uint64_t>(policy_->lastAllocatedSize());
+    }
+    if (!buffer) {
+        throwSpiderException("failed to allocate %zu bytes on stack [%s].", size,
+                             stackNamesArray()[static_cast<size_t>(stack_)]);
+    }
+    recordAllocation(footprint);
+    return buffer;
+}
@@ -42,13 +42,54 @@
 #include <memory/dynamic-policies/GenericAllocatorPolicy.h>
 #include <api/global-api.h>
 #include <cmath>
+#include <atomic>
+#include <mutex>
+#include <utility>
 
 namespace spider {
 
+    /* === Forward declaration(s) === */
+
+    namespace detail {
+        struct StackCacheEntry;
+
+        struct StackThreadCache;
+
+        struct Slab;
+
+        struct LargeBlock;
+    }
+
     /* === Class definition === */
 
+    /**
+     * @brief Memory stack wrapping an allocation policy.
+     * @remark Allocations up to SLAB_MAX_SIZE bytes are rounded to a size class and carved out of page aligned slabs
+     *         requested to the policy. Every page of a slab is tagged with the slab in the page map, so the owner of a
+     *         buffer is found from its address alone and no per-buffer header is needed.
+     *         Larger allocations are requested to the policy directly, aligned on LARGE_ALIGNMENT bytes, and the page
+     *         of their first byte is tagged with a descriptor allocated in the stack.
+     * @remark Every buffer is at least 16 bytes aligned, buffers of size class multiple of 64 bytes (and large
+     *         buffers) are 64 bytes aligned.
+     * @remark Small allocations (up to CACHE_MAX_SIZE bytes) go through a per-thread cache of freed blocks, so that
+     *         allocation / deallocation of small objects does not lock the stack.
+     * @remark Policies tagging their own pages (see @refitem AbstractAllocatorPolicy::tagPages, e.g. the ARENA policy)
+     *         bypass the slabs and the thread caches: every allocation is requested to the policy directly.
+     * @remark Usage statistics are updated with relaxed atomics on every operation, peak and average do not lag
+     *         behind the usage when several threads share the stack.
+     */
     class Stack {
     public:
+        friend struct detail::StackThreadCache;
+
+        static constexpr size_t CACHE_CLASS_COUNT = 16;
+        static constexpr size_t CACHE_MAX_SIZE = 512;
+        static constexpr size_t SLAB_CLASS_COUNT = 28;
+        static constexpr size_t SLAB_MAX_SIZE = 4096;
+        static constexpr size_t SLAB_HEADER_SIZE = 64;
+        static constexpr size_t LARGE_ALIGNMENT = 64;
+        static constexpr u32 CACHE_DEPTH = 64;
+
         explicit Stack(StackID stack) : policy_{ new GenericAllocatorPolicy() },
                                         stack_{ stack } {
         }
@@ -61,24 +102,10 @@ namespace spider {
 
         Stack &operator=(const Stack &) = delete;
 
-        ~Stack() {
-            print(stackNamesArray()[static_cast<size_t>(stack_)], peak_, total_, sampleCount_, usage_);
-            delete policy_;
-        }
+        ~Stack();
 
         /* === Method(s) === */
 
-        inline void increaseUsage(uint64_t size) {
-            usage_ += size;
-            peak_ = std::max(peak_, usage_);
-            total_ += usage_;
-            sampleCount_++;
-        }
-
-        inline void decreaseUsage(uint64_t size) {
-            usage_ -= size;
-        }
-
         inline static void
         print(const char *name, uint64_t peak, uint64_t total, uint64_t sampleCount, uint64_t usage) {
             if (peak && log::enabled()) {
@@ -113,17 +140,43 @@ namespace spider {
             }
         }
 
-        inline void *allocate(size_t size) {
-            std::lock_guard<std::mutex> lockGuard{ lock_ };
-            auto buffer = policy_->allocate(size);
-            increaseUsage(policy_->lastAllocatedSize());
-            return buffer;
-        }
+        /**
+         * @brief Allocate a buffer of given size.
+         * @remark Sizes up to CACHE_MAX_SIZE are rounded to their size class and served by the thread cache.
+         * @param size Size of the buffer.
+         * @return pointer to the allocated buffer, nullptr if size is 0.
+         */
+        void *allocate(size_t size);
 
-        inline void deallocate(void *ptr) {
-            std::lock_guard<std::mutex> lockGuard{ lock_ };
-            decreaseUsage(policy_->deallocate(ptr));
-        }
+        /**
+         * @brief Deallocate a buffer allocated by this stack.
+         * @remark Small buffers are kept in the thread cache (up to CACHE_DEPTH per size class).
+         * @param ptr Pointer to the buffer.
+         * @throws spider::Exception if ptr was not allocated by this stack.
+         */
+        void deallocate(void *ptr);
+
+        /**
+         * @brief Give back every cached block to its slab and release empty slabs to the policy.
+         * @warning This is non-thread safe, it should only be called at quiescent points.
+         */
+        void flushCaches();
+
+        /**
+         * @brief Flush the caches and reset the policy, called at iteration boundaries.
+         * @remark With @refitem ArenaAllocatorPolicy, every chunk is given back at once: buffers still alive are
+         *         invalidated, check @refitem Stack::liveCount before resetting.
+         * @warning This is non-thread safe, it should only be called at quiescent points.
+         * @return usage of the stack after the reset (size of the buffers still alive).
+         */
+        uint64_t reset();
+
+        /**
+         * @brief Find the stack that allocated a buffer from its address.
+         * @param ptr Pointer returned by @refitem Stack::allocate.
+         * @return owning stack, nullptr if ptr was not allocated by any stack.
+         */
+        static Stack *owner(const void *ptr) noexcept;
 
         /* === Getter(s) === */
 
@@ -132,16 +185,33 @@ namespace spider {
         }
 
         inline uint64_t peak() const {
-            return peak_;
+            return peak_.load(std::memory_order_relaxed);
         }
 
         inline uint64_t usage() const {
-            return usage_;
+            return usage_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of buffers of the stack still alive.
+         * @return number of allocations minus number of deallocations.
+         */
+        inline uint64_t liveCount() const {
+            return sampleCount_.load(std::memory_order_relaxed) - releaseCount_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of allocations made on the stack.
+         * @return number of allocations.
+         */
+        inline uint64_t allocationCount() const {
+            return sampleCount_.load(std::memory_order_relaxed);
         }
 
         inline uint64_t average() const {
-            if (sampleCount_) {
-                return total_ / sampleCount_;
+            const auto sampleCount = sampleCount_.load(std::memory_order_relaxed);
+            if (sampleCount) {
+                return total_.load(std::memory_order_relaxed) / sampleCount;
             }
             return 0;
         }
@@ -155,31 +225,87 @@ namespace spider {
         /**
          * @brief Set the allocation policy of the stack.
          * @remark If policy is nullptr or current policy has still memory in-use, nothing happens.
+         * @remark Thread caches are flushed before checking the usage of the current policy.
          * @warning This is non-thread safe, change of policy should be done at quiescent points.
          * @param policy Pointer to the policy to set.
          * @return true if operation succeed, false otherwise.
          */
-        inline bool setPolicy(AbstractAllocatorPolicy *policy) {
-            if (!policy || policy_->usage()) {
-                return false;
-            }
-            delete policy_;
-            policy_ = policy;
-            return true;
-        }
+        bool setPolicy(AbstractAllocatorPolicy *policy);
 
     private:
         AbstractAllocatorPolicy *policy_ = nullptr;
         std::mutex lock_;
-        uint64_t usage_ = 0;
-        uint64_t peak_ = 0;
-        uint64_t total_ = 0;
-        uint64_t sampleCount_ = 0;
+        std::atomic<uint64_t> usage_{ 0 };
+        std::atomic<uint64_t> peak_{ 0 };
+        std::atomic<uint64_t> total_{ 0 };
+        std::atomic<uint64_t> sampleCount_{ 0 };
+        std::atomic<uint64_t> releaseCount_{ 0 };
+        detail::Slab *slabs_[SLAB_CLASS_COUNT]{ };    /* = Circular lists of slabs, the ones with free blocks first = */
+        detail::LargeBlock *largeBlocks_ = nullptr;   /* = Live large allocations = */
+        detail::StackCacheEntry *entries_ = nullptr;  /* = Thread caches attached to this stack = */
         StackID stack_ = StackID::GENERAL;
-
+        size_t directAlignment_ = 0;                  /* = Non zero if the policy tags its own pages = */
 
         /* === Private methods === */
 
+        detail::StackCacheEntry &localEntry();
+
+        void attach(detail::StackCacheEntry &entry);
+
+        void drain(detail::StackCacheEntry &entry);
+
+        void detach(detail::StackCacheEntry &entry);
+
+        void recordAllocation(uint64_t size);
+
+        void recordDeallocation(uint64_t size);
+
+        void *slabAllocate(size_t ix);
+
+        void slabDeallocate(detail::Slab *slab, void *ptr);
+
+        detail::Slab *createSlab(size_t ix);
+
+        void releaseSlab(detail::Slab *slab);
+
+        void releaseEmptySlabs();
+
+        std::pair<void *, uint64_t> largeAllocate(size_t size);
+
+        void *directAllocate(size_t size);
+
+        uint64_t largeDeallocate(detail::LargeBlock *block);
+
+        static inline size_t sizeClass(size_t size) noexcept {
+            if (size <= 128) {
+                return (size + 15) / 16 - 1;
+            } else if (size <= 256) {
+                return 8 + (size - 129) / 32;
+            } else if (size <= 512) {
+                return 12 + (size - 257) / 64;
+            } else if (size <= 1024) {
+                return 16 + (size - 513) / 128;
+            } else if (size <= 2048) {
+                return 20 + (size - 1025) / 256;
+            }
+            return 24 + (size - 2049) / 512;
+        }
+
+        static inline size_t classSize(size_t ix) noexcept {
+            if (ix < 8) {
+                return (ix + 1) * 16;
+            } else if (ix < 12) {
+                return 128 + (ix - 7) * 32;
+            } else if (ix < 16) {
+                return 256 + (ix - 11) * 64;
+            } else if (ix < 20) {
+                return 512 + (ix - 15) * 128;
+            } else if (ix < 24) {
+                return 1024 + (ix - 19) * 256;
+            }
+            return 2048 + (ix - 23) * 512;
+        }
+
         static inline const char *getByteUnitString(uint64_t size) noexcept {
             constexpr uint64_t SIZE_GB = 1024 * 1024 * 1024;
             constexpr uint64_t SIZE_MB = 1024 * 1024;
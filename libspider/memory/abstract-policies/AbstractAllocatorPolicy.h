@@ -68,6 +68,26 @@ public:
      */
     virtual u64 deallocate(void *ptr) = 0;
 
+    /**
+     * @brief Give back at once the memory of every buffer already deallocated.
+     * @remark Policies reusing memory at deallocation have nothing to do.
+     * @return number of memory regions of the policy still holding live buffers.
+     */
+    virtual size_t reset() {
+        return 0;
+    }
+
+    /**
+     * @brief Tag every page of the memory regions of the policy in the page map (see memory/PageMap.h), so that the
+     *        owner of a buffer is found from its address without going through the slabs of @refitem spider::Stack.
+     * @remark Only policies with page aligned regions support it. Should be called before any allocation.
+     * @param value  Value to store for every page of the policy (0 to stop tagging).
+     * @return true if the policy tags its pages, false otherwise.
+     */
+    virtual bool tagPages(uintptr_t) {
+        return false;
+    }
+
     /* === Setter(s) === */
 
     /**
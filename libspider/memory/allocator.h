@@ -99,9 +99,8 @@ namespace spider {
             return stack_;
         }
 
-        inline value_type *allocate(size_t n, size_t extra = 0) {
-            auto size = n * sizeof(value_type) + extra;
-            return static_cast<value_type *>(stack_->allocate(size));
+        inline value_type *allocate(size_t n) {
+            return static_cast<value_type *>(stack_->allocate(n * sizeof(value_type)));
         }
 
         inline void deallocate(value_type *p, size_t) {
@@ -0,0 +1,224 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Includes === */
+
+#include <memory/dynamic-policies/ArenaAllocatorPolicy.h>
+#include <memory/PageMap.h>
+
+/* === Constant(s) === */
+
+size_t ArenaAllocatorPolicy::MIN_CHUNK_SIZE = 65536;
+
+size_t ArenaAllocatorPolicy::MAX_ALLOC_SCALE = 16;
+
+/* === Static function(s) === */
+
+static inline uintptr_t alignUp(uintptr_t address, size_t alignment) {
+    return (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+
+static inline uintptr_t alignDown(uintptr_t address, size_t alignment) {
+    return address & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+
+/* === Methods implementation === */
+
+ArenaAllocatorPolicy::ArenaAllocatorPolicy(size_t chunkSize, void *externalBuffer, size_t alignment) :
+        AbstractAllocatorPolicy(alignment) {
+    if (alignment < 8) {
+        throwSpiderException("Memory alignment should be at least of size sizeof(uint64_t) = 8 bytes.");
+    }
+    if (externalBuffer) {
+        if (!chunkSize) {
+            throwSpiderException("can not have null size with non null external buffer.");
+        }
+        Chunk chunk;
+        chunk.base_ = reinterpret_cast<char *>(externalBuffer);
+        chunk.size_ = chunkSize;
+        chunk.external_ = true;
+        chunks_.push_back(chunk);
+        chunkSize_ = std::max(chunkSize, MIN_CHUNK_SIZE);
+    } else {
+        chunkSize_ = std::max(chunkSize, MIN_CHUNK_SIZE);
+        createChunk(chunkSize_);
+    }
+}
+
+ArenaAllocatorPolicy::~ArenaAllocatorPolicy() noexcept {
+    for (auto &chunk : chunks_) {
+        releaseChunk(chunk);
+    }
+}
+
+void *ArenaAllocatorPolicy::allocate(size_t size) {
+    if (!size) {
+        lastAllocatedSize_ = 0;
+        return nullptr;
+    }
+    /* == Try the current chunk, then the rewound ones == */
+    for (auto ix = current_; ix < chunks_.size(); ++ix) {
+        auto *buffer = tryAllocate(ix, size);
+        if (buffer) {
+            current_ = ix;
+            return buffer;
+        }
+    }
+    /* == Reuse chunks released since the last reset before creating a new one == */
+    for (size_t ix = 0; ix < chunks_.size(); ++ix) {
+        auto &chunk = chunks_[ix];
+        if (!chunk.liveCount_ && chunk.offset_) {
+            chunk.offset_ = 0;
+            auto *buffer = tryAllocate(ix, size);
+            if (buffer) {
+                current_ = ix;
+                return buffer;
+            }
+        }
+    }
+    createChunk(size + sizeof(Header) + alignment_);
+    current_ = chunks_.size() - 1;
+    return tryAllocate(current_, size);
+}
+
+u64 ArenaAllocatorPolicy::deallocate(void *ptr) {
+    if (!ptr) {
+        return 0;
+    } else if (!usage_) {
+        throwSpiderException("bad memory free: no memory allocated.");
+    }
+    const auto *header = reinterpret_cast<Header *>(reinterpret_cast<uintptr_t>(ptr) - sizeof(Header));
+    if (header->chunkIx_ >= chunks_.size()) {
+        throwSpiderException("bad memory free: memory address out of allocated space.");
+    }
+    /* == Memory is only given back to the chunk on reset == */
+    chunks_[header->chunkIx_].liveCount_--;
+    usage_ -= header->size_;
+    return header->size_;
+}
+
+size_t ArenaAllocatorPolicy::reset() {
+    size_t liveChunkCount = 0;
+    size_t totalSize = 0;
+    auto hasExternal = false;
+    for (auto &chunk : chunks_) {
+        liveChunkCount += chunk.liveCount_ ? 1 : 0;
+        chunk.offset_ = 0;
+        chunk.liveCount_ = 0;
+        totalSize += chunk.size_;
+        hasExternal |= chunk.external_;
+    }
+    usage_ = 0;
+    if (!hasExternal && (chunks_.size() > 1)) {
+        /* == Merge every chunk so that next allocations are contiguous == */
+        for (auto &chunk : chunks_) {
+            releaseChunk(chunk);
+        }
+        chunks_.clear();
+        allocScale_ = 1;
+        createChunk(totalSize);
+    }
+    current_ = 0;
+    return liveChunkCount;
+}
+
+bool ArenaAllocatorPolicy::tagPages(uintptr_t value) {
+    if (usage_) {
+        throwSpiderException("can not tag the pages of an arena with live buffers.");
+    }
+    for (auto &chunk : chunks_) {
+        if (chunk.external_ && !pageTag_) {
+            /* == External buffer is not page aligned, only its inner pages can be used == */
+            const auto begin = alignUp(reinterpret_cast<uintptr_t>(chunk.base_), spider::detail::PAGE_SIZE);
+            const auto end = alignDown(reinterpret_cast<uintptr_t>(chunk.base_) + chunk.size_,
+                                       spider::detail::PAGE_SIZE);
+            chunk.base_ = reinterpret_cast<char *>(begin);
+            chunk.size_ = end > begin ? static_cast<size_t>(end - begin) : 0;
+        }
+        chunk.offset_ = 0;
+        spider::detail::setPages(reinterpret_cast<uintptr_t>(chunk.base_),
+                                 chunk.size_ / spider::detail::PAGE_SIZE, value);
+    }
+    pageTag_ = value;
+    return true;
+}
+
+/* === Private method(s) implementation === */
+
+void *ArenaAllocatorPolicy::tryAllocate(size_t chunkIx, size_t size) {
+    auto &chunk = chunks_[chunkIx];
+    const auto start = reinterpret_cast<uintptr_t>(chunk.base_) + chunk.offset_;
+    const auto unaligned = start + sizeof(Header);
+    const auto dataAddress = unaligned + AbstractAllocatorPolicy::computePadding(unaligned, alignment_);
+    const auto requiredSize = static_cast<size_t>(dataAddress - start) + size;
+    if (chunk.offset_ + requiredSize > chunk.size_) {
+        return nullptr;
+    }
+    auto *header = reinterpret_cast<Header *>(dataAddress - sizeof(Header));
+    header->size_ = requiredSize;
+    header->chunkIx_ = chunkIx;
+    chunk.offset_ += requiredSize;
+    chunk.liveCount_++;
+    usage_ += requiredSize;
+    lastAllocatedSize_ = requiredSize;
+    return reinterpret_cast<void *>(dataAddress);
+}
+
+void ArenaAllocatorPolicy::createChunk(size_t size) {
+    Chunk chunk;
+    chunk.size_ = std::max(AbstractAllocatorPolicy::computeAlignedSize(size, chunkSize_ * allocScale_),
+                           chunkSize_);
+    chunk.size_ = AbstractAllocatorPolicy::computeAlignedSize(chunk.size_, spider::detail::PAGE_SIZE);
+    chunk.memory_ = std::malloc(chunk.size_ + spider::detail::PAGE_SIZE - 1);
+    if (!chunk.memory_) {
+        // LCOV_IGNORE
+        throwSpiderException("malloc failure. requested size: %zu", chunk.size_);
+    }
+    const auto base = alignUp(reinterpret_cast<uintptr_t>(chunk.memory_), spider::detail::PAGE_SIZE);
+    chunk.base_ = reinterpret_cast<char *>(base);
+    if (pageTag_) {
+        spider::detail::setPages(base, chunk.size_ / spider::detail::PAGE_SIZE, pageTag_);
+    }
+    chunks_.push_back(chunk);
+    allocScale_ = std::min(2 * allocScale_, MAX_ALLOC_SCALE);
+}
+
+void ArenaAllocatorPolicy::releaseChunk(Chunk &chunk) {
+    if (pageTag_) {
+        spider::detail::setPages(reinterpret_cast<uintptr_t>(chunk.base_), chunk.size_ / spider::detail::PAGE_SIZE, 0);
+    }
+    if (!chunk.external_) {
+        std::free(chunk.memory_);
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_ARENAALLOCATORPOLICY_H
+#define SPIDER2_ARENAALLOCATORPOLICY_H
+
+/* === Includes === */
+
+#include <vector>
+#include <memory/abstract-policies/AbstractAllocatorPolicy.h>
+
+/* === Class definition === */
+
+/**
+ * @brief Monotonic allocator policy: buffers are bump allocated in chunks and deallocation never reuses memory.
+ *        Memory is given back at once with @refitem ArenaAllocatorPolicy::reset.
+ * @remark Every chunk counts its live buffers so that a chunk emptied by its buffers is reused before creating a new
+ *         one. Reset rewinds every chunk, buffers still alive are invalidated.
+ * @remark New chunks double in size (like extra buffers of @refitem FreeListAllocatorPolicy). Reset merges them in a
+ *         single chunk so that next iterations bump allocate in one contiguous chunk.
+ */
+class ArenaAllocatorPolicy final : public AbstractAllocatorPolicy {
+public:
+
+    explicit ArenaAllocatorPolicy(size_t chunkSize,
+                                  void *externalBuffer = nullptr,
+                                  size_t alignment = sizeof(int64_t));
+
+    ~ArenaAllocatorPolicy() noexcept override;
+
+    ArenaAllocatorPolicy(ArenaAllocatorPolicy &&) = default;
+
+    ArenaAllocatorPolicy(const ArenaAllocatorPolicy &) = delete;
+
+    ArenaAllocatorPolicy &operator=(ArenaAllocatorPolicy &&) = default;
+
+    ArenaAllocatorPolicy &operator=(const ArenaAllocatorPolicy &) = delete;
+
+    void *allocate(size_t size) override;
+
+    u64 deallocate(void *ptr) override;
+
+    /**
+     * @brief Rewind every chunk, live buffers included.
+     * @return number of chunks that were still holding live buffers (invalidated by the reset).
+     */
+    size_t reset() override;
+
+    bool tagPages(uintptr_t value) override;
+
+    /* === Getter(s) === */
+
+    inline size_t chunkCount() const noexcept {
+        return chunks_.size();
+    }
+
+    static size_t MIN_CHUNK_SIZE;
+    static size_t MAX_ALLOC_SCALE;
+private:
+
+    struct Header {
+        size_t size_ = 0;     /* = Size consumed in the chunk (padding included) = */
+        size_t chunkIx_ = 0;
+    };
+
+    struct Chunk {
+        void *memory_ = nullptr;  /* = Pointer returned by malloc = */
+        char *base_ = nullptr;    /* = Page aligned start of the chunk = */
+        size_t size_ = 0;
+        size_t offset_ = 0;
+        size_t liveCount_ = 0;
+        bool external_ = false;
+    };
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+    size_t allocScale_ = 1;
+    size_t chunkSize_ = 0;
+    uintptr_t pageTag_ = 0;
+
+    void *tryAllocate(size_t chunkIx, size_t size);
+
+    void createChunk(size_t size);
+
+    void releaseChunk(Chunk &chunk);
+};
+
+#endif //SPIDER2_ARENAALLOCATORPOLICY_H
@@ -45,8 +45,9 @@ size_t FreeListAllocatorPolicy::MIN_CHUNK_SIZE = 8192;
 FreeListAllocatorPolicy::FreeListAllocatorPolicy(size_t staticBufferSize,
                                                  void *externalBuffer,
                                                  FreeListPolicy policy,
-                                                 size_t alignment) :
-        AbstractAllocatorPolicy(alignment) {
+                                                 size_t alignment,
+                                                 spider::MemoryBacking backing) :
+        AbstractAllocatorPolicy(alignment), backing_{ backing } {
     if (alignment < 8) {
         throwSpiderException("Memory alignment should be at least of size sizeof(uint64_t) = 8 bytes.");
     }
@@ -58,7 +59,7 @@ FreeListAllocatorPolicy::FreeListAllocatorPolicy(size_t staticBufferSize,
         external_ = true;
     } else {
         staticBufferSize_ = std::max(staticBufferSize, MIN_CHUNK_SIZE);
-        staticBufferPtr_ = std::malloc(staticBufferSize_ + sizeof(Node));
+        staticBufferPtr_ = spider::detail::allocateMappedBuffer(staticBufferSize_ + sizeof(Node), backing_);
     }
     if (policy == FreeListPolicy::FIND_FIRST) {
         findNode_ = FreeListAllocatorPolicy::findFirst;
@@ -74,7 +75,7 @@ FreeListAllocatorPolicy::FreeListAllocatorPolicy(size_t staticBufferSize,
 
 FreeListAllocatorPolicy::~FreeListAllocatorPolicy() noexcept {
     if (!external_) {
-        std::free(staticBufferPtr_);
+        spider::detail::deallocateMappedBuffer(staticBufferPtr_, staticBufferSize_ + sizeof(Node), backing_);
     }
     for (auto &it: extraBuffers_) {
         std::free(it.bufferPtr_);
@@ -98,15 +99,16 @@ void *FreeListAllocatorPolicy::allocate(size_t size) {
     auto *memoryNode = result.first;
     auto *baseNode = result.second;
     if (!memoryNode) {
-        /* == Add extra buffer == */
-        memoryNode = createExtraBuffer(size, baseNode);
-
-        /* == Padding is ZERO == */
-        padding = 0;
+        /* == Add extra buffer, padding is kept so that the next blocks stay aligned == */
+        memoryNode = createExtraBuffer(size + padding, baseNode);
     }
 
     /* == Compute real required size == */
     auto requiredSize = size + padding;
+    if (memoryNode->blockSize_ - requiredSize < sizeof(Node)) {
+        /* == Left over memory can not hold a free Node, we give it with the block == */
+        requiredSize = memoryNode->blockSize_;
+    }
 
     /* == Update the list of FreeNode == */
     updateFreeNodeList(baseNode, memoryNode, requiredSize);
@@ -153,19 +155,20 @@ u64 FreeListAllocatorPolicy::deallocate(void *ptr) {
     if (!validAddress(freeNode)) {
         throwSpiderException("bad memory free: memory address out of allocated space.");
     }
-    freeNode->blockSize_ = size;
-    freeNode->next_ = nullptr;
-
     Node *it = list_;
     Node *itPrev = nullptr;
-    while (it) {
-        if (reinterpret_cast<uintptr_t>(freeNode) < reinterpret_cast<uintptr_t>(it)) {
-            insert(itPrev, freeNode);
-            break;
-        }
+    while (it && (reinterpret_cast<uintptr_t>(it) < reinterpret_cast<uintptr_t>(freeNode))) {
         itPrev = it;
         it = it->next_;
     }
+    if ((it == freeNode) || (itPrev && (reinterpret_cast<uintptr_t>(itPrev) + itPrev->blockSize_ >
+                                        reinterpret_cast<uintptr_t>(freeNode)))) {
+        /* == Buffer is already part of a free node, nothing to do == */
+        return 0;
+    }
+    freeNode->blockSize_ = size;
+    freeNode->next_ = nullptr;
+    insert(itPrev, freeNode);
 
     /* == Update internal usage == */
     usage_ -= freeNode->blockSize_;
@@ -211,7 +214,7 @@ FreeListAllocatorPolicy::Node *
 FreeListAllocatorPolicy::createExtraBuffer(size_t size, FreeListAllocatorPolicy::Node *base) {
     /* == Allocate new buffer with size aligned to MIN_CHUNK == */
     FreeListAllocatorPolicy::Buffer buffer;
-    buffer.size_ = AbstractAllocatorPolicy::computeAlignedSize(size, MIN_CHUNK_SIZE * allocScale_);
+    buffer.size_ = AbstractAllocatorPolicy::computeAlignedSize(size + sizeof(Node), MIN_CHUNK_SIZE * allocScale_);
     buffer.bufferPtr_ = std::malloc(buffer.size_ + sizeof(Node));
 
     /* == Initialize memoryNode == */
@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <memory/abstract-policies/AbstractAllocatorPolicy.h>
+#include <memory/MappedMemory.h>
 
 /* === Enumeration(s) === */
 
@@ -59,7 +60,8 @@ public:
     explicit FreeListAllocatorPolicy(size_t staticBufferSize,
                                      void *externalBuffer = nullptr,
                                      FreeListPolicy policy = FreeListPolicy::FIND_FIRST,
-                                     size_t alignment = sizeof(int64_t));
+                                     size_t alignment = sizeof(int64_t),
+                                     spider::MemoryBacking backing = spider::MemoryBacking::MALLOC);
 
     ~FreeListAllocatorPolicy() noexcept override;
 
@@ -87,6 +89,7 @@ private:
 
     void *staticBufferPtr_ = nullptr;
     bool external_ = false;
+    spider::MemoryBacking backing_ = spider::MemoryBacking::MALLOC;
     std::vector<Buffer> extraBuffers_;
     size_t staticBufferSize_ = 0;
     size_t allocScale_ = 1;
@@ -0,0 +1,343 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Includes === */
+
+#include <memory/dynamic-policies/TLSFAllocatorPolicy.h>
+#include <algorithm>
+#include <utility>
+
+/* === Constant(s) === */
+
+size_t TLSFAllocatorPolicy::MIN_CHUNK_SIZE = 8192;
+constexpr size_t TLSFAllocatorPolicy::SL_LOG2;
+constexpr size_t TLSFAllocatorPolicy::SL_COUNT;
+constexpr size_t TLSFAllocatorPolicy::ALIGN_SIZE;
+constexpr size_t TLSFAllocatorPolicy::FL_SHIFT;
+constexpr size_t TLSFAllocatorPolicy::FL_COUNT;
+constexpr size_t TLSFAllocatorPolicy::SMALL_BLOCK_SIZE;
+
+/* === Static function(s) === */
+
+namespace {
+    /**
+     * @brief Index of the most significant bit set (value must not be 0).
+     */
+    inline size_t findLastSet(u64 value) noexcept {
+#if defined(__GNUC__)
+        return static_cast<size_t>(63 - __builtin_clzll(value));
+#else
+        size_t bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    /**
+     * @brief Index of the least significant bit set (value must not be 0).
+     */
+    inline size_t findFirstSet(u64 value) noexcept {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(value));
+#else
+        size_t bit = 0;
+        while (!(value & 1)) {
+            value >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    inline uintptr_t alignUp(uintptr_t value, size_t alignment) noexcept {
+        return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    /**
+     * @brief Compute the (first level, second level) indices of the list holding blocks of given size.
+     */
+    inline std::pair<size_t, size_t> mapping(size_t size) noexcept {
+        if (size < TLSFAllocatorPolicy::SMALL_BLOCK_SIZE) {
+            return { 0, size / (TLSFAllocatorPolicy::SMALL_BLOCK_SIZE / TLSFAllocatorPolicy::SL_COUNT) };
+        }
+        const auto fl = findLastSet(size);
+        const auto sl = (size >> (fl - TLSFAllocatorPolicy::SL_LOG2)) ^ TLSFAllocatorPolicy::SL_COUNT;
+        return { fl - (TLSFAllocatorPolicy::FL_SHIFT - 1), sl };
+    }
+}
+
+/* === Methods implementation === */
+
+TLSFAllocatorPolicy::TLSFAllocatorPolicy(size_t staticBufferSize,
+                                         void *externalBuffer,
+                                         size_t alignment,
+                                         spider::MemoryBacking backing) :
+        AbstractAllocatorPolicy(alignment), backing_{ backing } {
+    if (alignment < 8) {
+        throwSpiderException("Memory alignment should be at least of size sizeof(uint64_t) = 8 bytes.");
+    }
+    if (externalBuffer) {
+        staticBufferPtr_ = externalBuffer;
+        staticBufferSize_ = staticBufferSize;
+        external_ = true;
+    } else {
+        /* == Room for the alignment of the pool, the first header and the end sentinel == */
+        staticBufferSize_ = std::max(staticBufferSize, MIN_CHUNK_SIZE) + 3 * ALIGN_SIZE;
+        staticBufferPtr_ = spider::detail::allocateMappedBuffer(staticBufferSize_, backing_);
+    }
+    addPool(staticBufferPtr_, staticBufferSize_);
+}
+
+TLSFAllocatorPolicy::~TLSFAllocatorPolicy() noexcept {
+    if (!external_) {
+        spider::detail::deallocateMappedBuffer(staticBufferPtr_, staticBufferSize_, backing_);
+    }
+    for (auto &it: extraBuffers_) {
+        std::free(it.bufferPtr_);
+        it.bufferPtr_ = nullptr;
+    }
+}
+
+void *TLSFAllocatorPolicy::allocate(size_t size) {
+    if (!size) {
+        lastAllocatedSize_ = 0;
+        return nullptr;
+    }
+    if (size >= (size_t{ 1 } << FL_MAX)) {
+        throwSpiderException("can not allocate buffer of size %zu: maximum size is %zu.", size,
+                             size_t{ 1 } << FL_MAX);
+    }
+    const auto requiredSize = static_cast<size_t>(alignUp(std::max(size, ALIGN_SIZE), ALIGN_SIZE));
+
+    /* == Alignments larger than ALIGN_SIZE may need to trim a leading free block == */
+    auto searchSize = requiredSize;
+    if (alignment_ > ALIGN_SIZE) {
+        searchSize += alignment_ + MIN_BLOCK_SIZE;
+    }
+
+    /* == Find a free block of the good size class == */
+    auto *block = locateFree(searchSize);
+    if (!block) {
+        createExtraBuffer(searchSize);
+        block = locateFree(searchSize);
+        if (!block) {
+            throwSpiderException("failed to allocate buffer of size %zu.", size);
+        }
+    }
+
+    /* == Trim leading space to honor the alignment == */
+    const auto payloadAddress = reinterpret_cast<uintptr_t>(block->payload());
+    auto alignedAddress = alignUp(payloadAddress, alignment_);
+    if (alignedAddress != payloadAddress) {
+        if (alignedAddress - payloadAddress < MIN_BLOCK_SIZE) {
+            alignedAddress = alignUp(payloadAddress + MIN_BLOCK_SIZE, alignment_);
+        }
+        auto *alignedBlock = split(block, alignedAddress - payloadAddress - ALIGN_SIZE);
+        insert(block);
+        block = alignedBlock;
+    }
+
+    /* == Trim trailing space to limit waste memory space == */
+    if (block->size() >= requiredSize + MIN_BLOCK_SIZE) {
+        auto *remainder = split(block, requiredSize);
+        insert(remainder);
+    }
+
+    /* == Mark the block as used == */
+    block->size_ &= ~FREE_FLAG;
+    block->nextPhys()->size_ &= ~PREV_FREE_FLAG;
+
+    /* == Updating usage stats == */
+    usage_ += block->size();
+    lastAllocatedSize_ = block->size();
+    return block->payload();
+}
+
+u64 TLSFAllocatorPolicy::deallocate(void *ptr) {
+    if (!ptr) {
+        return 0;
+    } else if (!usage_) {
+        throwSpiderException("bad memory free: no memory allocated.");
+    }
+    if (!validAddress(ptr)) {
+        throwSpiderException("bad memory free: memory address out of allocated space.");
+    }
+    auto *block = reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(ptr) - ALIGN_SIZE);
+    if (block->free()) {
+        throwSpiderException("bad memory free: memory address %p already freed.", ptr);
+    }
+    const auto size = block->size();
+    usage_ -= size;
+
+    /* == Mark the block as free == */
+    block->size_ |= FREE_FLAG;
+    block->nextPhys()->size_ |= PREV_FREE_FLAG;
+
+    /* == Look for contiguous free blocks to merge (coalescence) == */
+    if (block->prevFree()) {
+        remove(block->prevPhys_);
+        block = merge(block->prevPhys_, block);
+    }
+    auto *next = block->nextPhys();
+    if (next->free()) {
+        remove(next);
+        block = merge(block, next);
+    }
+    insert(block);
+    return size;
+}
+
+void TLSFAllocatorPolicy::addPool(void *memory, size_t size) {
+    const auto start = alignUp(reinterpret_cast<uintptr_t>(memory), ALIGN_SIZE);
+    const auto end = (reinterpret_cast<uintptr_t>(memory) + size) & ~(static_cast<uintptr_t>(ALIGN_SIZE) - 1);
+    if (!memory || (end < start) || (end - start < MIN_BLOCK_SIZE + ALIGN_SIZE)) {
+        throwSpiderException("buffer of size %zu is too small for TLSF allocator.", size);
+    }
+
+    /* == One free block spanning the whole pool == */
+    auto *block = reinterpret_cast<Block *>(start);
+    block->prevPhys_ = nullptr;
+    block->size_ = (end - start - 2 * ALIGN_SIZE) | FREE_FLAG;
+
+    /* == Used empty block closing the pool, it is never merged == */
+    auto *sentinel = block->nextPhys();
+    sentinel->prevPhys_ = block;
+    sentinel->size_ = PREV_FREE_FLAG;
+    insert(block);
+}
+
+void TLSFAllocatorPolicy::createExtraBuffer(size_t size) {
+    /* == Allocate new buffer with size aligned to MIN_CHUNK == */
+    TLSFAllocatorPolicy::Buffer buffer;
+    buffer.size_ = AbstractAllocatorPolicy::computeAlignedSize(size + 3 * ALIGN_SIZE, MIN_CHUNK_SIZE * allocScale_);
+    buffer.bufferPtr_ = std::malloc(buffer.size_);
+    addPool(buffer.bufferPtr_, buffer.size_);
+
+    /* == Push buffer into vector to keep track of it == */
+    extraBuffers_.push_back(buffer);
+    allocScale_ *= 2;
+}
+
+TLSFAllocatorPolicy::Block *TLSFAllocatorPolicy::locateFree(size_t size) {
+    /* == Round up to the next size class so that any block of the found list fits == */
+    if (size >= SMALL_BLOCK_SIZE) {
+        size += (size_t{ 1 } << (findLastSet(size) - SL_LOG2)) - 1;
+    }
+    auto index = mapping(size);
+    if (index.first >= FL_COUNT) {
+        return nullptr;
+    }
+    auto slMap = slBitmaps_[index.first] & (~u32{ 0 } << index.second);
+    if (!slMap) {
+        const auto flMap = flBitmap_ & (~u64{ 0 } << (index.first + 1));
+        if (!flMap) {
+            return nullptr;
+        }
+        index.first = findFirstSet(flMap);
+        slMap = slBitmaps_[index.first];
+    }
+    index.second = findFirstSet(slMap);
+    auto *block = heads_[index.first][index.second];
+    remove(block);
+    return block;
+}
+
+void TLSFAllocatorPolicy::insert(Block *block) {
+    const auto index = mapping(block->size());
+    auto *head = heads_[index.first][index.second];
+    block->links()->next_ = head;
+    block->links()->prev_ = nullptr;
+    if (head) {
+        head->links()->prev_ = block;
+    }
+    heads_[index.first][index.second] = block;
+    flBitmap_ |= (u64{ 1 } << index.first);
+    slBitmaps_[index.first] |= (u32{ 1 } << index.second);
+}
+
+void TLSFAllocatorPolicy::remove(Block *block) {
+    const auto index = mapping(block->size());
+    auto *links = block->links();
+    if (links->next_) {
+        links->next_->links()->prev_ = links->prev_;
+    }
+    if (links->prev_) {
+        links->prev_->links()->next_ = links->next_;
+    } else {
+        heads_[index.first][index.second] = links->next_;
+        if (!links->next_) {
+            /* == List is now empty == */
+            slBitmaps_[index.first] &= ~(u32{ 1 } << index.second);
+            if (!slBitmaps_[index.first]) {
+                flBitmap_ &= ~(u64{ 1 } << index.first);
+            }
+        }
+    }
+}
+
+TLSFAllocatorPolicy::Block *TLSFAllocatorPolicy::split(Block *block, size_t size) {
+    auto *remainder = reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(block->payload()) + size);
+    remainder->prevPhys_ = block;
+    remainder->size_ = (block->size() - size - ALIGN_SIZE) | FREE_FLAG;
+    remainder->nextPhys()->prevPhys_ = remainder;
+    block->size_ = size | (block->size_ & FLAGS_MASK);
+    /* == The remainder follows a free block until the caller marks it used == */
+    remainder->size_ |= (block->size_ & FREE_FLAG) ? PREV_FREE_FLAG : 0;
+    return remainder;
+}
+
+TLSFAllocatorPolicy::Block *TLSFAllocatorPolicy::merge(Block *prev, Block *block) {
+    prev->size_ += block->size() + ALIGN_SIZE;
+    prev->nextPhys()->prevPhys_ = prev;
+    return prev;
+}
+
+bool TLSFAllocatorPolicy::validAddress(void *ptr) noexcept {
+    const auto uintptr = reinterpret_cast<uintptr_t>(ptr);
+    const auto staticBufferUintptr = reinterpret_cast<uintptr_t>(staticBufferPtr_);
+    auto found = ((uintptr >= staticBufferUintptr) && (uintptr < (staticBufferUintptr + staticBufferSize_)));
+    if (!found) {
+        for (auto &it: extraBuffers_) {
+            const auto bufferUintptr = reinterpret_cast<uintptr_t>(it.bufferPtr_);
+            found = ((uintptr >= bufferUintptr) && (uintptr < (bufferUintptr + it.size_)));
+            if (found) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,172 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_TLSFALLOCATORPOLICY_H
+#define SPIDER2_TLSFALLOCATORPOLICY_H
+
+/* === Includes === */
+
+#include <vector>
+#include <memory/abstract-policies/AbstractAllocatorPolicy.h>
+#include <memory/MappedMemory.h>
+
+/* === Class definition === */
+
+/**
+ * @brief Two-Level Segregated Fit allocator policy.
+ * @remark Free blocks are kept in FL_COUNT x SL_COUNT segregated lists indexed by two bitmaps, so that allocation
+ *         and deallocation are O(1) (good fit search + immediate coalescing with physical neighbors).
+ * @remark Like @refitem FreeListAllocatorPolicy, the policy can use an external buffer and grows with extra
+ *         buffers (of doubling size) when no free block is large enough.
+ */
+class TLSFAllocatorPolicy final : public AbstractAllocatorPolicy {
+public:
+    static constexpr size_t SL_LOG2 = 4;
+    static constexpr size_t SL_COUNT = size_t{ 1 } << SL_LOG2;
+    static constexpr size_t ALIGN_LOG2 = 4;
+    static constexpr size_t ALIGN_SIZE = size_t{ 1 } << ALIGN_LOG2;
+    static constexpr size_t FL_SHIFT = SL_LOG2 + ALIGN_LOG2;
+    static constexpr size_t FL_MAX = 40;
+    static constexpr size_t FL_COUNT = FL_MAX - FL_SHIFT + 1;
+    static constexpr size_t SMALL_BLOCK_SIZE = size_t{ 1 } << FL_SHIFT;
+
+    explicit TLSFAllocatorPolicy(size_t staticBufferSize,
+                                 void *externalBuffer = nullptr,
+                                 size_t alignment = sizeof(int64_t),
+                                 spider::MemoryBacking backing = spider::MemoryBacking::MALLOC);
+
+    ~TLSFAllocatorPolicy() noexcept override;
+
+    TLSFAllocatorPolicy(TLSFAllocatorPolicy &&) = delete;
+
+    TLSFAllocatorPolicy(const TLSFAllocatorPolicy &) = delete;
+
+    TLSFAllocatorPolicy &operator=(TLSFAllocatorPolicy &&) = delete;
+
+    TLSFAllocatorPolicy &operator=(const TLSFAllocatorPolicy &) = delete;
+
+    void *allocate(size_t size) override;
+
+    u64 deallocate(void *ptr) override;
+
+    static size_t MIN_CHUNK_SIZE;
+private:
+
+    static constexpr size_t FREE_FLAG = 1;
+    static constexpr size_t PREV_FREE_FLAG = 2;
+    static constexpr size_t FLAGS_MASK = FREE_FLAG | PREV_FREE_FLAG;
+
+    struct Block;
+
+    /**
+     * @brief Links of a free block in its segregated list, stored in the (unused) payload of the block.
+     */
+    struct FreeLinks {
+        Block *next_ = nullptr;
+        Block *prev_ = nullptr;
+    };
+
+    /**
+     * @brief Header of a block, the payload directly follows it.
+     * @remark The two lowest bits of size_ store the free flag of the block and of its previous physical block.
+     */
+    struct Block {
+        Block *prevPhys_ = nullptr;
+        size_t size_ = 0;
+
+        inline size_t size() const noexcept {
+            return size_ & ~FLAGS_MASK;
+        }
+
+        inline bool free() const noexcept {
+            return size_ & FREE_FLAG;
+        }
+
+        inline bool prevFree() const noexcept {
+            return size_ & PREV_FREE_FLAG;
+        }
+
+        inline void *payload() noexcept {
+            return reinterpret_cast<char *>(this) + ALIGN_SIZE;
+        }
+
+        inline FreeLinks *links() noexcept {
+            return reinterpret_cast<FreeLinks *>(payload());
+        }
+
+        inline Block *nextPhys() noexcept {
+            return reinterpret_cast<Block *>(reinterpret_cast<char *>(payload()) + size());
+        }
+    };
+
+    static_assert(sizeof(Block) <= ALIGN_SIZE, "block header must fit in ALIGN_SIZE bytes.");
+    static_assert(sizeof(FreeLinks) <= ALIGN_SIZE, "free links must fit in the minimum payload.");
+
+    /* == Header + minimum payload == */
+    static constexpr size_t MIN_BLOCK_SIZE = 2 * ALIGN_SIZE;
+
+    struct Buffer {
+        size_t size_ = 0;
+        void *bufferPtr_ = nullptr;
+    };
+
+    Block *heads_[FL_COUNT][SL_COUNT] = { };
+    u32 slBitmaps_[FL_COUNT] = { };
+    u64 flBitmap_ = 0;
+
+    void *staticBufferPtr_ = nullptr;
+    size_t staticBufferSize_ = 0;
+    bool external_ = false;
+    spider::MemoryBacking backing_ = spider::MemoryBacking::MALLOC;
+    std::vector<Buffer> extraBuffers_;
+    size_t allocScale_ = 1;
+
+    void addPool(void *memory, size_t size);
+
+    void createExtraBuffer(size_t size);
+
+    Block *locateFree(size_t size);
+
+    void insert(Block *block);
+
+    void remove(Block *block);
+
+    Block *split(Block *block, size_t size);
+
+    static Block *merge(Block *prev, Block *block);
+
+    bool validAddress(void *ptr) noexcept;
+};
+
+#endif //SPIDER2_TLSFALLOCATORPOLICY_H
@@ -42,6 +42,8 @@
 #include <memory/static-policies/LinearStaticAllocator.h>
 #include <memory/dynamic-policies/FreeListAllocatorPolicy.h>
 #include <memory/dynamic-policies/GenericAllocatorPolicy.h>
+#include <memory/dynamic-policies/ArenaAllocatorPolicy.h>
+#include <memory/dynamic-policies/TLSFAllocatorPolicy.h>
 #include <memory/allocator.h>
 #include <api/global-api.h>
 #include <common/EnumIterator.h>
@@ -57,7 +59,7 @@ namespace spider {
 
     /**
      * @brief Allocates data using given stack.
-     * @remark This method allocates slightly more than asked for book keeping.
+     * @remark No book keeping is added to the buffer, the owning stack is retrieved from its address.
      * @param stack  Pointer to the stack to use.
      * @param size   Size of the buffer element to allocate (ex: sizeof(double).
      * @param n      Number of element of size "size" to allocate.
@@ -74,13 +76,11 @@ namespace spider {
      */
     template<typename T>
     inline T *allocate(StackID stackId, size_t n = 1) {
-        /* == Allocate buffer with (size + 1) to store stack identifier == */
         return reinterpret_cast<T *>(allocate(stackArray()[static_cast<size_t>(stackId)], sizeof(T), n));
     }
 
     template<typename T, StackID stackId = StackID::GENERAL>
     inline T *allocate(size_t n = 1) {
-        /* == Allocate buffer with (size + 1) to store stack identifier == */
         return reinterpret_cast<T *>(allocate(stackArray()[static_cast<size_t>(stackId)], sizeof(T), n));
     }
 
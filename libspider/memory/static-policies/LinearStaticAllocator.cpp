@@ -38,8 +38,11 @@
 
 /* === Methods implementation === */
 
-LinearStaticAllocator::LinearStaticAllocator(size_t totalSize, void *externalBase, size_t alignment) :
-        AbstractAllocatorPolicy(alignment), totalSize_{ totalSize }, buffer_{ externalBase } {
+LinearStaticAllocator::LinearStaticAllocator(size_t totalSize,
+                                             void *externalBase,
+                                             size_t alignment,
+                                             spider::MemoryBacking backing) :
+        AbstractAllocatorPolicy(alignment), totalSize_{ totalSize }, buffer_{ externalBase }, backing_{ backing } {
     if (alignment < 8) {
         throwSpiderException("Memory alignment should be at least of size sizeof(int64_t) = 8 bytes.");
     }
@@ -49,7 +52,7 @@ LinearStaticAllocator::LinearStaticAllocator(size_t totalSize, void *externalBas
         }
         external_ = true;
     } else {
-        buffer_ = std::malloc(totalSize);
+        buffer_ = spider::detail::allocateMappedBuffer(totalSize, backing_);
     }
 }
 
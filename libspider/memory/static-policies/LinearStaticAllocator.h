@@ -38,6 +38,7 @@
 /* === Includes === */
 
 #include <memory/abstract-policies/AbstractAllocatorPolicy.h>
+#include <memory/MappedMemory.h>
 
 /* === Class definition === */
 
@@ -45,11 +46,14 @@ class LinearStaticAllocator final : public AbstractAllocatorPolicy {
 public:
 
 
-    explicit LinearStaticAllocator(size_t totalSize, void *externalBase = nullptr, size_t alignment = sizeof(int64_t));
+    explicit LinearStaticAllocator(size_t totalSize,
+                                   void *externalBase = nullptr,
+                                   size_t alignment = sizeof(int64_t),
+                                   spider::MemoryBacking backing = spider::MemoryBacking::MALLOC);
 
     ~LinearStaticAllocator() override {
         if (!external_) {
-            std::free(buffer_);
+            spider::detail::deallocateMappedBuffer(buffer_, totalSize_, backing_);
         }
     };
 
@@ -70,6 +74,7 @@ private:
     size_t totalSize_ = 0;
     bool external_ = false;
     void *buffer_ = nullptr;
+    spider::MemoryBacking backing_ = spider::MemoryBacking::MALLOC;
 
     /* === Private method(s) === */
 
@@ -53,6 +53,8 @@
 #include <archi/Platform.h>
 #include <api/runtime-api.h>
 #include <graphs-tools/exporter/SRDAGDOTExporter.h>
+#include <memory/Stack.h>
+#include <cassert>
 
 /* === Static variable === */
 
@@ -70,6 +72,22 @@ static u64 getTime(spider::time::time_point value, spider::time::time_point offs
 
 /* === Function(s) definition === */
 
+void spider::Runtime::resetIterationStacks() {
+    for (const auto id : { StackID::TRANSFO, StackID::SCHEDULE }) {
+        auto *stack = stackArray()[static_cast<size_t>(id)];
+        const auto liveCount = stack->liveCount();
+        if (liveCount) {
+            /* == Rewinding the stack would invalidate the surviving objects, only give back the cached blocks == */
+            log::error("stack [%s]: %" PRIu64" objects survived the iteration, stack is not reset.\n",
+                       stackNamesArray()[static_cast<size_t>(id)], liveCount);
+            assert(!liveCount);
+            stack->flushCaches();
+            continue;
+        }
+        stack->reset();
+    }
+}
+
 #ifndef _NO_BUILD_GANTT_EXPORTER
 
 void spider::Runtime::exportPreExecGantt(const sched::Schedule *schedule, const std::string &path) {
@@ -39,6 +39,7 @@
 
 #include <common/Exception.h>
 #include <common/Time.h>
+#include <common/Types.h>
 #include <api/global-api.h>
 
 /* === Define(s) === */
@@ -83,6 +84,8 @@ namespace spider {
 
     namespace sched {
         class Schedule;
+
+        class FifoAllocator;
     }
 
     struct RuntimeConfig;
@@ -111,10 +114,27 @@ namespace spider {
          */
         virtual bool execute() = 0;
 
+        /* === Getter(s) === */
+
+        /**
+         * @brief Get the FifoAllocator used by the runtime.
+         * @return pointer to the allocator.
+         */
+        virtual const sched::FifoAllocator *fifoAllocator() const = 0;
+
     protected:
         pisdf::Graph *graph_ = nullptr;
         Monitor *monitor_ = nullptr;
 
+        /**
+         * @brief Reset the TRANSFO and SCHEDULE stacks at the end of an iteration.
+         * @remark With the ARENA allocator policy, memory of the iteration is given back at once. In practice this
+         *         only pays off for the single rate graph of the SRDAG based runtimes, the PiSDF based runtimes barely
+         *         allocate on these stacks.
+         * @remark State kept across iterations lives on other stacks. A stack still holding live objects is not reset
+         *         (an error is logged, and this asserts in debug).
+         */
+        void resetIterationStacks();
 
         /**
          * @brief Export the expected Gantt obtained by the scheduling algorithm.
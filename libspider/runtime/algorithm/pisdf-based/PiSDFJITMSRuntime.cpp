@@ -40,6 +40,7 @@
 #include <graphs-tools/transformation/pisdf/GraphHandler.h>
 #include <scheduling/ResourcesAllocator.h>
 #include <scheduling/memory/FifoAllocator.h>
+#include <scheduling/schedule/ScheduleCache.h>
 #include <runtime/runner/RTRunner.h>
 #include <runtime/platform/RTPlatform.h>
 #include <runtime/communicator/RTCommunicator.h>
@@ -58,14 +59,26 @@ spider::PiSDFJITMSRuntime::PiSDFJITMSRuntime(pisdf::Graph *graph, const RuntimeC
                                                                                       cfg.mapPolicy_,
                                                                                       cfg.execPolicy_,
                                                                                       cfg.allocType_,
-                                                                                      false) },
-        isStatic_{ isStatic } {
+                                                                                      false,
+                                                                                      isStatic ? 0U :
+                                                                                      cfg.scheduleCacheCapacity_) },
+        iterCount_{ cfg.mode_ == RunMode::LOOP ? cfg.loopCount_ : SIZE_MAX },
+        isStatic_{ isStatic },
+        pipelined_{ cfg.pipelineIterations_ && (cfg.mode_ != RunMode::EXTERN_LOOP) } {
     if (!rt::platform()) {
         throwSpiderException("JITMSRuntime need the runtime platform to be created.");
     }
+    if (pipelined_ && (cfg.execPolicy_ != ExecutionPolicy::DELAYED)) {
+        log::warning("pipelined iterations require the DELAYED execution policy, disabling it.\n");
+        pipelined_ = false;
+    }
+    if (pipelined_ && resourcesAllocator_->scheduleCache()) {
+        log::warning("pipelined iterations can not be used with the schedule cache, disabling it.\n");
+        pipelined_ = false;
+    }
     resourcesAllocator_->allocator()->allocatePersistentDelays(graph_);
     pisdf::recursiveSplitDynamicGraph(graph_);
-    graphHandler_ = make_unique<pisdf::GraphHandler, StackID::TRANSFO>(graph_, graph_->params(), 1u);
+    graphHandler_ = make_unique<pisdf::GraphHandler, StackID::GENERAL>(graph_, graph_->params(), 1u);
 }
 
 bool spider::PiSDFJITMSRuntime::execute() {
@@ -75,6 +88,14 @@ bool spider::PiSDFJITMSRuntime::execute() {
     return dynamicExecute();
 }
 
+const spider::sched::FifoAllocator *spider::PiSDFJITMSRuntime::fifoAllocator() const {
+    return resourcesAllocator_->allocator();
+}
+
+const spider::sched::ScheduleCache *spider::PiSDFJITMSRuntime::scheduleCache() const {
+    return resourcesAllocator_->scheduleCache();
+}
+
 /* === Private method(s) implementation === */
 
 bool spider::PiSDFJITMSRuntime::staticExecute() {
@@ -125,6 +146,7 @@ bool spider::PiSDFJITMSRuntime::staticExecute() {
     }
     resourcesAllocator_->clear();
     graphHandler_->clear();
+    resetIterationStacks();
     iter_++;
     return true;
 }
@@ -134,6 +156,14 @@ bool spider::PiSDFJITMSRuntime::dynamicExecute() {
     if (api::exportTraceEnabled()) {
         startIterStamp_ = time::now();
     }
+    /* == Schedules are cached as long as they are not needed for the traces == */
+    auto *cache = resourcesAllocator_->scheduleCache();
+    if (cache && (api::exportTraceEnabled() || api::exportGanttEnabled())) {
+        cache = nullptr;
+    }
+    if (cache) {
+        cache->beginIteration();
+    }
     /* == Resolve, schedule and run == */
     const auto grtIx = archi::platform()->getGRTIx();
     auto done = false;
@@ -142,7 +172,12 @@ bool spider::PiSDFJITMSRuntime::dynamicExecute() {
         TRACE_SCHEDULE_START();
         /* == Send LRT_START_ITERATION notification == */
         rt::platform()->sendStartIteration();
-        resourcesAllocator_->execute(graphHandler_.get());
+        if (resourcesAllocator_->prepared()) {
+            /* == First round was scheduled while the previous iteration was finishing == */
+            resourcesAllocator_->send();
+        } else {
+            resourcesAllocator_->execute(graphHandler_.get());
+        }
         /* == Send JOB_DELAY_BROADCAST_JOBSTAMP notification == */
         rt::platform()->sendDelayedBroadCastToRunners();
         /* == Send LRT_END_ITERATION notification == */
@@ -154,10 +189,23 @@ bool spider::PiSDFJITMSRuntime::dynamicExecute() {
         }
         /* == If there are jobs left, run == */
         rt::platform()->runner(grtIx)->run(false);
+        const auto replayed = cache && cache->replaying();
+        const auto expectedParamCount = replayed ? cache->expectedParamCount() :
+                                        countExpectedNumberOfParams(graphHandler_.get());
+        if (cache) {
+            cache->setExpectedParamCount(expectedParamCount);
+        }
+        if (!expectedParamCount && shouldPrepareNextIteration()) {
+            /* == Last round: schedule the first round of next iteration while other runners finish this one == */
+            resourcesAllocator_->clear();
+            graphHandler_->clear();
+            /* == Objects of current iteration are dead and other runners do not use the iteration stacks == */
+            resetIterationStacks();
+            resourcesAllocator_->prepare(graphHandler_.get());
+        }
         rt::platform()->waitForRunnersToFinish();
 
         /* == Wait for all parameters to be resolved == */
-        const auto expectedParamCount = countExpectedNumberOfParams(graphHandler_.get());
         if (!expectedParamCount) {
             done = true;
         } else {
@@ -173,11 +221,20 @@ bool spider::PiSDFJITMSRuntime::dynamicExecute() {
                 rt::platform()->communicator()->popParamNotification(notification);
                 if (notification.type_ == NotificationType::JOB_SENT_PARAM) {
                     /* == Get the message == */
-                    ParameterMessage message;
+                    auto &message = paramMessage_;
                     rt::platform()->communicator()->pop(message, grtIx, notification.notificationIx_);
-                    /* == Get the config vertex == */
-                    auto *task = schedule->task(message.taskIx_);
-                    task->receiveParams(message.params_);
+                    if (cache) {
+                        cache->receiveParams(static_cast<u32>(message.taskIx_), message.params_);
+                    }
+                    /* == Get the config vertex (the graph is not scheduled for replayed rounds) == */
+                    if (!replayed) {
+                        auto *task = schedule->task(message.taskIx_);
+                        if (!task) {
+                            // LCOV_IGNORE: this is a sanity check, it should never happen and it is not testable from the outside.
+                            throwSpiderException("received parameters of unknown task: %zu", message.taskIx_);
+                        }
+                        task->receiveParams(message.params_);
+                    }
                     readParam++;
                 } else {
                     // LCOV_IGNORE: this is a sanity check, it should never happen and it is not testable from the outside.
@@ -188,6 +245,9 @@ bool spider::PiSDFJITMSRuntime::dynamicExecute() {
         }
     }
 
+    if (cache) {
+        cache->endIteration();
+    }
     /* == Runners should clear their parameters == */
     rt::platform()->sendClearToRunners();
 
@@ -195,9 +255,13 @@ bool spider::PiSDFJITMSRuntime::dynamicExecute() {
     if (api::exportTraceEnabled()) {
         useExecutionTraces(resourcesAllocator_->schedule(), startIterStamp_);
     }
-    /* == Clear the resources == */
-    resourcesAllocator_->clear();
-    graphHandler_->clear();
+    /* == Clear the resources and reset the stacks (already done if next iteration was prepared) == */
+    if (!resourcesAllocator_->prepared()) {
+        resourcesAllocator_->clear();
+        graphHandler_->clear();
+        resetIterationStacks();
+    }
+    iter_++;
     return true;
 }
 
@@ -218,3 +282,8 @@ size_t spider::PiSDFJITMSRuntime::countExpectedNumberOfParams(const pisdf::Graph
     }
     return count;
 }
+
+bool spider::PiSDFJITMSRuntime::shouldPrepareNextIteration() const {
+    /* == Execution traces and gantt rely on the schedule of the current iteration == */
+    return pipelined_ && ((iter_ + 1) < iterCount_) && !api::exportTraceEnabled() && !api::exportGanttEnabled();
+}
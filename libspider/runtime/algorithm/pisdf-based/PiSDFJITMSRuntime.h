@@ -39,6 +39,7 @@
 
 #include <runtime/algorithm/Runtime.h>
 #include <memory/unique_ptr.h>
+#include <runtime/message/Message.h>
 
 namespace spider {
 
@@ -46,6 +47,8 @@ namespace spider {
 
     namespace sched {
         class ResourcesAllocator;
+
+        class ScheduleCache;
     }
 
     namespace pisdf {
@@ -68,14 +71,25 @@ namespace spider {
 
         /* === Getter(s) === */
 
+        const sched::FifoAllocator *fifoAllocator() const override;
+
+        /**
+         * @brief Get the schedule cache used for the iterations of dynamic graphs.
+         * @return pointer to the cache, nullptr if disabled.
+         */
+        const sched::ScheduleCache *scheduleCache() const;
+
         /* === Setter(s) === */
 
     private:
         time::time_point startIterStamp_ = time::min();
         spider::unique_ptr<sched::ResourcesAllocator> resourcesAllocator_;
         spider::unique_ptr<pisdf::GraphHandler> graphHandler_;
+        ParameterMessage paramMessage_; /* = Received parameters (capacity is kept between messages) = */
         size_t iter_ = 0U;
+        size_t iterCount_ = SIZE_MAX;
         bool isStatic_{};
+        bool pipelined_{};
 
         /* === Private method(s) === */
 
@@ -92,6 +106,12 @@ namespace spider {
         bool dynamicExecute();
 
         size_t countExpectedNumberOfParams(const pisdf::GraphHandler *graphHandler) const;
+
+        /**
+         * @brief Check if the next iteration should be scheduled while the current one is finishing.
+         * @return true if there is a next iteration and pipelining is enabled, false else.
+         */
+        bool shouldPrepareNextIteration() const;
     };
 }
 
@@ -57,19 +57,29 @@
 
 spider::SRDAGJITMSRuntime::SRDAGJITMSRuntime(pisdf::Graph *graph, const RuntimeConfig &cfg) :
         Runtime(graph),
-        srdag_{ make_unique<srdag::Graph, StackID::RUNTIME>(graph) },
         resourcesAllocator_{ make_unique<sched::ResourcesAllocator, StackID::RUNTIME>(cfg.schedPolicy_,
                                                                                       cfg.mapPolicy_,
                                                                                       cfg.execPolicy_,
                                                                                       cfg.allocType_,
-                                                                                      true) } {
+                                                                                      true) },
+        nextDynamicJobStack_{ factory::vector<srdag::TransfoJob>(StackID::GENERAL) },
+        iterCount_{ cfg.mode_ == RunMode::LOOP ? cfg.loopCount_ : SIZE_MAX },
+        pipelined_{ cfg.pipelineIterations_ && (cfg.mode_ != RunMode::EXTERN_LOOP) } {
     if (!rt::platform()) {
         throwSpiderException("JITMSRuntime need the runtime platform to be created.");
     }
+    if (pipelined_ && (cfg.execPolicy_ != ExecutionPolicy::DELAYED)) {
+        log::warning("pipelined iterations require the DELAYED execution policy, disabling it.\n");
+        pipelined_ = false;
+    }
     resourcesAllocator_->allocator()->allocatePersistentDelays(graph_);
     pisdf::recursiveSplitDynamicGraph(graph);
 }
 
+const spider::sched::FifoAllocator *spider::SRDAGJITMSRuntime::fifoAllocator() const {
+    return resourcesAllocator_->allocator();
+}
+
 bool spider::SRDAGJITMSRuntime::execute() {
     const auto grtIx = archi::platform()->spiderGRTPE()->attachedLRT()->virtualIx();
     /* == Time point used as reference == */
@@ -77,36 +87,45 @@ bool spider::SRDAGJITMSRuntime::execute() {
         startIterStamp_ = time::now();
     }
 
-    /* == Apply first transformation of root graph == */
-    TraceMessage transfoMsg{ };
-    TRACE_TRANSFO_START()
-    auto rootJob = srdag::TransfoJob(graph_);
-    rootJob.params_ = graph_->params();
-    auto resultRootJob = srdag::singleRateTransformation(rootJob, srdag_.get());
-
     /* == Initialize the job stacks == */
-    auto staticJobStack = factory::vector<srdag::TransfoJob>(StackID::TRANSFO);
-    auto dynamicJobStack = factory::vector<srdag::TransfoJob>(StackID::TRANSFO);
-    updateJobStack(resultRootJob.first, staticJobStack);
-    updateJobStack(resultRootJob.second, dynamicJobStack);
-    TRACE_TRANSFO_END()
-
-    /* == Transform, schedule and run == */
-    while (!staticJobStack.empty() || !dynamicJobStack.empty()) {
-        /* == Transform static jobs == */
+    TraceMessage transfoMsg{ };
+    auto staticJobStack = factory::vector<srdag::TransfoJob>(StackID::GENERAL);
+    auto dynamicJobStack = factory::vector<srdag::TransfoJob>(StackID::GENERAL);
+    auto prepared = resourcesAllocator_->prepared();
+    if (prepared) {
+        /* == Static part of the graph was transformed and scheduled during previous iteration == */
+        dynamicJobStack.swap(nextDynamicJobStack_);
+    } else {
+        /* == Apply first transformation of root graph == */
         TRACE_TRANSFO_START()
-        transformStaticJobs(staticJobStack, dynamicJobStack);
+        srdag_ = make_unique<srdag::Graph, StackID::TRANSFO>(graph_);
+        auto rootJob = srdag::TransfoJob(graph_);
+        rootJob.params_ = graph_->params();
+        auto resultRootJob = srdag::singleRateTransformation(rootJob, srdag_.get());
+        updateJobStack(resultRootJob.first, staticJobStack);
+        updateJobStack(resultRootJob.second, dynamicJobStack);
         TRACE_TRANSFO_END()
+    }
 
-        /* == Apply graph optimizations == */
-        if (api::shouldOptimizeSRDAG()) {
+    /* == Transform, schedule and run == */
+    while (prepared || !staticJobStack.empty() || !dynamicJobStack.empty()) {
+        if (!prepared) {
+            /* == Transform static jobs == */
             TRACE_TRANSFO_START()
-            optims::optimize(srdag_.get());
+            transformStaticJobs(staticJobStack, dynamicJobStack);
             TRACE_TRANSFO_END()
+
+            /* == Apply graph optimizations == */
+            if (api::shouldOptimizeSRDAG()) {
+                TRACE_TRANSFO_START()
+                optims::optimize(srdag_.get());
+                TRACE_TRANSFO_END()
+            }
         }
+        prepared = false;
 
         /* == Update schedule, run and wait == */
-        scheduleRunAndWait();
+        scheduleRunAndWait(dynamicJobStack.empty());
 
         /* == Wait for all parameters to be resolved == */
         if (!dynamicJobStack.empty()) {
@@ -121,7 +140,7 @@ bool spider::SRDAGJITMSRuntime::execute() {
                 rt::platform()->communicator()->popParamNotification(notification);
                 if (notification.type_ == NotificationType::JOB_SENT_PARAM) {
                     /* == Get the message == */
-                    ParameterMessage message;
+                    auto &message = paramMessage_;
                     rt::platform()->communicator()->pop(message, grtIx, notification.notificationIx_);
                     /* == Get the config vertex == */
                     auto *task = schedule->task(message.taskIx_);
@@ -147,12 +166,12 @@ bool spider::SRDAGJITMSRuntime::execute() {
             }
 
             /* == Update schedule, run and wait == */
-            scheduleRunAndWait();
+            scheduleRunAndWait(staticJobStack.empty() && dynamicJobStack.empty());
         }
     }
 
     /* == Export srdag if needed  == */
-    if (api::exportSRDAGEnabled()) {
+    if (api::exportSRDAGEnabled() && !resourcesAllocator_->prepared()) {
         Runtime::exportSRDAG(srdag_.get(), "./srdag.dot");
     }
 
@@ -164,23 +183,29 @@ bool spider::SRDAGJITMSRuntime::execute() {
         useExecutionTraces(resourcesAllocator_->schedule(), startIterStamp_);
     }
 
-    /* == Clear the srdag == */
-    srdag_->clear();
-
-    /* == Clear the resource allocator == */
-    resourcesAllocator_->clear();
+    /* == Release the srdag and clear the resource allocator (already done if next iteration was prepared) == */
+    if (!resourcesAllocator_->prepared()) {
+        srdag_.reset();
+        resourcesAllocator_->clear();
+        resetIterationStacks();
+    }
+    iter_++;
     return true;
 }
 
 /* === Private method(s) === */
 
-void spider::SRDAGJITMSRuntime::scheduleRunAndWait() {
+void spider::SRDAGJITMSRuntime::scheduleRunAndWait(bool lastRound) {
     TraceMessage schedMsg{ };
     TRACE_SCHEDULE_START()
     /* == Send LRT_START_ITERATION notification == */
     rt::platform()->sendStartIteration();
     /* == Schedule / Map current Single-Rate graph == */
-    resourcesAllocator_->execute(srdag_.get());
+    if (resourcesAllocator_->prepared()) {
+        resourcesAllocator_->send();
+    } else {
+        resourcesAllocator_->execute(srdag_.get());
+    }
     /* == Send JOB_DELAY_BROADCAST_JOBSTAMP notification == */
     rt::platform()->sendDelayedBroadCastToRunners();
     /* == Send LRT_END_ITERATION notification == */
@@ -194,9 +219,42 @@ void spider::SRDAGJITMSRuntime::scheduleRunAndWait() {
 
     /* == If there are jobs left, run == */
     rt::platform()->runner(archi::platform()->getGRTIx())->run(false);
+    if (lastRound && shouldPrepareNextIteration()) {
+        /* == Transform and schedule the next iteration while other runners finish this one == */
+        prepareNextIteration();
+    }
     rt::platform()->waitForRunnersToFinish();
 }
 
+bool spider::SRDAGJITMSRuntime::shouldPrepareNextIteration() const {
+    /* == Execution traces, gantt and srdag exports rely on the graph and schedule of current iteration == */
+    return pipelined_ && ((iter_ + 1) < iterCount_) && !api::exportTraceEnabled() && !api::exportGanttEnabled() &&
+           !api::exportSRDAGEnabled();
+}
+
+void spider::SRDAGJITMSRuntime::prepareNextIteration() {
+    srdag_.reset();
+    resourcesAllocator_->clear();
+    /* == Objects of current iteration are dead and other runners do not use the iteration stacks == */
+    resetIterationStacks();
+    /* == Apply first transformation of root graph == */
+    srdag_ = make_unique<srdag::Graph, StackID::TRANSFO>(graph_);
+    auto rootJob = srdag::TransfoJob(graph_);
+    rootJob.params_ = graph_->params();
+    auto resultRootJob = srdag::singleRateTransformation(rootJob, srdag_.get());
+    auto staticJobStack = factory::vector<srdag::TransfoJob>(StackID::GENERAL);
+    nextDynamicJobStack_.clear();
+    updateJobStack(resultRootJob.first, staticJobStack);
+    updateJobStack(resultRootJob.second, nextDynamicJobStack_);
+    /* == Transform static jobs == */
+    transformStaticJobs(staticJobStack, nextDynamicJobStack_);
+    if (api::shouldOptimizeSRDAG()) {
+        optims::optimize(srdag_.get());
+    }
+    /* == Schedule / Map, jobs will be sent at the start of next iteration == */
+    resourcesAllocator_->prepare(srdag_.get());
+}
+
 /* === Transformation related methods === */
 
 void spider::SRDAGJITMSRuntime::updateJobStack(vector<srdag::TransfoJob> &src, vector<srdag::TransfoJob> &dest) {
@@ -222,7 +280,7 @@ void spider::SRDAGJITMSRuntime::transformJobs(vector<srdag::TransfoJob> &iterJob
 
 void spider::SRDAGJITMSRuntime::transformStaticJobs(vector<srdag::TransfoJob> &staticJobStack,
                                                     vector<srdag::TransfoJob> &dynamicJobStack) {
-    auto tempJobStack = factory::vector<srdag::TransfoJob>(StackID::TRANSFO);
+    auto tempJobStack = factory::vector<srdag::TransfoJob>(StackID::GENERAL);
     while (!staticJobStack.empty()) {
         /* == Transform jobs of current static stack == */
         transformJobs(staticJobStack, tempJobStack, dynamicJobStack);
@@ -234,7 +292,7 @@ void spider::SRDAGJITMSRuntime::transformStaticJobs(vector<srdag::TransfoJob> &s
 
 void spider::SRDAGJITMSRuntime::transformDynamicJobs(vector<srdag::TransfoJob> &staticJobStack,
                                                      vector<srdag::TransfoJob> &dynamicJobStack) {
-    auto tempJobStack = factory::vector<srdag::TransfoJob>(StackID::TRANSFO);
+    auto tempJobStack = factory::vector<srdag::TransfoJob>(StackID::GENERAL);
     /* == Transform jobs of current dynamic stack == */
     transformJobs(dynamicJobStack, staticJobStack, tempJobStack);
     /* == Swap vectors == */
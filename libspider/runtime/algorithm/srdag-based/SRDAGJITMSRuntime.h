@@ -41,6 +41,7 @@
 
 #include <runtime/algorithm/Runtime.h>
 #include <graphs-tools/transformation/srdag/TransfoJob.h>
+#include <runtime/message/Message.h>
 
 namespace spider {
 
@@ -71,19 +72,39 @@ namespace spider {
 
         /* === Getter(s) === */
 
+        const sched::FifoAllocator *fifoAllocator() const override;
+
         /* === Setter(s) === */
 
     private:
         spider::unique_ptr<srdag::Graph> srdag_;
         spider::unique_ptr<sched::ResourcesAllocator> resourcesAllocator_;
+        vector<srdag::TransfoJob> nextDynamicJobStack_;
+        ParameterMessage paramMessage_; /* = Received parameters (capacity is kept between messages) = */
         time::time_point startIterStamp_ = time::min();
+        size_t iter_ = 0U;
+        size_t iterCount_ = SIZE_MAX;
+        bool pipelined_{};
 
         /* === Private method(s) === */
 
         /**
          * @brief Update scheduler, execute scheduler, run schedule and wait.
+         * @param lastRound Flag indicating if this is the last round of current iteration.
+         */
+        void scheduleRunAndWait(bool lastRound);
+
+        /**
+         * @brief Check if the next iteration should be scheduled while the current one is finishing.
+         * @return true if there is a next iteration and pipelining is enabled, false else.
+         */
+        bool shouldPrepareNextIteration() const;
+
+        /**
+         * @brief Clear current iteration, transform the static part of the next one and schedule / map it.
+         * @remark Dynamic jobs of the next iteration are stored in nextDynamicJobStack_.
          */
-        void scheduleRunAndWait();
+        void prepareNextIteration();
 
         /**
          * @brief Appends @refitem spider::srdag::TransfoJob from source vector to destination vector using MOVE semantic.
@@ -67,7 +67,6 @@ updateJobStack(spider::vector<spider::srdag::TransfoJob> &src, spider::vector<sp
 
 spider::StaticRuntime::StaticRuntime(pisdf::Graph *graph, const RuntimeConfig &cfg) :
         Runtime(graph),
-        srdag_{ make_unique<srdag::Graph, StackID::RUNTIME>(graph) },
         ressourcesAllocator_{ make_unique<sched::ResourcesAllocator, StackID::RUNTIME>(cfg.schedPolicy_,
                                                                                        cfg.mapPolicy_,
                                                                                        cfg.execPolicy_,
@@ -79,6 +78,10 @@ spider::StaticRuntime::StaticRuntime(pisdf::Graph *graph, const RuntimeConfig &c
     ressourcesAllocator_->allocator()->allocatePersistentDelays(graph_);
 }
 
+const spider::sched::FifoAllocator *spider::StaticRuntime::fifoAllocator() const {
+    return ressourcesAllocator_->allocator();
+}
+
 bool spider::StaticRuntime::execute() {
     /* == Time point used as reference == */
     if (api::exportTraceEnabled()) {
@@ -88,8 +91,9 @@ bool spider::StaticRuntime::execute() {
         run();
     } else {
         applyTransformationAndRun();
-        srdag_->clear();
+        srdag_.reset();
         ressourcesAllocator_->clear();
+        resetIterationStacks();
     }
     iter_++;
     return true;
@@ -103,6 +107,7 @@ void spider::StaticRuntime::applyTransformationAndRun() {
     TraceMessage transfoMsg{ };
     TRACE_TRANSFO_START();
     /* == Apply first transformation of root graph == */
+    srdag_ = make_unique<srdag::Graph, StackID::TRANSFO>(graph_);
     auto rootJob = srdag::TransfoJob(graph_);
     rootJob.params_ = graph_->params();
     auto resultRootJob = srdag::singleRateTransformation(rootJob, srdag_.get());
@@ -70,6 +70,8 @@ namespace spider {
 
         /* === Getter(s) === */
 
+        const sched::FifoAllocator *fifoAllocator() const override;
+
         /* === Setter(s) === */
 
     private:
@@ -36,6 +36,7 @@
 
 #include <runtime/common/Fifo.h>
 #include <archi/Platform.h>
+#include <archi/Cluster.h>
 #include <archi/MemoryInterface.h>
 
 #define cast_buffer_woffset(buffer, offset) (reinterpret_cast<void *>(reinterpret_cast<uintptr_t>((buffer)) + (offset)))
@@ -44,6 +45,18 @@
 
 namespace spider {
 
+#ifdef _SPIDER_SINGLE_CLUSTER
+    /* = Every fifo lives in the memory interface of the cluster: the tables dispatch to the local versions = */
+    static constexpr bool LOCAL_FIFOS = true;
+#else
+    static constexpr bool LOCAL_FIFOS = false;
+#endif
+
+    template<bool LOCAL>
+    static inline MemoryInterface *fifoMemoryInterface(const Fifo &fifo, MemoryInterface *memoryInterface) {
+        return LOCAL ? memoryInterface : getFifoMemoryInterface(fifo, memoryInterface);
+    }
+
     /* === Static read functions declaration === */
 
     static void *readDummy(array_handle<Fifo>::iterator &it, MemoryInterface *) {
@@ -59,12 +72,14 @@ namespace spider {
         return cast_buffer_woffset(archi::platform()->getExternalBuffer(fifo.address_), fifo.offset_);
     }
 
+    template<bool LOCAL>
     static void *readBuffer(array_handle<Fifo>::iterator &it, MemoryInterface *memoryInterface) {
         const auto fifo = *(it++);
         if (!fifo.size_) {
             return nullptr;
         }
-        return cast_buffer_woffset(memoryInterface->read(fifo.address_, fifo.count_), fifo.offset_);
+        auto *interface = fifoMemoryInterface<LOCAL>(fifo, memoryInterface);
+        return cast_buffer_woffset(interface->read(fifo.address_, fifo.count_), fifo.offset_);
     }
 
     static void *readRepeatBuffer(array_handle<Fifo>::iterator &, MemoryInterface *);
@@ -75,14 +90,17 @@ namespace spider {
 
     using fifo_fun_t = void *(*)(array_handle<Fifo>::iterator &it, MemoryInterface *);
 
-    static std::array<fifo_fun_t, FIFO_ATTR_COUNT> readFunctions = {{ readBuffer,             /*!< RW_ONLY  */
-                                                                            readBuffer,       /*!< RW_OWN   */
-                                                                            readExternBuffer, /*!< RW_EXT   */
-                                                                            readMergedBuffer, /*!< R_MERGE  */
-                                                                            readRepeatBuffer, /*!< R_REPEAT */
-                                                                            readDummy,        /*!< W_SINK   */
-                                                                            readBuffer,       /*!< RW_AUTO  */
-                                                                            readDummy         /*!< DUMMY    */ }};
+    static const std::array<fifo_fun_t, FIFO_ATTR_COUNT> readFunctions = {{
+            readBuffer<LOCAL_FIFOS>, /*!< RW_ONLY  */
+            readBuffer<LOCAL_FIFOS>, /*!< RW_OWN   */
+            readExternBuffer,        /*!< RW_EXT   */
+            readMergedBuffer,        /*!< R_MERGE  */
+            readRepeatBuffer,        /*!< R_REPEAT */
+            readDummy,               /*!< W_SINK   */
+            readBuffer<LOCAL_FIFOS>, /*!< RW_AUTO  */
+            readBuffer<LOCAL_FIFOS>, /*!< W_SHARED */
+            readDummy                /*!< DUMMY    */
+    }};
 
     /* === Static read functions definition === */
 
@@ -134,55 +152,68 @@ namespace spider {
 
     /* === Static allocate functions === */
 
+    template<bool LOCAL>
     static void *allocBuffer(array_handle<Fifo>::iterator &it, MemoryInterface *memoryInterface) {
         const auto fifo = *(it++);
-        return memoryInterface->allocate(fifo.address_, fifo.size_, fifo.count_);
+        return fifoMemoryInterface<LOCAL>(fifo, memoryInterface)->allocate(fifo.address_, fifo.size_, fifo.count_);
+    }
+
+    template<bool LOCAL>
+    static void *acquireBuffer(array_handle<Fifo>::iterator &it, MemoryInterface *memoryInterface) {
+        const auto fifo = *(it++);
+        auto *interface = fifoMemoryInterface<LOCAL>(fifo, memoryInterface);
+        return cast_buffer_woffset(interface->acquire(fifo.address_, fifo.size_, fifo.count_), fifo.offset_);
     }
 
     /* === Static array of allocate functions === */
 
-    static std::array<fifo_fun_t, FIFO_ATTR_COUNT> allocFunctions = {{ readBuffer,             /*!< RW_ONLY  */
-                                                                             allocBuffer,      /*!< RW_OWN   */
-                                                                             readExternBuffer, /*!< RW_EXT   */
-                                                                             readDummy,        /*!< R_MERGE  */
-                                                                             readDummy,        /*!< R_REPEAT */
-                                                                             allocBuffer,      /*!< W_SINK   */
-                                                                             allocBuffer,      /*!< RW_AUTO  */
-                                                                             readDummy         /*!< DUMMY    */}};
+    static const std::array<fifo_fun_t, FIFO_ATTR_COUNT> allocFunctions = {{
+            readBuffer<LOCAL_FIFOS>,    /*!< RW_ONLY  */
+            allocBuffer<LOCAL_FIFOS>,   /*!< RW_OWN   */
+            readExternBuffer,           /*!< RW_EXT   */
+            readDummy,                  /*!< R_MERGE  */
+            readDummy,                  /*!< R_REPEAT */
+            allocBuffer<LOCAL_FIFOS>,   /*!< W_SINK   */
+            allocBuffer<LOCAL_FIFOS>,   /*!< RW_AUTO  */
+            acquireBuffer<LOCAL_FIFOS>, /*!< W_SHARED */
+            readDummy                   /*!< DUMMY    */
+    }};
 }
 
 /* === Function(s) definition === */
 
-spider::array<void *>
-spider::getInputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface) {
-    size_t count = 0u;
-    auto it = std::begin(fifos);
-    while (it != std::end(fifos)) {
-        count += it->attribute_ != FifoAttribute::DUMMY;
-        it = it->attribute_ == FifoAttribute::R_MERGE ? it + it->offset_ + 1 : it + 1;
+spider::MemoryInterface *spider::getFifoMemoryInterface(const Fifo &fifo, MemoryInterface *memoryInterface) {
+#ifdef _SPIDER_SINGLE_CLUSTER
+    (void) fifo;
+    return memoryInterface;
+#else
+    if (fifo.memoryIx_ == Fifo::LOCAL_MEMORY) {
+        return memoryInterface;
     }
-    auto result = spider::array<void *>{ count, nullptr, StackID::RUNTIME };
+    return archi::platform()->cluster(fifo.memoryIx_)->memoryInterface();
+#endif
+}
+
+void spider::getInputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface,
+                             spider::vector<void *> &buffers) {
+    buffers.clear();
     /* = yeah it is ugly, but avoids changing everything else and keeps const at high level = */
     auto fifoIt = const_cast<array_handle<Fifo>::iterator>(std::begin(fifos));
-    auto resIt = std::begin(result);
-    while (resIt != std::end(result)) {
+    while (fifoIt != std::end(fifos)) {
         if (fifoIt->attribute_ == FifoAttribute::DUMMY) {
             fifoIt++;
         } else {
-            (*resIt) = readFunctions[static_cast<u8>(fifoIt->attribute_)](fifoIt, memoryInterface);
-            resIt++;
+            buffers.emplace_back(readFunctions[static_cast<u8>(fifoIt->attribute_)](fifoIt, memoryInterface));
         }
     }
-    return result;
 }
 
-spider::array<void *>
-spider::getOutputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface) {
-    auto result = spider::array<void *>{ fifos.size(), nullptr, StackID::RUNTIME };
+void spider::getOutputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface,
+                              spider::vector<void *> &buffers) {
+    buffers.clear();
     /* = yeah it is ugly, but avoids changing everything else and keeps const at high level = */
     auto fifoIt = const_cast<array_handle<Fifo>::iterator>(std::begin(fifos));
-    for (auto it = std::begin(result); it != std::end(result); ++it) {
-        (*it) = allocFunctions[static_cast<u8>((*fifoIt).attribute_)](fifoIt, memoryInterface);
+    while (fifoIt != std::end(fifos)) {
+        buffers.emplace_back(allocFunctions[static_cast<u8>(fifoIt->attribute_)](fifoIt, memoryInterface));
     }
-    return result;
 }
@@ -39,6 +39,7 @@
 
 #include <common/Types.h>
 #include <containers/array.h>
+#include <containers/vector.h>
 
 namespace spider {
 
@@ -52,6 +53,8 @@ namespace spider {
         R_REPEAT,    /*!< Owner of the FIFO needs to repeat the input FIFO a given number of times */
         W_SINK,      /*!< Owner of the FIFO writes to a sink, i.e FIFO is useless */
         RW_AUTO,     /*!< Owner of the FIFO allocates / reads a FIFO that will be automatically managed */
+        W_SHARED,    /*!< Owner of the FIFO writes at offset in a memory region shared with other producers:
+                        *   --> alloc of the whole region (size) if not in use, count update otherwise */
         DUMMY,       /*!< Sentry for synchronization */
         First = RW_ONLY, /*!< Sentry for EnumIterator::begin */
         Last = DUMMY     /*!< Sentry for EnumIterator::end */
@@ -72,15 +75,20 @@ namespace spider {
         u32 offset_;              /* = Offset in the address = */
         i32 count_;               /* = Number of use of this FIFO = */
         FifoAttribute attribute_; /* = Attribute of the Fifo = */
+        u16 memoryIx_;            /* = Cluster holding the memory of the Fifo (LOCAL_MEMORY: cluster of the job) = */
+
+        static constexpr u16 LOCAL_MEMORY = UINT16_MAX;
 
         Fifo() : address_{ SIZE_MAX },
                  size_{ 0u },
                  offset_{ 0u },
                  count_{ 0u },
-                 attribute_{ FifoAttribute::RW_OWN } { }
+                 attribute_{ FifoAttribute::RW_OWN },
+                 memoryIx_{ LOCAL_MEMORY } { }
 
         Fifo(size_t address, u32 size, u32 offset, i32 count, spider::FifoAttribute attribute) :
-                address_{ address }, size_{ size }, offset_{ offset }, count_{ count }, attribute_{ attribute } {
+                address_{ address }, size_{ size }, offset_{ offset }, count_{ count }, attribute_{ attribute },
+                memoryIx_{ LOCAL_MEMORY } {
         }
     };
 
@@ -88,9 +96,31 @@ namespace spider {
 
     class MemoryInterface;
 
-    spider::array<void *> getInputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface);
+    /**
+     * @brief Get the memory interface holding the buffer of a fifo.
+     * @param fifo            Fifo to locate.
+     * @param memoryInterface Memory interface of the cluster running the job.
+     * @return memory interface of the cluster given by the fifo, memoryInterface if the fifo is local.
+     */
+    MemoryInterface *getFifoMemoryInterface(const Fifo &fifo, MemoryInterface *memoryInterface);
+
+    /**
+     * @brief Get the input buffers of a job.
+     * @param fifos           Input fifos of the job.
+     * @param memoryInterface Memory interface of the cluster running the job.
+     * @param buffers         Vector to fill with the buffers (cleared first, its capacity is reused between jobs).
+     */
+    void getInputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface,
+                         spider::vector<void *> &buffers);
 
-    spider::array<void *> getOutputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface);
+    /**
+     * @brief Get the output buffers of a job.
+     * @param fifos           Output fifos of the job.
+     * @param memoryInterface Memory interface of the cluster running the job.
+     * @param buffers         Vector to fill with the buffers (cleared first, its capacity is reused between jobs).
+     */
+    void getOutputBuffers(const array_handle<Fifo> &fifos, MemoryInterface *memoryInterface,
+                          spider::vector<void *> &buffers);
 }
 
 #endif //SPIDER2_FIFO_H
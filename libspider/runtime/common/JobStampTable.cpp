@@ -0,0 +1,98 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <runtime/common/JobStampTable.h>
+#include <memory/memory.h>
+#include <new>
+
+/* === Method(s) implementation === */
+
+spider::JobStampTable::JobStampTable(size_t lrtCount) : lrtCount_{ lrtCount }, wordCount_{ (lrtCount + 63) / 64 } {
+    /* == Over-allocate by one entry to align the table on a cache line, waiter masks are stored after it == */
+    const auto waiterCount = lrtCount_ * wordCount_;
+    buffer_ = spider::allocate<char, StackID::RUNTIME>((lrtCount_ + 1) * sizeof(Entry) +
+                                                       waiterCount * sizeof(std::atomic<u64>));
+    const auto address = reinterpret_cast<uintptr_t>(buffer_);
+    const auto alignedAddress = (address + CACHE_LINE_SIZE - 1) & ~(static_cast<uintptr_t>(CACHE_LINE_SIZE) - 1);
+    entries_ = reinterpret_cast<Entry *>(alignedAddress);
+    for (size_t i = 0; i < lrtCount_; ++i) {
+        new(&entries_[i]) Entry();
+    }
+    waiters_ = reinterpret_cast<std::atomic<u64> *>(entries_ + lrtCount_);
+    for (size_t i = 0; i < waiterCount; ++i) {
+        new(&waiters_[i]) std::atomic<u64>{ 0 };
+    }
+}
+
+spider::JobStampTable::~JobStampTable() {
+    for (size_t i = 0; i < lrtCount_; ++i) {
+        entries_[i].~Entry();
+    }
+    deallocate(buffer_);
+}
+
+void spider::JobStampTable::reset() {
+    for (size_t i = 0; i < lrtCount_; ++i) {
+        entries_[i].stamp_.store(SIZE_MAX, std::memory_order_relaxed);
+        entries_[i].waitedLRT_.store(SIZE_MAX, std::memory_order_relaxed);
+        entries_[i].waitedJob_.store(SIZE_MAX, std::memory_order_relaxed);
+        entries_[i].maskedLRT_ = SIZE_MAX;
+    }
+    for (size_t i = 0; i < lrtCount_ * wordCount_; ++i) {
+        waiters_[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void spider::JobStampTable::setWaiting(size_t lrtIx, size_t waitedLRTIx, size_t waitedJob) {
+    auto &entry = entries_[lrtIx];
+    if (waitedLRTIx == SIZE_MAX) {
+        entry.waitedLRT_.store(SIZE_MAX, std::memory_order_seq_cst);
+        return;
+    }
+    const auto word = lrtIx / 64;
+    const auto bit = u64{ 1 } << (lrtIx % 64);
+    if (entry.maskedLRT_ != waitedLRTIx) {
+        /* == We do not wait on the previous producer anymore == */
+        if (entry.maskedLRT_ != SIZE_MAX) {
+            waiterWords(entry.maskedLRT_)[word].fetch_and(~bit, std::memory_order_relaxed);
+        }
+        entry.maskedLRT_ = waitedLRTIx;
+    }
+    entry.waitedJob_.store(waitedJob, std::memory_order_relaxed);
+    entry.waitedLRT_.store(waitedLRTIx, std::memory_order_seq_cst);
+    waiterWords(waitedLRTIx)[word].fetch_or(bit, std::memory_order_seq_cst);
+}
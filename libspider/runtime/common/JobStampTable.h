@@ -0,0 +1,205 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_JOBSTAMPTABLE_H
+#define SPIDER2_JOBSTAMPTABLE_H
+
+/* === Include(s) === */
+
+#include <common/Types.h>
+#include <atomic>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace spider {
+
+    /* === Class definition === */
+
+    /**
+     * @brief Platform-wide table of the last job stamp achieved by every LRT, for platforms where LRTs share memory.
+     *        Each LRT only writes its own entry, entries are padded to a cache line to avoid false sharing.
+     *        An LRT that has to wait on another one registers itself in its own entry and sets its bit in the waiter
+     *        mask of the other LRT, so that the producer only visits and wakes up the LRTs actually waiting on it.
+     *        A bit is only cleared by its LRT, when it registers on another producer, so that a registration can
+     *        never be lost. The mask of a producer thus holds at most one stale bit per LRT released by it.
+     */
+    class JobStampTable {
+    public:
+        explicit JobStampTable(size_t lrtCount);
+
+        ~JobStampTable();
+
+        JobStampTable(JobStampTable &&) = delete;
+
+        JobStampTable(const JobStampTable &) = delete;
+
+        JobStampTable &operator=(JobStampTable &&) = delete;
+
+        JobStampTable &operator=(const JobStampTable &) = delete;
+
+        /* === Method(s) === */
+
+        /**
+         * @brief Reset every job stamp to SIZE_MAX and every waiting registration.
+         * @warning Must only be called when no LRT is running a job.
+         */
+        void reset();
+
+        /**
+         * @brief Register LRT lrtIx as waiting for LRT waitedLRTIx to reach the job stamp waitedJob.
+         * @remark Caller should check the job stamp again after this call as it may have been updated in between.
+         * @warning Must only be called by LRT lrtIx itself.
+         * @param lrtIx       Index of the waiting LRT.
+         * @param waitedLRTIx Index of the waited LRT (SIZE_MAX to unregister).
+         * @param waitedJob   Job stamp waited.
+         */
+        void setWaiting(size_t lrtIx, size_t waitedLRTIx, size_t waitedJob);
+
+        /**
+         * @brief Un-register the LRTs waiting on LRT producerIx for a job stamp inferior or equal to value.
+         * @remark Only the LRTs registered in the waiter mask of the producer are visited.
+         * @param producerIx Index of the LRT that updated its stamp.
+         * @param value      New job stamp of the producer.
+         * @param wake       Function called with the index of every released LRT.
+         */
+        template<class WakeFunction>
+        inline void releaseWaiting(size_t producerIx, size_t value, WakeFunction &&wake) {
+            auto *words = waiterWords(producerIx);
+            for (size_t w = 0; w < wordCount_; ++w) {
+                auto mask = words[w].load(std::memory_order_seq_cst);
+                while (mask) {
+                    const auto bit = findFirstSet(mask);
+                    mask &= mask - 1;
+                    const auto lrtIx = w * 64 + bit;
+                    if (releaseWaiting(lrtIx, producerIx, value)) {
+                        wake(lrtIx);
+                    }
+                }
+            }
+        }
+
+        /* === Getter(s) === */
+
+        /**
+         * @brief Get the last job stamp achieved by a given LRT.
+         * @param lrtIx Index of the LRT.
+         * @return job stamp, SIZE_MAX if no job were done.
+         */
+        inline size_t get(size_t lrtIx) const {
+            return entries_[lrtIx].stamp_.load(std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief Get the number of LRT in the table.
+         * @return number of LRT.
+         */
+        inline size_t size() const {
+            return lrtCount_;
+        }
+
+        /* === Setter(s) === */
+
+        /**
+         * @brief Set the job stamp of a given LRT (should only be called by the LRT itself).
+         * @param lrtIx Index of the LRT.
+         * @param value Value of the job stamp.
+         */
+        inline void set(size_t lrtIx, size_t value) {
+            entries_[lrtIx].stamp_.store(value, std::memory_order_seq_cst);
+        }
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        struct Entry {
+            std::atomic<size_t> stamp_{ SIZE_MAX };
+            std::atomic<size_t> waitedLRT_{ SIZE_MAX };
+            std::atomic<size_t> waitedJob_{ SIZE_MAX };
+            size_t maskedLRT_ = SIZE_MAX; /* = LRT whose waiter mask has our bit set (only used by the owner) = */
+            char padding_[CACHE_LINE_SIZE - 3 * sizeof(std::atomic<size_t>) - sizeof(size_t)];
+        };
+
+        void *buffer_ = nullptr;
+        Entry *entries_ = nullptr;
+        std::atomic<u64> *waiters_ = nullptr; /* = Per LRT bit mask of the LRTs that registered as waiting on it = */
+        size_t lrtCount_ = 0;
+        size_t wordCount_ = 0;
+
+        /* === Private method(s) === */
+
+        inline std::atomic<u64> *waiterWords(size_t lrtIx) const {
+            return waiters_ + lrtIx * wordCount_;
+        }
+
+        /**
+         * @brief Index of the least significant bit set (value must not be 0).
+         */
+        static inline size_t findFirstSet(u64 value) noexcept {
+#if defined(__GNUC__)
+            return static_cast<size_t>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long bit = 0;
+            _BitScanForward64(&bit, value);
+            return static_cast<size_t>(bit);
+#else
+            size_t bit = 0;
+            while (!(value & 1)) {
+                value >>= 1;
+                bit++;
+            }
+            return bit;
+#endif
+        }
+
+        /**
+         * @brief Check if LRT lrtIx is waiting on LRT producerIx for a job stamp inferior or equal to value, and
+         *        un-register it if so.
+         * @param lrtIx      Index of the LRT to check.
+         * @param producerIx Index of the LRT that updated its stamp.
+         * @param value      New job stamp of the producer.
+         * @return true if the LRT was waiting and should be woken up, false else.
+         */
+        inline bool releaseWaiting(size_t lrtIx, size_t producerIx, size_t value) {
+            auto &entry = entries_[lrtIx];
+            auto waitedLRT = entry.waitedLRT_.load(std::memory_order_seq_cst);
+            if ((waitedLRT != producerIx) || (entry.waitedJob_.load(std::memory_order_relaxed) > value)) {
+                return false;
+            }
+            return entry.waitedLRT_.compare_exchange_strong(waitedLRT, SIZE_MAX, std::memory_order_acq_rel);
+        }
+    };
+}
+
+#endif //SPIDER2_JOBSTAMPTABLE_H
@@ -103,33 +103,56 @@ namespace spider {
          */
         virtual bool popTraceNotification(Notification &notification) = 0;
 
+        /**
+         * @brief Get a JobMessage to be filled and pushed.
+         * @remark Messages are recycled, the content (and capacity) of the previous use is kept.
+         * @return pointer to the message.
+         */
+        virtual JobMessage *acquireJobMessage() = 0;
+
         /**
          * @brief Push a JobMessage for a given target LRT.
-         * @param message  Message to push.
+         * @remark Messages chained through JobMessage::next_ are pushed along as a single batch.
+         * @param message  Message to push (obtained with @refitem RTCommunicator::acquireJobMessage).
          * @param receiver Receiver of the notification.
          * @return Index of the pushed message in the queue.
          */
-        virtual size_t push(JobMessage message, size_t receiver) = 0;
+        virtual size_t push(JobMessage *message, size_t receiver) = 0;
 
         /**
          * @brief Pop a JobMessage.
-         * @param message  Message structure to be filled.
+         * @param message  Pointer set to the message.
          * @param receiver Receiver of the message.
          * @param ix       Index of the message in the queue.
          * @return true on success, false else.
          */
-        virtual bool pop(JobMessage &message, size_t receiver, size_t ix) = 0;
+        virtual bool pop(JobMessage *&message, size_t receiver, size_t ix) = 0;
+
+        /**
+         * @brief Give back a JobMessage once the receiver does not need it anymore.
+         * @param message  Pointer to the message.
+         * @param receiver Receiver of the message.
+         */
+        virtual void release(JobMessage *message, size_t receiver) = 0;
+
+        /**
+         * @brief Grow the free JobMessages so that filling them for the next jobs does not call the allocator.
+         * @remark Called by the GRT once every runner has finished its jobs.
+         */
+        virtual void reserveJobMessages() = 0;
 
         /**
          * @brief Push a ParameterMessage for a given target LRT.
+         * @remark The message is copied, the sender can reuse it right away.
          * @param message  Message to push.
          * @param receiver Receiver of the notification.
          * @return Index of the pushed message in the queue.
          */
-        virtual size_t push(ParameterMessage message, size_t receiver) = 0;
+        virtual size_t push(const ParameterMessage &message, size_t receiver) = 0;
 
         /**
          * @brief Pop a ParameterMessage.
+         * @remark Keeping the same message structure between calls lets it reuse its memory.
          * @param message  Message structure to be filled.
          * @param receiver Receiver of the message.
          * @param ix       Index of the message in the queue.
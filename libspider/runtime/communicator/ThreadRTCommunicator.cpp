@@ -44,10 +44,11 @@
 
 /* === Private method(s) implementation === */
 
-spider::ThreadRTCommunicator::ThreadRTCommunicator(size_t lrtCount) {
-    auto *queues = spider::make_n<spider::Queue<Notification> *, StackID::RUNTIME>(lrtCount, nullptr);
+spider::ThreadRTCommunicator::ThreadRTCommunicator(size_t lrtCount) : jobMessagePool_{ lrtCount } {
+    auto *queues = spider::make_n<spider::MPSCQueue<Notification, StackID::RUNTIME> *, StackID::RUNTIME>(lrtCount,
+                                                                                                       nullptr);
     for (size_t i = 0; i < archi::platform()->LRTCount(); ++i) {
-        queues[i] = spider::make<spider::Queue<Notification>, StackID::RUNTIME>();
+        queues[i] = spider::make<spider::MPSCQueue<Notification, StackID::RUNTIME>, StackID::RUNTIME>();
     }
     notificationQueueArray_ = spider::make_unique(queues);
 }
@@ -86,16 +87,30 @@ bool spider::ThreadRTCommunicator::popTraceNotification(Notification &notificati
     return traceNotificationQueue_.try_pop(notification);
 }
 
-size_t spider::ThreadRTCommunicator::push(JobMessage message, size_t) {
-    return jobMessageQueueArray_.push(std::move(message));
+spider::JobMessage *spider::ThreadRTCommunicator::acquireJobMessage() {
+    return jobMessagePool_.acquire();
 }
 
-bool spider::ThreadRTCommunicator::pop(JobMessage &message, size_t, size_t ix) {
-    return jobMessageQueueArray_.pop(message, ix);
+size_t spider::ThreadRTCommunicator::push(JobMessage *message, size_t) {
+    /* == Memory is shared, only the index of the message is needed by the receiver == */
+    return message->ix_;
 }
 
-size_t spider::ThreadRTCommunicator::push(ParameterMessage message, size_t) {
-    return paramMessageQueueArray_.push(std::move(message));
+bool spider::ThreadRTCommunicator::pop(JobMessage *&message, size_t, size_t ix) {
+    message = jobMessagePool_.at(ix);
+    return true;
+}
+
+void spider::ThreadRTCommunicator::release(JobMessage *message, size_t) {
+    jobMessagePool_.release(message);
+}
+
+void spider::ThreadRTCommunicator::reserveJobMessages() {
+    jobMessagePool_.reserve();
+}
+
+size_t spider::ThreadRTCommunicator::push(const ParameterMessage &message, size_t) {
+    return paramMessageQueueArray_.push(message);
 }
 
 bool spider::ThreadRTCommunicator::pop(ParameterMessage &message, size_t, size_t ix) {
@@ -126,7 +141,6 @@ bool spider::ThreadRTCommunicator::pop(TraceMessage &message, size_t, size_t ix)
  */
 static void foo() {
     spider::Queue<spider::Notification> a;
-    spider::IndexedQueue<spider::JobMessage> b;
     spider::IndexedQueue<spider::ParameterMessage> c;
     spider::IndexedQueue<spider::TraceMessage> d;
 }
@@ -38,7 +38,9 @@
 /* === Include(s) === */
 
 #include <runtime/communicator/RTCommunicator.h>
+#include <runtime/message/JobMessagePool.h>
 #include <thread/Queue.h>
+#include <thread/MPSCQueue.h>
 #include <thread/IndexedQueue.h>
 #include <containers/array.h>
 #include <containers/vector.h>
@@ -69,11 +71,17 @@ namespace spider {
 
         bool popTraceNotification(Notification &notification) override;
 
-        size_t push(JobMessage message, size_t receiver) override;
+        JobMessage *acquireJobMessage() override;
 
-        bool pop(JobMessage &message, size_t receiver, size_t ix) override;
+        size_t push(JobMessage *message, size_t receiver) override;
 
-        size_t push(ParameterMessage message, size_t receiver) override;
+        bool pop(JobMessage *&message, size_t receiver, size_t ix) override;
+
+        void release(JobMessage *message, size_t receiver) override;
+
+        void reserveJobMessages() override;
+
+        size_t push(const ParameterMessage &message, size_t receiver) override;
 
         bool pop(ParameterMessage &message, size_t receiver, size_t ix) override;
 
@@ -81,11 +89,17 @@ namespace spider {
 
         bool pop(TraceMessage &message, size_t receiver, size_t ix) override;
 
+        /* === Getter(s) === */
+
+        inline const JobMessagePool &jobMessagePool() const {
+            return jobMessagePool_;
+        }
+
     private:
-        spider::unique_ptr<spider::Queue<Notification> *> notificationQueueArray_;
+        spider::unique_ptr<spider::MPSCQueue<Notification, StackID::RUNTIME> *> notificationQueueArray_;
         spider::Queue<Notification> paramNotificationQueue_;
         spider::Queue<Notification> traceNotificationQueue_;
-        IndexedQueue<JobMessage, StackID::RUNTIME> jobMessageQueueArray_;
+        JobMessagePool jobMessagePool_;
         IndexedQueue<ParameterMessage, StackID::RUNTIME> paramMessageQueueArray_;
         IndexedQueue<TraceMessage, StackID::RUNTIME> traceMessageQueueArray_;
     };
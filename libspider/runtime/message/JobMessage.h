@@ -39,6 +39,7 @@
 
 #include <scheduling/memory/JobFifos.h>
 #include <common/Types.h>
+#include <containers/vector.h>
 
 namespace spider {
 
@@ -53,16 +54,32 @@ namespace spider {
 
     /**
      * @brief Information message about an LRT job to run.
+     * @remark JobMessage are recycled through the @refitem JobMessagePool, their containers keep their capacity
+     *         between uses so that steady state iterations do not allocate.
      */
     struct JobMessage {
-        spider::array<SyncInfo> execConstraints_;       /*!< Array of jobs this job has to wait before running (size is inferior or equal to the number of LRT) */
-        spider::unique_ptr<JobFifos> fifos_;            /*!< Fifos of the task */
-        spider::unique_ptr<i64> inputParams_;           /*!< Array of static input parameters */
-        spider::unique_ptr<bool> synchronizationFlags_; /*!< Array of LRT to notify after job completion (size IS equal to the number of LRT) */
-        u32 kernelIx_;                                  /*!< Kernel used for executing the task */
-        u32 execIx_;                                    /*!< Index of the job */
-        u32 taskIx_;                                    /*!< Index of the task associated with the job */
-        u32 nParamsOut_;                                /*!< Number of output parameters to be set by this job. */
+        spider::vector<SyncInfo> execConstraints_;      /*!< Jobs this job has to wait before running (size is inferior or equal to the number of LRT) */
+        JobFifos fifos_;                                /*!< Fifos of the task */
+        spider::vector<i64> inputParams_;               /*!< Static input parameters */
+        bool *synchronizationFlags_ = nullptr;          /*!< Array of LRT to notify after job completion (size IS equal to the number of LRT), owned by the @refitem JobMessagePool */
+        JobMessage *next_ = nullptr;                    /*!< Next message of a batch, or next free message in the @refitem JobMessagePool */
+        size_t ix_ = SIZE_MAX;                          /*!< Index of the message in the @refitem JobMessagePool */
+        u32 kernelIx_ = UINT32_MAX;                     /*!< Kernel used for executing the task */
+        u32 execIx_ = UINT32_MAX;                       /*!< Index of the job */
+        u32 taskIx_ = UINT32_MAX;                       /*!< Index of the task associated with the job */
+        u32 nParamsOut_ = 0;                            /*!< Number of output parameters to be set by this job. */
+        bool notify_ = false;                           /*!< Whether synchronizationFlags_ has at least one flag set */
+
+        JobMessage() : execConstraints_{ factory::vector<SyncInfo>(StackID::RUNTIME) },
+                       inputParams_{ factory::vector<i64>(StackID::RUNTIME) } { }
+
+        /**
+         * @brief Get the notification flags of the job.
+         * @return pointer to the flags if at least one LRT needs to be notified, nullptr else.
+         */
+        inline bool *notificationFlags() const {
+            return notify_ ? synchronizationFlags_ : nullptr;
+        }
     };
 }
 
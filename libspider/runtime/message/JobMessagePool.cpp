@@ -0,0 +1,141 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <runtime/message/JobMessagePool.h>
+#include <algorithm>
+
+/* === Method(s) implementation === */
+
+spider::JobMessagePool::JobMessagePool(size_t lrtCount, size_t slabSize) :
+        slabs_{ spider::make_n<JobMessage *, StackID::RUNTIME>(MAX_SLAB_COUNT, nullptr) },
+        lrtCount_{ lrtCount } {
+    /* == Slab size is rounded up to a power of 2 so that indexing only needs shift and mask == */
+    slabSize_ = 1u;
+    while (slabSize_ < std::max(slabSize, static_cast<size_t>(2u))) {
+        slabSize_ <<= 1u;
+        slabShift_++;
+    }
+    allocateSlab();
+}
+
+spider::JobMessagePool::~JobMessagePool() {
+    const auto slabCount = slabCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < slabCount; ++i) {
+        auto *slab = slabs_[i];
+        /* == Notification flags of the slab are stored in a single array starting at the flags of its first message == */
+        deallocate(slab[0].synchronizationFlags_);
+        for (size_t j = 0; j < slabSize_; ++j) {
+            slab[j].~JobMessage();
+        }
+        deallocate(slab);
+    }
+}
+
+spider::JobMessage *spider::JobMessagePool::acquire() {
+    if (!freeHead_) {
+        /* == Take every released message at once, no ABA is possible since we are the only consumer == */
+        freeHead_ = releasedHead_.exchange(nullptr, std::memory_order_acquire);
+        if (!freeHead_) {
+            allocateSlab();
+        }
+    }
+    auto *message = freeHead_;
+    freeHead_ = message->next_;
+    message->next_ = nullptr;
+    acquireCount_++;
+    return message;
+}
+
+void spider::JobMessagePool::release(JobMessage *message) {
+    if (!message) {
+        return;
+    }
+    auto *head = releasedHead_.load(std::memory_order_relaxed);
+    do {
+        message->next_ = head;
+    } while (!releasedHead_.compare_exchange_weak(head, message, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+}
+
+void spider::JobMessagePool::reserve() {
+    /* == Move the released messages in the free list so that they are grown too == */
+    auto *released = releasedHead_.exchange(nullptr, std::memory_order_acquire);
+    if (released) {
+        auto *tail = released;
+        while (tail->next_) {
+            tail = tail->next_;
+        }
+        tail->next_ = freeHead_;
+        freeHead_ = released;
+    }
+    u32 inputFifoCapacity = 0;
+    u32 outputFifoCapacity = 0;
+    size_t constraintCapacity = 0;
+    size_t paramCapacity = 0;
+    for (auto *message = freeHead_; message; message = message->next_) {
+        inputFifoCapacity = std::max(inputFifoCapacity, message->fifos_.inputFifoCapacity());
+        outputFifoCapacity = std::max(outputFifoCapacity, message->fifos_.outputFifoCapacity());
+        constraintCapacity = std::max(constraintCapacity, message->execConstraints_.capacity());
+        paramCapacity = std::max(paramCapacity, message->inputParams_.capacity());
+    }
+    for (auto *message = freeHead_; message; message = message->next_) {
+        message->fifos_.reserve(inputFifoCapacity, outputFifoCapacity);
+        message->execConstraints_.reserve(constraintCapacity);
+        message->inputParams_.reserve(paramCapacity);
+    }
+}
+
+/* === Private method(s) implementation === */
+
+void spider::JobMessagePool::allocateSlab() {
+    const auto slabIx = slabCount_.load(std::memory_order_relaxed);
+    if (slabIx >= MAX_SLAB_COUNT) {
+        throwSpiderException("JobMessagePool: maximum number of in-flight job messages reached (%zu).",
+                             MAX_SLAB_COUNT * slabSize_);
+    }
+    auto *slab = spider::make_n<JobMessage, StackID::RUNTIME>(slabSize_);
+    auto *flags = spider::make_n<bool, StackID::RUNTIME>(slabSize_ * lrtCount_, false);
+    for (size_t i = 0; i < slabSize_; ++i) {
+        auto &message = slab[i];
+        message.ix_ = slabIx * slabSize_ + i;
+        message.synchronizationFlags_ = flags + i * lrtCount_;
+        message.next_ = (i + 1) < slabSize_ ? &slab[i + 1] : freeHead_;
+    }
+    freeHead_ = slab;
+    slabs_[slabIx] = slab;
+    slabCount_.store(slabIx + 1, std::memory_order_release);
+    allocationCount_.fetch_add(1, std::memory_order_relaxed);
+}
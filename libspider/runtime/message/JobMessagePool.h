@@ -0,0 +1,156 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_JOBMESSAGEPOOL_H
+#define SPIDER2_JOBMESSAGEPOOL_H
+
+/* === Include(s) === */
+
+#include <runtime/message/JobMessage.h>
+#include <memory/unique_ptr.h>
+#include <common/Exception.h>
+#include <atomic>
+
+namespace spider {
+
+    /* === Class definition === */
+
+    /**
+     * @brief Pool of recycled @refitem JobMessage.
+     *        Messages are stored in slabs that are never moved nor freed before the pool is destroyed, so a message
+     *        can be addressed by its index from any thread once it has been published.
+     *        Only one thread (the GRT) can acquire messages while any thread can release them.
+     *        Released messages are pushed on a lock-free stack that the acquiring thread grabs in a single exchange,
+     *        so that, once warm, acquiring a message never calls the allocator.
+     */
+    class JobMessagePool {
+    public:
+        explicit JobMessagePool(size_t lrtCount, size_t slabSize = 256);
+
+        ~JobMessagePool();
+
+        JobMessagePool(JobMessagePool &&) = delete;
+
+        JobMessagePool(const JobMessagePool &) = delete;
+
+        JobMessagePool &operator=(JobMessagePool &&) = delete;
+
+        JobMessagePool &operator=(const JobMessagePool &) = delete;
+
+        /* === Method(s) === */
+
+        /**
+         * @brief Get a free message from the pool, a new slab is allocated if none is available.
+         * @remark Content of the message is left as it was on release (containers keep their capacity).
+         * @warning Must only be called by a single thread.
+         * @return pointer to the message.
+         */
+        JobMessage *acquire();
+
+        /**
+         * @brief Give back a message to the pool (thread safe and lock-free).
+         * @param message Pointer to the message (nullptr is ignored).
+         */
+        void release(JobMessage *message);
+
+        /**
+         * @brief Grow every free message to the largest capacity found among the free messages.
+         * @remark Recycled messages are picked in no particular order, so without this a message only reaches the
+         *         size of the largest job after being used by it. Once warm, acquiring and filling a message for a job
+         *         no larger than the ones seen before never calls the allocator.
+         * @warning Must only be called by the thread acquiring the messages.
+         */
+        void reserve();
+
+        /* === Getter(s) === */
+
+        /**
+         * @brief Get the message of index ix.
+         * @param ix Index of the message.
+         * @return pointer to the message.
+         * @throws spider::Exception if index is out of bound (only in debug).
+         */
+        inline JobMessage *at(size_t ix) const {
+#ifndef NDEBUG
+            if (ix >= slabCount_.load(std::memory_order_acquire) * slabSize_) {
+                throwSpiderException("job message index out of bound: %zu", ix);
+            }
+#endif
+            return &(slabs_[ix >> slabShift_][ix & (slabSize_ - 1)]);
+        }
+
+        /**
+         * @brief Number of message slots allocated by the pool.
+         */
+        inline size_t capacity() const {
+            return slabCount_.load(std::memory_order_acquire) * slabSize_;
+        }
+
+        /**
+         * @brief Number of slabs allocated by the pool.
+         * @remark A slab takes two allocator calls, one for its messages and one for their notification flags.
+         *         This does not count the containers of the messages, which only grow in @refitem reserve or when
+         *         they are filled.
+         */
+        inline size_t allocationCount() const {
+            return allocationCount_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Number of messages acquired.
+         */
+        inline size_t acquireCount() const {
+            return acquireCount_;
+        }
+
+    private:
+        static constexpr size_t MAX_SLAB_COUNT = 4096;
+
+        spider::unique_ptr<JobMessage *> slabs_;
+        std::atomic<JobMessage *> releasedHead_{ nullptr };
+        JobMessage *freeHead_ = nullptr;
+        std::atomic<size_t> slabCount_{ 0 };
+        std::atomic<size_t> allocationCount_{ 0 };
+        size_t acquireCount_ = 0;
+        size_t lrtCount_ = 0;
+        size_t slabSize_ = 0;
+        size_t slabShift_ = 0;
+
+        /* === Private method(s) === */
+
+        void allocateSlab();
+    };
+}
+
+#endif //SPIDER2_JOBMESSAGEPOOL_H
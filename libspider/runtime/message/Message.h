@@ -37,7 +37,7 @@
 
 /* === Include(s) === */
 
-#include <containers/array.h>
+#include <containers/vector.h>
 #include <memory/unique_ptr.h>
 #include <runtime/common/Fifo.h>
 #include <common/Time.h>
@@ -51,15 +51,12 @@ namespace spider {
      */
     struct ParameterMessage {
 
-        ParameterMessage() = default;
+        ParameterMessage() : params_{ factory::vector<i64>(StackID::RUNTIME) } { };
 
         ParameterMessage(const ParameterMessage &) = default;
 
         ParameterMessage(ParameterMessage &&) noexcept = default;
 
-        ParameterMessage(size_t kernelIx, spider::array<int64_t> params) : params_{ std::move(params) },
-                                                                           taskIx_{ kernelIx } { };
-
         ParameterMessage &operator=(const ParameterMessage &) = default;
 
         ParameterMessage &operator=(ParameterMessage &&) noexcept = default;
@@ -68,8 +65,8 @@ namespace spider {
 
         /* === Struct member(s) === */
 
-        spider::array<i64> params_; /*!< Array of parameter(s) value */
-        size_t taskIx_ = SIZE_MAX;  /*!< Ix of the kernel setting the parameter(s) */
+        spider::vector<i64> params_; /*!< Parameter(s) value (capacity is kept when the message is copied over) */
+        size_t taskIx_ = SIZE_MAX;   /*!< Ix of the kernel setting the parameter(s) */
     };
 
     /**
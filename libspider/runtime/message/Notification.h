@@ -54,6 +54,9 @@ namespace spider {
         LRT_STOP,                       /*!< Signal LRT to stop */
         LRT_PAUSE,                      /*!< Signal LRT to freeze */
         LRT_RESUME,                     /*!< Signal LRT to un-freeze */
+        LRT_WAIT_BLOCKING,              /*!< Signal LRT to park right away when waiting for a dependency */
+        LRT_WAIT_SPIN_THEN_PARK,        /*!< Signal LRT to spin (for the given budget) before parking when waiting for a dependency */
+        LRT_WAIT_BUSY_POLL,             /*!< Signal LRT to never park when waiting for a dependency */
         TRACE_ENABLE,                   /*!< Signal LRT to enable its trace */
         TRACE_DISABLE,                  /*!< Signal LRT to disable its trace */
         TRACE_TASK,                     /*!< Signal that an execution trace of a task has been sent */
@@ -61,7 +64,7 @@ namespace spider {
         TRACE_TRANSFO,                  /*!< Signal that an execution trace of transformation step has been sent */
         TRACE_PARAM,                    /*!< Signal that an execution trace of param resolution has been sent */
         TRACE_MEMORY,                   /*!< Signal that an execution trace of memory alloc has been sent */
-        JOB_ADD,                        /*!< Signal LRT that a job is available in shared queue */
+        JOB_ADD,                        /*!< Signal LRT that a job (and the ones chained from it) is available in shared queue */
         JOB_CLEAR_QUEUE,                /*!< Signal LRT to clear its job queue (if LRT_REPEAT_ITERATION_EN, signal is ignored) */
         JOB_SENT_PARAM,                 /*!< Signal that LRT sent a ParameterMessage */
         JOB_BROADCAST_JOBSTAMP,         /*!< Signal LRT to broadcast its job stamp to everybody */
@@ -95,6 +98,12 @@ namespace spider {
                 return "LRT_PAUSE";
             case NotificationType::LRT_RESUME:
                 return "LRT_RESUME";
+            case NotificationType::LRT_WAIT_BLOCKING:
+                return "LRT_WAIT_BLOCKING";
+            case NotificationType::LRT_WAIT_SPIN_THEN_PARK:
+                return "LRT_WAIT_SPIN_THEN_PARK";
+            case NotificationType::LRT_WAIT_BUSY_POLL:
+                return "LRT_WAIT_BUSY_POLL";
             case NotificationType::TRACE_ENABLE:
                 return "TRACE_ENABLE";
             case NotificationType::TRACE_DISABLE:
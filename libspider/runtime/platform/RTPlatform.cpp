@@ -121,6 +121,9 @@ void spider::RTPlatform::sendDelayedBroadCastToRunners() const {
 
 void spider::RTPlatform::sendClearToRunners() const {
     const auto grtIx = archi::platform()->getGRTIx();
+    if (jobStampTable_) {
+        jobStampTable_->reset();
+    }
     for (size_t i = 0; i < archi::platform()->LRTCount(); ++i) {
         communicator()->push(Notification{ NotificationType::LRT_CLEAR_ITERATION, grtIx }, i);
     }
@@ -128,6 +131,9 @@ void spider::RTPlatform::sendClearToRunners() const {
 
 void spider::RTPlatform::sendResetToRunners() const {
     const auto grtIx = archi::platform()->getGRTIx();
+    if (jobStampTable_) {
+        jobStampTable_->reset();
+    }
     for (size_t i = 0; i < archi::platform()->LRTCount(); ++i) {
         communicator()->push(Notification{ NotificationType::LRT_RST_ITERATION, grtIx }, i);
     }
@@ -149,6 +155,26 @@ void spider::RTPlatform::sendTraceToRunners(bool value) const {
     }
 }
 
+void spider::RTPlatform::sendWaitPolicyToRunners(RunnerWaitPolicy policy, size_t spinCount) const {
+    NotificationType type;
+    switch (policy) {
+        case RunnerWaitPolicy::BLOCKING:
+            type = NotificationType::LRT_WAIT_BLOCKING;
+            break;
+        case RunnerWaitPolicy::SPIN_THEN_PARK:
+            type = NotificationType::LRT_WAIT_SPIN_THEN_PARK;
+            break;
+        case RunnerWaitPolicy::BUSY_POLL:
+            type = NotificationType::LRT_WAIT_BUSY_POLL;
+            break;
+        default:
+            throwSpiderException("unsupported runner wait policy.");
+    }
+    for (size_t i = 0; i < archi::platform()->LRTCount(); ++i) {
+        communicator()->push(Notification{ type, archi::platform()->getGRTIx(), spinCount }, i);
+    }
+}
+
 void spider::RTPlatform::waitForRunnersToFinish() {
     const auto grtIx = archi::platform()->spiderGRTPE()->attachedLRT()->virtualIx();
     auto notifVector = factory::vector<Notification>(StackID::RUNTIME);
@@ -171,6 +197,8 @@ void spider::RTPlatform::waitForRunnersToFinish() {
     }
     /* == Reset values == */
     finishedRunnerArray_.assign(false);
+    /* == Every job is done, grow the recycled messages for the next ones == */
+    communicator()->reserveJobMessages();
 }
 
 void spider::RTPlatform::registerFinishedRunner(size_t ix) {
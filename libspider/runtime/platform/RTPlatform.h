@@ -40,6 +40,8 @@
 #include <containers/array.h>
 #include <containers/vector.h>
 #include <runtime/common/RTKernel.h>
+#include <runtime/common/JobStampTable.h>
+#include <api/global-api.h>
 #include <thread/Thread.h>
 #include <algorithm>
 #include <memory/unique_ptr.h>
@@ -96,11 +98,13 @@ namespace spider {
 
         /**
          * @brief send LRT_CLEAR_ITERATION notification to every runners.
+         * @remark The shared job stamp table (if any) is reset, runners should have finished their iteration.
          */
         void sendClearToRunners() const;
 
         /**
          * @brief send LRT_RST_ITERATION notification to every runners.
+         * @remark The shared job stamp table (if any) is reset, runners should have finished their iteration.
          */
         void sendResetToRunners() const;
 
@@ -116,6 +120,13 @@ namespace spider {
          */
         void sendTraceToRunners(bool value) const;
 
+        /**
+         * @brief Send LRT_WAIT_BLOCKING(SPIN_THEN_PARK, BUSY_POLL) notification to every runners.
+         * @param policy    Wait policy to use when a job is waiting for a job of another runner.
+         * @param spinCount Number of polling iterations before parking (only used with SPIN_THEN_PARK).
+         */
+        void sendWaitPolicyToRunners(RunnerWaitPolicy policy, size_t spinCount) const;
+
         /**
          * @brief Wait for every runners to send the LRT_FINISHED_ITERATION notification.
          */
@@ -156,6 +167,15 @@ namespace spider {
             return communicator_.get();
         }
 
+        /**
+         * @brief Returns the job stamp table shared by the runners.
+         * @return pointer to the @refitem JobStampTable, nullptr if runners do not share memory (in which case
+         *         job stamps are exchanged through JOB_UPDATE_JOBSTAMP notifications).
+         */
+        inline JobStampTable *jobStampTable() const {
+            return jobStampTable_.get();
+        }
+
         /**
          * @brief Returns the vector of runtime kernels of the platform.
          * @return const reference to a spider::vector of pointer of @refitem RTKernel.
@@ -186,6 +206,7 @@ namespace spider {
         array<RTRunner *> runnerArray_;                    /* = Array of RTRunner = */
         array<bool> finishedRunnerArray_;                  /* = Array of registered finished runner */
         unique_ptr<RTCommunicator> communicator_;          /* = Communicator of the RTPlatform = */
+        unique_ptr<JobStampTable> jobStampTable_;          /* = Shared job stamps (only for shared memory platforms) = */
     };
 }
 
@@ -50,6 +50,8 @@ extern bool spider2StopRunning;
 spider::ThreadRTPlatform::ThreadRTPlatform(size_t runnerCount) : RTPlatform(runnerCount),
                                                                  threadArray_{ runnerCount, nullptr,
                                                                                StackID::RUNTIME } {
+    /* == Runners are threads of the same process, they can directly share their job stamps == */
+    jobStampTable_ = spider::make_unique<JobStampTable, StackID::RUNTIME>(runnerCount);
     std::signal(SIGINT, [](int signal) {
         if (signal == SIGINT) {
             spider2StopRunning = true;
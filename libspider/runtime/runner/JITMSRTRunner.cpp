@@ -43,6 +43,7 @@
 #include <archi/Platform.h>
 #include <archi/Cluster.h>
 #include <archi/MemoryInterface.h>
+#include <archi/NUMATopology.h>
 #include <api/config-api.h>
 
 /* === Define(s) === */
@@ -55,6 +56,8 @@
 #define LOG_STOP() \
     if (log::enabled<log::LRT>()) {\
         log::info<log::LRT>("Runner #%zu -> received STOP notification.\n", ix());\
+        log::info<log::LRT>("Runner #%zu -> spin: %" PRIu64 " ns (%" PRIu64 " wake up, %" PRIu64 " from stamps) -- park: %" PRIu64 " ns (%" PRIu64 " wake up).\n",\
+                            ix(), waitStats_.spinTime_, waitStats_.spinWakeCount_, waitStats_.stampWakeCount_, waitStats_.parkTime_, waitStats_.parkCount_);\
     }
 
 #define LOG_JOB_PUSH() \
@@ -64,7 +67,7 @@
         log::print<log::LRT>(log::blue, "INFO", "Runner #%zu -> received jobs:\n", ix());\
         for (size_t i = 0; i < (jobQueue_.size() - currentNumberOfJob); ++i) {\
             log::print<log::LRT>(log::blue, "INFO", "Runner #%zu ->          >> %zu\n", ix(),\
-                    jobQueue_[currentNumberOfJob + i].ix_);\
+                    jobQueue_[currentNumberOfJob + i]->ix_);\
         }\
     }
 
@@ -133,12 +136,12 @@
                     constraint.jobToWait_, constraint.lrtToWait_);\
         }\
         log::print<log::LRT>(log::blue, "INFO", "Runner #%zu -> Input Fifo(s):\n", ix());\
-        for (auto &fifo : job.fifos_->inputFifos()) {\
+        for (auto &fifo : job.fifos_.inputFifos()) {\
             log::print<log::LRT>(log::blue, "INFO", "Runner #%zu -> >> size: %8zu -- address: %8zu -- offset: %8zu\n", ix(), fifo.size_,\
             fifo.address_, fifo.offset_);\
         }\
         log::print<log::LRT>(log::blue, "INFO", "Runner #%zu -> Output Fifo(s):\n", ix());\
-        for (auto &fifo : job.fifos_->outputFifos()) {\
+        for (auto &fifo : job.fifos_.outputFifos()) {\
             log::print<log::LRT>(log::blue, "INFO", "Runner #%zu -> >> size: %8zu -- address: %8zu -- offset: %8zu\n", ix(), fifo.size_,\
             fifo.address_, fifo.offset_);\
         }\
@@ -158,7 +161,11 @@ void spider::JITMSRTRunner::run(bool infiniteLoop) {
     bool waitForJob = false;
     while (run && !stop_) {
         /* == Check for notifications == */
-        auto blockingPop = (infiniteLoop && finished_) || waitForJob;
+        auto blockingPop = infiniteLoop && finished_;
+        if (waitForJob) {
+            waitForNotification(*jobQueue_[jobQueueCurrentPos_]);
+            blockingPop = pause_;
+        }
         while (!stop_ && readNotification(blockingPop)) {
             blockingPop = pause_;
         }
@@ -168,13 +175,18 @@ void spider::JITMSRTRunner::run(bool infiniteLoop) {
         }
         /* == If there is a job available, do it == */
         if (start_ && (jobQueueCurrentPos_ != jobQueue_.size())) {
-            auto &job = jobQueue_[jobQueueCurrentPos_];
+            auto &job = *jobQueue_[jobQueueCurrentPos_];
             waitForJob = !isJobRunnable(job);
             if (!waitForJob) {
                 /* == Run the job == */
                 LOG_JOB_START();
                 runJob(job);
                 lastJobStamp_ = job.execIx_;
+                if (!repeat_) {
+                    /* == The job will not be run again, give the message back as soon as possible == */
+                    rt::platform()->communicator()->release(&job, ix());
+                    jobQueue_[jobQueueCurrentPos_] = nullptr;
+                }
                 jobQueueCurrentPos_++;
                 LOG_JOB_END();
             }
@@ -208,11 +220,18 @@ void spider::JITMSRTRunner::run(bool infiniteLoop) {
 }
 
 void spider::JITMSRTRunner::begin() {
+    const auto *platform = archi::platform();
+    const auto isGRT = attachedPE_ == platform->spiderGRTPE();
     if (affinity_ >= 0) {
         this_thread::set_affinity(affinity_);
+    } else if (!isGRT) {
+        /* == Keep the runner close to the memory of its cluster == */
+        const auto node = attachedPE_->cluster()->memoryInterface()->numaNode();
+        if (node >= 0) {
+            numa::bindThreadToNode(node);
+        }
     }
-    const auto *platform = archi::platform();
-    if (attachedPE_ != platform->spiderGRTPE()) {
+    if (!isGRT) {
         run(true);
     }
 }
@@ -227,13 +246,14 @@ void spider::JITMSRTRunner::runJob(const JobMessage &job) {
         msgMemory.startTime_ = time::now();
     }
     /* == Create input buffers == */
-    auto inputBuffersArray = getInputBuffers(job.fifos_->inputFifos(), attachedPE_->cluster()->memoryInterface());
+    getInputBuffers(job.fifos_.inputFifos(), attachedPE_->cluster()->memoryInterface(), inputBuffers_);
 
     /* == Create output buffers == */
-    auto outputBuffersArray = getOutputBuffers(job.fifos_->outputFifos(), attachedPE_->cluster()->memoryInterface());
+    getOutputBuffers(job.fifos_.outputFifos(), attachedPE_->cluster()->memoryInterface(), outputBuffers_);
 
-    /* == Allocate output parameter memory == */
-    array<int64_t> outputParams{ static_cast<size_t>(job.nParamsOut_), 0, StackID::RUNTIME };
+    /* == Reset output parameter memory == */
+    auto &outputParams = paramMessage_.params_;
+    outputParams.assign(static_cast<size_t>(job.nParamsOut_), 0);
     if (trace_) {
         msgMemory.endTime_ = time::now();
         auto *communicator = rt::platform()->communicator();
@@ -249,7 +269,7 @@ void spider::JITMSRTRunner::runJob(const JobMessage &job) {
             msgExec.taskIx_ = job.taskIx_;
             msgExec.startTime_ = time::now();
         }
-        (*kernel)(job.inputParams_.get(), outputParams.data(), inputBuffersArray.data(), outputBuffersArray.data());
+        (*kernel)(job.inputParams_.data(), outputParams.data(), inputBuffers_.data(), outputBuffers_.data());
         if (trace_) {
             msgExec.endTime_ = time::now();
             auto *communicator = rt::platform()->communicator();
@@ -259,26 +279,26 @@ void spider::JITMSRTRunner::runJob(const JobMessage &job) {
     }
 
     /* == Deallocate input buffers == */
-    for (auto &fifo : job.fifos_->inputFifos()) {
+    for (auto &fifo : job.fifos_.inputFifos()) {
         if (fifo.attribute_ == FifoAttribute::RW_OWN || fifo.attribute_ == FifoAttribute::R_MERGE) {
-            auto *memoryInterface = attachedPE_->cluster()->memoryInterface();
+            auto *memoryInterface = getFifoMemoryInterface(fifo, attachedPE_->cluster()->memoryInterface());
             memoryInterface->deallocate(fifo.address_, fifo.size_);
         }
     }
     /* == Deallocate output buffers (only buffers to sinks) == */
-    for (auto &fifo : job.fifos_->outputFifos()) {
+    for (auto &fifo : job.fifos_.outputFifos()) {
         if (fifo.attribute_ == FifoAttribute::W_SINK) {
-            auto *memoryInterface = attachedPE_->cluster()->memoryInterface();
+            auto *memoryInterface = getFifoMemoryInterface(fifo, attachedPE_->cluster()->memoryInterface());
             memoryInterface->deallocate(fifo.address_, fifo.size_);
         }
     }
 
     /* == Notify other runtimes that need to know == */
     updateJobStamp(ix(), job.execIx_);
-    sendJobStampNotification(job.synchronizationFlags_.get(), job.execIx_);
+    sendJobStampNotification(job.notificationFlags(), job.execIx_);
 
     /* == Send output parameters == */
-    sendParameters(job.taskIx_, outputParams);
+    sendParameters(job.taskIx_);
 
     /* == Send traces == */
 }
@@ -287,12 +307,22 @@ bool spider::JITMSRTRunner::isJobRunnable(const JobMessage &job) const {
     for (const auto &constraint : job.execConstraints_) {
         const auto runner2WaitIx = constraint.lrtToWait_;
         const auto job2Wait = constraint.jobToWait_;
-        const auto localJobStamp = localJobStampsArray_[runner2WaitIx];
+        auto localJobStamp = jobStampTable_ ? jobStampTable_->get(runner2WaitIx) : localJobStampsArray_[runner2WaitIx];
         if ((localJobStamp == SIZE_MAX) || (localJobStamp < job2Wait)) {
             if (runner2WaitIx == ix()) {
                 LOG_STATUS_ERROR();
                 throwSpiderException("Runner #%zu -> bad job ix.", ix());
             }
+            if (jobStampTable_ && (waitPolicy_ != RunnerWaitPolicy::BUSY_POLL)) {
+                /* == Register as waiting, then check again in case the stamp was updated in between == */
+                /* == (busy polling runners poll the table instead of waiting for a notification) == */
+                jobStampTable_->setWaiting(ix(), runner2WaitIx, job2Wait);
+                localJobStamp = jobStampTable_->get(runner2WaitIx);
+                if ((localJobStamp != SIZE_MAX) && (localJobStamp >= job2Wait)) {
+                    jobStampTable_->setWaiting(ix(), SIZE_MAX, SIZE_MAX);
+                    continue;
+                }
+            }
             LOG_STATUS();
             return false;
         }
@@ -312,6 +342,8 @@ bool spider::JITMSRTRunner::readNotification(bool blocking) {
     switch (notification.type_) {
         case NotificationType::LRT_START_ITERATION:
             if (finished_) {
+                /* == Place the reserved pages of the pool of the cluster on the node of its runners == */
+                attachedPE_->cluster()->memoryInterface()->firstTouch();
                 start_ = true;
                 finished_ = false;
                 jobCount_ = 0;
@@ -356,6 +388,16 @@ bool spider::JITMSRTRunner::readNotification(bool blocking) {
         case NotificationType::LRT_RESUME:
             pause_ = false;
             break;
+        case NotificationType::LRT_WAIT_BLOCKING:
+            waitPolicy_ = RunnerWaitPolicy::BLOCKING;
+            break;
+        case NotificationType::LRT_WAIT_SPIN_THEN_PARK:
+            waitPolicy_ = RunnerWaitPolicy::SPIN_THEN_PARK;
+            spinCount_ = notification.notificationIx_;
+            break;
+        case NotificationType::LRT_WAIT_BUSY_POLL:
+            waitPolicy_ = RunnerWaitPolicy::BUSY_POLL;
+            break;
         case NotificationType::TRACE_ENABLE:
             trace_ = true;
             break;
@@ -363,10 +405,16 @@ bool spider::JITMSRTRunner::readNotification(bool blocking) {
             trace_ = false;
             break;
         case NotificationType::JOB_ADD: {
-            JobMessage message;
+            JobMessage *message = nullptr;
             rt::platform()->communicator()->pop(message, ix(), notification.notificationIx_);
-            if (start_) {
-                jobQueue_.emplace_back(std::move(message));
+            while (message) {
+                auto *next = message->next_;
+                if (start_) {
+                    jobQueue_.emplace_back(message);
+                } else {
+                    rt::platform()->communicator()->release(message, ix());
+                }
+                message = next;
             }
         }
             break;
@@ -407,6 +455,43 @@ bool spider::JITMSRTRunner::readNotification(bool blocking) {
     return true;
 }
 
+bool spider::JITMSRTRunner::isJobStampReached(const JobMessage &job) const {
+    for (const auto &constraint : job.execConstraints_) {
+        const auto jobStamp = jobStampTable_->get(constraint.lrtToWait_);
+        if ((jobStamp == SIZE_MAX) || (jobStamp < constraint.jobToWait_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void spider::JITMSRTRunner::waitForNotification(const JobMessage &job) {
+    if (waitPolicy_ != RunnerWaitPolicy::BLOCKING) {
+        const auto spinStart = time::now();
+        const auto busyPoll = waitPolicy_ == RunnerWaitPolicy::BUSY_POLL;
+        for (size_t i = 0; busyPoll || (i < spinCount_); ++i) {
+            if (readNotification(false)) {
+                waitStats_.spinTime_ += static_cast<u64>(time::duration::nanoseconds(spinStart, time::now()));
+                waitStats_.spinWakeCount_++;
+                return;
+            }
+            if (jobStampTable_ && isJobStampReached(job)) {
+                /* == No need to be woken up anymore == */
+                jobStampTable_->setWaiting(ix(), SIZE_MAX, SIZE_MAX);
+                waitStats_.spinTime_ += static_cast<u64>(time::duration::nanoseconds(spinStart, time::now()));
+                waitStats_.stampWakeCount_++;
+                return;
+            }
+            this_thread::relax();
+        }
+        waitStats_.spinTime_ += static_cast<u64>(time::duration::nanoseconds(spinStart, time::now()));
+    }
+    const auto parkStart = time::now();
+    readNotification(true);
+    waitStats_.parkTime_ += static_cast<u64>(time::duration::nanoseconds(parkStart, time::now()));
+    waitStats_.parkCount_++;
+}
+
 void spider::JITMSRTRunner::updateJobStamp(size_t lrtIx, size_t jobStampValue) {
     if (localJobStampsArray_.at(lrtIx) == SIZE_MAX ||
         (localJobStampsArray_[lrtIx] < jobStampValue)) {
@@ -47,9 +47,10 @@ namespace spider {
     class JITMSRTRunner final : public RTRunner {
     public:
 
-        JITMSRTRunner(PE *attachedPE, size_t runnerIx, int32_t affinity = -1) : RTRunner(attachedPE,
-                                                                                         runnerIx,
-                                                                                         affinity) { }
+        JITMSRTRunner(PE *attachedPE, size_t runnerIx, int32_t affinity = -1) :
+                RTRunner(attachedPE, runnerIx, affinity),
+                inputBuffers_{ factory::vector<void *>(StackID::RUNTIME) },
+                outputBuffers_{ factory::vector<void *>(StackID::RUNTIME) } { }
 
         ~JITMSRTRunner() override = default;
 
@@ -69,6 +70,8 @@ namespace spider {
         /* === Setter(s) === */
 
     private:
+        spider::vector<void *> inputBuffers_;  /* = Input buffers of the running job (capacity is kept between jobs) = */
+        spider::vector<void *> outputBuffers_; /* = Output buffers of the running job (capacity is kept between jobs) = */
         size_t jobCount_ = 0;
         bool shouldBroadcast_ = false;
 
@@ -92,6 +95,23 @@ namespace spider {
          */
         bool readNotification(bool blocking);
 
+        /**
+         * @brief Checks in the job stamp table if the dependencies of a job are met, without registering as waiting.
+         * @param job  Job to evaluate.
+         * @return true if every job stamp waited by the job has been published, false else.
+         */
+        bool isJobStampReached(const JobMessage &job) const;
+
+        /**
+         * @brief Wait for at least one notification, or for the dependencies of the current job to be met, when the
+         *        current job is waiting for a job of another runner.
+         * @remark Depending on the wait policy, the queue (and the job stamp table if the platform shares one) is
+         *         first polled (with a processor pause between two tries) for the spin budget (forever with
+         *         BUSY_POLL) before parking. Time spent is added to the wait stats.
+         * @param job  Job waiting for its dependencies.
+         */
+        void waitForNotification(const JobMessage &job);
+
         /**
          * @brief Update the local job stamp value of a given runner.
          * @param lrtIx          Ix of the local runtime to update.
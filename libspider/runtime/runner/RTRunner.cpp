@@ -58,7 +58,7 @@
 /* === Function(s) definition === */
 
 spider::RTRunner::RTRunner(PE *attachedPe, size_t runnerIx, i32 affinity) : jobQueue_{
-        factory::vector<JobMessage>(StackID::RUNTIME) },
+        factory::vector<JobMessage *>(StackID::RUNTIME) },
                                                                             localJobStampsArray_{ array < size_t >
                                                                                                   { archi::platform()->LRTCount(),
                                                                                                     SIZE_MAX,
@@ -66,6 +66,9 @@ spider::RTRunner::RTRunner(PE *attachedPe, size_t runnerIx, i32 affinity) : jobQ
                                                                             attachedPE_{ attachedPe },
                                                                             runnerIx_{ runnerIx },
                                                                             affinity_{ affinity } {
+    if (rt::platform()) {
+        jobStampTable_ = rt::platform()->jobStampTable();
+    }
     if (api::exportTraceEnabled()) {
         trace_ = true;
     }
@@ -76,12 +79,16 @@ void spider::RTRunner::clearLocalJobStamps() {
 }
 
 void spider::RTRunner::clearJobQueue() {
+    auto *communicator = rt::platform()->communicator();
+    for (auto *message : jobQueue_) {
+        communicator->release(message, ix());
+    }
     jobQueueCurrentPos_ = 0;
     jobQueue_.clear();
 }
 
 void spider::RTRunner::broadcastCurrentJobStamp() const {
-    if (lastJobStamp_ != SIZE_MAX) {
+    if (!jobStampTable_ && (lastJobStamp_ != SIZE_MAX)) {
         Notification broadcastNotification{ NotificationType::JOB_UPDATE_JOBSTAMP,
                                             ix(),
                                             lastJobStamp_ };
@@ -105,7 +112,20 @@ void spider::RTRunner::sendFinishedNotification() const {
 }
 
 void spider::RTRunner::sendJobStampNotification(bool *notificationFlags, size_t jobIx) const {
-    if (jobIx == SIZE_MAX || !notificationFlags) {
+    if (jobIx == SIZE_MAX) {
+        return;
+    }
+    if (jobStampTable_) {
+        jobStampTable_->set(ix(), jobIx);
+        /* == Only wake up the runners waiting on us == */
+        jobStampTable_->releaseWaiting(ix(), jobIx, [this, jobIx](size_t lrtIx) {
+            rt::platform()->communicator()->push(Notification{ NotificationType::JOB_UPDATE_JOBSTAMP, ix(), jobIx },
+                                                 lrtIx);
+            LOG_NOTIFY();
+        });
+        return;
+    }
+    if (!notificationFlags) {
         return;
     }
     size_t lrtIx = 0;
@@ -119,11 +139,11 @@ void spider::RTRunner::sendJobStampNotification(bool *notificationFlags, size_t
     }
 }
 
-void spider::RTRunner::sendParameters(size_t vertexIx, array<int64_t> &parameters) const {
-    if (!parameters.empty()) {
+void spider::RTRunner::sendParameters(size_t vertexIx) {
+    if (!paramMessage_.params_.empty()) {
         const auto *spiderGRT = archi::platform()->spiderGRTPE()->attachedLRT();
-        auto paramMessage = ParameterMessage(vertexIx, std::move(parameters));
-        auto index = rt::platform()->communicator()->push(std::move(paramMessage), spiderGRT->virtualIx());
+        paramMessage_.taskIx_ = vertexIx;
+        auto index = rt::platform()->communicator()->push(paramMessage_, spiderGRT->virtualIx());
         rt::platform()->communicator()->pushParamNotification(attachedPE_->virtualIx(), index);
     }
 }
@@ -41,6 +41,7 @@
 #include <containers/vector.h>
 #include <runtime/message/Message.h>
 #include <runtime/message/JobMessage.h>
+#include <api/global-api.h>
 
 namespace spider {
 
@@ -48,6 +49,21 @@ namespace spider {
 
     class PE;
 
+    class JobStampTable;
+
+    /* === Structure(s) definition === */
+
+    /**
+     * @brief Statistics of a runner on the time spent waiting for jobs of other runners.
+     */
+    struct RunnerWaitStats {
+        u64 spinTime_ = 0;      /*!< Time spent polling the notification queue (in ns) */
+        u64 parkTime_ = 0;      /*!< Time spent parked on the notification queue (in ns) */
+        u64 spinWakeCount_ = 0; /*!< Number of waits ended by a notification while polling */
+        u64 stampWakeCount_ = 0; /*!< Number of waits ended by polling the job stamp table */
+        u64 parkCount_ = 0;     /*!< Number of waits that ended up parked */
+    };
+
     /* === Class definition === */
 
     class RTRunner {
@@ -85,9 +101,22 @@ namespace spider {
             return attachedPE_;
         }
 
+        /**
+         * @brief Get the statistics on the time spent waiting for jobs of other runners.
+         * @warning Values are only consistent when the runner is not running any iteration.
+         * @return const reference to the @refitem RunnerWaitStats of the runner.
+         */
+        inline const RunnerWaitStats &waitStats() const {
+            return waitStats_;
+        }
+
     protected:
-        vector<JobMessage> jobQueue_;
+        vector<JobMessage *> jobQueue_;
         array<size_t> localJobStampsArray_;
+        JobStampTable *jobStampTable_{ nullptr };
+        RunnerWaitStats waitStats_;
+        ParameterMessage paramMessage_; /* = Output parameters of the running job (capacity is kept between jobs) = */
+        size_t spinCount_{ 0 };
         PE *attachedPE_{ nullptr };
         size_t runnerIx_{ SIZE_MAX };
         size_t jobQueueCurrentPos_{ 0 };
@@ -100,6 +129,7 @@ namespace spider {
         bool pause_{ false };
         bool trace_{ false };
         bool repeat_{ false };
+        RunnerWaitPolicy waitPolicy_{ RunnerWaitPolicy::BLOCKING };
 
         /**
          * @brief Clear all the local copies of other LRT job stamps.
@@ -107,12 +137,13 @@ namespace spider {
         void clearLocalJobStamps();
 
         /**
-         * @brief Clear job queue.
+         * @brief Clear job queue and give back the remaining messages to the communicator.
          */
         void clearJobQueue();
 
         /**
          * @brief Broadcast current job stamp to every other LRT.
+         * @remark Nothing is sent if the job stamps are shared through a @refitem JobStampTable.
          */
         void broadcastCurrentJobStamp() const;
 
@@ -123,17 +154,18 @@ namespace spider {
 
         /**
          * @brief Send notification with last achieved job to lrt that need to know.
+         * @remark If the job stamps are shared through a @refitem JobStampTable, the stamp is published in the table
+         *         and only the LRTs currently waiting on it are notified (notificationFlags are then ignored).
          * @param notificationFlags  Array of notification flags.
          * @param jobIx              Ix of the job to send.
          */
         void sendJobStampNotification(bool *notificationFlags, size_t jobIx) const;
 
         /**
-         * @brief Send notification with produced parameters.
-         * @param parameters Array of parameter values to send.
+         * @brief Send notification with the parameters produced in paramMessage_.
          * @param vertexIx   Ix of the vertex which produced the parameter values.
          */
-        void sendParameters(size_t vertexIx, array<int64_t> &parameters) const;
+        void sendParameters(size_t vertexIx);
     };
 }
 
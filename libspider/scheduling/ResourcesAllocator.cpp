@@ -49,8 +49,11 @@
 
 #include <scheduling/scheduler/pisdf-based/PiSDFGreedyScheduler.h>
 #include <scheduling/scheduler/pisdf-based/PiSDFListScheduler.h>
+#include <scheduling/scheduler/pisdf-based/PiSDFHEFTScheduler.h>
 #include <scheduling/mapper/BestFitMapper.h>
 #include <scheduling/mapper/RoundRobinMapper.h>
+#include <scheduling/mapper/InsertionMapper.h>
+#include <scheduling/mapper/LookaheadMapper.h>
 #include <scheduling/memory/pisdf-based/PiSDFFifoAllocator.h>
 #include <scheduling/launcher/TaskLauncher.h>
 #include <scheduling/task/PiSDFTask.h>
@@ -85,15 +88,25 @@ spider::sched::ResourcesAllocator::ResourcesAllocator(SchedulingPolicy schedulin
                                                       MappingPolicy mappingPolicy,
                                                       ExecutionPolicy executionPolicy,
                                                       FifoAllocatorType allocatorType,
-                                                      bool legacy) :
+                                                      bool legacy,
+                                                      size_t cacheCapacity) :
         scheduler_{ spider::make_unique(allocateScheduler(schedulingPolicy, legacy)) },
         mapper_{ spider::make_unique(allocateMapper(mappingPolicy)) },
-        schedule_{ spider::make_unique<Schedule, StackID::SCHEDULE>() },
+        schedule_{ spider::make_unique<Schedule, StackID::GENERAL>() },
         allocator_{ spider::make_unique(allocateAllocator(allocatorType, legacy)) },
         executionPolicy_{ executionPolicy } {
+    if (cacheCapacity && !legacy) {
+        cache_ = spider::make_unique<ScheduleCache, StackID::RUNTIME>(cacheCapacity);
+    }
+    if (mappingPolicy == MappingPolicy::INSERTION && executionPolicy != ExecutionPolicy::DELAYED) {
+        throwSpiderException("INSERTION mapping policy can only be used with the DELAYED execution policy.");
+    }
     if (allocator_) {
         checkFifoAllocatorTraits(allocator_.get(), executionPolicy);
         allocator_->setSchedule(schedule_.get());
+        allocator_->setScheduleCache(cache_.get());
+        /* == Consumers co-located with the buffer placed by the allocator do not need a copy == */
+        mapper_->setFifoAllocator(allocator_.get());
     }
 }
 
@@ -110,6 +123,13 @@ void spider::sched::ResourcesAllocator::execute(const srdag::Graph *graph) {
 #endif
 
 void spider::sched::ResourcesAllocator::execute(pisdf::GraphHandler *graphHandler) {
+    if (cache_ && cache_->active()) {
+        /* == On hit, the jobs of the round were sent by the cache == */
+        if (cache_->replay()) {
+            return;
+        }
+        restore(graphHandler);
+    }
     /* == Schedule the graph == */
     const auto currentSize = schedule_->size();
     scheduler_->schedule(graphHandler, schedule_.get());
@@ -117,32 +137,77 @@ void spider::sched::ResourcesAllocator::execute(pisdf::GraphHandler *graphHandle
     execute<PiSDFTask>(currentSize);
 }
 
+#ifndef _NO_BUILD_LEGACY_RT
+
+void spider::sched::ResourcesAllocator::prepare(const srdag::Graph *graph) {
+    if (executionPolicy_ != ExecutionPolicy::DELAYED) {
+        throwSpiderException("tasks can only be prepared with the DELAYED execution policy.");
+    }
+    preparedOffset_ = schedule_->size();
+    scheduler_->schedule(graph, schedule_.get());
+    mapTasks<SRDAGTask>(preparedOffset_);
+}
+
+#endif
+
+void spider::sched::ResourcesAllocator::prepare(pisdf::GraphHandler *graphHandler) {
+    if (executionPolicy_ != ExecutionPolicy::DELAYED) {
+        throwSpiderException("tasks can only be prepared with the DELAYED execution policy.");
+    }
+    preparedOffset_ = schedule_->size();
+    scheduler_->schedule(graphHandler, schedule_.get());
+    mapTasks<PiSDFTask>(preparedOffset_);
+}
+
+void spider::sched::ResourcesAllocator::send() {
+    if (!prepared()) {
+        return;
+    }
+    allocator_->updateDynamicBuffersCount();
+    sendTasks(preparedOffset_);
+    preparedOffset_ = SIZE_MAX;
+}
+
 void spider::sched::ResourcesAllocator::clear() {
+    preparedOffset_ = SIZE_MAX;
+    allocator_->reserveRegion();
     allocator_->clear();
     schedule_->clear();
     scheduler_->clear();
+    mapper_->clear();
 }
 
 /* === Private method(s) implementation === */
 
+void spider::sched::ResourcesAllocator::restore(pisdf::GraphHandler *graphHandler) {
+    cache_->setMuted(true);
+    for (size_t round = 0; round < cache_->restoreCount(); ++round) {
+        const auto currentSize = schedule_->size();
+        scheduler_->schedule(graphHandler, schedule_.get());
+        execute<PiSDFTask>(currentSize);
+        cache_->restoreParams(round, schedule_.get());
+    }
+    cache_->setMuted(false);
+}
+
 template<class T>
 void spider::sched::ResourcesAllocator::execute(size_t offset) {
-    mapper_->setStartTime(computeMinStartTime());
     allocator_->updateDynamicBuffersCount();
-    auto launcher = TaskLauncher{ schedule_.get(), allocator_.get() };
     switch (executionPolicy_) {
         case ExecutionPolicy::JIT: {
+            mapper_->setStartTime(computeMinStartTime());
+            auto launcher = TaskLauncher{ schedule_.get(), allocator_.get(), cache_.get() };
             auto size = schedule_->size();
             for (auto i = offset; i < size; ++i) {
-                auto *task = static_cast<T *>(schedule_->task(i));
+                auto *task = static_cast<T *>(schedule_->walk(i));
                 /* == Map the task == */
                 mapper_->map(task, schedule_.get());
                 /* == Check for synchronization == */
                 const auto delta = schedule_->size() - size;
                 if (delta) {
                     /* == We added synchronization == */
-                    for (auto j = i; j < i + delta; ++i) {
-                        auto *syncTask = schedule_->task(i);
+                    for (auto j = i; j < i + delta; ++j) {
+                        auto *syncTask = schedule_->task(j);
                         syncTask->visit(&launcher);
                     }
                     i += delta;
@@ -150,27 +215,15 @@ void spider::sched::ResourcesAllocator::execute(size_t offset) {
                 }
                 /* == Send the task == */
                 task->visit(&launcher);
+                launcher.flush();
                 /* == Update min start time of the mapping process == */
                 mapper_->setStartTime(computeMinStartTime());
             }
         }
             break;
-        case ExecutionPolicy::DELAYED: {
-            auto size = schedule_->size();
-            for (auto i = offset; i < size; ++i) {
-                auto *task = static_cast<T *>(schedule_->task(i));
-                /* == Map the task == */
-                mapper_->map(task, schedule_.get());
-                /* == Update min start time of the mapping process == */
-                mapper_->setStartTime(computeMinStartTime());
-            }
-            size = schedule_->size(); /* == in case communications were added, size will have changed == */
-            for (auto i = offset; i < size; ++i) {
-                /* == Send the task == */
-                auto *task = schedule_->task(i);
-                task->visit(&launcher);
-            }
-        }
+        case ExecutionPolicy::DELAYED:
+            mapTasks<T>(offset);
+            sendTasks(offset);
             break;
         default:
             throwSpiderException("unexpected execution policy.");
@@ -178,28 +231,65 @@ void spider::sched::ResourcesAllocator::execute(size_t offset) {
 
 }
 
+template<class T>
+void spider::sched::ResourcesAllocator::mapTasks(size_t offset) {
+    mapper_->setStartTime(computeMinStartTime());
+    auto size = schedule_->size();
+    for (auto i = offset; i < size; ++i) {
+        auto *task = static_cast<T *>(schedule_->walk(i));
+        /* == Map the task == */
+        mapper_->map(task, schedule_.get());
+        /* == Skip the synchronization tasks inserted before the task == */
+        const auto delta = schedule_->size() - size;
+        i += delta;
+        size += delta;
+        /* == Update min start time of the mapping process == */
+        mapper_->setStartTime(computeMinStartTime());
+    }
+    mapper_->commit(schedule_.get(), offset);
+}
+
+void spider::sched::ResourcesAllocator::sendTasks(size_t offset) {
+    auto launcher = TaskLauncher{ schedule_.get(), allocator_.get(), cache_.get() };
+    /* == in case communications were added, size and indexes will have changed since the mapping == */
+    schedule_->updateIndexes();
+    const auto size = schedule_->size();
+    for (auto i = offset; i < size; ++i) {
+        /* == Send the task == */
+        auto *task = schedule_->task(i);
+        task->visit(&launcher);
+    }
+    /* == Send the remaining batch of jobs == */
+    launcher.flush();
+}
+
 spider::sched::Scheduler *
 spider::sched::ResourcesAllocator::allocateScheduler(SchedulingPolicy policy, bool legacy) {
     switch (policy) {
         case SchedulingPolicy::LIST:
             if (legacy) {
 #ifndef _NO_BUILD_LEGACY_RT
-                return spider::make<sched::ListScheduler, StackID::SCHEDULE>();
+                return spider::make<sched::ListScheduler, StackID::GENERAL>();
 #else
                 return nullptr;
 #endif
             }
-            return spider::make<sched::PiSDFListScheduler, StackID::SCHEDULE>();
+            return spider::make<sched::PiSDFListScheduler, StackID::GENERAL>();
         case SchedulingPolicy::GREEDY:
             if (legacy) {
 #ifndef _NO_BUILD_LEGACY_RT
-                return spider::make<sched::GreedyScheduler, StackID::SCHEDULE>();
+                return spider::make<sched::GreedyScheduler, StackID::GENERAL>();
 #else
                 return nullptr;
 #endif
             } else {
-                return spider::make<sched::PiSDFGreedyScheduler, StackID::SCHEDULE>();
+                return spider::make<sched::PiSDFGreedyScheduler, StackID::GENERAL>();
             }
+        case SchedulingPolicy::HEFT:
+            if (legacy) {
+                throwSpiderException("HEFT scheduling policy is not supported by the SRDAG based runtime.");
+            }
+            return spider::make<sched::PiSDFHEFTScheduler, StackID::GENERAL>();
         default:
             throwSpiderException("unsupported scheduling policy.");
     }
@@ -230,7 +320,19 @@ spider::sched::ResourcesAllocator::allocateAllocator(FifoAllocatorType type, boo
                                      "Rebuild the Spider 2.0 library with the cmake flag -DBUILD_LEGACY_RUNTIME=ON.\n");
             return nullptr;
 #endif
+        case spider::FifoAllocatorType::LIFETIME_AWARE:
         case spider::FifoAllocatorType::ARCHI_AWARE:
+            if (!legacy) {
+                return spider::make<spider::sched::PiSDFFifoAllocator, StackID::RUNTIME>(type);
+            }
+#ifndef _NO_BUILD_LEGACY_RT
+            return spider::make<spider::sched::SRDAGFifoAllocator, StackID::RUNTIME>(type);
+#else
+            printer::fprintf(stderr, "Lifetime / architecture aware allocators are part of the legacy runtime which "
+                                     "was not built.\n"
+                                     "Rebuild the Spider 2.0 library with the cmake flag -DBUILD_LEGACY_RUNTIME=ON.\n");
+            return nullptr;
+#endif
         default:
             throwSpiderException("unsupported type of FifoAllocator.");
     }
@@ -239,9 +341,13 @@ spider::sched::ResourcesAllocator::allocateAllocator(FifoAllocatorType type, boo
 spider::sched::Mapper *spider::sched::ResourcesAllocator::allocateMapper(MappingPolicy policy) {
     switch (policy) {
         case MappingPolicy::BEST_FIT:
-            return spider::make<sched::BestFitMapper, StackID::SCHEDULE>();
+            return spider::make<sched::BestFitMapper, StackID::GENERAL>();
         case MappingPolicy::ROUND_ROBIN:
-            return spider::make<sched::RoundRobinMapper, StackID::SCHEDULE>();
+            return spider::make<sched::RoundRobinMapper, StackID::GENERAL>();
+        case MappingPolicy::INSERTION:
+            return spider::make<sched::InsertionMapper, StackID::GENERAL>();
+        case MappingPolicy::LOOKAHEAD:
+            return spider::make<sched::LookaheadMapper, StackID::GENERAL>();
         default:
             throwSpiderException("unsupported mapping policy.");
     }
@@ -41,6 +41,7 @@
 #include <scheduling/schedule/Schedule.h>
 #include <scheduling/scheduler/Scheduler.h>
 #include <scheduling/mapper/Mapper.h>
+#include <scheduling/schedule/ScheduleCache.h>
 #include <global-api.h>
 
 namespace spider {
@@ -61,11 +62,22 @@ namespace spider {
 
         class ResourcesAllocator final {
         public:
+            /**
+             * @brief Constructor.
+             * @param schedulingPolicy   Scheduling policy to use.
+             * @param mappingPolicy      Mapping policy to use.
+             * @param executionPolicy    Execution policy to use.
+             * @param allocatorType      Fifo allocator type to use.
+             * @param legacy             Flag indicating if we are using the legacy intermediate representation.
+             * @param cacheCapacity      Number of graph iterations kept by the schedule cache, 0 to disable it
+             *                           (ignored with the legacy representation).
+             */
             explicit ResourcesAllocator(SchedulingPolicy schedulingPolicy,
                                         MappingPolicy mappingPolicy,
                                         ExecutionPolicy executionPolicy,
                                         FifoAllocatorType allocatorType,
-                                        bool legacy);
+                                        bool legacy,
+                                        size_t cacheCapacity = 0);
 
             ~ResourcesAllocator() noexcept = default;
 
@@ -77,8 +89,38 @@ namespace spider {
 
 #endif
 
+            /**
+             * @brief Schedule, map and send the tasks of the graph that can be resolved.
+             * @remark If the schedule cache is active and holds a matching round, its jobs are sent instead.
+             * @param graphHandler Pointer to the graph handler.
+             */
             void execute(pisdf::GraphHandler *graphHandler);
 
+#ifndef _NO_BUILD_LEGACY_RT
+
+            /**
+             * @brief Schedule and map the graph without sending any job (see @refitem ResourcesAllocator::send).
+             * @remark Only available with ExecutionPolicy::DELAYED.
+             * @param graph Pointer to the graph.
+             * @throws spider::Exception if execution policy is not DELAYED.
+             */
+            void prepare(const srdag::Graph *graph);
+
+#endif
+
+            /**
+             * @brief Schedule and map the graph without sending any job (see @refitem ResourcesAllocator::send).
+             * @remark Only available with ExecutionPolicy::DELAYED.
+             * @param graphHandler Pointer to the graph handler.
+             * @throws spider::Exception if execution policy is not DELAYED.
+             */
+            void prepare(pisdf::GraphHandler *graphHandler);
+
+            /**
+             * @brief Allocate and send the jobs of the tasks prepared by the last call to prepare.
+             */
+            void send();
+
             void clear();
 
             /* === Getter(s) === */
@@ -91,6 +133,18 @@ namespace spider {
 
             inline FifoAllocator *allocator() const noexcept { return allocator_.get(); }
 
+            /**
+             * @brief Get the schedule cache.
+             * @return pointer to the cache, nullptr if disabled.
+             */
+            inline ScheduleCache *scheduleCache() const noexcept { return cache_.get(); }
+
+            /**
+             * @brief Check if tasks were prepared and are waiting to be sent.
+             * @return true if send has to be called, false else.
+             */
+            inline bool prepared() const noexcept { return preparedOffset_ != SIZE_MAX; }
+
             /* === Setter(s) === */
 
         private:
@@ -98,6 +152,8 @@ namespace spider {
             spider::unique_ptr<Mapper> mapper_;
             spider::unique_ptr<Schedule> schedule_;
             spider::unique_ptr<FifoAllocator> allocator_;
+            spider::unique_ptr<ScheduleCache> cache_;
+            size_t preparedOffset_ = SIZE_MAX;
             ExecutionPolicy executionPolicy_;
 
             /* === Private method(s) === */
@@ -105,6 +161,27 @@ namespace spider {
             template<class T>
             void execute(size_t offset);
 
+            /**
+             * @brief Rebuild, without sending anything, the rounds of the current iteration replayed by the cache.
+             * @remark This brings the schedule and the graph back to the state they would have had without the
+             *         cache, before scheduling the first round that missed.
+             * @param graphHandler Pointer to the graph handler.
+             */
+            void restore(pisdf::GraphHandler *graphHandler);
+
+            /**
+             * @brief Map every task of the schedule starting from a given offset.
+             * @param offset Index of the first task to map.
+             */
+            template<class T>
+            void mapTasks(size_t offset);
+
+            /**
+             * @brief Allocate and send every task of the schedule starting from a given offset.
+             * @param offset Index of the first task to send.
+             */
+            void sendTasks(size_t offset);
+
             /**
              * @brief Allocates the scheduler corresponding to the given policy.
              * @param policy  Scheduling policy to use.
@@ -38,6 +38,7 @@
 #include <scheduling/task/PiSDFTask.h>
 #include <scheduling/task/SyncTask.h>
 #include <scheduling/memory/FifoAllocator.h>
+#include <scheduling/schedule/ScheduleCache.h>
 #include <graphs-tools/helper/pisdf-helper.h>
 #include <graphs-tools/transformation/pisdf/GraphFiring.h>
 #include <graphs-tools/numerical/detail/dependenciesImpl.h>
@@ -61,6 +62,17 @@
 #endif
 /* === Static function === */
 
+/**
+ * @brief Build the fifo of the copy of the part of a buffer read through a given fifo.
+ * @remark Copies are keyed by the virtual address of the part they hold, copies of the same part made for several
+ *         consumers of a cluster share their memory.
+ * @param fifo Fifo reading the original buffer.
+ * @return fifo of the copy in the memory interface of the job.
+ */
+static spider::Fifo makeCopyFifo(const spider::Fifo &fifo) {
+    return spider::Fifo{ fifo.address_ + fifo.offset_, fifo.size_, 0u, 1, spider::FifoAttribute::W_SHARED };
+}
+
 /* === Method(s) implementation === */
 
 #ifndef _NO_BUILD_LEGACY_RT
@@ -69,17 +81,17 @@ void spider::sched::TaskLauncher::visit(SRDAGTask *task) {
     if (task->state() != TaskState::READY) {
         return;
     }
-    JobMessage message{ };
+    auto *message = rt::platform()->communicator()->acquireJobMessage();
     /* == Setting core properties == */
     const auto *vertex = task->vertex();
-    message.nParamsOut_ = static_cast<u32>(vertex->reference()->outputParamCount());
-    message.kernelIx_ = static_cast<u32>(vertex->runtimeInformation()->kernelIx());
+    message->nParamsOut_ = static_cast<u32>(vertex->reference()->outputParamCount());
+    message->kernelIx_ = static_cast<u32>(vertex->runtimeInformation()->kernelIx());
     /* == Set the synchronization flags == */
-    message.synchronizationFlags_ = buildJobNotificationFlags(task);
+    buildJobNotificationFlags(message, task);
     /* == Set Fifos == */
-    message.fifos_ = allocator_->buildJobFifos(task);
+    allocator_->buildJobFifos(task, message->fifos_);
     /* == Set input params == */
-    message.inputParams_ = srdag::buildVertexRuntimeInputParameters(vertex);
+    srdag::buildVertexRuntimeInputParameters(vertex, message->inputParams_);
     /* == Send the job == */
     sendTask(task, message);
 }
@@ -90,8 +102,20 @@ void spider::sched::TaskLauncher::visit(SyncTask *task) {
     if (task->state() != TaskState::READY) {
         return;
     }
+    if (task->syncType() == SyncType::SEND) {
+        /* == Send tasks are sent along with their receive task == */
+        return;
+    }
     /* == Push task for later purpose == */
-    deferedSyncTasks_.push_back({ task, task->nextTask(0, nullptr)->ix() });
+    const auto entryIx = static_cast<u32>(deferedSyncTasks_.size());
+    deferedSyncTasks_.push_back({ task, UINT32_MAX });
+    auto res = deferedSyncHeads_.insert({ task->nextTask(0, nullptr)->ix(), { entryIx, entryIx }});
+    if (!res.second) {
+        /* == Keep the order of visit for the synchronizations of the same task == */
+        auto &range = res.first->second;
+        deferedSyncTasks_[range.second].second = entryIx;
+        range.second = entryIx;
+    }
 }
 
 void spider::sched::TaskLauncher::visit(PiSDFTask *task) {
@@ -101,101 +125,125 @@ void spider::sched::TaskLauncher::visit(PiSDFTask *task) {
     if (task->state() != TaskState::READY) {
         return;
     }
-    JobMessage message{ };
+    auto *message = rt::platform()->communicator()->acquireJobMessage();
     const auto *vertex = task->vertex();
     const auto *handler = task->handler();
     const auto firing = task->firing();
     /* == Setting core properties == */
-    message.nParamsOut_ = static_cast<u32>(vertex->outputParamCount());
-    message.kernelIx_ = static_cast<u32>(vertex->runtimeInformation()->kernelIx());
+    message->nParamsOut_ = static_cast<u32>(vertex->outputParamCount());
+    message->kernelIx_ = static_cast<u32>(vertex->runtimeInformation()->kernelIx());
     /* == Set Fifos == */
     u32 totalFifoCount = 0;
     for (const auto *edge : vertex->inputEdges()) {
         const auto count = handler->getEdgeDepCount(vertex, edge, firing);
         totalFifoCount += count + (count > 1);
     }
-    auto fifos = spider::make<JobFifos, StackID::RUNTIME>(totalFifoCount, static_cast<u32>(vertex->outputEdgeCount()));
+    message->fifos_.reset(totalFifoCount, static_cast<u32>(vertex->outputEdgeCount()));
     /* == Set the synchronization flags == */
-    message.synchronizationFlags_ = buildJobNotificationFlags(task, handler, vertex, firing,
-                                                              fifos->outputFifos().data());
+    buildJobNotificationFlags(message, task, handler, vertex, firing, message->fifos_.outputFifos().data());
     /* == Set Fifos == */
-    message.fifos_ = allocator_->buildJobFifos(task, fifos);
+    allocator_->buildJobFifos(task, message->fifos_);
     /* == Set input params == */
-    message.inputParams_ = pisdf::buildVertexRuntimeInputParameters(vertex, handler);
+    pisdf::buildVertexRuntimeInputParameters(vertex, handler, message->inputParams_);
     /* == Send the job == */
     sendTask(task, message);
 }
 
 /* === Private method(s) implementation === */
 
-void spider::sched::TaskLauncher::sendTask(Task *task, JobMessage &message) {
+void spider::sched::TaskLauncher::sendTask(Task *task, JobMessage *message) {
     /* == Set core properties == */
-    message.taskIx_ = task->ix();
-    message.execIx_ = task->jobExecIx();
+    message->taskIx_ = task->ix();
+    message->execIx_ = task->jobExecIx();
     /* == Set the execution task constraints == */
-    message.execConstraints_ = buildExecConstraints(task);
+    buildExecConstraints(task, message->execConstraints_);
     /* == Check for sync tasks to be sent == */
-    if (!deferedSyncTasks_.empty()) {
-        for (size_t i = 0; i < deferedSyncTasks_.size(); ++i) {
-            const auto &deferedTask = deferedSyncTasks_[i];
-            if (deferedTask.second == message.taskIx_) {
-                /* == Ok, this concern us == */
+    if (!deferedSyncHeads_.empty()) {
+        const auto it = deferedSyncHeads_.find(message->taskIx_);
+        if (it != deferedSyncHeads_.end()) {
+            for (auto i = it->second.first; i != UINT32_MAX; i = deferedSyncTasks_[i].second) {
+                auto *rcvTask = deferedSyncTasks_[i].first;
                 /* == Send task == */
-                sendSyncTask(deferedSyncTasks_[i - 1].first, message);
+                sendSyncTask(static_cast<SyncTask *>(rcvTask->previousTask(0, nullptr)), *message);
                 /* == Receive task == */
-                sendSyncTask(deferedTask.first, message);
+                sendSyncTask(rcvTask, *message);
+                /* == The task reads the copy made by the receive task in its own memory interface == */
+                auto fifo = makeCopyFifo(message->fifos_.inputFifo(rcvTask->getDepIx()));
+                fifo.count_ = 0;
+                fifo.attribute_ = FifoAttribute::RW_OWN;
+                message->fifos_.setInputFifo(rcvTask->getDepIx(), fifo);
             }
+            deferedSyncHeads_.erase(it);
         }
     }
     /* == Send the job == */
-    const auto grtIx = archi::platform()->getGRTIx();
-    auto *communicator = rt::platform()->communicator();
-    const auto mappedLRTIx = task->mappedLRT()->virtualIx();
-    const auto messageIx = communicator->push(std::move(message), mappedLRTIx);
-    communicator->push(Notification{ NotificationType::JOB_ADD, grtIx, messageIx }, mappedLRTIx);
+    pushJob(message, task->mappedLRT()->virtualIx());
     /* == Set job in TaskState::RUNNING == */
     task->setState(TaskState::RUNNING);
 }
 
-spider::array<spider::SyncInfo> spider::sched::TaskLauncher::buildExecConstraints(const Task *task) const {
+void spider::sched::TaskLauncher::flush() {
+    if (!batchHead_) {
+        return;
+    }
+    const auto grtIx = archi::platform()->getGRTIx();
+    auto *communicator = rt::platform()->communicator();
+    if (cache_) {
+        cache_->record(batchHead_, batchLRTIx_);
+    }
+    if (cache_ && cache_->muted()) {
+        /* == Jobs were already sent by the schedule cache == */
+        auto *message = batchHead_;
+        while (message) {
+            auto *next = message->next_;
+            communicator->release(message, batchLRTIx_);
+            message = next;
+        }
+    } else {
+        const auto messageIx = communicator->push(batchHead_, batchLRTIx_);
+        communicator->push(Notification{ NotificationType::JOB_ADD, grtIx, messageIx }, batchLRTIx_);
+    }
+    batchHead_ = nullptr;
+    batchTail_ = nullptr;
+    batchLRTIx_ = SIZE_MAX;
+}
+
+void spider::sched::TaskLauncher::pushJob(JobMessage *message, size_t lrtIx) {
+    if (batchHead_ && (lrtIx != batchLRTIx_)) {
+        flush();
+    }
+    message->next_ = nullptr;
+    if (batchHead_) {
+        batchTail_->next_ = message;
+    } else {
+        batchHead_ = message;
+        batchLRTIx_ = lrtIx;
+    }
+    batchTail_ = message;
+}
+
+void spider::sched::TaskLauncher::buildExecConstraints(const Task *task, spider::vector<SyncInfo> &result) const {
     const auto lrtCount = archi::platform()->LRTCount();
-    size_t constraintsCount = 0;
-    /* == Count the number of dependencies == */
+    result.clear();
     for (size_t i = 0; i < lrtCount; ++i) {
-        constraintsCount += task->syncExecIxOnLRT(i) != UINT32_MAX;
-    }
-    /* == Now build the actual array of synchronization info == */
-    auto result = spider::array<SyncInfo>(constraintsCount, StackID::RUNTIME);
-    if (constraintsCount) {
-        auto resultIt = std::begin(result);
-        for (size_t i = 0; i < lrtCount; ++i) {
-            const auto *srcTask = schedule_->task(task->syncExecIxOnLRT(i));
-            if (srcTask) {
-                /* == Set this dependency as a synchronization constraint == */
-                resultIt->lrtToWait_ = i;
-                resultIt->jobToWait_ = srcTask->jobExecIx();
-                /* == Update iterator == */
-                if ((++resultIt) == std::end(result)) {
-                    /* == shortcut to avoid useless other checks == */
-                    break;
-                }
-            }
+        const auto *srcTask = schedule_->task(task->syncExecIxOnLRT(i));
+        if (srcTask) {
+            /* == Set this dependency as a synchronization constraint == */
+            SyncInfo info;
+            info.lrtToWait_ = i;
+            info.jobToWait_ = srcTask->jobExecIx();
+            result.push_back(info);
         }
     }
-    return result;
 }
 
 template<class ...Args>
-spider::unique_ptr<bool>
-spider::sched::TaskLauncher::buildJobNotificationFlags(Task *task, Args &&...args) const {
-    auto flags = spider::make_n<bool, StackID::RUNTIME>(archi::platform()->LRTCount(), false);
+void spider::sched::TaskLauncher::buildJobNotificationFlags(JobMessage *message, Task *task, Args &&...args) const {
+    const auto lrtCount = archi::platform()->LRTCount();
+    auto *flags = message->synchronizationFlags_;
+    std::fill(flags, flags + lrtCount, false);
     updateNotificationFlags(task, flags, std::forward<Args>(args)...);
-    if (std::any_of(flags, flags + archi::platform()->LRTCount(), [](bool value) { return value; })) {
-        return make_unique(flags);
-    } else {
-        deallocate(flags);
-        return spider::unique_ptr<bool>();
-    }
+    message->notify_ = std::any_of(flags, flags + lrtCount, [](bool value) { return value; });
 }
 
 /* === Task type specific functions === */
@@ -222,7 +270,8 @@ void spider::sched::TaskLauncher::updateNotificationFlags(Task *task,
     const auto lambda = [taskIx, mappedLRTIx, flags, schedule](const pisdf::DependencyInfo &dep) {
         auto broadcast = false;
         for (auto k = dep.firingStart_; !broadcast && k <= dep.firingEnd_; ++k) {
-            const auto *snkTask = dep.vertex_ ? schedule->task(dep.handler_->getTaskIx(dep.vertex_, k)) : nullptr;
+            const auto *snkTask = dep.vertex_ ? schedule->task(dep.handler_->getTaskIx(dep.vertex_, k),
+                                                               dep.handler_->getTask(dep.vertex_), k) : nullptr;
             broadcast |= setFlagsFromSink(taskIx, mappedLRTIx, snkTask, flags);
         }
     };
@@ -251,45 +300,47 @@ bool spider::sched::TaskLauncher::setFlagsFromSink(u32 taskIx, size_t mappedLRTI
 }
 
 void spider::sched::TaskLauncher::sendSyncTask(SyncTask *task, const JobMessage &message) {
-    JobMessage syncMessage{ };
+    auto *communicator = rt::platform()->communicator();
+    auto *syncMessage = communicator->acquireJobMessage();
     /* == Set the synchronization flags == */
-    syncMessage.synchronizationFlags_ = buildJobNotificationFlags(task);
+    buildJobNotificationFlags(syncMessage, task);
     /* == Set the execution task constraints == */
-    syncMessage.execConstraints_ = buildExecConstraints(task);
+    buildExecConstraints(task, syncMessage->execConstraints_);
     /* == Set Fifos == */
-    syncMessage.fifos_ = spider::make_unique<JobFifos, StackID::RUNTIME>(1, 1);
-    auto fifo = message.fifos_->inputFifo(task->getDepIx());
+    syncMessage->fifos_.reset(1, 1);
+    auto fifo = message.fifos_.inputFifo(task->getDepIx());
     fifo.count_ = 0;
     fifo.attribute_ = FifoAttribute::RW_ONLY;
-    syncMessage.fifos_->setInputFifo(0, fifo);
     if (task->syncType() == SyncType::RECEIVE) {
-        /* == The receive task should allocate memory in the other memory interface == */
-        fifo.count_ = 1;
-        fifo.attribute_ = FifoAttribute::RW_OWN;
+        /* == The buffer lives in the memory interface of the cluster of the send task == */
+        fifo.memoryIx_ = static_cast<u16>(task->previousTask(0, nullptr)->mappedLRT()->cluster()->ix());
+    }
+    syncMessage->fifos_.setInputFifo(0, fifo);
+    if (task->syncType() == SyncType::RECEIVE) {
+        /* == The receive task copies the part read by the consumer in its own memory interface == */
+        syncMessage->fifos_.setOutputFifo(0, makeCopyFifo(fifo));
+    } else {
+        syncMessage->fifos_.setOutputFifo(0, fifo);
     }
-    syncMessage.fifos_->setOutputFifo(0, fifo);
     /* == Set core properties == */
-    syncMessage.nParamsOut_ = 0u;
+    syncMessage->nParamsOut_ = 0u;
     if (task->syncType() == SyncType::SEND) {
-        syncMessage.kernelIx_ = static_cast<u32>(task->getMemoryBus()->sendKernel()->ix());
+        syncMessage->kernelIx_ = static_cast<u32>(task->getMemoryBus()->sendKernel()->ix());
     } else {
-        syncMessage.kernelIx_ = static_cast<u32>(task->getMemoryBus()->receiveKernel()->ix());
+        syncMessage->kernelIx_ = static_cast<u32>(task->getMemoryBus()->receiveKernel()->ix());
     }
-    syncMessage.taskIx_ = task->ix();
-    syncMessage.execIx_ = task->jobExecIx();
+    syncMessage->taskIx_ = task->ix();
+    syncMessage->execIx_ = task->jobExecIx();
     /* == Set input params == */
-    auto params = spider::allocate<i64, StackID::RUNTIME>(4u);
-#ifndef NDEBUG
-    if (!params) {
-        throwNullptrException();
-    }
-#endif
+    auto &params = syncMessage->inputParams_;
+    params.resize(5u);
     if (task->syncType() == SyncType::SEND) {
         const auto *fstLRT = task->mappedLRT();
         const auto *sndLRT = task->nextTask(0, nullptr)->mappedLRT();
         params[0u] = static_cast<i64>(fstLRT->cluster()->ix());
         params[1u] = static_cast<i64>(sndLRT->cluster()->ix());
         params[2u] = static_cast<i64>(fifo.size_);
+        params[3u] = 0;
         params[4u] = 0;
     } else {
         const auto *fstLRT = task->previousTask(0, nullptr)->mappedLRT();
@@ -298,14 +349,10 @@ void spider::sched::TaskLauncher::sendSyncTask(SyncTask *task, const JobMessage
         params[1u] = static_cast<i64>(sndLRT->cluster()->ix());
         params[2u] = static_cast<i64>(fifo.size_);
         params[3u] = static_cast<i64>(fifo.address_);
+        params[4u] = static_cast<i64>(fifo.offset_);
     }
-    syncMessage.inputParams_ = spider::make_unique(params);
     /* == Send the job == */
-    const auto grtIx = archi::platform()->getGRTIx();
-    auto *communicator = rt::platform()->communicator();
-    const auto mappedLRTIx = task->mappedLRT()->virtualIx();
-    const auto messageIx = communicator->push(std::move(syncMessage), mappedLRTIx);
-    communicator->push(Notification{ NotificationType::JOB_ADD, grtIx, messageIx }, mappedLRTIx);
+    pushJob(syncMessage, task->mappedLRT()->virtualIx());
     /* == Set job in TaskState::RUNNING == */
     task->setState(TaskState::RUNNING);
 }
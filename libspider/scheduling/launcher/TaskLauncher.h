@@ -41,6 +41,7 @@
 #include <common/Types.h>
 #include <scheduling/memory/JobFifos.h>
 #include <scheduling/schedule/Schedule.h>
+#include <containers/unordered_map.h>
 #include <runtime/message/JobMessage.h>
 #include <graphs-tools/numerical/dependencies.h>
 
@@ -57,13 +58,26 @@ namespace spider {
 
         class FifoAllocator;
 
+        class ScheduleCache;
+
         /* === Class definition === */
 
         class TaskLauncher {
         public:
-            explicit TaskLauncher(const Schedule *schedule, FifoAllocator *allocator) : schedule_{ schedule },
-                                                                                        allocator_{ allocator } {
+            /**
+             * @brief Constructor.
+             * @param schedule  Pointer to the schedule.
+             * @param allocator Pointer to the fifo allocator.
+             * @param cache     Pointer to the schedule cache recording the sent jobs (optional). If the cache is
+             *                  muted, jobs are built but not sent.
+             */
+            explicit TaskLauncher(const Schedule *schedule,
+                                  FifoAllocator *allocator,
+                                  ScheduleCache *cache = nullptr) : schedule_{ schedule },
+                                                                    allocator_{ allocator },
+                                                                    cache_{ cache } {
                 deferedSyncTasks_ = factory::vector<std::pair<SyncTask *, u32>>(StackID::RUNTIME);
+                deferedSyncHeads_ = factory::unordered_map<u32, std::pair<u32, u32>>(StackID::RUNTIME);
             }
 
             ~TaskLauncher() noexcept = default;
@@ -82,33 +96,54 @@ namespace spider {
 
             void visit(sched::PiSDFTask *task);
 
+            /**
+             * @brief Send the pending batch of jobs (if any) to its LRT with a single notification.
+             * @remark Jobs are only batched while they are sent consecutively to the same LRT, this must be called
+             *         once the tasks have been visited.
+             */
+            void flush();
+
         private:
+            /* = Deferred receive tasks, each linked to the next one sharing its successor = */
             spider::vector<std::pair<SyncTask *, u32>> deferedSyncTasks_;
+            /* = First and last deferred receive tasks of every successor not sent yet = */
+            spider::unordered_map<u32, std::pair<u32, u32>> deferedSyncHeads_;
             const Schedule *schedule_ = nullptr;
             FifoAllocator *allocator_ = nullptr;
+            ScheduleCache *cache_ = nullptr;
+            JobMessage *batchHead_ = nullptr;
+            JobMessage *batchTail_ = nullptr;
+            size_t batchLRTIx_ = SIZE_MAX;
 
             /* === Private method(s) === */
 
-            void sendTask(Task *task, JobMessage &message);
+            void sendTask(Task *task, JobMessage *message);
 
             void sendSyncTask(SyncTask *task, const JobMessage &message);
 
             /**
-             * @brief Build the notification flags for this task.
-             * @param task Pointer to the task.
-             * @return array of only true booleans if this task need to broadcast its job stamp,
-             *         empty array if no notifications are required,
-             *         array with corresponding flags for each LRT else.
+             * @brief Append a job to the pending batch, the batch is flushed first if it targets another LRT.
+             * @param message Pointer to the message of the job.
+             * @param lrtIx   Index of the LRT the job is mapped on.
+             */
+            void pushJob(JobMessage *message, size_t lrtIx);
+
+            /**
+             * @brief Fill the notification flags of the message for this task.
+             *        Flags are all true if this task need to broadcast its job stamp, all false if no notifications
+             *        are required (message->notify_ is then set to false), corresponding flags for each LRT else.
+             * @param message Pointer to the message to fill.
+             * @param task    Pointer to the task.
              */
             template<class ...Args>
-            spider::unique_ptr<bool> buildJobNotificationFlags(Task *task, Args &&...args) const;
+            void buildJobNotificationFlags(JobMessage *message, Task *task, Args &&...args) const;
 
             /**
              * @brief Build execution constraints for this task (needed job + lrt).
-             * @param task Pointer to the task.
-             * @return array of constraints if any, empty array else.
+             * @param task   Pointer to the task.
+             * @param result Vector filled with the constraints (empty if none).
              */
-            spider::array<SyncInfo> buildExecConstraints(const Task *task) const;
+            void buildExecConstraints(const Task *task, spider::vector<SyncInfo> &result) const;
 
             /**
              * @brief Based on current state of the mapping / scheduling, fill the boolean array "flags" with
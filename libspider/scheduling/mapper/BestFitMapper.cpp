@@ -38,6 +38,7 @@
 #include <scheduling/schedule/Schedule.h>
 #include <archi/Platform.h>
 #include <archi/Cluster.h>
+#include <archi/PE.h>
 
 /* === Private method(s) implementation === */
 
@@ -46,11 +47,16 @@ const spider::PE *spider::sched::BestFitMapper::findPE(const Cluster *cluster,
                                                        const Task *task,
                                                        ufast64 minStartTime) const {
     const auto *grtPE = archi::platform()->spiderGRTPE();
+    const auto &availability = stats.availability();
+    const auto isUsable = [task](const PE *pe) { return pe->enabled() && task->isMappableOnPE(pe); };
     const PE *foundPE = nullptr;
     auto bestFitIdleTime = UINT_FAST64_MAX;
     auto bestFitEndTime = UINT_FAST64_MAX;
-    for (const auto *pe : cluster->peArray()) {
-        if (!pe->enabled() || !task->isMappableOnPE(pe)) {
+    /* == PEs of a bucket share the same timing, only the best fit PE of every bucket is evaluated == */
+    const auto buckets = availability.clusterBuckets(cluster->ix());
+    for (auto ix = buckets.first; ix < buckets.second; ++ix) {
+        const auto *pe = availability.bestFit(ix, minStartTime, isUsable);
+        if (!pe) {
             continue;
         }
         /* == Add a small overhead in choosing GRT as a mapping choice to break inequality in favor of other PEs == */
@@ -58,11 +64,10 @@ const spider::PE *spider::sched::BestFitMapper::findPE(const Cluster *cluster,
         const auto startTime = std::max(readyTime, minStartTime);
         const auto idleTime = startTime - readyTime;
         const auto endTime = startTime + task->timingOnPE(pe);
-        if (endTime < bestFitEndTime) {
-            foundPE = pe;
-            bestFitEndTime = endTime;
-            bestFitIdleTime = std::min(idleTime, bestFitIdleTime);
-        } else if ((endTime == bestFitEndTime) && (idleTime < bestFitIdleTime)) {
+        if ((endTime < bestFitEndTime) ||
+            ((endTime == bestFitEndTime) &&
+             ((idleTime < bestFitIdleTime) ||
+              ((idleTime == bestFitIdleTime) && (pe->virtualIx() < foundPE->virtualIx()))))) {
             foundPE = pe;
             bestFitEndTime = endTime;
             bestFitIdleTime = idleTime;
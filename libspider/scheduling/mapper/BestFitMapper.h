@@ -49,18 +49,25 @@ namespace spider {
 
         /* === Class definition === */
 
-        class BestFitMapper final : public Mapper {
+        class BestFitMapper : public Mapper {
         public:
             BestFitMapper() = default;
 
             ~BestFitMapper() noexcept override = default;
 
+        protected:
+
+            explicit BestFitMapper(bool slotInsertion) : Mapper(slotInsertion) { }
+
         private:
 
             /* === Private method(s) === */
 
             /**
              * @brief Find which PE is the best fit inside a given cluster.
+             * @remark The best fit PE is the one giving the earliest end time, then the least idle time. It is
+             *         searched in the @refitem PEAvailability index of the stats in O(log(P)) per group of PEs
+             *         sharing the same hardware type in the cluster.
              * @param cluster       Cluster to go through.
              * @param stats         Schedule information about current usage of PEs.
              * @param minStartTime  Lower bound for start time.
@@ -0,0 +1,142 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <scheduling/mapper/InsertionMapper.h>
+#include <scheduling/schedule/Schedule.h>
+#include <archi/Platform.h>
+#include <archi/Cluster.h>
+#include <archi/PE.h>
+#include <api/archi-api.h>
+
+/* === Method(s) implementation === */
+
+spider::sched::InsertionMapper::InsertionMapper() :
+        BestFitMapper(true),
+        timelines_{ factory::vector<spider::vector<Slot>>(StackID::GENERAL) },
+        readyTimes_{ factory::vector<ufast64>(StackID::GENERAL) } {
+
+}
+
+void spider::sched::InsertionMapper::commit(Schedule *schedule, size_t offset) {
+    if (inserted_) {
+        schedule->sortByStartTime(offset);
+    }
+    open_ = false;
+    inserted_ = false;
+}
+
+void spider::sched::InsertionMapper::clear() {
+    open_ = false;
+    inserted_ = false;
+}
+
+/* === Private method(s) implementation === */
+
+spider::sched::Mapper::MappingResult spider::sched::InsertionMapper::findSlot(const Cluster *cluster,
+                                                                             const Schedule *schedule,
+                                                                             const Task *task,
+                                                                             ufast64 minStartTime) {
+    const auto *platform = archi::platform();
+    if (!open_) {
+        /* == Tasks mapped before last commit may have been sent, nothing can be inserted before them == */
+        while (timelines_.size() < platform->PECount()) {
+            timelines_.emplace_back(factory::vector<Slot>(StackID::GENERAL));
+        }
+        readyTimes_.resize(platform->PECount());
+        for (size_t ix = 0; ix < readyTimes_.size(); ++ix) {
+            readyTimes_[ix] = schedule->stats().endTime(ix);
+            timelines_[ix].clear();
+        }
+        open_ = true;
+    }
+    const auto *grtPE = platform->spiderGRTPE();
+    MappingResult result{ };
+    auto bestFitIdleTime = UINT_FAST64_MAX;
+    auto bestFitEndTime = UINT_FAST64_MAX;
+    for (const auto *pe : cluster->peArray()) {
+        if (!pe->enabled() || !task->isMappableOnPE(pe)) {
+            continue;
+        }
+        const auto peIx = pe->virtualIx();
+        const auto duration = task->timingOnPE(pe);
+        ufast64 idleTime = 0;
+        const auto startTime = findIdleSlot(timelines_[peIx], readyTimes_[peIx], minStartTime, duration, idleTime);
+        /* == Add a small overhead in choosing GRT as a mapping choice to break inequality in favor of other PEs == */
+        const auto endTime = startTime + duration + (pe == grtPE) * 10;
+        if ((endTime < bestFitEndTime) || ((endTime == bestFitEndTime) && (idleTime < bestFitIdleTime))) {
+            result.mappingPE = pe;
+            result.startTime = startTime;
+            result.endTime = startTime + duration;
+            bestFitEndTime = endTime;
+            bestFitIdleTime = idleTime;
+        }
+    }
+    return result;
+}
+
+void spider::sched::InsertionMapper::reserveSlot(const MappingResult &result) {
+    if (!result.mappingPE) {
+        return;
+    }
+    auto &timeline = timelines_[result.mappingPE->virtualIx()];
+    /* == The slot was found idle, it goes before the first busy slot starting after its end (zero length
+     *    SEND / RECEIVE slots included) so that the end times of the timeline stay sorted == */
+    const auto it = std::lower_bound(std::begin(timeline), std::end(timeline), result.endTime,
+                                     [](const Slot &slot, ufast64 time) { return slot.startTime_ < time; });
+    inserted_ |= (it != std::end(timeline));
+    timeline.insert(it, Slot{ result.startTime, result.endTime });
+}
+
+ufast64 spider::sched::InsertionMapper::findIdleSlot(const spider::vector<Slot> &timeline,
+                                                     ufast64 readyTime,
+                                                     ufast64 minStartTime,
+                                                     ufast64 duration,
+                                                     ufast64 &idleTime) {
+    auto startTime = std::max(readyTime, minStartTime);
+    /* == Slots are sorted and do not overlap, skip the ones ending before the task can start == */
+    auto it = std::upper_bound(std::begin(timeline), std::end(timeline), startTime,
+                               [](ufast64 time, const Slot &slot) { return time < slot.endTime_; });
+    auto idleStart = it == std::begin(timeline) ? readyTime : std::prev(it)->endTime_;
+    for (; it != std::end(timeline); ++it) {
+        if (it->startTime_ >= startTime + duration) {
+            break;
+        }
+        startTime = std::max(startTime, it->endTime_);
+        idleStart = it->endTime_;
+    }
+    idleTime = startTime - idleStart;
+    return startTime;
+}
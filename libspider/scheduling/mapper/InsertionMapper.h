@@ -0,0 +1,101 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_INSERTIONMAPPER_H
+#define SPIDER2_INSERTIONMAPPER_H
+
+/* === Include(s) === */
+
+#include <scheduling/mapper/BestFitMapper.h>
+
+namespace spider {
+
+    namespace sched {
+
+        /* === Class definition === */
+
+        /**
+         * @brief Best fit mapper able to place a task in an idle slot left between two tasks of a PE.
+         * @remark Only tasks mapped since the last call to @refitem InsertionMapper::commit can be preceded by an
+         *         inserted task, the schedule is then reordered by start time on commit. On multi cluster platforms,
+         *         SEND / RECEIVE tasks are placed in idle slots the same way.
+         */
+        class InsertionMapper final : public BestFitMapper {
+        public:
+            InsertionMapper();
+
+            ~InsertionMapper() noexcept override = default;
+
+            /* === Method(s) === */
+
+            void commit(Schedule *schedule, size_t offset) override;
+
+            void clear() override;
+
+        private:
+            struct Slot {
+                ufast64 startTime_;
+                ufast64 endTime_;
+            };
+            spider::vector<spider::vector<Slot>> timelines_; /* = Sorted busy slots of every PE since last commit = */
+            spider::vector<ufast64> readyTimes_;             /* = End time of every PE at last commit = */
+            bool open_ = false;
+            bool inserted_ = false;
+
+            /* === Private method(s) === */
+
+            MappingResult
+            findSlot(const Cluster *cluster, const Schedule *schedule, const Task *task, ufast64 minStartTime) final;
+
+            void reserveSlot(const MappingResult &result) final;
+
+            /**
+             * @brief Find the first idle slot of a PE large enough for a task.
+             * @param timeline      Busy slots of the PE.
+             * @param readyTime     End time of the PE at last commit.
+             * @param minStartTime  Lower bound for start time.
+             * @param duration      Duration of the task.
+             * @param idleTime      Set to the idle time left before the task in the slot.
+             * @return start time of the task.
+             */
+            static ufast64 findIdleSlot(const spider::vector<Slot> &timeline,
+                                        ufast64 readyTime,
+                                        ufast64 minStartTime,
+                                        ufast64 duration,
+                                        ufast64 &idleTime);
+        };
+    }
+}
+
+#endif //SPIDER2_INSERTIONMAPPER_H
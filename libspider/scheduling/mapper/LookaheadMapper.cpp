@@ -0,0 +1,156 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <scheduling/mapper/LookaheadMapper.h>
+#include <scheduling/schedule/Schedule.h>
+#include <scheduling/task/PiSDFTask.h>
+#include <graphs/pisdf/Vertex.h>
+#include <graphs-tools/transformation/pisdf/GraphFiring.h>
+#include <graphs-tools/numerical/detail/dependenciesImpl.h>
+#include <runtime/common/RTInfo.h>
+#include <archi/Platform.h>
+#include <archi/Cluster.h>
+#include <archi/MemoryBus.h>
+#include <archi/PE.h>
+#include <api/archi-api.h>
+
+/* === Method(s) implementation === */
+
+spider::sched::LookaheadMapper::LookaheadMapper() :
+        BestFitMapper(),
+        receivedData_{ factory::map<consumer_t, spider::vector<u64>>(StackID::GENERAL) },
+        successors_{ factory::vector<Successor>(StackID::GENERAL) },
+        gatherCosts_{ factory::vector<ufast64>(StackID::GENERAL) } {
+
+}
+
+void spider::sched::LookaheadMapper::clear() {
+    receivedData_.clear();
+    successors_.clear();
+}
+
+/* === Private method(s) implementation === */
+
+void spider::sched::LookaheadMapper::computeSuccessorsCost(PiSDFTask *task, const Schedule *, ufast64 *costs) {
+    successors_.clear();
+    const auto firing = task->firing();
+    const auto lambda = [this](const pisdf::DependencyInfo &dep) {
+        if (!dep.vertex_ || !dep.handler_ || !dep.vertex_->executable()) {
+            return;
+        }
+        const auto vertexIx = static_cast<u32>(dep.vertex_->ix());
+        for (auto k = dep.firingStart_; k <= dep.firingEnd_; ++k) {
+            const auto memoryStart = (k == dep.firingStart_) * dep.memoryStart_;
+            const auto memoryEnd = k == dep.firingEnd_ ? dep.memoryEnd_ : static_cast<u32>(dep.rate_) - 1;
+            const auto size = (dep.rate_ > 0) * (memoryEnd - memoryStart + 1);
+            if (size) {
+                successors_.push_back({ consumer_t{ dep.handler_, vertexIx, k }, dep.vertex_, size });
+            }
+        }
+    };
+    const auto *handler = task->handler();
+    for (const auto *edge : task->vertex()->outputEdges()) {
+        pisdf::detail::computeConsDependency(handler, edge, firing, lambda);
+    }
+    task->setOnFiring(firing);
+    /* == Each successor is expected to be mapped on the cluster where gathering its data is the cheapest == */
+    const auto &clusters = archi::platform()->clusters();
+    for (const auto &successor : successors_) {
+        if (!computeGatherCosts(successor)) {
+            continue;
+        }
+        for (const auto *cluster : clusters) {
+            auto cost = UINT_FAST64_MAX;
+            for (const auto *snkCluster : clusters) {
+                const auto gatherCost = gatherCosts_[snkCluster->ix()];
+                if (gatherCost != UINT_FAST64_MAX) {
+                    cost = std::min(cost, math::saturateAdd(gatherCost,
+                                                            transferCost(cluster, snkCluster, successor.size_)));
+                }
+            }
+            costs[cluster->ix()] = math::saturateAdd(costs[cluster->ix()], cost);
+        }
+    }
+}
+
+void spider::sched::LookaheadMapper::onTaskMapped(PiSDFTask *task, const Schedule *) {
+    const auto clusterCount = archi::platform()->clusterCount();
+    const auto clusterIx = task->mappedPe()->cluster()->ix();
+    for (const auto &successor : successors_) {
+        auto it = receivedData_.find(successor.consumer_);
+        if (it == receivedData_.end()) {
+            it = receivedData_.emplace(successor.consumer_,
+                                       factory::vector<u64>(clusterCount, 0, StackID::GENERAL)).first;
+        }
+        it->second[clusterIx] += successor.size_;
+    }
+    successors_.clear();
+    /* == Data sent to the task is not needed anymore == */
+    receivedData_.erase(consumer_t{ task->handler(), static_cast<u32>(task->vertex()->ix()), task->firing() });
+}
+
+bool spider::sched::LookaheadMapper::computeGatherCosts(const Successor &successor) {
+    const auto &clusters = archi::platform()->clusters();
+    const auto *rtInfo = successor.vertex_->runtimeInformation();
+    const auto it = receivedData_.find(successor.consumer_);
+    gatherCosts_.assign(clusters.size(), UINT_FAST64_MAX);
+    auto mappable = false;
+    for (const auto *snkCluster : clusters) {
+        const auto &peArray = snkCluster->peArray();
+        if (std::none_of(std::begin(peArray), std::end(peArray),
+                         [rtInfo](const PE *pe) { return pe->enabled() && rtInfo->isPEMappable(pe); })) {
+            continue;
+        }
+        ufast64 cost = 0;
+        if (it != receivedData_.end()) {
+            for (const auto *srcCluster : clusters) {
+                cost = math::saturateAdd(cost, transferCost(srcCluster, snkCluster, it->second[srcCluster->ix()]));
+            }
+        }
+        gatherCosts_[snkCluster->ix()] = cost;
+        mappable = true;
+    }
+    return mappable;
+}
+
+ufast64 spider::sched::LookaheadMapper::transferCost(const Cluster *src, const Cluster *snk, u64 size) {
+    if ((src == snk) || !size) {
+        return 0;
+    }
+    const auto *platform = archi::platform();
+    const auto sendCost = platform->getClusterToClusterMemoryBus(src, snk)->sendCost(size);
+    return math::saturateAdd(sendCost, platform->getClusterToClusterMemoryBus(snk, src)->receiveCost(size));
+}
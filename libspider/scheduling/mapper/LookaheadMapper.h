@@ -0,0 +1,111 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_LOOKAHEADMAPPER_H
+#define SPIDER2_LOOKAHEADMAPPER_H
+
+/* === Include(s) === */
+
+#include <tuple>
+#include <scheduling/mapper/BestFitMapper.h>
+#include <containers/map.h>
+
+namespace spider {
+
+    class Cluster;
+
+    namespace pisdf {
+        class GraphFiring;
+    }
+
+    namespace sched {
+
+        /* === Class definition === */
+
+        /**
+         * @brief Best fit mapper accounting for the communications a mapping choice forces onto the successors of a
+         *        task on multi cluster platforms.
+         * @remark For every candidate cluster, the data sent to each successor is added to the data already sent to
+         *         it by its mapped predecessors. The cost of the successor is then the one of gathering its data in
+         *         the cheapest cluster it can be mapped on (SEND / RECEIVE costs of the memory buses). On single
+         *         cluster platforms, tasks are mapped as with the @refitem BestFitMapper.
+         */
+        class LookaheadMapper final : public BestFitMapper {
+        public:
+            LookaheadMapper();
+
+            ~LookaheadMapper() noexcept override = default;
+
+            /* === Method(s) === */
+
+            void clear() override;
+
+        private:
+            using consumer_t = std::tuple<const pisdf::GraphFiring *, u32, u32>; /* = Handler, vertex and firing = */
+
+            struct Successor {
+                consumer_t consumer_;
+                const pisdf::Vertex *vertex_;
+                u64 size_;
+            };
+            spider::map<consumer_t, spider::vector<u64>> receivedData_; /* = Data sent to every successor per cluster = */
+            spider::vector<Successor> successors_;                      /* = Successors of the task being mapped = */
+            spider::vector<ufast64> gatherCosts_;                       /* = Scratch buffer for the cost per cluster = */
+
+            /* === Private method(s) === */
+
+            void computeSuccessorsCost(PiSDFTask *task, const Schedule *schedule, ufast64 *costs) final;
+
+            void onTaskMapped(PiSDFTask *task, const Schedule *schedule) final;
+
+            /**
+             * @brief Compute the cost of gathering the data already sent to a successor on every cluster.
+             * @param successor Successor to evaluate.
+             * @return false if the successor can not be mapped on any cluster, true else.
+             */
+            bool computeGatherCosts(const Successor &successor);
+
+            /**
+             * @brief Compute the cost of sending data from a cluster to another one.
+             * @param src  Source cluster.
+             * @param snk  Sink cluster.
+             * @param size Size of the data.
+             * @return cost of the SEND and RECEIVE of the data, 0 if both clusters are the same.
+             */
+            static ufast64 transferCost(const Cluster *src, const Cluster *snk, u64 size);
+        };
+    }
+}
+
+#endif //SPIDER2_LOOKAHEADMAPPER_H
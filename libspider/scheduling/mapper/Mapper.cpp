@@ -39,6 +39,7 @@
 #include <scheduling/task/Task.h>
 #include <scheduling/task/PiSDFTask.h>
 #include <scheduling/task/SyncTask.h>
+#include <scheduling/memory/FifoAllocator.h>
 #include <archi/PE.h>
 #include <api/archi-api.h>
 #include <graphs-tools/numerical/detail/dependenciesImpl.h>
@@ -75,33 +76,58 @@ void spider::sched::Mapper::map(PiSDFTask *task, Schedule *schedule) {
 
 template<class T>
 void spider::sched::Mapper::mapImpl(T *task, Schedule *schedule) {
-    auto comRates = spider::make_unique(make_n<u32>(archi::platform()->LRTCount(), 0));
-    if (!comRates) {
-        throwNullptrException();
+#ifdef _SPIDER_SINGLE_CLUSTER
+    mapOnSingleCluster(task, schedule);
+#else
+    if (archi::platform()->clusterCount() == 1) {
+        mapOnSingleCluster(task, schedule);
+    } else {
+        mapOnMultiCluster(task, schedule);
     }
+#endif
+}
+
+template<class T>
+void spider::sched::Mapper::mapOnSingleCluster(T *task, Schedule *schedule) {
+    /* == Compute the minimum start time possible for the task == */
+    const auto minStartTime = computeStartTime(task, schedule, nullptr);
+    /* == Every PE shares the same memory, only the best fit PE matters == */
+    const auto result = findSlot(archi::platform()->cluster(0), schedule, task, minStartTime);
+    if (!result.mappingPE) {
+        throwSpiderException("Could not find suitable processing element for vertex: [%s]", task->name().c_str());
+    }
+    reserveSlot(result);
+    schedule->updateTaskAndSetReady(task, result.mappingPE, result.startTime, result.endTime);
+}
+
+template<class T>
+void spider::sched::Mapper::mapOnMultiCluster(T *task, Schedule *schedule) {
+    /* == Scratch buffer keeps its capacity from one task to another == */
+    comRates_.assign(archi::platform()->LRTCount(), 0);
+    successorsCosts_.assign(archi::platform()->clusterCount(), 0);
     /* == Compute the minimum start time possible for the task == */
-    const auto minStartTime = computeStartTime(task, schedule, comRates.get());
+    const auto minStartTime = computeStartTime(task, schedule, comRates_.data());
+    /* == Evaluate the communications forced onto the successors of the task (if the policy does) == */
+    computeSuccessorsCost(task, schedule, successorsCosts_.data());
     /* == Build the data dependency vector in order to compute receive cost == */
     const auto *platform = archi::platform();
     /* == Search for a slave to map the task on */
-    const auto &scheduleStats = schedule->stats();
     MappingResult mappingResult{ };
     for (const auto *cluster : platform->clusters()) {
-        /* == Find best fit PE for this cluster == */
-        const auto *foundPE = findPE(cluster, scheduleStats, task, minStartTime);
-        if (foundPE) {
-            const auto result = computeCommunicationCost(task, foundPE, schedule, comRates.get());
+        /* == Find best fit slot for this cluster == */
+        const auto slot = findSlot(cluster, schedule, task, minStartTime);
+        if (slot.mappingPE) {
+            const auto result = computeCommunicationCost(task, slot.mappingPE, schedule, comRates_.data());
             const auto communicationCost = result.first;
             const auto externDataToReceive = result.second;
             mappingResult.needToAddCommunication |= (externDataToReceive != 0);
             /* == Check if it is better than previous cluster PE == */
-            const auto startTime{ std::max(scheduleStats.endTime(foundPE->virtualIx()), minStartTime) };
-            const auto endTime{ startTime + task->timingOnPE(foundPE) };
-            const auto scheduleCost{ math::saturateAdd(endTime, communicationCost) };
+            const auto scheduleCost{ math::saturateAdd(math::saturateAdd(slot.endTime, communicationCost),
+                                                       successorsCosts_[cluster->ix()]) };
             if (scheduleCost < mappingResult.scheduleCost) {
-                mappingResult.mappingPE = foundPE;
-                mappingResult.startTime = startTime;
-                mappingResult.endTime = endTime;
+                mappingResult.mappingPE = slot.mappingPE;
+                mappingResult.startTime = slot.startTime;
+                mappingResult.endTime = slot.endTime;
                 mappingResult.scheduleCost = scheduleCost;
             }
         }
@@ -112,13 +138,34 @@ void spider::sched::Mapper::mapImpl(T *task, Schedule *schedule) {
     }
     if (mappingResult.needToAddCommunication) {
         /* == Map communications == */
-        mapCommunications(mappingResult, task, schedule);
+        const auto receiveEndTime = mapCommunications(mappingResult, task, schedule);
+        if (receiveEndTime > mappingResult.startTime) {
+            /* == The task waits for its receptions, the slot is searched again inside the selected cluster == */
+            mappingResult = findSlot(mappingResult.mappingPE->cluster(), schedule, task, receiveEndTime);
+        }
     }
+    reserveSlot(mappingResult);
     schedule->updateTaskAndSetReady(task, mappingResult.mappingPE, mappingResult.startTime, mappingResult.endTime);
+    onTaskMapped(task, schedule);
+}
+
+spider::sched::Mapper::MappingResult spider::sched::Mapper::findSlot(const Cluster *cluster,
+                                                                    const Schedule *schedule,
+                                                                    const Task *task,
+                                                                    ufast64 minStartTime) {
+    MappingResult result{ };
+    const auto &scheduleStats = schedule->stats();
+    result.mappingPE = findPE(cluster, scheduleStats, task, minStartTime);
+    if (result.mappingPE) {
+        result.startTime = std::max(scheduleStats.endTime(result.mappingPE->virtualIx()), minStartTime);
+        result.endTime = result.startTime + task->timingOnPE(result.mappingPE);
+    }
+    return result;
 }
 
 ufast64 spider::sched::Mapper::computeStartTime(Task *task, const Schedule *schedule, u32 *comRates) const {
-    auto minTime = startTime_;
+    /* == With slot insertion, tasks may start before the end of the other PEs == */
+    auto minTime = slotInsertion_ ? ufast64{ 0 } : startTime_;
     if (!task) {
         return minTime;
     }
@@ -128,11 +175,14 @@ ufast64 spider::sched::Mapper::computeStartTime(Task *task, const Schedule *sche
             const auto srcLRTIx = srcTask->mappedLRT()->virtualIx();
             const auto currentJob = task->syncExecIxOnLRT(srcLRTIx);
             const auto srcJobIx = srcTask->ix();
-            if (currentJob == UINT32_MAX || srcJobIx > currentJob) {
+            if (currentJob == UINT32_MAX ||
+                isExecutedAfter(srcTask->startTime(), srcTask->endTime(), srcJobIx, currentJob, schedule)) {
                 task->setSyncExecIxOnLRT(srcLRTIx, srcJobIx);
             }
             /* == By summing up all the rates we are sure to compute com cost accurately == */
-            comRates[srcLRTIx] += static_cast<u32>(task->inputRate(ix));
+            if (comRates) {
+                comRates[srcLRTIx] += static_cast<u32>(task->inputRate(ix));
+            }
             minTime = std::max(minTime, srcTask->endTime());
         }
     }
@@ -140,13 +190,14 @@ ufast64 spider::sched::Mapper::computeStartTime(Task *task, const Schedule *sche
 }
 
 ufast64 spider::sched::Mapper::computeStartTime(PiSDFTask *task, const Schedule *schedule, u32 *comRates) const {
-    auto minTime = startTime_;
+    /* == With slot insertion, tasks may start before the end of the other PEs == */
+    auto minTime = slotInsertion_ ? ufast64{ 0 } : startTime_;
     if (!task) {
         return minTime;
     }
     const auto *vertex = task->vertex();
     const auto *handler = task->handler();
-    const auto lambda = [task, schedule, comRates, &minTime](const pisdf::DependencyInfo &dep) {
+    const auto lambda = [this, task, schedule, comRates, &minTime](const pisdf::DependencyInfo &dep) {
         if (!dep.vertex_ || !dep.handler_) {
             return;
         }
@@ -157,16 +208,22 @@ ufast64 spider::sched::Mapper::computeStartTime(PiSDFTask *task, const Schedule
             const auto *srcTask = schedule->task(srcTaskIxArray[k]);
             if (srcTask) {
                 const auto srcLRTIx = srcTask->mappedLRT()->virtualIx();
+                const auto srcStartTime = slotInsertion_ ? srcTask->startTime() : 0;
                 const auto srcEndTime = srcTask->endTime();
                 task->setOnFiring(firing);
                 const auto currentJob = task->syncExecIxOnLRT(srcLRTIx);
-                if (currentJob == UINT32_MAX || srcTaskIx > currentJob) {
+                if (currentJob == UINT32_MAX ||
+                    isExecutedAfter(srcStartTime, srcEndTime, srcTaskIx, currentJob, schedule)) {
+                    /* == Fetching the recorded task may have changed the current firing of the task == */
+                    task->setOnFiring(firing);
                     task->setSyncExecIxOnLRT(srcLRTIx, srcTaskIx);
                 }
                 /* == By summing up all the rates we are sure to compute com cost accurately == */
-                const auto memoryStart = (k == dep.firingStart_) * dep.memoryStart_;
-                const auto memoryEnd = k == dep.firingEnd_ ? dep.memoryEnd_ : static_cast<u32>(dep.rate_) - 1;
-                comRates[srcLRTIx] += (dep.rate_ > 0) * (memoryEnd - memoryStart + 1);
+                if (comRates) {
+                    const auto memoryStart = (k == dep.firingStart_) * dep.memoryStart_;
+                    const auto memoryEnd = k == dep.firingEnd_ ? dep.memoryEnd_ : static_cast<u32>(dep.rate_) - 1;
+                    comRates[srcLRTIx] += (dep.rate_ > 0) * (memoryEnd - memoryStart + 1);
+                }
                 minTime = std::max(minTime, srcEndTime);
             }
         }
@@ -178,6 +235,30 @@ ufast64 spider::sched::Mapper::computeStartTime(PiSDFTask *task, const Schedule
     return minTime;
 }
 
+bool spider::sched::Mapper::isExecutedAfter(u64 srcStartTime,
+                                            u64 srcEndTime,
+                                            u32 srcTaskIx,
+                                            u32 currentJob,
+                                            const Schedule *schedule) const {
+    if (!slotInsertion_) {
+        return srcTaskIx > currentJob;
+    }
+    /* == Same order as the one of Schedule::sortByStartTime == */
+    const auto *currentTask = schedule->task(currentJob);
+    if (!currentTask) {
+        return true;
+    }
+    const auto currentStartTime = currentTask->startTime();
+    if (srcStartTime != currentStartTime) {
+        return srcStartTime > currentStartTime;
+    }
+    const auto currentEndTime = currentTask->endTime();
+    if (srcEndTime != currentEndTime) {
+        return srcEndTime > currentEndTime;
+    }
+    return srcTaskIx > currentJob;
+}
+
 std::pair<ufast64, ufast64> spider::sched::Mapper::computeCommunicationCost(Task *task,
                                                                             const PE *mappedPE,
                                                                             const Schedule *schedule,
@@ -206,87 +287,105 @@ std::pair<ufast64, ufast64> spider::sched::Mapper::computeCommunicationCost(Task
     return { communicationCost, externDataToReceive };
 }
 
-void spider::sched::Mapper::mapCommunications(MappingResult &mappingInfo, Task *task, Schedule *schedule) const {
+ufast64 spider::sched::Mapper::mapCommunications(const MappingResult &mappingInfo, Task *task, Schedule *schedule) {
+    ufast64 receiveEndTime = 0;
     for (size_t ix = 0; ix < task->dependencyCount(); ++ix) {
+        /* == In the SR-DAG, every edge is read as a whole by its only sink == */
         auto *srcTask = task->previousTask(ix, schedule);
-        mapCommunications(mappingInfo, task, srcTask, ix, schedule);
+        receiveEndTime = std::max(receiveEndTime, mapCommunications(mappingInfo, task, srcTask, ix, true, schedule));
     }
+    return receiveEndTime;
 }
 
-void spider::sched::Mapper::mapCommunications(MappingResult &mappingInfo, PiSDFTask *task, Schedule *schedule) const {
-    size_t depIx = 0;
-    const auto lambda = [&depIx, &mappingInfo, schedule, task, this](const pisdf::DependencyInfo &dep) {
+ufast64
+spider::sched::Mapper::mapCommunications(const MappingResult &mappingInfo, PiSDFTask *task, Schedule *schedule) {
+    ufast64 receiveEndTime = 0;
+    size_t fifoIx = 0;
+    const auto lambda = [&fifoIx, &receiveEndTime, &mappingInfo, schedule, task, this](const pisdf::DependencyInfo &dep) {
         if (!dep.handler_ || !dep.vertex_) {
             return;
         }
+        const auto rate = static_cast<u32>(dep.rate_);
         for (auto k = dep.firingStart_; k <= dep.firingEnd_; ++k) {
             auto *srcTask = schedule->task(dep.handler_->getTaskIx(dep.vertex_, k));
-            mapCommunications(mappingInfo, task, srcTask, depIx, schedule);
-            depIx++;
+            const auto memoryStart = k == dep.firingStart_ ? dep.memoryStart_ : 0;
+            const auto memoryEnd = k == dep.firingEnd_ ? dep.memoryEnd_ : rate - 1;
+            const auto wholeBuffer = !memoryStart && (memoryEnd + 1 == rate);
+            receiveEndTime = std::max(receiveEndTime,
+                                      mapCommunications(mappingInfo, task, srcTask, fifoIx, wholeBuffer, schedule));
+            fifoIx++;
         }
     };
     const auto *vertex = task->vertex();
     const auto firing = task->firing();
     const auto *handler = task->handler();
+    size_t edgeFifoIx = 0;
     for (const auto *edge : vertex->inputEdges()) {
+        /* == Same layout as the input fifos of the job: merged edges start with the fifo of the merged buffer == */
+        const auto depCount = handler->getEdgeDepCount(vertex, edge, firing);
+        fifoIx = edgeFifoIx + (depCount > 1);
         pisdf::detail::computeExecDependency(handler, edge, firing, lambda);
+        edgeFifoIx += depCount > 1 ? depCount + 1 : 1;
     }
-
+    return receiveEndTime;
 }
 
-void spider::sched::Mapper::mapCommunications(MappingResult &mappingInfo,
-                                              Task *task,
-                                              Task *srcTask,
-                                              size_t depIx,
-                                              Schedule *schedule) const {
+ufast64 spider::sched::Mapper::mapCommunications(const MappingResult &mappingInfo,
+                                                 Task *task,
+                                                 Task *srcTask,
+                                                 size_t fifoIx,
+                                                 bool wholeBuffer,
+                                                 Schedule *schedule) {
     if (!srcTask) {
-        return;
+        return 0;
     }
     const auto *mappedCluster = mappingInfo.mappingPE->cluster();
     const auto *prevCluster = srcTask->mappedPe()->cluster();
-    if (prevCluster != mappedCluster) {
-        /* == Insert send on source cluster == */
-        const auto *sndBus = archi::platform()->getClusterToClusterMemoryBus(prevCluster, mappedCluster);
-        /* == Create the com task == */
-        auto *sndTask = spider::make<SyncTask, StackID::SCHEDULE>(SyncType::SEND, sndBus);
-        /* == Search for the first PE able to run the send task == */
-        auto minStartTime = srcTask->endTime();
-        auto *mappedPe = this->findPE(prevCluster, schedule->stats(), sndTask, minStartTime);
-        if (!mappedPe) {
-            throwSpiderException("could not find any processing element to map communication vertexTask.");
-        }
-        /* == Set job information and update schedule == */
-        auto mappedPeIx{ mappedPe->virtualIx() };
-        auto mappingSt{ std::max(schedule->stats().endTime(mappedPeIx), minStartTime) };
-        auto mappingEt{ mappingSt + sndTask->timingOnPE(nullptr) };
-        schedule->updateTaskAndSetReady(sndTask, mappedPe, mappingSt, mappingEt);
-        /* == Insert receive on mapped cluster == */
-        const auto *rcvBus = archi::platform()->getClusterToClusterMemoryBus(mappedCluster, prevCluster);
-        auto *rcvTask = spider::make<SyncTask, StackID::SCHEDULE>(SyncType::RECEIVE, rcvBus);
-        /* == Search for the first PE able to run the send task == */
-        minStartTime = sndTask->endTime();
-        mappedPe = this->findPE(mappedCluster, schedule->stats(), rcvTask, minStartTime);
-        if (!mappedPe) {
-            throwSpiderException("could not find any processing element to map communication vertexTask.");
-        }
-        /* == Set job information and update schedule == */
-        mappedPeIx = mappedPe->virtualIx();
-        mappingSt = std::max(schedule->stats().endTime(mappedPeIx), minStartTime);
-        mappingEt = mappingSt + rcvTask->timingOnPE(nullptr);
-        schedule->updateTaskAndSetReady(rcvTask, mappedPe, mappingSt, mappingEt);
-        schedule->insertTasks(task->ix(), { ComposedTask{ sndTask, 0 }, ComposedTask{ rcvTask, 0 }});
-        /* == Re-route dependency of the original vertex to the recvTask == */
-        if (rcvTask->endTime() > mappingInfo.startTime) {
-            const auto offset = rcvTask->endTime() - mappingInfo.startTime;
-            mappingInfo.startTime += offset;
-            mappingInfo.endTime += +offset;
-        }
-        /* == Set dependencies == */
-        sndTask->setPredecessor(srcTask);
-        sndTask->setSuccessor(rcvTask);
-        sndTask->setDepIx(static_cast<u32>(depIx));
-        rcvTask->setPredecessor(sndTask);
-        rcvTask->setSuccessor(task);
-        rcvTask->setDepIx(static_cast<u32>(depIx));
+    if ((prevCluster == mappedCluster) || (allocator_ && allocator_->isPlacedWithConsumer(srcTask, wholeBuffer))) {
+        return 0;
     }
+    /* == Insert send on the PE of the producer, no other LRT has to be notified of the end of the producer == */
+    const auto *sndBus = archi::platform()->getClusterToClusterMemoryBus(prevCluster, mappedCluster);
+    const auto srcLRTIx = srcTask->mappedLRT()->virtualIx();
+    const auto srcTaskIx = srcTask->ix();
+    /* == Create the com task == */
+    auto *sndTask = spider::make<SyncTask, StackID::SCHEDULE>(SyncType::SEND, sndBus);
+    sndTask->setMappablePE(srcTask->mappedPe());
+    sndTask->setPredecessor(srcTask);
+    schedule->ownTask(sndTask);
+    /* == Search for the first slot able to run the send task == */
+    const auto sndSlot = findSlot(prevCluster, schedule, sndTask, srcTask->endTime());
+    if (!sndSlot.mappingPE) {
+        throwSpiderException("could not find any processing element to map communication vertexTask.");
+    }
+    /* == Set job information and update schedule == */
+    reserveSlot(sndSlot);
+    schedule->updateTaskAndSetReady(sndTask, sndSlot.mappingPE, sndSlot.startTime, sndSlot.endTime);
+    /* == Insert receive on mapped cluster == */
+    const auto *rcvBus = archi::platform()->getClusterToClusterMemoryBus(mappedCluster, prevCluster);
+    auto *rcvTask = spider::make<SyncTask, StackID::SCHEDULE>(SyncType::RECEIVE, rcvBus);
+    schedule->ownTask(rcvTask);
+    /* == Search for the first slot able to run the receive task == */
+    const auto rcvSlot = findSlot(mappedCluster, schedule, rcvTask, sndTask->endTime());
+    if (!rcvSlot.mappingPE) {
+        throwSpiderException("could not find any processing element to map communication vertexTask.");
+    }
+    /* == Set job information and update schedule == */
+    reserveSlot(rcvSlot);
+    schedule->updateTaskAndSetReady(rcvTask, rcvSlot.mappingPE, rcvSlot.startTime, rcvSlot.endTime);
+    const auto firing = task->firing();
+    schedule->insertTasks(task->ix(), { ComposedTask{ sndTask, 0 }, ComposedTask{ rcvTask, 0 }});
+    /* == Updating the indexes of the following tasks may have changed the current firing of the task == */
+    task->setOnFiring(firing);
+    /* == Set dependencies == */
+    sndTask->setSuccessor(rcvTask);
+    sndTask->setDepIx(static_cast<u32>(fifoIx));
+    rcvTask->setPredecessor(sndTask);
+    rcvTask->setSuccessor(task);
+    rcvTask->setDepIx(static_cast<u32>(fifoIx));
+    /* == Set execution constraints: producer -> send -> receive -> task == */
+    sndTask->setSyncExecIxOnLRT(srcLRTIx, srcTaskIx);
+    rcvTask->setSyncExecIxOnLRT(sndTask->mappedLRT()->virtualIx(), sndTask->ix());
+    task->setSyncExecIxOnLRT(rcvTask->mappedLRT()->virtualIx(), rcvTask->ix());
+    return rcvTask->endTime();
 }
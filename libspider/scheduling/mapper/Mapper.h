@@ -57,6 +57,8 @@ namespace spider {
 
         class Schedule;
 
+        class FifoAllocator;
+
         /* === Class definition === */
 
         class Mapper {
@@ -83,14 +85,44 @@ namespace spider {
              */
             void map(sched::PiSDFTask *task, Schedule *schedule);
 
+            /**
+             * @brief Called once every task of the schedule starting at a given position has been mapped, before they
+             *        are sent.
+             * @remark Default does nothing. Mappers placing tasks in idle slots reorder the tasks by start time.
+             * @param schedule pointer to the schedule.
+             * @param offset   position of the first task mapped since previous call.
+             */
+            inline virtual void commit(Schedule *, size_t) { }
+
+            /**
+             * @brief Reset the internal state of the mapper (called at the end of every graph iteration).
+             */
+            inline virtual void clear() { }
+
             /* === Getter(s) === */
 
             /* === Setter(s) === */
 
             inline void setStartTime(ufast64 time) { startTime_ = time; }
 
+            /**
+             * @brief Set the FifoAllocator placing the buffers read by the mapped tasks.
+             * @remark SEND / RECEIVE tasks are inserted between tasks mapped on different clusters, unless the buffer
+             *         is placed in the cluster of its consumer (see @refitem FifoAllocator::isPlacedWithConsumer).
+             * @param allocator Pointer to the allocator (nullptr if buffers always stay with their producer).
+             */
+            inline void setFifoAllocator(const FifoAllocator *allocator) { allocator_ = allocator; }
+
         protected:
 
+            /**
+             * @brief Constructor for mappers placing tasks in idle slots of the PEs.
+             * @remark With slot insertion, the last dependency of a task on a LRT is the one with the greatest start
+             *         time instead of the one with the greatest schedule index.
+             * @param slotInsertion Enable / disable slot insertion.
+             */
+            explicit Mapper(bool slotInsertion) : slotInsertion_{ slotInsertion } { }
+
             struct MappingResult {
                 const PE *mappingPE{ nullptr };
                 ufast64 startTime{ UINT_FAST64_MAX };
@@ -110,19 +142,86 @@ namespace spider {
             virtual const PE *
             findPE(const Cluster *cluster, const Stats &stats, const Task *task, ufast64 minStartTime) const = 0;
 
+            /**
+             * @brief Select the PE and the time slot of a task inside a cluster (no communication involved).
+             * @remark Default implementation appends the task after the last task of the PE found by
+             *         @refitem Mapper::findPE. The slot is only taken once given to @refitem Mapper::reserveSlot.
+             * @param cluster       Cluster to go through.
+             * @param schedule      Pointer to the schedule.
+             * @param task          Pointer to the vertexTask.
+             * @param minStartTime  Lower bound for start time.
+             * @return mapping result of the task, mappingPE is nullptr if no fit was found.
+             */
+            virtual MappingResult
+            findSlot(const Cluster *cluster, const Schedule *schedule, const Task *task, ufast64 minStartTime);
+
+            /**
+             * @brief Mark the slot selected by @refitem Mapper::findSlot as taken.
+             * @remark Default does nothing, the schedule statistics already give the end time of every PE.
+             * @param result Mapping result of the task.
+             */
+            inline virtual void reserveSlot(const MappingResult &) { }
+
+            /**
+             * @brief Estimate, for every cluster, the cost of the communications that mapping a task on this cluster
+             *        would force onto the successors of the task.
+             * @remark Default does nothing. Only called on multi cluster platforms, before choosing the cluster of
+             *         the task. The costs are added to the schedule cost of the best fit PE of every cluster.
+             * @param task     Pointer to the task.
+             * @param schedule Pointer to the schedule.
+             * @param costs    Array of costs indexed by cluster to fill (set to 0 beforehand).
+             */
+            inline virtual void computeSuccessorsCost(PiSDFTask *, const Schedule *, ufast64 *) { }
+
+            /**
+             * @brief Called once a task has been mapped on a multi cluster platform.
+             * @remark Default does nothing.
+             * @param task     Pointer to the task.
+             * @param schedule Pointer to the schedule.
+             */
+            inline virtual void onTaskMapped(PiSDFTask *, const Schedule *) { }
+
         private:
 
+            spider::vector<u32> comRates_{ factory::vector<u32>(StackID::GENERAL) }; /* = Scratch buffer for the data received from each LRT = */
+            spider::vector<ufast64> successorsCosts_{ factory::vector<ufast64>(StackID::GENERAL) }; /* = Scratch buffer for the cost of the successors on each cluster = */
+            const FifoAllocator *allocator_{ nullptr };
             ufast64 startTime_{ 0U };
+            bool slotInsertion_{ false };
 
             /* === Private method(s) === */
 
+            /**
+             * @brief Dispatch the mapping of a task to the single cluster fast path whenever possible.
+             * @remark When built with SINGLE_CLUSTER_PLATFORM, the multi cluster path is never instantiated.
+             * @param task     Pointer to the task.
+             * @param schedule Pointer to the schedule.
+             */
             template<class T>
             void mapImpl(T *task, Schedule *schedule);
 
+            /**
+             * @brief Map a task on a platform with a single shared memory cluster.
+             * @remark No communication cost is evaluated and no SEND / RECEIVE task is ever inserted.
+             * @param task     Pointer to the task.
+             * @param schedule Pointer to the schedule.
+             */
+            template<class T>
+            void mapOnSingleCluster(T *task, Schedule *schedule);
+
+            /**
+             * @brief Map a task on a platform with multiple clusters.
+             * @param task     Pointer to the task.
+             * @param schedule Pointer to the schedule.
+             */
+            template<class T>
+            void mapOnMultiCluster(T *task, Schedule *schedule);
+
             /**
              * @brief Compute the minimum start time possible for a given task.
              * @param task      Pointer to the task.
              * @param schedule  Pointer to the schedule.
+             * @param comRates  Array of data received from each LRT to fill (ignored if nullptr).
              * @return value of the minimum start time possible
              */
             ufast64 computeStartTime(Task *task, const Schedule *schedule, u32 *comRates) const;
@@ -131,10 +230,26 @@ namespace spider {
              * @brief Compute the minimum start time possible for a given task.
              * @param task         Pointer to the task.
              * @param schedule     Pointer to the schedule.
+             * @param comRates     Array of data received from each LRT to fill (ignored if nullptr).
              * @return value of the minimum start time possible
              */
             ufast64 computeStartTime(PiSDFTask *task, const Schedule *schedule, u32 *comRates) const;
 
+            /**
+             * @brief Check if a source task is executed after the task currently recorded as last dependency on a LRT.
+             * @param srcStartTime Start time of the source task.
+             * @param srcEndTime   End time of the source task.
+             * @param srcTaskIx    Schedule index of the source task.
+             * @param currentJob   Schedule index of the recorded task.
+             * @param schedule     Pointer to the schedule.
+             * @return true if the source task is executed after, false else.
+             */
+            bool isExecutedAfter(u64 srcStartTime,
+                                 u64 srcEndTime,
+                                 u32 srcTaskIx,
+                                 u32 currentJob,
+                                 const Schedule *schedule) const;
+
             /**
              * @brief Compute the communication cost and the data size that would need to be send if a vertexTask is mapped
              *        on a given PE.
@@ -148,15 +263,40 @@ namespace spider {
                                                                         const Schedule *schedule,
                                                                         const u32 *comRates);
 
-            void mapCommunications(MappingResult &mappingInfo, Task *task, Schedule *schedule) const;
+            /**
+             * @brief Successors of legacy SRDAG tasks are not evaluated.
+             */
+            inline void computeSuccessorsCost(Task *, const Schedule *, ufast64 *) { }
+
+            inline void onTaskMapped(Task *, const Schedule *) { }
+
+            /**
+             * @brief Map the SEND / RECEIVE tasks needed by the dependencies of a task mapped on another cluster.
+             * @param mappingInfo Mapping result of the task.
+             * @param task        Pointer to the task.
+             * @param schedule    Pointer to the schedule.
+             * @return end time of the last RECEIVE task, 0 if none was mapped.
+             */
+            ufast64 mapCommunications(const MappingResult &mappingInfo, Task *task, Schedule *schedule);
 
-            void mapCommunications(MappingResult &mappingInfo, PiSDFTask *task, Schedule *schedule) const;
+            ufast64 mapCommunications(const MappingResult &mappingInfo, PiSDFTask *task, Schedule *schedule);
 
-            void mapCommunications(MappingResult &mappingInfo,
-                                   Task *task,
-                                   Task *srcTask,
-                                   size_t depIx,
-                                   Schedule *schedule) const;
+            /**
+             * @brief Map the SEND / RECEIVE tasks copying one input buffer of a task to the cluster of the task.
+             * @param mappingInfo Mapping result of the task.
+             * @param task        Pointer to the task.
+             * @param srcTask     Pointer to the producer of the buffer.
+             * @param fifoIx      Index of the input fifo of the task reading the buffer.
+             * @param wholeBuffer Whether the task reads the whole output of the producer.
+             * @param schedule    Pointer to the schedule.
+             * @return end time of the RECEIVE task, 0 if the buffer is already in the cluster of the task.
+             */
+            ufast64 mapCommunications(const MappingResult &mappingInfo,
+                                      Task *task,
+                                      Task *srcTask,
+                                      size_t fifoIx,
+                                      bool wholeBuffer,
+                                      Schedule *schedule);
 
         };
     }
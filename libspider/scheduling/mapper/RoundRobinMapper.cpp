@@ -44,7 +44,7 @@
 /* === Method(s) implementation === */
 
 spider::sched::RoundRobinMapper::RoundRobinMapper() : Mapper() {
-    currentPeIx_ = spider::make_unique(make_n<size_t, StackID::SCHEDULE>(archi::platform()->clusterCount(), 0));
+    currentPeIx_ = spider::make_unique(make_n<size_t, StackID::GENERAL>(archi::platform()->clusterCount(), 0));
 }
 
 /* === Private method(s) implementation === */
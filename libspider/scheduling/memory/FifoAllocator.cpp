@@ -35,17 +35,61 @@
 /* === Include(s) === */
 
 #include <scheduling/memory/FifoAllocator.h>
+#include <scheduling/task/Task.h>
 #include <graphs/pisdf/Graph.h>
 #include <archi/MemoryInterface.h>
 #include <api/archi-api.h>
+#include <archi/Platform.h>
+#include <cstddef>
+
+/* === Static variable(s) === */
+
+/* = In lifetime aware mode, buffers are located at their virtual address in a physical region (see
+ *   MemoryInterface::reserveRegion): virtual addresses are aligned as malloc would align the buffers = */
+static constexpr size_t MAX_BUFFER_ALIGNMENT = alignof(std::max_align_t);
+
+/* === Static function(s) === */
+
+static inline size_t alignUp(size_t address, size_t alignment) {
+    return (address + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Natural alignment of a buffer: largest power of two dividing its size, capped to MAX_BUFFER_ALIGNMENT.
+ * @remark A buffer of n elements of type T has a size multiple of alignof(T), tiny buffers are thus not padded.
+ */
+static inline size_t bufferAlignment(size_t size) {
+    const auto alignment = size & (~size + 1);
+    return (alignment && (alignment < MAX_BUFFER_ALIGNMENT)) ? alignment : MAX_BUFFER_ALIGNMENT;
+}
 
 /* === Function(s) definition === */
 
+spider::sched::FifoAllocator::FifoAllocator(FifoAllocatorTraits traits, FifoAllocatorType type) :
+        traits_{ traits },
+        freeRanges_{ factory::vector<spider::vector<range_t>>(StackID::GENERAL) },
+        liveFifos_{ factory::unordered_map<size_t, liveFifo_t>(StackID::GENERAL) },
+        pendingReads_{ factory::vector<std::pair<size_t, size_t>>(StackID::GENERAL) },
+        placements_{ factory::unordered_map<size_t, u16>(StackID::GENERAL) },
+        type_{ type } {
+
+}
+
 void spider::sched::FifoAllocator::clear() noexcept {
+    peakVirtualMemorySize_ = std::max(peakVirtualMemorySize_, virtualMemorySize());
     virtualMemoryAddress_ = reservedMemory_;
+    for (auto &ranges : freeRanges_) {
+        ranges.clear();
+    }
+    liveFifos_.clear();
+    pendingReads_.clear();
+    placements_.clear();
 }
 
 size_t spider::sched::FifoAllocator::allocate(size_t size) {
+    if (reuseEnabled()) {
+        virtualMemoryAddress_ = alignUp(virtualMemoryAddress_, bufferAlignment(size));
+    }
     const auto address = virtualMemoryAddress_;
     if (log::enabled<log::MEMORY>()) {
         log::print<log::MEMORY>(log::green, "INFO:", "VIRTUAL: allocating %zu bytes at address %zu.\n", size,
@@ -55,6 +99,122 @@ size_t spider::sched::FifoAllocator::allocate(size_t size) {
     return address;
 }
 
+size_t spider::sched::FifoAllocator::allocate(size_t size, size_t lrtIx, i32 uses) {
+    if (!reuseEnabled()) {
+        return allocate(size);
+    }
+    if (freeRanges_.size() <= lrtIx) {
+        freeRanges_.resize(archi::platform()->LRTCount(), factory::vector<range_t>(StackID::GENERAL));
+    }
+    /* == First fit (aligned) in the dead ranges of the LRT, fall back to the end of the address space == */
+    size_t address = SIZE_MAX;
+    auto &ranges = freeRanges_[lrtIx];
+    for (auto it = std::begin(ranges); it != std::end(ranges); ++it) {
+        const auto start = alignUp(it->address_, bufferAlignment(size));
+        const auto end = it->address_ + it->size_;
+        if (start + size <= end) {
+            address = start;
+            const auto head = range_t{ it->address_, start - it->address_ };
+            const auto tail = range_t{ start + size, end - (start + size) };
+            if (tail.size_) {
+                *it = tail;
+                if (head.size_) {
+                    ranges.insert(it, head);
+                }
+            } else if (head.size_) {
+                *it = head;
+            } else {
+                ranges.erase(it);
+            }
+            if (log::enabled<log::MEMORY>()) {
+                log::print<log::MEMORY>(log::green, "INFO:", "VIRTUAL: reusing %zu bytes at address %zu.\n", size,
+                                        address);
+            }
+            break;
+        }
+    }
+    if (address == SIZE_MAX) {
+        address = allocate(size);
+    }
+    track(address, size, uses);
+    return address;
+}
+
+void spider::sched::FifoAllocator::track(size_t address, size_t size, i32 uses) {
+    if (reuseEnabled() && (uses > 0) && size) {
+        liveFifos_[address] = liveFifo_t{ size, uses, SIZE_MAX };
+    }
+}
+
+void spider::sched::FifoAllocator::read(size_t address, size_t lrtIx) {
+    if (type_ == FifoAllocatorType::LIFETIME_AWARE) {
+        pendingReads_.emplace_back(address, lrtIx);
+    }
+}
+
+void spider::sched::FifoAllocator::pin(size_t address) {
+    if (type_ == FifoAllocatorType::LIFETIME_AWARE) {
+        liveFifos_.erase(address);
+    }
+}
+
+void spider::sched::FifoAllocator::commitReads() {
+    for (const auto &read : pendingReads_) {
+        auto it = liveFifos_.find(read.first);
+        if (it == std::end(liveFifos_)) {
+            continue;
+        }
+        auto &fifo = it->second;
+        if (fifo.lrtIx_ == SIZE_MAX) {
+            fifo.lrtIx_ = read.second;
+        } else if (fifo.lrtIx_ != read.second) {
+            /* == Readers on several LRTs: nothing orders them with a future writer == */
+            liveFifos_.erase(it);
+            continue;
+        }
+        if (!(--fifo.uses_)) {
+            releaseRange(range_t{ read.first, fifo.size_ }, fifo.lrtIx_);
+            liveFifos_.erase(it);
+        }
+    }
+    pendingReads_.clear();
+}
+
+void spider::sched::FifoAllocator::place(size_t address, size_t clusterIx) {
+    if (placementEnabled()) {
+        placements_[address] = static_cast<u16>(clusterIx);
+    }
+}
+
+void spider::sched::FifoAllocator::locate(Fifo &fifo) const {
+    fifo.memoryIx_ = Fifo::LOCAL_MEMORY;
+    if (placements_.empty() || (fifo.attribute_ == FifoAttribute::RW_EXT) ||
+        (fifo.attribute_ == FifoAttribute::RW_ONLY)) {
+        return;
+    }
+    auto it = placements_.find(fifo.address_);
+    if (it != std::end(placements_)) {
+        fifo.memoryIx_ = it->second;
+    }
+}
+
+bool spider::sched::FifoAllocator::isPlacedWithConsumer(const Task *producer, bool wholeBuffer) const {
+    /* == Buffers are allocated when their producer is sent: the consumer has to be mapped before == */
+    return placementEnabled() && wholeBuffer && (producer->state() == TaskState::READY) &&
+           allocatesOutputs(producer);
+}
+
+void spider::sched::FifoAllocator::reserveRegion() const {
+    if (!reuseEnabled()) {
+        return;
+    }
+    const auto base = alignUp(reservedMemory_, MAX_BUFFER_ALIGNMENT);
+    if (virtualMemorySize() > base) {
+        auto *interface = archi::platform()->spiderGRTPE()->cluster()->memoryInterface();
+        interface->reserveRegion(static_cast<uint64_t>(base), static_cast<uint64_t>(virtualMemorySize() - base));
+    }
+}
+
 void spider::sched::FifoAllocator::allocatePersistentDelays(pisdf::Graph *graph) {
     const auto *grt = archi::platform()->spiderGRTPE();
     auto *interface = grt->cluster()->memoryInterface();
@@ -72,3 +232,34 @@ void spider::sched::FifoAllocator::allocatePersistentDelays(pisdf::Graph *graph)
     }
     virtualMemoryAddress_ = reservedMemory_;
 }
+
+/* === Private method(s) === */
+
+void spider::sched::FifoAllocator::releaseRange(range_t range, size_t lrtIx) {
+    auto &ranges = freeRanges_[lrtIx];
+    auto it = std::lower_bound(std::begin(ranges), std::end(ranges), range.address_,
+                               [](const range_t &lhs, size_t address) { return lhs.address_ < address; });
+    /* == Merge with the following range == */
+    if ((it != std::end(ranges)) && (range.address_ + range.size_ == it->address_)) {
+        range.size_ += it->size_;
+        it = ranges.erase(it);
+    }
+    /* == Merge with the previous range == */
+    if ((it != std::begin(ranges)) && (std::prev(it)->address_ + std::prev(it)->size_ == range.address_)) {
+        std::prev(it)->size_ += range.size_;
+        return;
+    }
+    ranges.insert(it, range);
+}
+
+bool spider::sched::FifoAllocator::reuseEnabled() const {
+    return (type_ == FifoAllocatorType::LIFETIME_AWARE) && (archi::platform()->clusterCount() == 1);
+}
+
+bool spider::sched::FifoAllocator::placementEnabled() const {
+#ifdef _SPIDER_SINGLE_CLUSTER
+    return false;
+#else
+    return (type_ == FifoAllocatorType::ARCHI_AWARE) && (archi::platform()->clusterCount() > 1);
+#endif
+}
@@ -40,6 +40,8 @@
 #include <runtime/common/Fifo.h>
 #include <scheduling/memory/JobFifos.h>
 #include <graphs-tools/numerical/dependencies.h>
+#include <containers/vector.h>
+#include <containers/unordered_map.h>
 
 namespace spider {
 
@@ -61,6 +63,8 @@ namespace spider {
 
     namespace sched {
 
+        class Task;
+
         class PiSDFTask;
 
         class SRDAGTask;
@@ -69,6 +73,8 @@ namespace spider {
 
         class Schedule;
 
+        class ScheduleCache;
+
         /* === Class definition === */
 
         class FifoAllocator {
@@ -102,6 +108,82 @@ namespace spider {
              */
             size_t allocate(size_t size);
 
+            /**
+             * @brief Allocate size bytes for a fifo written by a task mapped on a given LRT.
+             * @remark In lifetime aware mode, the range of a dead fifo whose every reader was mapped on the same LRT
+             *         may be returned: the runner of the LRT executes the readers before the writer of the new fifo.
+             * @param size  Size to allocate.
+             * @param lrtIx Virtual index of the LRT of the writer.
+             * @param uses  Number of fifos that will read the buffer (if <= 0, the range is never reused).
+             * @return address of allocated buffer
+             */
+            size_t allocate(size_t size, size_t lrtIx, i32 uses);
+
+            /**
+             * @brief Track the reads of a part of a buffer given by @refitem allocate(size).
+             * @remark Used when several firings of a producer write distinct parts of the same buffer: each part
+             *         is released on its own.
+             * @param address Virtual address of the part.
+             * @param size    Size of the part.
+             * @param uses    Number of fifos that will read the part (if <= 0, the part is never reused).
+             */
+            void track(size_t address, size_t size, i32 uses);
+
+            /**
+             * @brief Record a read of a buffer given by @refitem allocate(size, lrtIx, uses) or @refitem track.
+             * @remark The read only takes effect on the next call to @refitem commitReads, so that the writer of
+             *         the fifos of a task can not get the range of one of its inputs.
+             * @param address Virtual address of the buffer.
+             * @param lrtIx   Virtual index of the LRT of the reader.
+             */
+            void read(size_t address, size_t lrtIx);
+
+            /**
+             * @brief Prevent a buffer from being reused in the current iteration.
+             * @remark Used when a buffer is forwarded to other fifos (fork / duplicate): readers of these fifos are
+             *         not accounted in the uses of the buffer.
+             * @param address Virtual address of the buffer.
+             */
+            void pin(size_t address);
+
+            /**
+             * @brief Apply the reads recorded since last call, ranges of buffers without remaining use become free.
+             */
+            void commitReads();
+
+            /**
+             * @brief Record the cluster whose memory interface holds a buffer.
+             * @remark Only recorded by the architecture aware allocator on multi cluster platforms.
+             * @param address   Virtual address of the buffer.
+             * @param clusterIx Index of the cluster.
+             */
+            void place(size_t address, size_t clusterIx);
+
+            /**
+             * @brief Set the memory location of an output fifo writing a buffer recorded with @refitem place.
+             * @remark Input fifos are always local: consumers are either co-located with their buffer or read the copy
+             *         made by a RECEIVE task. Fifos forwarded by fork / duplicate live with the forwarding task.
+             * @param fifo Fifo to locate (set to Fifo::LOCAL_MEMORY if the buffer was not placed).
+             */
+            void locate(Fifo &fifo) const;
+
+            /**
+             * @brief Check if the buffer read by a consumer is placed in the cluster of this consumer.
+             * @remark Only a buffer read as a whole by a single consumer mapped before its producer is sent is placed
+             *         with this consumer, any other buffer stays in the cluster of its producer.
+             * @param producer    Pointer to the mapped producer of the buffer.
+             * @param wholeBuffer Whether the consumer reads the whole output of the producer.
+             * @return true if the consumer does not need a copy of the buffer, false else.
+             */
+            bool isPlacedWithConsumer(const Task *producer, bool wholeBuffer) const;
+
+            /**
+             * @brief Back the virtual address space of the iteration with one physical region of the memory interface.
+             * @remark Only done in lifetime aware mode, called at iteration boundaries (before @refitem clear): the
+             *         ranges reused by the allocator then map to the same physical bytes in the next iterations.
+             */
+            void reserveRegion() const;
+
             /**
              * @brief Reserve memory for permanent delays.
              * @param graph pointer to the graph.
@@ -110,17 +192,22 @@ namespace spider {
 
 #ifndef _NO_BUILD_LEGACY_RT
 
-            inline virtual spider::unique_ptr<JobFifos> buildJobFifos(SRDAGTask *) {
-                return spider::make_unique<JobFifos>(0, 0);
+            inline virtual void buildJobFifos(SRDAGTask *, JobFifos &fifos) {
+                fifos.reset(0, 0);
             }
 
 #endif
 
             inline virtual void updateDynamicBuffersCount() { }
 
-            inline virtual spider::unique_ptr<JobFifos> buildJobFifos(PiSDFTask *, JobFifos *) {
-                return spider::make_unique<JobFifos>(0, 0);
-            }
+            inline virtual void buildJobFifos(PiSDFTask *, JobFifos &) { }
+
+            /**
+             * @brief Check if a task allocates its output buffers.
+             * @remark Fork / duplicate tasks forward their input buffer and extern tasks use external buffers.
+             * @return true if the output buffers of the task may be placed, false else.
+             */
+            inline virtual bool allocatesOutputs(const Task *) const { return true; }
 
             /* === Getter(s) === */
 
@@ -128,7 +215,20 @@ namespace spider {
              * @brief Get the type of the FifoAllocator
              * @return @refitem FifoAllocatorType
              */
-            inline virtual FifoAllocatorType type() const { return FifoAllocatorType::DEFAULT; };
+            inline FifoAllocatorType type() const { return type_; };
+
+            /**
+             * @brief Get the size of the virtual address space used by the fifos of the current iteration.
+             * @return size in bytes (persistent delays included).
+             */
+            inline size_t virtualMemorySize() const { return virtualMemoryAddress_; }
+
+            /**
+             * @brief Get the largest virtual address space used by the fifos of an iteration.
+             * @remark Updated on @refitem clear.
+             * @return size in bytes (persistent delays included).
+             */
+            inline size_t peakVirtualMemorySize() const { return peakVirtualMemorySize_; }
 
             /* === Setter(s) === */
 
@@ -138,15 +238,73 @@ namespace spider {
              */
             inline void setSchedule(const Schedule *schedule) { schedule_ = schedule; }
 
+            /**
+             * @brief Set the schedule cache recording the notifications sent by the FifoAllocator.
+             * @param cache Pointer to the cache (nullptr to disable).
+             */
+            inline void setScheduleCache(ScheduleCache *cache) { cache_ = cache; }
+
         private:
+            struct range_t {
+                size_t address_;
+                size_t size_;
+            };
+
+            struct liveFifo_t {
+                size_t size_;
+                i32 uses_;
+                size_t lrtIx_; /* = LRT of the readers (SIZE_MAX until the first read) = */
+            };
+
             const Schedule *schedule_ = nullptr;
+            ScheduleCache *cache_ = nullptr;
             size_t reservedMemory_ = 0;
             size_t virtualMemoryAddress_ = 0;
+            size_t peakVirtualMemorySize_ = 0;
+            /* = Free ranges sorted by address, one list per LRT = */
+            spider::vector<spider::vector<range_t>> freeRanges_;
+            spider::unordered_map<size_t, liveFifo_t> liveFifos_;
+            spider::vector<std::pair<size_t, size_t>> pendingReads_;
+            /* = Cluster holding the buffers (architecture aware mode) = */
+            spider::unordered_map<size_t, u16> placements_;
+
+            /**
+             * @brief Give back a range to the free list of a LRT, merging it with contiguous free ranges.
+             * @param range Range to release.
+             * @param lrtIx Virtual index of the LRT.
+             */
+            void releaseRange(range_t range, size_t lrtIx);
 
         protected:
-            explicit FifoAllocator(FifoAllocatorTraits traits) noexcept: traits_{ traits } {
+            FifoAllocatorType type_ = FifoAllocatorType::DEFAULT;
 
-            }
+            explicit FifoAllocator(FifoAllocatorTraits traits, FifoAllocatorType type = FifoAllocatorType::DEFAULT);
+
+            /**
+             * @brief Get the schedule set with @refitem setSchedule.
+             * @return pointer to the schedule.
+             */
+            inline const Schedule *schedule() const { return schedule_; }
+
+            /**
+             * @brief Get the schedule cache set with @refitem setScheduleCache.
+             * @return pointer to the cache (may be nullptr).
+             */
+            inline ScheduleCache *scheduleCache() const { return cache_; }
+
+            /**
+             * @brief Check if dead fifos may be reused.
+             * @remark Ranges are only reused on single cluster platforms, readers of other clusters read copies made
+             *         by synchronization tasks.
+             * @return true if lifetime aware mode is enabled and usable, false else.
+             */
+            bool reuseEnabled() const;
+
+            /**
+             * @brief Check if buffers are placed in the memory of the cluster of their consumers.
+             * @return true if architecture aware mode is enabled and the platform has several clusters, false else.
+             */
+            bool placementEnabled() const;
         };
     }
 }
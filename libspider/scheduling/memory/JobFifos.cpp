@@ -43,10 +43,29 @@ spider::JobFifos::JobFifos(u32 inputFifoCount, u32 outputFifoCount) :
         inputFifos_{ spider::allocate<Fifo, StackID::RUNTIME>(inputFifoCount) },
         outputFifos_{ spider::allocate<Fifo, StackID::RUNTIME>(outputFifoCount) },
         inputFifoCount_{ inputFifoCount },
-        outputFifoCount_{ outputFifoCount } {
+        outputFifoCount_{ outputFifoCount },
+        inputFifoCapacity_{ inputFifoCount },
+        outputFifoCapacity_{ outputFifoCount } {
 
 }
 
+void spider::JobFifos::reset(u32 inputFifoCount, u32 outputFifoCount) {
+    reserve(inputFifoCount, outputFifoCount);
+    inputFifoCount_ = inputFifoCount;
+    outputFifoCount_ = outputFifoCount;
+}
+
+void spider::JobFifos::reserve(u32 inputFifoCapacity, u32 outputFifoCapacity) {
+    if (inputFifoCapacity > inputFifoCapacity_) {
+        inputFifos_ = spider::make_unique(spider::allocate<Fifo, StackID::RUNTIME>(inputFifoCapacity));
+        inputFifoCapacity_ = inputFifoCapacity;
+    }
+    if (outputFifoCapacity > outputFifoCapacity_) {
+        outputFifos_ = spider::make_unique(spider::allocate<Fifo, StackID::RUNTIME>(outputFifoCapacity));
+        outputFifoCapacity_ = outputFifoCapacity;
+    }
+}
+
 spider::array_handle<spider::Fifo> spider::JobFifos::inputFifos() const {
     return make_handle(inputFifos_.get(), inputFifoCount_);
 }
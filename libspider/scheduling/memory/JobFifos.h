@@ -47,6 +47,8 @@ namespace spider {
 
     class JobFifos {
     public:
+        JobFifos() = default;
+
         JobFifos(u32 inputFifoCount, u32 outputFifoCount);
 
         ~JobFifos() = default;
@@ -61,6 +63,24 @@ namespace spider {
 
         /* === Method(s) === */
 
+        /**
+         * @brief Resize the fifo arrays to the given counts.
+         * @remark Memory is only re-allocated if the new counts exceed the current capacity so that a recycled
+         *         JobFifos does not allocate once it has reached its steady state size.
+         * @remark Content of the fifos is left unspecified.
+         * @param inputFifoCount  New number of input fifos.
+         * @param outputFifoCount New number of output fifos.
+         */
+        void reset(u32 inputFifoCount, u32 outputFifoCount);
+
+        /**
+         * @brief Grow the capacity of the fifo arrays to at least the given values (counts are left unchanged).
+         * @remark Content of the fifos is left unspecified if any array is re-allocated.
+         * @param inputFifoCapacity  Minimum capacity of the input fifo array.
+         * @param outputFifoCapacity Minimum capacity of the output fifo array.
+         */
+        void reserve(u32 inputFifoCapacity, u32 outputFifoCapacity);
+
         /* === Getter(s) === */
 
         /**
@@ -103,6 +123,22 @@ namespace spider {
          */
         size_t outputFifoCount() const;
 
+        /**
+         * @brief Returns the capacity of the input fifo array.
+         * @return capacity of the input fifo array.
+         */
+        inline u32 inputFifoCapacity() const {
+            return inputFifoCapacity_;
+        }
+
+        /**
+         * @brief Returns the capacity of the output fifo array.
+         * @return capacity of the output fifo array.
+         */
+        inline u32 outputFifoCapacity() const {
+            return outputFifoCapacity_;
+        }
+
         /* === Setter(s) === */
 
         /**
@@ -124,6 +160,8 @@ namespace spider {
         spider::unique_ptr<Fifo> outputFifos_;
         u32 inputFifoCount_ = 0;
         u32 outputFifoCount_ = 0;
+        u32 inputFifoCapacity_ = 0;
+        u32 outputFifoCapacity_ = 0;
     };
 }
 #endif //SPIDER2_JOBFIFOS_H
@@ -36,6 +36,8 @@
 
 #include <scheduling/memory/pisdf-based/PiSDFFifoAllocator.h>
 #include <scheduling/task/PiSDFTask.h>
+#include <scheduling/schedule/Schedule.h>
+#include <scheduling/schedule/ScheduleCache.h>
 #include <graphs/pisdf/ExternInterface.h>
 #include <graphs/pisdf/Graph.h>
 #include <graphs-tools/transformation/pisdf/GraphFiring.h>
@@ -45,6 +47,8 @@
 #include <runtime/platform/RTPlatform.h>
 #include <runtime/communicator/RTCommunicator.h>
 #include <runtime-api.h>
+#include <archi/PE.h>
+#include <archi/Cluster.h>
 
 /* === Function(s) definition === */
 
@@ -64,12 +68,19 @@ void spider::sched::PiSDFFifoAllocator::updateDynamicBuffersCount() {
         if (count > 0) {
             const auto sndIx = task->mappedLRT()->virtualIx();
             const auto grtIx = archi::platform()->spiderGRTPE()->virtualIx();
-            const auto address = task->handler()->getEdgeAddress(edge, it->firing_);
+            const auto address = getEdgeAddress(task->handler(), edge, it->firing_);
             auto addrNotifcation = Notification{ NotificationType::MEM_UPDATE_COUNT, grtIx, address };
             auto countNotifcation = Notification{ NotificationType::MEM_UPDATE_COUNT, grtIx,
                                                   static_cast<size_t>(count - 1) };
-            rt::platform()->communicator()->push(addrNotifcation, sndIx);
-            rt::platform()->communicator()->push(countNotifcation, sndIx);
+            auto *cache = scheduleCache();
+            if (cache) {
+                cache->record(addrNotifcation, sndIx);
+                cache->record(countNotifcation, sndIx);
+            }
+            if (!cache || !cache->muted()) {
+                rt::platform()->communicator()->push(addrNotifcation, sndIx);
+                rt::platform()->communicator()->push(countNotifcation, sndIx);
+            }
             spider::out_of_order_erase(dynamicBuffers_, it);
         } else {
             it++;
@@ -77,30 +88,35 @@ void spider::sched::PiSDFFifoAllocator::updateDynamicBuffersCount() {
     }
 }
 
-spider::unique_ptr<spider::JobFifos>
-spider::sched::PiSDFFifoAllocator::buildJobFifos(PiSDFTask *task, JobFifos *fifos) {
+void spider::sched::PiSDFFifoAllocator::buildJobFifos(PiSDFTask *task, JobFifos &fifos) {
     const auto *vertex = task->vertex();
     const auto *handler = task->handler();
     const auto firing = task->firing();
     /* == Allocate input fifos == */
-    auto *inputFifos = fifos->inputFifos().data();
+    auto *inputFifos = fifos.inputFifos().data();
     for (const auto *edge : vertex->inputEdges()) {
         const auto depCount = handler->getEdgeDepCount(vertex, edge, firing);
         if (depCount > 1) {
-            buildMergeFifo(inputFifos, handler, edge, firing);
+            buildMergeFifo(inputFifos, handler, edge, task);
             inputFifos += depCount + 1;
         } else {
-            buildSingleFifo(inputFifos, handler, edge, firing);
+            buildSingleFifo(inputFifos, handler, edge, task);
             inputFifos += 1;
         }
     }
     /* == Allocate output fifos == */
-    allocate(task, fifos);
-    auto *outputFifos = fifos->outputFifos().data();
+    allocate(task, &fifos);
+    auto *outputFifos = fifos.outputFifos().data();
     for (const auto *edge : vertex->outputEdges()) {
         buildOutputFifo(*(outputFifos++), edge, task);
     }
-    return spider::make_unique(fifos);
+    /* == Inputs are released once outputs are allocated so that they can not share a range == */
+    commitReads();
+}
+
+bool spider::sched::PiSDFFifoAllocator::allocatesOutputs(const Task *task) const {
+    const auto *pisdfTask = static_cast<const PiSDFTask *>(task);
+    return !isForwardingTask(pisdfTask) && (pisdfTask->vertex()->subtype() != pisdf::VertexType::EXTERN_IN);
 }
 
 /* === Private methods === */
@@ -144,7 +160,24 @@ void spider::sched::PiSDFFifoAllocator::allocate(PiSDFTask *task, const JobFifos
                     handler->setEdgeAddress(ext->address(), edge, 0);
                 } else {
                     const auto size = static_cast<size_t>(handler->getSrcRate(edge));
-                    handler->setEdgeAddress(FifoAllocator::allocate(size * handler->getRV(vertex)), edge, firing);
+                    const auto rv = handler->getRV(vertex);
+                    const auto uses = isSharedEdge(handler, edge) ? 0 : fifos->outputFifo(edge->sourcePortIx()).count_;
+                    if (rv == 1) {
+                        const auto address = FifoAllocator::allocate(size, task->mappedLRT()->virtualIx(), uses);
+                        handler->setEdgeAddress(address, edge, firing);
+                    } else {
+                        /* == Firings write their part of the buffer allocated by the first one to be sent, they
+                         *    may run on different LRTs so the buffer itself only reuses a dead range when there is
+                         *    a single LRT == */
+                        if (handler->getEdgeAddress(edge, 0) == SIZE_MAX) {
+                            const auto address = archi::platform()->LRTCount() == 1 ?
+                                                 FifoAllocator::allocate(size * rv, task->mappedLRT()->virtualIx(), 0) :
+                                                 FifoAllocator::allocate(size * rv);
+                            handler->setEdgeAddress(address, edge, firing);
+                        }
+                        track(getEdgeAddress(handler, edge, firing), size, uses);
+                    }
+                    placeOutputBuffer(task, edge, getEdgeAddress(handler, edge, firing));
                 }
             }
             break;
@@ -154,26 +187,27 @@ void spider::sched::PiSDFFifoAllocator::allocate(PiSDFTask *task, const JobFifos
 void spider::sched::PiSDFFifoAllocator::buildSingleFifo(Fifo *fifos,
                                                         const pisdf::GraphFiring *handler,
                                                         const pisdf::Edge *edge,
-                                                        u32 firing) {
-    auto lambda = [fifos](const pisdf::DependencyInfo &dep) {
+                                                        const PiSDFTask *task) {
+    auto lambda = [this, fifos, task](const pisdf::DependencyInfo &dep) {
         Fifo fifo{ };
         if (dep.vertex_) {
             const auto *srcEdge = dep.vertex_->outputEdge(dep.edgeIx_);
             const auto size = dep.memoryEnd_ - dep.memoryStart_ + 1;
             fifo = buildInputFifo(srcEdge, size, dep.memoryStart_, dep.firingStart_, dep.handler_);
+            readInputFifo(fifo, dep, task);
         }
         fifos[0] = fifo;
     };
-    pisdf::detail::computeExecDependency(handler, edge, firing, lambda);
+    pisdf::detail::computeExecDependency(handler, edge, task->firing(), lambda);
 }
 
 void spider::sched::PiSDFFifoAllocator::buildMergeFifo(Fifo *fifos,
                                                        const pisdf::GraphFiring *handler,
                                                        const pisdf::Edge *edge,
-                                                       u32 firing) {
+                                                       const PiSDFTask *task) {
     /* == Allocate the Fifos == */
     u32 fifoIx = 1;
-    auto lambda = [fifos, &fifoIx](const pisdf::DependencyInfo &dep) {
+    auto lambda = [this, fifos, task, &fifoIx](const pisdf::DependencyInfo &dep) {
         if (!dep.vertex_ || !dep.handler_) {
             return;
         }
@@ -182,13 +216,31 @@ void spider::sched::PiSDFFifoAllocator::buildMergeFifo(Fifo *fifos,
             const auto memStart = k == dep.firingStart_ ? dep.memoryStart_ : 0;
             const auto memEnd = k == dep.firingEnd_ ? dep.memoryEnd_ : static_cast<u32>(dep.rate_) - 1;
             fifos[fifoIx] = buildInputFifo(srcEdge, memEnd - memStart + 1, memStart, k, dep.handler_);
+            readInputFifo(fifos[fifoIx], dep, task);
             fifoIx++;
         }
     };
     const auto snkRate = handler->getSnkRate(edge);
-    pisdf::detail::computeExecDependency(handler, edge, firing, lambda);
-    /* == Allocate merged fifo == */
-    fifos[0].address_ = FifoAllocator::allocate(static_cast<size_t>(snkRate));
+    pisdf::detail::computeExecDependency(handler, edge, task->firing(), lambda);
+    if (isContiguousMerge(fifos + 1, fifoIx - 1)) {
+        /* == Every parts are already laid out contiguously in the same buffer: read it in place == */
+        const auto partCount = static_cast<i32>(fifoIx - 1);
+        fifos[0] = fifos[1];
+        fifos[0].size_ = static_cast<u32>(snkRate);
+        /* == Owned buffer is released once per part: the read takes the extra uses == */
+        fifos[0].count_ = fifos[0].attribute_ == FifoAttribute::RW_OWN ? 1 - partCount : 0;
+        for (u32 i = 1; i < fifoIx; ++i) {
+            fifos[i] = Fifo{ SIZE_MAX, 0u, 0u, 0, FifoAttribute::DUMMY };
+        }
+        return;
+    }
+    /* == Allocate merged fifo (only read by the task itself, unless it forwards it) == */
+    const auto lrtIx = task->mappedLRT()->virtualIx();
+    const auto isForwarded = isForwardingTask(task);
+    fifos[0].address_ = FifoAllocator::allocate(static_cast<size_t>(snkRate), lrtIx, isForwarded ? 0 : 1);
+    if (!isForwarded) {
+        read(fifos[0].address_, lrtIx);
+    }
     fifos[0].size_ = static_cast<u32>(snkRate);
     fifos[0].offset_ = fifoIx - 1;
     fifos[0].count_ = 1;
@@ -201,8 +253,8 @@ spider::Fifo spider::sched::PiSDFFifoAllocator::buildInputFifo(const pisdf::Edge
                                                                u32 firing,
                                                                const pisdf::GraphFiring *handler) {
     Fifo fifo{ };
-    fifo.address_ = handler->getEdgeAddress(edge, firing);
-    fifo.offset_ = handler->getEdgeOffset(edge, firing) + offset;
+    fifo.address_ = getEdgeAddress(handler, edge, firing);
+    fifo.offset_ = getEdgeOffset(handler, edge, firing) + offset;
     fifo.size_ = size;
     fifo.count_ = 0;
     fifo.attribute_ = FifoAttribute::RW_OWN;
@@ -216,10 +268,11 @@ spider::Fifo spider::sched::PiSDFFifoAllocator::buildInputFifo(const pisdf::Edge
 void spider::sched::PiSDFFifoAllocator::buildOutputFifo(Fifo &fifo, const pisdf::Edge *edge, const PiSDFTask *task) {
     auto *handler = task->handler();
     const auto firing = task->firing();
-    fifo.address_ = handler->getEdgeAddress(edge, firing);
-    fifo.offset_ = handler->getEdgeOffset(edge, firing);
+    const auto isShared = isSharedEdge(handler, edge);
+    fifo.address_ = getEdgeAddress(handler, edge, firing);
+    fifo.offset_ = getEdgeOffset(handler, edge, firing);
     fifo.size_ = static_cast<u32>(handler->getSrcRate(edge));
-    fifo.attribute_ = FifoAttribute::RW_OWN;
+    fifo.attribute_ = isShared ? FifoAttribute::W_SHARED : FifoAttribute::RW_OWN;
     if (!fifo.count_) {
         /* == Dynamic case, the FIFO will be automatically managed == */
         fifo.count_ = 1;
@@ -227,6 +280,15 @@ void spider::sched::PiSDFFifoAllocator::buildOutputFifo(Fifo &fifo, const pisdf:
     } else if (fifo.count_ < 0) {
         fifo.count_ = 1;
         fifo.attribute_ = FifoAttribute::W_SINK;
+        if (isShared) {
+            /* == Nobody reads this firing, do not keep the shared region alive for it == */
+            fifo.address_ = FifoAllocator::allocate(fifo.size_);
+            fifo.offset_ = 0;
+        }
+    }
+    if (fifo.attribute_ == FifoAttribute::W_SHARED) {
+        /* == Producer acquires the whole region == */
+        fifo.size_ *= handler->getRV(edge->source());
     }
     /* == Set attribute == */
     const auto sourceSubType = edge->source()->subtype();
@@ -239,4 +301,107 @@ void spider::sched::PiSDFFifoAllocator::buildOutputFifo(Fifo &fifo, const pisdf:
     } else if (sourceSubType == pisdf::VertexType::FORK || sourceSubType == pisdf::VertexType::DUPLICATE) {
         fifo.attribute_ = FifoAttribute::RW_ONLY;
     }
+    locate(fifo);
+}
+
+void spider::sched::PiSDFFifoAllocator::placeOutputBuffer(PiSDFTask *task, const pisdf::Edge *edge, size_t address) {
+    if (!placementEnabled()) {
+        return;
+    }
+    const auto *schedule = this->schedule();
+    size_t readerCount = 0;
+    auto clusterIx = task->mappedPe()->cluster()->ix();
+    const auto lambda = [schedule, &readerCount, &clusterIx](const pisdf::DependencyInfo &dep) {
+        if (!dep.vertex_ || !dep.handler_ || (dep.rate_ <= 0)) {
+            return;
+        }
+        readerCount += dep.firingEnd_ - dep.firingStart_ + 1;
+        if (readerCount != 1) {
+            return;
+        }
+        const auto *snkTask = schedule->task(dep.handler_->getTaskIx(dep.vertex_, dep.firingStart_),
+                                             dep.handler_->getTask(dep.vertex_), dep.firingStart_);
+        if (snkTask && (snkTask->state() == TaskState::READY)) {
+            clusterIx = snkTask->mappedPe()->cluster()->ix();
+        }
+    };
+    const auto firing = task->firing();
+    pisdf::detail::computeConsDependency(task->handler(), edge, firing, lambda);
+    task->setOnFiring(firing);
+    place(address, readerCount == 1 ? clusterIx : task->mappedPe()->cluster()->ix());
+}
+
+void spider::sched::PiSDFFifoAllocator::readInputFifo(const Fifo &fifo,
+                                                      const pisdf::DependencyInfo &dep,
+                                                      const PiSDFTask *task) {
+    if ((type_ != FifoAllocatorType::LIFETIME_AWARE) || (fifo.attribute_ != FifoAttribute::RW_OWN)) {
+        return;
+    }
+    /* == Buffers forwarded by fork / duplicate are owned by their original producer == */
+    const auto sourceSubType = dep.vertex_->subtype();
+    if (sourceSubType == pisdf::VertexType::FORK || sourceSubType == pisdf::VertexType::DUPLICATE) {
+        return;
+    }
+    if (isForwardingTask(task)) {
+        pin(fifo.address_);
+    } else {
+        read(fifo.address_, task->mappedLRT()->virtualIx());
+    }
+}
+
+bool spider::sched::PiSDFFifoAllocator::isForwardingTask(const PiSDFTask *task) {
+    const auto subType = task->vertex()->subtype();
+    return (subType == pisdf::VertexType::FORK) || (subType == pisdf::VertexType::DUPLICATE);
+}
+
+bool spider::sched::PiSDFFifoAllocator::isSharedEdge(const pisdf::GraphFiring *handler, const pisdf::Edge *edge) {
+    if (archi::platform()->clusterCount() > 1) {
+        /* == Synchronization tasks copy single fifos between memory interfaces == */
+        return false;
+    }
+    const auto sourceSubType = edge->source()->subtype();
+    if (sourceSubType == pisdf::VertexType::FORK || sourceSubType == pisdf::VertexType::DUPLICATE ||
+        sourceSubType == pisdf::VertexType::EXTERN_IN || edge->sink()->subtype() == pisdf::VertexType::EXTERN_OUT) {
+        return false;
+    }
+    const auto srcRate = handler->getSrcRate(edge);
+    const auto snkRate = handler->getSnkRate(edge);
+    return (srcRate > 0) && (snkRate > 0) && (srcRate % snkRate) && (handler->getRV(edge->source()) > 1);
+}
+
+size_t spider::sched::PiSDFFifoAllocator::getEdgeAddress(const pisdf::GraphFiring *handler,
+                                                         const pisdf::Edge *edge,
+                                                         u32 firing) {
+    return handler->getEdgeAddress(edge, isSharedEdge(handler, edge) ? 0 : firing);
+}
+
+u32 spider::sched::PiSDFFifoAllocator::getEdgeOffset(const pisdf::GraphFiring *handler,
+                                                     const pisdf::Edge *edge,
+                                                     u32 firing) {
+    const auto offset = handler->getEdgeOffset(edge, firing);
+    if (isSharedEdge(handler, edge)) {
+        return offset + static_cast<u32>(handler->getSrcRate(edge)) * firing;
+    }
+    return offset;
+}
+
+bool spider::sched::PiSDFFifoAllocator::isContiguousMerge(const Fifo *fifos, u32 count) {
+    if ((count < 2) || (archi::platform()->clusterCount() > 1)) {
+        return false;
+    }
+    const auto &first = fifos[0];
+    if ((first.address_ == SIZE_MAX) ||
+        ((first.attribute_ != FifoAttribute::RW_OWN) && (first.attribute_ != FifoAttribute::RW_ONLY) &&
+         (first.attribute_ != FifoAttribute::RW_EXT))) {
+        return false;
+    }
+    for (u32 i = 1; i < count; ++i) {
+        const auto &previous = fifos[i - 1];
+        const auto &current = fifos[i];
+        if ((current.address_ != first.address_) || (current.attribute_ != first.attribute_) ||
+            (current.offset_ != previous.offset_ + previous.size_)) {
+            return false;
+        }
+    }
+    return true;
 }
@@ -52,8 +52,9 @@ namespace spider {
 
         class PiSDFFifoAllocator final : public FifoAllocator {
         public:
-            PiSDFFifoAllocator() : FifoAllocator({ true, true }),
-                                   dynamicBuffers_{ factory::vector<dynaBuffer_t>(StackID::SCHEDULE) } {
+            explicit PiSDFFifoAllocator(FifoAllocatorType type = FifoAllocatorType::DEFAULT) :
+                    FifoAllocator({ true, true }, type),
+                    dynamicBuffers_{ factory::vector<dynaBuffer_t>(StackID::GENERAL) } {
 
             }
 
@@ -66,11 +67,13 @@ namespace spider {
             void updateDynamicBuffersCount() final;
 
             /**
-             * @brief Creates the fifos needed for the runtime execution of a task.
+             * @brief Fills the fifos needed for the runtime execution of a task.
              * @param task     Pointer to the task.
-             * @return @refitem unique_ptr of @refitem JobFifos
+             * @param fifos    JobFifos to fill (should already be sized for the task).
              */
-            spider::unique_ptr<JobFifos> buildJobFifos(PiSDFTask *task, JobFifos *fifos) final;
+            void buildJobFifos(PiSDFTask *task, JobFifos &fifos) final;
+
+            bool allocatesOutputs(const Task *task) const final;
 
         private:
             struct dynaBuffer_t {
@@ -92,10 +95,10 @@ namespace spider {
              * @param fifos Pointer to the fifo array (should be offsetted to the current fifo to be set).
              * @param dep   Execution dependency.
              */
-            static void buildSingleFifo(Fifo *fifos,
-                                        const pisdf::GraphFiring *handler,
-                                        const pisdf::Edge *edge,
-                                        u32 firing);
+            void buildSingleFifo(Fifo *fifos,
+                                 const pisdf::GraphFiring *handler,
+                                 const pisdf::Edge *edge,
+                                 const PiSDFTask *task);
 
             /**
              * @brief Creates a merged input fifo.
@@ -106,7 +109,69 @@ namespace spider {
             void buildMergeFifo(Fifo *fifos,
                                 const pisdf::GraphFiring *handler,
                                 const pisdf::Edge *edge,
-                                u32 firing);
+                                const PiSDFTask *task);
+
+            /**
+             * @brief Place the buffer of an output edge of a task in the cluster of its consumer.
+             * @remark The buffer stays in the cluster of the producer if it has several consumers or if its consumer
+             *         is not mapped yet (JIT policy), see @refitem FifoAllocator::isPlacedWithConsumer.
+             * @param task    Pointer to the producer task.
+             * @param edge    Pointer to the output edge.
+             * @param address Virtual address of the buffer.
+             */
+            void placeOutputBuffer(PiSDFTask *task, const pisdf::Edge *edge, size_t address);
+
+            /**
+             * @brief Account for the read of an input fifo by a task (see @refitem FifoAllocator::read).
+             * @param fifo Input fifo of the task.
+             * @param dep  Execution dependency the fifo was built from.
+             * @param task Pointer to the task.
+             */
+            void readInputFifo(const Fifo &fifo, const pisdf::DependencyInfo &dep, const PiSDFTask *task);
+
+            /**
+             * @brief Check if a task forwards its input buffers to its outputs instead of reading them.
+             * @param task Pointer to the task.
+             * @return true for fork and duplicate tasks, false else.
+             */
+            static bool isForwardingTask(const PiSDFTask *task);
+
+            /**
+             * @brief Check if every firings of the producer of an edge write in a single shared memory region.
+             * @remark This is the case when consumers may read data of several producer firings at once (rate of
+             *         the producer is not a multiple of the rate of the consumer). Readers can then read the
+             *         merged data in place instead of copying every producer buffer.
+             * @param handler Handler of the producer of the edge.
+             * @param edge    Pointer to the edge.
+             * @return true if the edge uses a shared region, false else.
+             */
+            static bool isSharedEdge(const pisdf::GraphFiring *handler, const pisdf::Edge *edge);
+
+            /**
+             * @brief Get the virtual address of the buffer written by a given firing of the producer of an edge.
+             * @param handler Handler of the producer of the edge.
+             * @param edge    Pointer to the edge.
+             * @param firing  Firing of the producer.
+             * @return virtual address of the buffer (of the shared region if @refitem isSharedEdge).
+             */
+            static size_t getEdgeAddress(const pisdf::GraphFiring *handler, const pisdf::Edge *edge, u32 firing);
+
+            /**
+             * @brief Get the offset in the buffer written by a given firing of the producer of an edge.
+             * @param handler Handler of the producer of the edge.
+             * @param edge    Pointer to the edge.
+             * @param firing  Firing of the producer.
+             * @return offset of the data of the firing in the buffer.
+             */
+            static u32 getEdgeOffset(const pisdf::GraphFiring *handler, const pisdf::Edge *edge, u32 firing);
+
+            /**
+             * @brief Check if the fifos of a merge can be read in place.
+             * @param fifos  Pointer to the first fifo to merge.
+             * @param count  Number of fifos to merge.
+             * @return true if the fifos are contiguous parts of the same buffer, false else.
+             */
+            static bool isContiguousMerge(const Fifo *fifos, u32 count);
 
             /**
              * @brief Creates an input @refitem spider::Fifo from raw information.
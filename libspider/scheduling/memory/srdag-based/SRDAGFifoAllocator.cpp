@@ -38,28 +38,50 @@
 
 #include <scheduling/memory/srdag-based/SRDAGFifoAllocator.h>
 #include <scheduling/task/SRDAGTask.h>
+#include <scheduling/schedule/Schedule.h>
 #include <graphs/srdag/SRDAGEdge.h>
 #include <graphs/srdag/SRDAGGraph.h>
 #include <graphs/pisdf/ExternInterface.h>
 #include <archi/MemoryInterface.h>
 #include <api/archi-api.h>
+#include <archi/PE.h>
+#include <archi/Cluster.h>
 
 /* === Function(s) definition === */
 
-spider::unique_ptr<spider::JobFifos> spider::sched::SRDAGFifoAllocator::buildJobFifos(SRDAGTask *task) {
+void spider::sched::SRDAGFifoAllocator::buildJobFifos(SRDAGTask *task, JobFifos &fifos) {
     const auto *vertex = task->vertex();
-    auto fifos = spider::make_unique<JobFifos, StackID::RUNTIME>(static_cast<u32>(vertex->inputEdgeCount()),
-                                                                 static_cast<u32>(vertex->outputEdgeCount()));
+    fifos.reset(static_cast<u32>(vertex->inputEdgeCount()), static_cast<u32>(vertex->outputEdgeCount()));
+    const auto isForwarding = (vertex->subtype() == pisdf::VertexType::FORK) ||
+                              (vertex->subtype() == pisdf::VertexType::DUPLICATE);
     /* == Allocate input fifos == */
     for (const auto *edge : vertex->inputEdges()) {
-        fifos->setInputFifo(edge->sinkPortIx(), buildInputFifo(edge));
+        const auto fifo = buildInputFifo(edge);
+        fifos.setInputFifo(edge->sinkPortIx(), fifo);
+        /* == Buffers forwarded by fork / duplicate are owned by their original producer == */
+        const auto sourceSubType = edge->source()->subtype();
+        if ((fifo.attribute_ == FifoAttribute::RW_OWN) && (sourceSubType != pisdf::VertexType::FORK) &&
+            (sourceSubType != pisdf::VertexType::DUPLICATE)) {
+            if (isForwarding) {
+                pin(fifo.address_);
+            } else {
+                read(fifo.address_, task->mappedLRT()->virtualIx());
+            }
+        }
     }
     /* == Allocate output fifos == */
     allocate(task);
     for (const auto *edge : vertex->outputEdges()) {
-        fifos->setOutputFifo(edge->sourcePortIx(), buildOutputFifo(edge));
+        fifos.setOutputFifo(edge->sourcePortIx(), buildOutputFifo(edge));
     }
-    return fifos;
+    /* == Inputs are released once outputs are allocated so that they can not share a range == */
+    commitReads();
+}
+
+bool spider::sched::SRDAGFifoAllocator::allocatesOutputs(const Task *task) const {
+    const auto subType = static_cast<const SRDAGTask *>(task)->vertex()->subtype();
+    return (subType != pisdf::VertexType::FORK) && (subType != pisdf::VertexType::DUPLICATE) &&
+           (subType != pisdf::VertexType::EXTERN_IN);
 }
 
 /* === Private methods === */
@@ -94,15 +116,31 @@ void spider::sched::SRDAGFifoAllocator::allocate(SRDAGTask *task) {
                     const auto *ext = edge->sink()->reference()->convertTo<pisdf::ExternInterface>();
                     edge->setAddress(ext->address());
                 } else {
-                    edge->setAddress(FifoAllocator::allocate(static_cast<size_t>(edge->rate())));
+                    edge->setAddress(FifoAllocator::allocate(static_cast<size_t>(edge->rate()),
+                                                             task->mappedLRT()->virtualIx(), 1));
                     edge->setOffset(0);
+                    placeOutputBuffer(task, edge);
                 }
             }
             break;
     }
 }
 
-spider::Fifo spider::sched::SRDAGFifoAllocator::buildInputFifo(const srdag::Edge *edge) {
+void spider::sched::SRDAGFifoAllocator::placeOutputBuffer(const SRDAGTask *task, const srdag::Edge *edge) {
+    if (!placementEnabled()) {
+        return;
+    }
+    /* == In the SR-DAG, the only reader of the buffer is the sink of the edge == */
+    const auto producerClusterIx = task->mappedPe()->cluster()->ix();
+    const auto *snkTask = schedule()->task(edge->sink()->scheduleTaskIx());
+    if (!snkTask || (snkTask->state() != TaskState::READY)) {
+        place(edge->address(), producerClusterIx);
+        return;
+    }
+    place(edge->address(), snkTask->mappedPe()->cluster()->ix());
+}
+
+spider::Fifo spider::sched::SRDAGFifoAllocator::buildInputFifo(const srdag::Edge *edge) const {
     Fifo fifo{ };
     fifo.address_ = edge->address();
     fifo.offset_ = edge->offset();
@@ -116,7 +154,7 @@ spider::Fifo spider::sched::SRDAGFifoAllocator::buildInputFifo(const srdag::Edge
     return fifo;
 }
 
-spider::Fifo spider::sched::SRDAGFifoAllocator::buildOutputFifo(const srdag::Edge *edge) {
+spider::Fifo spider::sched::SRDAGFifoAllocator::buildOutputFifo(const srdag::Edge *edge) const {
     Fifo fifo{ };
     fifo.address_ = edge->address();
     fifo.offset_ = edge->offset();
@@ -131,6 +169,7 @@ spider::Fifo spider::sched::SRDAGFifoAllocator::buildOutputFifo(const srdag::Edg
     } else if (sourceSubType == pisdf::VertexType::FORK || sourceSubType == pisdf::VertexType::DUPLICATE) {
         fifo.attribute_ = FifoAttribute::RW_ONLY;
     }
+    locate(fifo);
     return fifo;
 }
 
@@ -49,7 +49,8 @@ namespace spider {
 
         class SRDAGFifoAllocator final : public FifoAllocator {
         public:
-            SRDAGFifoAllocator() : FifoAllocator({ true, true }) {
+            explicit SRDAGFifoAllocator(FifoAllocatorType type = FifoAllocatorType::DEFAULT) :
+                    FifoAllocator({ true, true }, type) {
 
             }
 
@@ -58,19 +59,13 @@ namespace spider {
             /* === Method(s) === */
 
             /**
-             * @brief Creates the fifos needed for the runtime execution of a task.
-             * @param task Pointer to the task.
-             * @return @refitem unique_ptr of @refitem JobFifos
+             * @brief Fills the fifos needed for the runtime execution of a task.
+             * @param task  Pointer to the task.
+             * @param fifos JobFifos to fill (resized to the number of edges of the task).
              */
-            spider::unique_ptr<JobFifos> buildJobFifos(SRDAGTask *task) final;
-
-            /* === Getter(s) === */
+            void buildJobFifos(SRDAGTask *task, JobFifos &fifos) final;
 
-            /**
-             * @brief Get the type of the FifoAllocator
-             * @return @refitem FifoAllocatorType
-             */
-            FifoAllocatorType type() const final { return FifoAllocatorType::DEFAULT; };
+            bool allocatesOutputs(const Task *task) const final;
 
         private:
 
@@ -80,9 +75,17 @@ namespace spider {
              */
             void allocate(SRDAGTask *task);
 
-            static Fifo buildInputFifo(const srdag::Edge *edge);
+            /**
+             * @brief Place the buffer of an output edge of a task in the cluster of its consumer.
+             * @remark The buffer stays in the cluster of the producer if the consumer is not mapped yet (JIT policy).
+             * @param task Pointer to the producer task.
+             * @param edge Pointer to the output edge (with its address already set).
+             */
+            void placeOutputBuffer(const SRDAGTask *task, const srdag::Edge *edge);
+
+            Fifo buildInputFifo(const srdag::Edge *edge) const;
 
-            static Fifo buildOutputFifo(const srdag::Edge *edge);
+            Fifo buildOutputFifo(const srdag::Edge *edge) const;
 
         };
     }
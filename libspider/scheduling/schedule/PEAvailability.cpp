@@ -0,0 +1,93 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <scheduling/schedule/PEAvailability.h>
+#include <archi/Cluster.h>
+#include <archi/PE.h>
+
+/* === Method(s) implementation === */
+
+spider::PEAvailability::PEAvailability() :
+        buckets_{ factory::vector<spider::set<entry_t>>(StackID::GENERAL) },
+        clusterOffsets_{ factory::vector<size_t>(StackID::GENERAL) },
+        peBuckets_{ factory::vector<u32>(StackID::GENERAL) } {
+    const auto *platform = archi::platform();
+    const auto *grtPE = platform->spiderGRTPE();
+    auto hardwareTypes = factory::vector<u32>(StackID::GENERAL);
+    peBuckets_.resize(platform->PECount(), UINT32_MAX);
+    clusterOffsets_.reserve(platform->clusterCount() + 1);
+    for (const auto *cluster : platform->clusters()) {
+        const auto offset = buckets_.size();
+        clusterOffsets_.emplace_back(offset);
+        for (const auto *pe : cluster->peArray()) {
+            auto bucketIx = buckets_.size();
+            if (pe != grtPE) {
+                for (auto ix = offset; ix < buckets_.size(); ++ix) {
+                    if (hardwareTypes[ix] == pe->hardwareType()) {
+                        bucketIx = ix;
+                        break;
+                    }
+                }
+            }
+            if (bucketIx == buckets_.size()) {
+                buckets_.emplace_back(factory::set<entry_t>(StackID::GENERAL));
+                /* == The GRT never shares its bucket == */
+                hardwareTypes.emplace_back(pe == grtPE ? UINT32_MAX : pe->hardwareType());
+            }
+            peBuckets_[pe->virtualIx()] = static_cast<u32>(bucketIx);
+            buckets_[bucketIx].insert({ 0, static_cast<u32>(pe->virtualIx()) });
+        }
+    }
+    clusterOffsets_.emplace_back(buckets_.size());
+}
+
+void spider::PEAvailability::reset() {
+    for (auto &bucket : buckets_) {
+        bucket.clear();
+    }
+    for (size_t ix = 0; ix < peBuckets_.size(); ++ix) {
+        buckets_[peBuckets_[ix]].insert({ 0, static_cast<u32>(ix) });
+    }
+}
+
+void spider::PEAvailability::update(size_t ix, u64 oldTime, u64 newTime) {
+    if (oldTime == newTime) {
+        return;
+    }
+    auto &bucket = buckets_[peBuckets_[ix]];
+    bucket.erase({ oldTime, static_cast<u32>(ix) });
+    bucket.insert({ newTime, static_cast<u32>(ix) });
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_PEAVAILABILITY_H
+#define SPIDER2_PEAVAILABILITY_H
+
+/* === Include(s) === */
+
+#include <utility>
+#include <common/Types.h>
+#include <containers/vector.h>
+#include <containers/set.h>
+#include <api/archi-api.h>
+#include <archi/Platform.h>
+
+namespace spider {
+
+    class PE;
+
+    /* === Class definition === */
+
+    /**
+     * @brief Index of the PEs of the platform ordered by the time they become available.
+     * @remark PEs are split in buckets of interchangeable PEs: same cluster and same hardware type (i.e same
+     *         timings). The GRT always has its own bucket, mappers may then give it a penalty without breaking the
+     *         order of a bucket. Mappability being set per vertex, PEs a task can not be mapped on are skipped
+     *         when searching a bucket.
+     */
+    class PEAvailability {
+    public:
+
+        PEAvailability();
+
+        PEAvailability(PEAvailability &&) = default;
+
+        PEAvailability &operator=(PEAvailability &&) = default;
+
+        PEAvailability(const PEAvailability &) = delete;
+
+        PEAvailability &operator=(const PEAvailability &) = delete;
+
+        ~PEAvailability() = default;
+
+        /* === Method(s) === */
+
+        /**
+         * @brief Set every PE as available at time 0.
+         */
+        void reset();
+
+        /**
+         * @brief Update the time a PE becomes available.
+         * @param ix      Virtual index of the PE.
+         * @param oldTime Time the PE was available at so far.
+         * @param newTime Time the PE is now available at.
+         */
+        void update(size_t ix, u64 oldTime, u64 newTime);
+
+        /**
+         * @brief Find the best fit PE of a bucket for a task that can not start before a given time.
+         * @remark The best fit PE is the one available the latest before minStartTime (least idle time) or, if
+         *         none is, the earliest available one. Ties are broken by virtual index of the PEs.
+         * @param bucketIx      Index of the bucket.
+         * @param minStartTime  Lower bound for the start time of the task.
+         * @param filter        Predicate telling if a PE can be used.
+         * @return best fit PE, nullptr if no PE of the bucket can be used.
+         */
+        template<class Filter>
+        const PE *bestFit(size_t bucketIx, u64 minStartTime, Filter &&filter) const;
+
+        /* === Getter(s) === */
+
+        /**
+         * @brief Get the range of buckets of a cluster.
+         * @param clusterIx Index of the cluster.
+         * @return pair with the index of the first bucket and the index past the last one.
+         */
+        inline std::pair<size_t, size_t> clusterBuckets(size_t clusterIx) const {
+            return { clusterOffsets_[clusterIx], clusterOffsets_[clusterIx + 1] };
+        }
+
+    private:
+        using entry_t = std::pair<u64, u32>; /* = Available time and virtual index of a PE = */
+
+        spider::vector<spider::set<entry_t>> buckets_;
+        spider::vector<size_t> clusterOffsets_;
+        spider::vector<u32> peBuckets_;
+    };
+
+    /* === Inline method(s) === */
+
+    template<class Filter>
+    const PE *PEAvailability::bestFit(size_t bucketIx, u64 minStartTime, Filter &&filter) const {
+        const auto *platform = archi::platform();
+        const auto &bucket = buckets_[bucketIx];
+        const auto bound = bucket.upper_bound({ minStartTime, UINT32_MAX });
+        /* == Latest PE available before the start time, smallest index first among equal times == */
+        auto last = bound;
+        while (last != std::begin(bucket)) {
+            const auto time = std::prev(last)->first;
+            const auto first = bucket.lower_bound({ time, 0 });
+            for (auto it = first; it != last; ++it) {
+                const auto *pe = platform->peFromVirtualIx(it->second);
+                if (filter(pe)) {
+                    return pe;
+                }
+            }
+            last = first;
+        }
+        /* == Otherwise, earliest available PE == */
+        for (auto it = bound; it != std::end(bucket); ++it) {
+            const auto *pe = platform->peFromVirtualIx(it->second);
+            if (filter(pe)) {
+                return pe;
+            }
+        }
+        return nullptr;
+    }
+}
+
+#endif //SPIDER2_PEAVAILABILITY_H
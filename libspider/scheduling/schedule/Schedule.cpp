@@ -36,6 +36,9 @@
 
 #include <scheduling/schedule/Schedule.h>
 #include <archi/PE.h>
+#include <archi/Platform.h>
+#include <api/archi-api.h>
+#include <algorithm>
 
 /* === Static function === */
 
@@ -52,12 +55,55 @@ void spider::sched::Schedule::reserve(size_t size) {
 void spider::sched::Schedule::clear() {
     stats_.reset();
     tasks_.clear();
+    ownedTasks_.clear();
+    gapBegin_ = 0;
+    gapSize_ = 0;
+    staleOffset_ = SIZE_MAX;
+    staleShift_ = 0;
+}
+
+void spider::sched::Schedule::insertTasks(u32 pos, std::initializer_list<ComposedTask> l) {
+    const auto count = l.size();
+    moveGap(pos);
+    if (gapSize_ < count) {
+        /* == Growing the gap with the schedule keeps the cost of the insertions amortized linear == */
+        const auto growth = std::max(count, std::max(size_t{ 64 }, size() / 8));
+        tasks_.insert(std::next(std::begin(tasks_), static_cast<long>(gapBegin_ + gapSize_)), growth,
+                      ComposedTask{ nullptr, 0 });
+        gapSize_ += growth;
+    }
+    std::copy(std::begin(l), std::end(l), std::next(std::begin(tasks_), static_cast<long>(gapBegin_)));
+    gapBegin_ += count;
+    gapSize_ -= count;
+    updateInsertedIndexes(pos, count);
+}
+
+void spider::sched::Schedule::updateIndexes() {
+    refreshIndexes(staleOffset_, size());
+    staleOffset_ = SIZE_MAX;
+    staleShift_ = 0;
+}
+
+spider::sched::Task *spider::sched::Schedule::task(size_t ix, const Task *expected, u32 firing) const {
+    if (staleOffset_ == SIZE_MAX) {
+        return task(ix);
+    }
+    if (ix < staleOffset_) {
+        const auto &composedTask = tasks_[storageIx(ix)];
+        if (composedTask.first == expected && composedTask.second == firing) {
+            return task(ix);
+        }
+    }
+    /* == The task has not been walked since tasks were inserted before it == */
+    return task(ix + staleShift_);
 }
 
 void spider::sched::Schedule::reset() {
     for (auto &task : tasks_) {
-        task.first->setOnFiring(task.second);
-        task.first->setState(TaskState::READY);
+        if (task.first) {
+            task.first->setOnFiring(task.second);
+            task.first->setState(TaskState::READY);
+        }
     }
 }
 
@@ -72,11 +118,116 @@ void spider::sched::Schedule::updateTaskAndSetReady(Task *task, const PE *slave,
     task->setEndTime(endTime);
     task->setJobExecIx(static_cast<u32>(stats_.jobCount(peIx)));
     /* == Update schedule statistics == */
-    stats_.updateStartTime(peIx, startTime);
-    stats_.updateIDLETime(peIx, startTime - stats_.endTime(peIx));
-    stats_.updateEndTime(peIx, endTime);
-    stats_.updateLoadTime(peIx, endTime - startTime);
-    stats_.updateJobCount(peIx);
+    if (startTime < stats_.endTime(peIx)) {
+        /* == Task placed in an idle slot, its job index is fixed by sortByStartTime == */
+        stats_.insertJob(peIx, startTime, endTime);
+    } else {
+        stats_.updateStartTime(peIx, startTime);
+        stats_.updateIDLETime(peIx, startTime - stats_.endTime(peIx));
+        stats_.updateEndTime(peIx, endTime);
+        stats_.updateLoadTime(peIx, endTime - startTime);
+        stats_.updateJobCount(peIx);
+    }
     /* == Update job state == */
     task->setState(TaskState::READY);
 }
+
+void spider::sched::Schedule::sortByStartTime(size_t offset) {
+    if (offset >= size()) {
+        return;
+    }
+    updateIndexes();
+    struct SortEntry {
+        u64 startTime_;
+        u64 endTime_;
+        u32 ix_;
+        ComposedTask task_;
+    };
+    const auto count = size() - offset;
+    auto entries = factory::vector<SortEntry>(StackID::SCHEDULE);
+    entries.reserve(count);
+    for (auto i = offset; i < size(); ++i) {
+        const auto *current = task(i);
+        entries.push_back({ current->startTime(), current->endTime(), static_cast<u32>(i), tasks_[storageIx(i)] });
+    }
+    /* == Ties are broken with the previous index so that producers stay before their consumers == */
+    std::sort(std::begin(entries), std::end(entries), [](const SortEntry &a, const SortEntry &b) {
+        if (a.startTime_ != b.startTime_) {
+            return a.startTime_ < b.startTime_;
+        }
+        if (a.endTime_ != b.endTime_) {
+            return a.endTime_ < b.endTime_;
+        }
+        return a.ix_ < b.ix_;
+    });
+    const auto *platform = archi::platform();
+    auto newIndexes = factory::vector<u32>(count, UINT32_MAX, StackID::SCHEDULE);
+    auto jobIndexes = factory::vector<u32>(platform->PECount(), 0, StackID::SCHEDULE);
+    for (size_t k = 0; k < count; ++k) {
+        const auto ix = static_cast<u32>(offset + k);
+        tasks_[storageIx(ix)] = entries[k].task_;
+        newIndexes[entries[k].ix_ - offset] = ix;
+        auto *current = task(ix);
+        current->setIx(ix);
+        if (current->mappedPe()) {
+            jobIndexes[current->mappedPe()->virtualIx()]++;
+        }
+    }
+    /* == Job indexes of the sorted tasks start after the ones of the previous tasks == */
+    for (size_t i = 0; i < jobIndexes.size(); ++i) {
+        jobIndexes[i] = static_cast<u32>(stats_.jobCount(i)) - jobIndexes[i];
+    }
+    const auto lrtCount = platform->LRTCount();
+    for (auto i = offset; i < size(); ++i) {
+        auto *current = task(i);
+        if (current->mappedPe()) {
+            current->setJobExecIx(jobIndexes[current->mappedPe()->virtualIx()]++);
+        }
+        for (size_t lrtIx = 0; lrtIx < lrtCount; ++lrtIx) {
+            const auto syncIx = current->syncExecIxOnLRT(lrtIx);
+            if ((syncIx != UINT32_MAX) && (syncIx >= offset)) {
+                current->setSyncExecIxOnLRT(lrtIx, newIndexes[syncIx - offset]);
+            }
+        }
+    }
+}
+
+/* === Private method(s) implementation === */
+
+void spider::sched::Schedule::moveGap(size_t pos) {
+    if (!gapSize_) {
+        gapBegin_ = pos;
+        return;
+    }
+    auto begin = std::begin(tasks_);
+    const auto gapBegin = static_cast<long>(gapBegin_);
+    const auto gapEnd = static_cast<long>(gapBegin_ + gapSize_);
+    const auto position = static_cast<long>(pos);
+    if (pos < gapBegin_) {
+        std::move_backward(std::next(begin, position), std::next(begin, gapBegin), std::next(begin, gapEnd));
+    } else if (pos > gapBegin_) {
+        std::move(std::next(begin, gapEnd), std::next(begin, position + gapEnd - gapBegin), std::next(begin, gapBegin));
+    }
+    gapBegin_ = pos;
+}
+
+void spider::sched::Schedule::refreshIndexes(size_t begin, size_t end) const {
+    for (auto i = begin; i < end; ++i) {
+        auto &composedTask = tasks_[storageIx(i)];
+        composedTask.first->setOnFiring(composedTask.second);
+        composedTask.first->setIx(static_cast<u32>(i));
+    }
+}
+
+void spider::sched::Schedule::updateInsertedIndexes(size_t pos, size_t count) {
+    /* == Up to date tasks following the insertion would otherwise be off by count, not by staleShift_ + count == */
+    const auto upToDateEnd = (staleOffset_ == SIZE_MAX || staleOffset_ <= pos) ? pos + 1 : staleOffset_;
+    refreshIndexes(std::min(staleOffset_, pos), std::min(upToDateEnd + count, size()));
+    /* == Tasks following the insertion are now out of date == */
+    staleShift_ += count;
+    staleOffset_ = upToDateEnd + count;
+    if (staleOffset_ >= size()) {
+        staleOffset_ = SIZE_MAX;
+        staleShift_ = 0;
+    }
+}
@@ -52,9 +52,20 @@ namespace spider {
 
         using ComposedTask = std::pair<Task *, u32>;
 
+        /**
+         * @brief Ordered list of the tasks of an iteration with the statistics of their mapping.
+         * @remark Every task records its position in the schedule (see @refitem Task::ix). Inserting tasks (see
+         *         @refitem Schedule::insertTasks) only updates the inserted ones and the one they are inserted before,
+         *         the recorded position of the following tasks stays outdated until they are walked in order with
+         *         @refitem Schedule::walk or until @refitem Schedule::updateIndexes is called.
+         * @remark Getters never update the recorded positions: looking up a task from its recorded position with
+         *         @refitem Schedule::task(size_t) requires the indexes to be up to date, otherwise use
+         *         @refitem Schedule::task(size_t, const Task *, u32).
+         */
         class Schedule {
         public:
-            Schedule() : tasks_{ factory::vector<ComposedTask>(StackID::SCHEDULE) } {
+            Schedule() : tasks_{ factory::vector<ComposedTask>(StackID::GENERAL) },
+                         ownedTasks_{ factory::vector<spider::unique_ptr<Task>>(StackID::GENERAL) } {
 
             };
 
@@ -78,6 +89,7 @@ namespace spider {
 
             /**
              * @brief Clear schedule tasks.
+             * @remark Tasks owned by the schedule (see @refitem Schedule::ownTask) are destroyed.
              */
             void clear();
 
@@ -94,10 +106,20 @@ namespace spider {
              * @param slave     Slave (cluster and pe) to execute on.
              * @param startTime Start time of the vertexTask.
              * @param endTime   End time of the vertexTask.
+             * @remark If startTime is lower than the end time of the PE, the task is placed in an idle slot of the PE.
+             *         The schedule must then be reordered with @refitem Schedule::sortByStartTime before being sent.
              * @throw std::out_of_range if bad ix.
              */
             void updateTaskAndSetReady(Task *task, const PE *slave, u64 startTime, u64 endTime);
 
+            /**
+             * @brief Sort the tasks from a given position by start time and update their indexes accordingly.
+             * @remark Job index on PE and synchronization constraints of the sorted tasks are updated so that the order
+             *         of the schedule matches the execution order on every PE.
+             * @param offset  Position of the first task to sort.
+             */
+            void sortByStartTime(size_t offset);
+
             /**
              * @brief Add a task to the schedule
              * @remark Once added, memory of the task is handled by the schedule, DO NOT FREE it yourself.
@@ -105,39 +127,90 @@ namespace spider {
              */
             inline void addTask(Task *task, u32 firing = 0) {
                 if (task) {
+                    if (staleOffset_ != SIZE_MAX) {
+                        updateIndexes();
+                    }
                     task->setOnFiring(firing);
-                    task->setIx(static_cast<u32>(tasks_.size()));
+                    task->setIx(static_cast<u32>(size()));
                     tasks_.emplace_back(task, firing);
                 }
             }
 
-            template<class ...Args>
-            inline void insertTasks(u32 pos, Args &&...args) {
-                tasks_.insert(std::next(std::begin(tasks_), pos), std::forward<Args>(args)...);
-                for (auto i = pos; i < tasks_.size(); ++i) {
-                    task(i)->setIx(i);
-                }
+            /**
+             * @brief Insert tasks in the schedule before a given position.
+             * @remark Tasks are stored around a gap kept at the position of the last insertion so that inserting the
+             *         synchronization tasks while walking the schedule is linear. Only the inserted tasks and the task
+             *         they are inserted before get their index updated, the following ones are updated one after the
+             *         other when walking the schedule through @refitem Schedule::walk or at once by
+             *         @refitem Schedule::updateIndexes. Until then, their recorded index is off by the number of tasks
+             *         inserted before them, see @refitem Schedule::task(size_t, const Task *, u32).
+             * @param pos  Position of the insertion.
+             * @param l    Tasks to insert.
+             */
+            void insertTasks(u32 pos, std::initializer_list<ComposedTask> l);
+
+            /**
+             * @brief Give the ownership of a task created while scheduling (such as synchronization tasks) to the
+             *        schedule, the task is destroyed on @refitem Schedule::clear.
+             * @param task  Pointer to the task.
+             */
+            inline void ownTask(Task *task) {
+                ownedTasks_.emplace_back(task);
             }
 
-            inline void insertTasks(u32 pos, std::initializer_list<ComposedTask> &&l) {
-                tasks_.insert(std::next(std::begin(tasks_), pos), l);
-                for (auto i = pos; i < tasks_.size(); ++i) {
-                    task(i)->setIx(i);
+            /**
+             * @brief Update the index of every task following a previous insertion.
+             * @remark This must be called before looking up tasks by their index outside of a walk of the schedule.
+             */
+            void updateIndexes();
+
+            /**
+             * @brief Get the task at a given position of the schedule while walking it in order and set it on its
+             *        firing.
+             * @remark If the task is the first one with an outdated index, its index is updated so that walking the
+             *         whole schedule brings every index up to date, insertions included.
+             * @param ix  Position in the schedule.
+             * @return pointer to the task, nullptr if ix is out of range.
+             */
+            inline Task *walk(size_t ix) {
+                auto *task = this->task(ix);
+                if (task && (ix == staleOffset_)) {
+                    task->setIx(static_cast<u32>(ix));
+                    if (++staleOffset_ == size()) {
+                        staleOffset_ = SIZE_MAX;
+                        staleShift_ = 0;
+                    }
                 }
+                return task;
             }
 
             /* === Getter(s) === */
 
+            /**
+             * @brief Get the task at a given position of the schedule and set it on its firing.
+             * @param ix  Position in the schedule.
+             * @return pointer to the task, nullptr if ix is out of range.
+             */
             inline Task *task(size_t ix) const {
-                if (ix >= tasks_.size()) {
+                if (ix >= size()) {
                     return nullptr;
                 }
-                auto &composedTask = tasks_[ix];
+                auto &composedTask = tasks_[storageIx(ix)];
                 auto *task = composedTask.first;
                 task->setOnFiring(composedTask.second);
                 return task;
             }
 
+            /**
+             * @brief Get a task of the schedule from the index recorded for it, which may be outdated following an
+             *        insertion (see @refitem Schedule::insertTasks).
+             * @param ix        Recorded index of the task.
+             * @param expected  Task expected at this index.
+             * @param firing    Firing of the expected task.
+             * @return pointer to the task, nullptr if ix is out of range.
+             */
+            Task *task(size_t ix, const Task *expected, u32 firing) const;
+
             /**
              * @brief Get the different statistics of the platform.
              * @return const reference to @refitem Stats
@@ -169,12 +242,51 @@ namespace spider {
              * @return number of tasks in the schedule.
              */
             inline size_t size() const {
-                return tasks_.size();
+                return tasks_.size() - gapSize_;
             }
 
         private:
             spider::vector<ComposedTask> tasks_;
+            spider::vector<spider::unique_ptr<Task>> ownedTasks_; /* = Tasks created while scheduling = */
             Stats stats_;
+            size_t gapBegin_ = 0;                   /* = Storage position of the free slots left for insertions = */
+            size_t gapSize_ = 0;                    /* = Number of free slots left for insertions = */
+            size_t staleOffset_ = SIZE_MAX;         /* = Position of the first task whose index is outdated = */
+            size_t staleShift_ = 0;                 /* = Offset of the outdated indexes from their position = */
+
+            /* === Private method(s) === */
+
+            /**
+             * @brief Get the storage position of a task.
+             * @param ix Position of the task in the schedule.
+             * @return position of the task in the task vector.
+             */
+            inline size_t storageIx(size_t ix) const {
+                return ix < gapBegin_ ? ix : ix + gapSize_;
+            }
+
+            /**
+             * @brief Move the free slots of the task vector before a given position of the schedule.
+             * @remark Cost is linear in the distance between the current position of the gap and pos.
+             * @param pos Position of the schedule.
+             */
+            void moveGap(size_t pos);
+
+            /**
+             * @brief Set the index of the tasks in [begin, end) of the schedule.
+             * @param begin First position to update.
+             * @param end   Position following the last one to update.
+             */
+            void refreshIndexes(size_t begin, size_t end) const;
+
+            /**
+             * @brief Set the index of inserted tasks and of the task they were inserted before.
+             * @remark Tasks following the insertion with an up to date index are updated as well so that every outdated
+             *         index is off by the same number of positions.
+             * @param pos   Position of the insertion.
+             * @param count Number of inserted tasks.
+             */
+            void updateInsertedIndexes(size_t pos, size_t count);
         };
     }
 }
@@ -0,0 +1,304 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <scheduling/schedule/ScheduleCache.h>
+#include <scheduling/schedule/Schedule.h>
+#include <archi/Platform.h>
+#include <api/archi-api.h>
+#include <runtime/platform/RTPlatform.h>
+#include <runtime/communicator/RTCommunicator.h>
+#include <api/runtime-api.h>
+#include <memory/memory.h>
+#include <algorithm>
+
+/* === Method(s) implementation === */
+
+spider::sched::ScheduleCache::Round::Round() : key_{ factory::vector<i64>(StackID::RUNTIME) },
+                                               records_{ factory::vector<Record>(StackID::RUNTIME) },
+                                               jobs_{ factory::vector<Job>(StackID::RUNTIME) },
+                                               constraints_{ factory::vector<SyncInfo>(StackID::RUNTIME) },
+                                               fifos_{ factory::vector<Fifo>(StackID::RUNTIME) },
+                                               params_{ factory::vector<i64>(StackID::RUNTIME) },
+                                               flags_{ factory::vector<u8>(StackID::RUNTIME) } {
+
+}
+
+spider::sched::ScheduleCache::ScheduleCache(size_t capacity) :
+        iterations_{ factory::vector<Iteration>(StackID::RUNTIME) },
+        history_{ factory::vector<spider::vector<i64>>(StackID::RUNTIME) },
+        pending_{ factory::vector<i64>(StackID::RUNTIME) },
+        current_{ factory::vector<std::shared_ptr<Round>>(StackID::RUNTIME) },
+        capacity_{ capacity } {
+    if (!capacity_) {
+        throwSpiderException("schedule cache capacity must be greater than 0.");
+    }
+}
+
+void spider::sched::ScheduleCache::beginIteration() {
+    history_.clear();
+    pending_.clear();
+    current_.clear();
+    replayedIx_ = SIZE_MAX;
+    restoreCount_ = 0;
+    recording_ = false;
+    muted_ = false;
+    active_ = true;
+}
+
+void spider::sched::ScheduleCache::endIteration() {
+    if (!active_) {
+        return;
+    }
+    if (replayedIx_ != SIZE_MAX) {
+        /* == Every round was replayed, the iteration becomes the most recently used == */
+        const auto it = std::next(std::begin(iterations_), static_cast<long>(replayedIx_));
+        std::rotate(std::begin(iterations_), it, std::next(it));
+    } else if (!current_.empty()) {
+        /* == The recorded iteration becomes the most recently used == */
+        iterations_.emplace_back(std::move(current_));
+        std::rotate(std::begin(iterations_), std::prev(std::end(iterations_)), std::end(iterations_));
+        if (iterations_.size() > capacity_) {
+            iterations_.pop_back();
+        }
+        current_ = factory::vector<std::shared_ptr<Round>>(StackID::RUNTIME);
+    }
+    history_.clear();
+    pending_.clear();
+    replayedIx_ = SIZE_MAX;
+    restoreCount_ = 0;
+    recording_ = false;
+    muted_ = false;
+    active_ = false;
+}
+
+bool spider::sched::ScheduleCache::replay() {
+    if (!active_) {
+        throwSpiderException("schedule cache is not active.");
+    }
+    pushPendingKey();
+    restoreCount_ = 0;
+    if (!recording_) {
+        const auto ix = find();
+        if (ix != SIZE_MAX) {
+            replayedIx_ = ix;
+            send(*(iterations_[ix][roundIx()]));
+            hitCount_++;
+            return true;
+        }
+        /* == First miss of the iteration: the replayed rounds are shared with the recorded iteration == */
+        if (replayedIx_ != SIZE_MAX) {
+            const auto &replayed = iterations_[replayedIx_];
+            current_.assign(std::begin(replayed), std::next(std::begin(replayed), static_cast<long>(roundIx())));
+            restoreCount_ = roundIx();
+        }
+        replayedIx_ = SIZE_MAX;
+        recording_ = true;
+    }
+    auto round = spider::make_shared<Round, StackID::RUNTIME>();
+    round->key_ = history_.back();
+    current_.emplace_back(std::move(round));
+    missCount_++;
+    return false;
+}
+
+void spider::sched::ScheduleCache::receiveParams(u32 taskIx, const spider::vector<i64> &values) {
+    if (!active_) {
+        return;
+    }
+    pending_.emplace_back(static_cast<i64>(taskIx));
+    pending_.emplace_back(static_cast<i64>(values.size()));
+    pending_.insert(std::end(pending_), std::begin(values), std::end(values));
+}
+
+void spider::sched::ScheduleCache::restoreParams(size_t round, const Schedule *schedule) const {
+    const auto &key = history_.at(round + 1);
+    size_t i = 0;
+    while (i < key.size()) {
+        const auto taskIx = static_cast<size_t>(key[i]);
+        const auto count = static_cast<size_t>(key[i + 1]);
+        auto values = factory::vector<i64>(StackID::RUNTIME);
+        const auto first = std::next(std::begin(key), static_cast<long>(i + 2));
+        values.assign(first, std::next(first, static_cast<long>(count)));
+        schedule->task(taskIx)->receiveParams(values);
+        i += count + 2;
+    }
+}
+
+void spider::sched::ScheduleCache::record(const JobMessage *batch, size_t lrtIx) {
+    if (!recording_ || muted_) {
+        return;
+    }
+    auto &round = *(current_.back());
+    const auto lrtCount = archi::platform()->LRTCount();
+    size_t count = 0;
+    for (const auto *message = batch; message; message = message->next_) {
+        const auto inputFifos = message->fifos_.inputFifos();
+        const auto outputFifos = message->fifos_.outputFifos();
+        round.jobs_.push_back({ message->kernelIx_, message->execIx_, message->taskIx_, message->nParamsOut_,
+                                static_cast<u32>(message->execConstraints_.size()),
+                                static_cast<u32>(inputFifos.size()), static_cast<u32>(outputFifos.size()),
+                                static_cast<u32>(message->inputParams_.size()), message->notify_ });
+        round.constraints_.insert(std::end(round.constraints_), std::begin(message->execConstraints_),
+                                  std::end(message->execConstraints_));
+        round.fifos_.insert(std::end(round.fifos_), std::begin(inputFifos), std::end(inputFifos));
+        round.fifos_.insert(std::end(round.fifos_), std::begin(outputFifos), std::end(outputFifos));
+        round.params_.insert(std::end(round.params_), std::begin(message->inputParams_),
+                             std::end(message->inputParams_));
+        if (message->notify_) {
+            const auto *flags = message->synchronizationFlags_;
+            round.flags_.insert(std::end(round.flags_), flags, flags + lrtCount);
+        }
+        count++;
+    }
+    const auto grtIx = archi::platform()->getGRTIx();
+    round.records_.push_back({ Notification{ NotificationType::JOB_ADD, grtIx }, lrtIx, count });
+}
+
+void spider::sched::ScheduleCache::record(const Notification &notification, size_t lrtIx) {
+    if (!recording_ || muted_) {
+        return;
+    }
+    current_.back()->records_.push_back({ notification, lrtIx, 0 });
+}
+
+size_t spider::sched::ScheduleCache::expectedParamCount() const {
+    if (replayedIx_ != SIZE_MAX) {
+        return iterations_[replayedIx_][roundIx()]->expectedParamCount_;
+    }
+    if (!recording_) {
+        throwSpiderException("no round was replayed nor recorded.");
+    }
+    return current_.back()->expectedParamCount_;
+}
+
+void spider::sched::ScheduleCache::setExpectedParamCount(size_t count) {
+    if (recording_) {
+        current_.back()->expectedParamCount_ = count;
+    }
+}
+
+/* === Private method(s) implementation === */
+
+void spider::sched::ScheduleCache::pushPendingKey() {
+    /* == Parameters may be received in any order, entries are sorted by task index == */
+    auto entries = factory::vector<std::pair<i64, size_t>>(StackID::RUNTIME);
+    size_t i = 0;
+    while (i < pending_.size()) {
+        entries.emplace_back(pending_[i], i);
+        i += static_cast<size_t>(pending_[i + 1]) + 2;
+    }
+    std::sort(std::begin(entries), std::end(entries));
+    auto key = factory::vector<i64>(StackID::RUNTIME);
+    key.reserve(pending_.size());
+    for (const auto &entry : entries) {
+        const auto first = std::next(std::begin(pending_), static_cast<long>(entry.second));
+        key.insert(std::end(key), first, std::next(first, static_cast<long>(*(first + 1) + 2)));
+    }
+    history_.emplace_back(std::move(key));
+    pending_.clear();
+}
+
+size_t spider::sched::ScheduleCache::find() const {
+    const auto round = roundIx();
+    for (size_t i = 0; i < iterations_.size(); ++i) {
+        const auto &iteration = iterations_[i];
+        if (iteration.size() <= round) {
+            continue;
+        }
+        auto match = true;
+        for (size_t r = 0; match && (r <= round); ++r) {
+            match = iteration[r]->key_ == history_[r];
+        }
+        if (match) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+void spider::sched::ScheduleCache::send(const Round &round) {
+    auto *communicator = rt::platform()->communicator();
+    const auto lrtCount = archi::platform()->LRTCount();
+    auto job = std::begin(round.jobs_);
+    auto constraint = std::begin(round.constraints_);
+    auto fifo = std::begin(round.fifos_);
+    auto param = std::begin(round.params_);
+    auto flag = std::begin(round.flags_);
+    for (const auto &record : round.records_) {
+        if (!record.jobCount_) {
+            communicator->push(record.notification_, record.lrtIx_);
+            continue;
+        }
+        JobMessage *head = nullptr;
+        JobMessage *tail = nullptr;
+        for (size_t i = 0; i < record.jobCount_; ++i, ++job) {
+            auto *message = communicator->acquireJobMessage();
+            message->kernelIx_ = job->kernelIx_;
+            message->execIx_ = job->execIx_;
+            message->taskIx_ = job->taskIx_;
+            message->nParamsOut_ = job->nParamsOut_;
+            message->notify_ = job->notify_;
+            message->next_ = nullptr;
+            message->execConstraints_.assign(constraint, constraint + job->constraintCount_);
+            constraint += job->constraintCount_;
+            message->fifos_.reset(job->inputFifoCount_, job->outputFifoCount_);
+            for (u32 j = 0; j < job->inputFifoCount_; ++j) {
+                message->fifos_.setInputFifo(j, *(fifo++));
+            }
+            for (u32 j = 0; j < job->outputFifoCount_; ++j) {
+                message->fifos_.setOutputFifo(j, *(fifo++));
+            }
+            message->inputParams_.assign(param, param + job->paramCount_);
+            param += job->paramCount_;
+            auto *flags = message->synchronizationFlags_;
+            if (job->notify_) {
+                std::transform(flag, flag + lrtCount, flags, [](u8 value) { return value != 0; });
+                flag += lrtCount;
+            } else {
+                std::fill(flags, flags + lrtCount, false);
+            }
+            if (head) {
+                tail->next_ = message;
+            } else {
+                head = message;
+            }
+            tail = message;
+        }
+        auto notification = record.notification_;
+        notification.notificationIx_ = communicator->push(head, record.lrtIx_);
+        communicator->push(notification, record.lrtIx_);
+    }
+}
@@ -0,0 +1,257 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_SCHEDULECACHE_H
+#define SPIDER2_SCHEDULECACHE_H
+
+/* === Include(s) === */
+
+#include <memory>
+#include <common/Types.h>
+#include <containers/vector.h>
+#include <runtime/message/JobMessage.h>
+#include <runtime/message/Notification.h>
+#include <runtime/common/Fifo.h>
+
+namespace spider {
+
+    namespace sched {
+
+        class Schedule;
+
+        /* === Class definition === */
+
+        /**
+         * @brief LRU cache of the jobs sent to the runners during the iterations of a dynamic graph.
+         * @remark An iteration is made of rounds: every round schedules what was resolved by the parameters received
+         *         at the end of the previous one. The content of a round only depends on the parameter values
+         *         received so far in the iteration, which are used as key. On a hit, the recorded jobs and
+         *         notifications are sent as is, without scheduling, mapping or allocating anything. On the first
+         *         miss of an iteration, the replayed rounds have to be rebuilt silently (see
+         *         @refitem ScheduleCache::setMuted) before the iteration goes on normally and gets recorded.
+         */
+        class ScheduleCache final {
+        public:
+            explicit ScheduleCache(size_t capacity);
+
+            ~ScheduleCache() noexcept = default;
+
+            ScheduleCache(const ScheduleCache &) = delete;
+
+            ScheduleCache(ScheduleCache &&) = delete;
+
+            ScheduleCache &operator=(const ScheduleCache &) = delete;
+
+            ScheduleCache &operator=(ScheduleCache &&) = delete;
+
+            /* === Method(s) === */
+
+            /**
+             * @brief Start a new graph iteration, the cache stays active until @refitem ScheduleCache::endIteration.
+             */
+            void beginIteration();
+
+            /**
+             * @brief Store the recorded iteration (if any) as the most recently used one and deactivate the cache.
+             * @remark The least recently used iteration is evicted if the capacity is exceeded.
+             */
+            void endIteration();
+
+            /**
+             * @brief Start a new round of the current iteration and send its jobs if a cached iteration received the
+             *        same parameter values so far.
+             * @remark On a miss, every job and notification sent until the next round is recorded.
+             * @return true on hit, false else.
+             * @throw @refitem spider::Exception if the cache is not active.
+             */
+            bool replay();
+
+            /**
+             * @brief Register the parameter values sent by a task during the current round.
+             * @param taskIx  Index of the task in the schedule.
+             * @param values  Values of the parameters.
+             */
+            void receiveParams(u32 taskIx, const spider::vector<i64> &values);
+
+            /**
+             * @brief Give to the tasks of a schedule the parameter values they sent at the end of a given round.
+             * @param round    Round of the current iteration.
+             * @param schedule Pointer to the schedule.
+             */
+            void restoreParams(size_t round, const Schedule *schedule) const;
+
+            /**
+             * @brief Record a batch of jobs about to be pushed to a runner.
+             * @param batch  First message of the batch (messages are chained through JobMessage::next_).
+             * @param lrtIx  Index of the receiving runner.
+             */
+            void record(const JobMessage *batch, size_t lrtIx);
+
+            /**
+             * @brief Record a notification about to be pushed to a runner.
+             * @param notification  Notification.
+             * @param lrtIx         Index of the receiving runner.
+             */
+            void record(const Notification &notification, size_t lrtIx);
+
+            /* === Getter(s) === */
+
+            /**
+             * @brief Check if the cache is used for the current iteration.
+             */
+            inline bool active() const { return active_; }
+
+            /**
+             * @brief Check if jobs and notifications should be dropped instead of being pushed to the runners.
+             */
+            inline bool muted() const { return muted_; }
+
+            /**
+             * @brief Check if every round of the current iteration was replayed from the cache so far.
+             */
+            inline bool replaying() const { return replayedIx_ != SIZE_MAX; }
+
+            /**
+             * @brief Get the number of replayed rounds that have to be rebuilt before scheduling the current one.
+             * @remark Only non zero for the first round missed after a hit, the parameters received at the end of
+             *         every rebuilt round are given back with @refitem ScheduleCache::restoreParams.
+             */
+            inline size_t restoreCount() const { return restoreCount_; }
+
+            /**
+             * @brief Get the index of the current round of the iteration.
+             */
+            inline size_t roundIx() const { return history_.size() - 1; }
+
+            /**
+             * @brief Get the number of parameters expected at the end of the current round.
+             * @remark Only valid if the round was replayed or if @refitem ScheduleCache::setExpectedParamCount was
+             *         called for this round.
+             */
+            size_t expectedParamCount() const;
+
+            inline size_t capacity() const { return capacity_; }
+
+            inline size_t size() const { return iterations_.size(); }
+
+            /**
+             * @brief Get the number of rounds replayed from the cache.
+             */
+            inline size_t hitCount() const { return hitCount_; }
+
+            /**
+             * @brief Get the number of rounds that had to be scheduled.
+             */
+            inline size_t missCount() const { return missCount_; }
+
+            /* === Setter(s) === */
+
+            inline void setMuted(bool value) { muted_ = value; }
+
+            /**
+             * @brief Set the number of parameters expected at the end of the current (recorded) round.
+             * @param count Number of parameters.
+             */
+            void setExpectedParamCount(size_t count);
+
+        private:
+            struct Job {
+                u32 kernelIx_;
+                u32 execIx_;
+                u32 taskIx_;
+                u32 nParamsOut_;
+                u32 constraintCount_;
+                u32 inputFifoCount_;
+                u32 outputFifoCount_;
+                u32 paramCount_;
+                bool notify_;
+            };
+
+            struct Record {
+                Notification notification_; /* = Notification pushed after the jobs (if any) = */
+                size_t lrtIx_;              /* = Index of the receiving runner = */
+                size_t jobCount_;           /* = Number of jobs of the batch, 0 for a single notification = */
+            };
+
+            struct Round {
+                spider::vector<i64> key_;            /* = Parameters received at the end of the previous rounds = */
+                spider::vector<Record> records_;     /* = Pushed batches and notifications, in order = */
+                spider::vector<Job> jobs_;           /* = Core properties of the jobs of every batch = */
+                spider::vector<SyncInfo> constraints_;
+                spider::vector<Fifo> fifos_;
+                spider::vector<i64> params_;
+                spider::vector<u8> flags_;           /* = Notification flags of the jobs (LRTCount per notifying job) = */
+                size_t expectedParamCount_ = 0;
+
+                Round();
+            };
+
+            /* == Rounds are shared between iterations with the same beginning == */
+            using Iteration = spider::vector<std::shared_ptr<Round>>;
+
+            spider::vector<Iteration> iterations_;        /* = Cached iterations, most recently used first = */
+            spider::vector<spider::vector<i64>> history_; /* = Key of every round of the current iteration = */
+            spider::vector<i64> pending_;                 /* = Parameters received during the current round = */
+            Iteration current_;                           /* = Rounds of the iteration being recorded = */
+            size_t capacity_;
+            size_t replayedIx_ = SIZE_MAX;                /* = Cached iteration replayed so far = */
+            size_t restoreCount_ = 0;
+            size_t hitCount_ = 0;
+            size_t missCount_ = 0;
+            bool active_ = false;
+            bool recording_ = false;
+            bool muted_ = false;
+
+            /* === Private method(s) === */
+
+            /**
+             * @brief Move the parameters received during the last round to the history, sorted by task index.
+             */
+            void pushPendingKey();
+
+            /**
+             * @brief Search for a cached iteration matching the history of the current iteration.
+             * @return index of the iteration, SIZE_MAX if none matches.
+             */
+            size_t find() const;
+
+            /**
+             * @brief Send the jobs and notifications of a recorded round.
+             * @param round Round to send.
+             */
+            static void send(const Round &round);
+        };
+    }
+}
+#endif //SPIDER2_SCHEDULECACHE_H
@@ -51,11 +51,11 @@ spider::Stats::Stats() {
     const auto *platform = archi::platform();
     /* == Init stat vectors == */
     const auto n = platform->PECount();
-    startTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::SCHEDULE>(n, 0));
-    endTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::SCHEDULE>(n, 0));
-    loadTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::SCHEDULE>(n, 0));
-    idleTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::SCHEDULE>(n, 0));
-    jobCountArray_ = spider::make_unique(spider::make_n<size_t, StackID::SCHEDULE>(n, 0));
+    startTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::GENERAL>(n, 0));
+    endTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::GENERAL>(n, 0));
+    loadTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::GENERAL>(n, 0));
+    idleTimeArray_ = spider::make_unique(spider::make_n<u64, StackID::GENERAL>(n, 0));
+    jobCountArray_ = spider::make_unique(spider::make_n<size_t, StackID::GENERAL>(n, 0));
 }
 
 void spider::Stats::reset() {
@@ -66,6 +66,7 @@ void spider::Stats::reset() {
     std::fill(loadTimeArray_.get(), loadTimeArray_.get() + n, 0);
     std::fill(idleTimeArray_.get(), idleTimeArray_.get() + n, 0);
     std::fill(jobCountArray_.get(), jobCountArray_.get() + n, 0);
+    availability_.reset();
     /* == Reset min / max time == */
     minStartTime_ = UINT64_MAX;
     maxEndTime_ = 0;
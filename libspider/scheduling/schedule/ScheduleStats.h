@@ -41,6 +41,7 @@
 #include <common/Types.h>
 #include <memory/unique_ptr.h>
 #include <containers/vector.h>
+#include <scheduling/schedule/PEAvailability.h>
 
 namespace spider {
 
@@ -145,6 +146,12 @@ namespace spider {
          */
         inline uint64_t maxEndTime() const;
 
+        /**
+         * @brief Get the index of the PEs ordered by end time.
+         * @return const reference to the @refitem PEAvailability.
+         */
+        inline const PEAvailability &availability() const { return availability_; }
+
         /* === Setter(s) === */
 
         inline void updateStartTime(size_t ix, uint64_t time);
@@ -157,12 +164,22 @@ namespace spider {
 
         inline void updateJobCount(size_t ix, uint32_t incValue = 1);
 
+        /**
+         * @brief Account for a job placed in an idle slot of a PE (i.e before the last job of the PE).
+         * @remark Start and end time of the PE are unchanged, the duration of the job is moved from idle to load time.
+         * @param ix         PE of the job.
+         * @param startTime  Start time of the job.
+         * @param endTime    End time of the job.
+         */
+        inline void insertJob(size_t ix, uint64_t startTime, uint64_t endTime);
+
     private:
         spider::unique_ptr<u64> startTimeArray_;
         spider::unique_ptr<u64> endTimeArray_;
         spider::unique_ptr<u64> loadTimeArray_;
         spider::unique_ptr<u64> idleTimeArray_;
         spider::unique_ptr<size_t> jobCountArray_;
+        PEAvailability availability_;
         u64 minStartTime_ = UINT64_MAX;
         u64 maxEndTime_ = 0;
     };
@@ -221,6 +238,7 @@ namespace spider {
 
     void Stats::updateEndTime(size_t ix, uint64_t time) {
         auto &endTime = endTimeArray_[ix];
+        availability_.update(ix, endTime, time);
         endTime = time;
         maxEndTime_ = std::max(endTime, maxEndTime_);
     }
@@ -239,6 +257,14 @@ namespace spider {
         auto &jobCount = jobCountArray_[ix];
         jobCount += incValue;
     }
+
+    void Stats::insertJob(size_t ix, uint64_t startTime, uint64_t endTime) {
+        const auto duration = endTime - startTime;
+        idleTimeArray_[ix] -= duration;
+        loadTimeArray_[ix] += duration;
+        jobCountArray_[ix] += 1;
+        minStartTime_ = std::min(startTime, minStartTime_);
+    }
 }
 
 
@@ -39,6 +39,7 @@
 #include <archi/PE.h>
 #include <scheduling/schedule/Schedule.h>
 #include <scheduling/task/Task.h>
+#include <containers/vector.h>
 
 
 /* === Method(s) implementation === */
@@ -49,24 +50,43 @@ void spider::SchedStatsExporter::print() const {
 
 void spider::SchedStatsExporter::printFromFile(FILE *file) const {
     const auto &stats = schedule_->stats();
+    const auto peCount = archi::platform()->PECount();
+    /* == Bucket the tasks by PE in a single walk of the schedule, keeping the order of the schedule == */
+    auto offsets = factory::vector<size_t>(peCount + 1, 0, StackID::GENERAL);
+    for (size_t i = 0; i < schedule_->size(); ++i) {
+        const auto *pe = schedule_->task(i)->mappedPe();
+        if (pe) {
+            offsets[pe->virtualIx() + 1]++;
+        }
+    }
+    for (size_t i = 0; i < peCount; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    auto peTasks = factory::vector<size_t>(offsets.back(), StackID::GENERAL);
+    auto positions = factory::vector<size_t>(offsets, StackID::GENERAL);
+    for (size_t i = 0; i < schedule_->size(); ++i) {
+        const auto *pe = schedule_->task(i)->mappedPe();
+        if (pe) {
+            peTasks[positions[pe->virtualIx()]++] = i;
+        }
+    }
     printer::fprintf(file, "Schedule statistics: \n");
     printer::fprintf(file, "Total number of jobs:     %zu\n", schedule_->size());
     printer::fprintf(file, "Makespan of the schedule: %zu\n", stats.makespan());
     for (const auto &pe : archi::platform()->peArray()) {
-        printer::fprintf(file, "PE #%zu\n", pe->virtualIx());
-        printer::fprintf(file, "\t >> job count:          %zu\n", stats.jobCount(pe->virtualIx()));
-        printer::fprintf(file, "\t >> start time:         %zu\n", stats.endTime(pe->virtualIx()));
-        printer::fprintf(file, "\t >> end time:           %zu\n", stats.startTime(pe->virtualIx()));
-        printer::fprintf(file, "\t >> load time:          %zu\n", stats.loadTime(pe->virtualIx()));
-        printer::fprintf(file, "\t >> idle time:          %zu\n", stats.idleTime(pe->virtualIx()));
-        printer::fprintf(file, "\t >> utilization factor: %f\n", stats.utilizationFactor(pe->virtualIx()));
-        if (stats.jobCount(pe->virtualIx())) {
+        const auto peIx = pe->virtualIx();
+        printer::fprintf(file, "PE #%zu\n", peIx);
+        printer::fprintf(file, "\t >> job count:          %zu\n", stats.jobCount(peIx));
+        printer::fprintf(file, "\t >> start time:         %zu\n", stats.startTime(peIx));
+        printer::fprintf(file, "\t >> end time:           %zu\n", stats.endTime(peIx));
+        printer::fprintf(file, "\t >> load time:          %zu\n", stats.loadTime(peIx));
+        printer::fprintf(file, "\t >> idle time:          %zu\n", stats.idleTime(peIx));
+        printer::fprintf(file, "\t >> utilization factor: %f\n", stats.utilizationFactor(peIx));
+        if (stats.jobCount(peIx)) {
             printer::fprintf(file, "\t >> job list: \n");
-            for (size_t i = 0; i < schedule_->size(); ++i) {
-                const auto &task = schedule_->task(i);
-                if (task->mappedPe()->virtualIx() == pe->virtualIx()) {
-                    printer::fprintf(file, "\t\t >> {%zu,%zu}\n", task->startTime(), task->endTime());
-                }
+            for (auto i = offsets[peIx]; i < offsets[peIx + 1]; ++i) {
+                const auto *task = schedule_->task(peTasks[i]);
+                printer::fprintf(file, "\t\t >> {%zu,%zu}\n", task->startTime(), task->endTime());
             }
         }
     }
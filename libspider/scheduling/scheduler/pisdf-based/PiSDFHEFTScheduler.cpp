@@ -0,0 +1,238 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* === Include(s) === */
+
+#include <scheduling/scheduler/pisdf-based/PiSDFHEFTScheduler.h>
+#include <scheduling/schedule/Schedule.h>
+#include <scheduling/task/PiSDFTask.h>
+#include <graphs/pisdf/Graph.h>
+#include <graphs/pisdf/Vertex.h>
+#include <graphs/pisdf/Param.h>
+#include <graphs-tools/transformation/pisdf/GraphHandler.h>
+#include <graphs-tools/transformation/pisdf/GraphFiring.h>
+#include <runtime/common/RTInfo.h>
+#include <archi/Platform.h>
+#include <archi/Cluster.h>
+#include <archi/PE.h>
+#include <api/archi-api.h>
+
+#include <graphs-tools/numerical/dependencies.h>
+#include <graphs-tools/numerical/detail/dependenciesImpl.h>
+
+/* === Method(s) implementation === */
+
+spider::sched::PiSDFHEFTScheduler::PiSDFHEFTScheduler() :
+        Scheduler(),
+        taskVector_{ factory::vector<HEFTTask>(StackID::GENERAL) },
+        unresolvedFirings_{ factory::vector<UnresolvedFiring>(StackID::GENERAL) },
+        seenHWTypes_{ factory::vector<u8>(StackID::GENERAL) } {
+
+}
+
+void spider::sched::PiSDFHEFTScheduler::schedule(pisdf::GraphHandler *graphHandler, Schedule *schedule) {
+    /* == Reset previous non-schedulable tasks == */
+    resetUnScheduledTasks();
+    /* == Creates HEFTTasks == */
+    unresolvedFirings_.clear();
+    recursiveAddVertices(graphHandler);
+    for (const auto &firing : unresolvedFirings_) {
+        recursiveSetNonSchedulable(firing.handler_, firing.vertex_, firing.firing_);
+    }
+    /* == Compute the dependency counts and the upward rank of the schedulable tasks == */
+    const auto noop = [](const pisdf::DependencyInfo &) { };
+    for (auto &task : taskVector_) {
+        if (task.schedulable_) {
+            const auto *vertex = task.vertex_;
+            for (const auto *edge : vertex->inputEdges()) {
+                const auto count = pisdf::detail::computeExecDependency(task.handler_, edge, task.firing_, noop);
+                task.handler_->setEdgeDepCount(vertex, edge, task.firing_, static_cast<u32>(count > 0 ? count : 1));
+            }
+            computeUpwardRank(task);
+        }
+    }
+    /* == Sort the tasks by decreasing rank, producers always have a greater rank (or depth) than their consumers == */
+    std::stable_sort(std::begin(taskVector_), std::end(taskVector_), [](const HEFTTask &A, const HEFTTask &B) {
+        if (A.schedulable_ != B.schedulable_) {
+            return A.schedulable_;
+        }
+        if (A.rank_ != B.rank_) {
+            return A.rank_ > B.rank_;
+        }
+        return A.depth_ > B.depth_;
+    });
+    const auto lastSchedulable = static_cast<size_t>(
+            std::distance(std::begin(taskVector_),
+                          std::find_if(std::begin(taskVector_), std::end(taskVector_),
+                                       [](const HEFTTask &task) { return !task.schedulable_; })));
+    /* == Create the list of tasks to be scheduled == */
+    schedule->reserve(lastSchedulable);
+    for (auto &task : taskVector_) {
+        task.handler_->setTaskIx(task.vertex_, task.firing_, UINT32_MAX);
+    }
+    for (size_t k = 0; k < lastSchedulable; ++k) {
+        auto &task = taskVector_[k];
+        Scheduler::addTask(schedule, task.handler_, task.vertex_, task.firing_);
+    }
+    /* == Remove scheduled tasks == */
+    taskVector_.erase(std::begin(taskVector_), std::next(std::begin(taskVector_), static_cast<long>(lastSchedulable)));
+}
+
+void spider::sched::PiSDFHEFTScheduler::clear() {
+    Scheduler::clear();
+    taskVector_.clear();
+}
+
+/* === Private method(s) implementation === */
+
+void spider::sched::PiSDFHEFTScheduler::resetUnScheduledTasks() {
+    for (size_t k = 0; k < taskVector_.size(); ++k) {
+        auto &task = taskVector_[k];
+        task.handler_->setTaskIx(task.vertex_, task.firing_, static_cast<u32>(k));
+        task.rank_ = -1;
+        task.depth_ = 0;
+        task.schedulable_ = true;
+    }
+}
+
+void spider::sched::PiSDFHEFTScheduler::recursiveAddVertices(pisdf::GraphHandler *graphHandler) {
+    for (auto &firingHandler : graphHandler->firings()) {
+        if (firingHandler->isResolved()) {
+            for (const auto &vertex : graphHandler->graph()->vertices()) {
+                if (vertex->subtype() != spider::pisdf::VertexType::DELAY) {
+                    const auto vertexRV = firingHandler->getRV(vertex.get());
+                    for (u32 k = 0u; k < vertexRV; ++k) {
+                        createTask(vertex.get(), k, firingHandler);
+                    }
+                }
+            }
+            for (auto *child : firingHandler->subgraphHandlers()) {
+                recursiveAddVertices(child);
+            }
+        } else if (graphHandler->base()) {
+            unresolvedFirings_.push_back({ graphHandler->base(), graphHandler->graph(),
+                                           firingHandler->firingValue() });
+        }
+    }
+}
+
+void spider::sched::PiSDFHEFTScheduler::createTask(pisdf::Vertex *vertex, u32 firing, pisdf::GraphFiring *handler) {
+    if (vertex->executable() && (handler->getTaskIx(vertex, firing) == UINT32_MAX)) {
+        taskVector_.push_back({ vertex, handler, -1, firing, 0, true });
+        handler->setTaskIx(vertex, firing, static_cast<u32>(taskVector_.size() - 1));
+    }
+}
+
+spider::sched::PiSDFHEFTScheduler::HEFTTask *
+spider::sched::PiSDFHEFTScheduler::findTask(const pisdf::GraphFiring *handler, const pisdf::Vertex *vertex, u32 firing) {
+    /* == In case of dynamic applications, the task index may be the one of a task scheduled previously == */
+    const auto ix = handler->getTaskIx(vertex, firing);
+    if (ix < taskVector_.size()) {
+        auto &task = taskVector_[ix];
+        if ((task.vertex_ == vertex) && (task.firing_ == firing) && (task.handler_ == handler)) {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+void spider::sched::PiSDFHEFTScheduler::recursiveSetNonSchedulable(const pisdf::GraphFiring *handler,
+                                                                   const pisdf::Vertex *vertex,
+                                                                   u32 firing) {
+    const auto lambda = [this](const pisdf::DependencyInfo &dep) {
+        if (!dep.vertex_ || dep.rate_ <= 0) {
+            return;
+        }
+        for (auto k = dep.firingStart_; k <= dep.firingEnd_; ++k) {
+            auto *task = findTask(dep.handler_, dep.vertex_, k);
+            if (task && task->schedulable_) {
+                task->schedulable_ = false;
+                recursiveSetNonSchedulable(dep.handler_, dep.vertex_, k);
+            }
+        }
+    };
+    for (const auto *edge : vertex->outputEdges()) {
+        pisdf::detail::computeConsDependency(handler, edge, firing, lambda);
+    }
+}
+
+i64 spider::sched::PiSDFHEFTScheduler::computeUpwardRank(HEFTTask &task) {
+    if (task.rank_ >= 0) {
+        return task.rank_;
+    }
+    i64 successorRank = 0;
+    u32 successorDepth = 0;
+    const auto lambda = [this, &successorRank, &successorDepth](const pisdf::DependencyInfo &dep) {
+        if (!dep.vertex_ || dep.rate_ <= 0) {
+            return;
+        }
+        for (auto k = dep.firingStart_; k <= dep.firingEnd_; ++k) {
+            auto *successor = findTask(dep.handler_, dep.vertex_, k);
+            if (successor && successor->schedulable_) {
+                successorRank = std::max(successorRank, computeUpwardRank(*successor));
+                successorDepth = std::max(successorDepth, successor->depth_ + 1);
+            }
+        }
+    };
+    const auto *vertex = task.vertex_;
+    for (const auto *edge : vertex->outputEdges()) {
+        pisdf::detail::computeConsDependency(task.handler_, edge, task.firing_, lambda);
+    }
+    task.rank_ = computeAverageExecTime(vertex->runtimeInformation(), task.handler_->getParams()) + successorRank;
+    task.depth_ = successorDepth;
+    return task.rank_;
+}
+
+i64 spider::sched::PiSDFHEFTScheduler::computeAverageExecTime(const RTInfo *rtInfo,
+                                                              const spider::vector<std::shared_ptr<pisdf::Param>> &params) {
+    const auto *platform = archi::platform();
+    seenHWTypes_.assign(platform->HWTypeCount(), 0);
+    i64 totalExecutionTime = 0;
+    i64 count = 0;
+    for (const auto &cluster : platform->clusters()) {
+        if (!rtInfo->isClusterMappable(cluster)) {
+            continue;
+        }
+        for (const auto &pe : cluster->peArray()) {
+            const auto type = pe->hardwareType();
+            if (!pe->enabled() || !rtInfo->isPEMappable(pe) || seenHWTypes_[type]) {
+                continue;
+            }
+            seenHWTypes_[type] = 1;
+            totalExecutionTime += rtInfo->timingOnPE(pe, params);
+            count++;
+        }
+    }
+    return count ? totalExecutionTime / count : 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_PISDFHEFTSCHEDULER_H
+#define SPIDER2_PISDFHEFTSCHEDULER_H
+
+/* === Include(s) === */
+
+#include <scheduling/scheduler/Scheduler.h>
+
+namespace spider {
+
+    class RTInfo;
+
+    namespace pisdf {
+        class Param;
+
+        class GraphFiring;
+    }
+
+    namespace sched {
+
+        /* === Class definition === */
+
+        /**
+         * @brief HEFT (Heterogeneous Earliest Finish Time) scheduler working directly on the PiSDF graph.
+         * @remark Tasks are sorted by decreasing upward rank, i.e the length of the longest path from the task to an
+         *         exit task where the cost of a task is its average execution time over the hardware types it can be
+         *         mapped on. Best used with the @refitem MappingPolicy::INSERTION mapping policy.
+         */
+        class PiSDFHEFTScheduler final : public Scheduler {
+        public:
+
+            PiSDFHEFTScheduler();
+
+            ~PiSDFHEFTScheduler() noexcept override = default;
+
+            /* === Method(s) === */
+
+            void schedule(pisdf::GraphHandler *graphHandler, Schedule *schedule) override;
+
+            void clear() override;
+
+        private:
+
+            /* === Types definition === */
+
+            struct HEFTTask {
+                pisdf::Vertex *vertex_;
+                pisdf::GraphFiring *handler_;
+                i64 rank_;         /* = Upward rank of the task (-1 if not computed yet) = */
+                u32 firing_;
+                u32 depth_;        /* = Number of tasks on the longest path to an exit task (breaks rank ties) = */
+                bool schedulable_;
+            };
+
+            struct UnresolvedFiring {
+                const pisdf::GraphFiring *handler_; /* = Handler of the subgraph vertex = */
+                const pisdf::Vertex *vertex_;       /* = Subgraph vertex = */
+                u32 firing_;
+            };
+
+            /* === Members === */
+
+            spider::vector<HEFTTask> taskVector_;
+            spider::vector<UnresolvedFiring> unresolvedFirings_;
+            spider::vector<u8> seenHWTypes_;
+
+            /* == Private method(s) === */
+
+            /**
+             * @brief Reset unscheduled task from previous schedule pass.
+             */
+            void resetUnScheduledTasks();
+
+            /**
+             * @brief Recursively add vertices into the taskVector_ vector.
+             * @param graphHandler  Top level graph base;
+             */
+            void recursiveAddVertices(pisdf::GraphHandler *graphHandler);
+
+            /**
+             * @brief Create a @refitem PiSDFHEFTScheduler::HEFTTask for a vertex firing if not already scheduled.
+             * @param vertex  Pointer to the vertex associated.
+             * @param firing  Firing of the vertex.
+             * @param handler Pointer to the base of the vertex.
+             */
+            void createTask(pisdf::Vertex *vertex, u32 firing, pisdf::GraphFiring *handler);
+
+            /**
+             * @brief Get the task of a vertex firing.
+             * @param handler Pointer to the base of the vertex.
+             * @param vertex  Pointer to the vertex.
+             * @param firing  Firing of the vertex.
+             * @return pointer to the task, nullptr if the vertex firing is not in taskVector_.
+             */
+            HEFTTask *findTask(const pisdf::GraphFiring *handler, const pisdf::Vertex *vertex, u32 firing);
+
+            /**
+             * @brief Recursively set all consumers of a vertex firing as not schedulable.
+             * @param handler Pointer to the base of the vertex.
+             * @param vertex  Pointer to the vertex.
+             * @param firing  Firing of the vertex.
+             */
+            void recursiveSetNonSchedulable(const pisdf::GraphFiring *handler, const pisdf::Vertex *vertex, u32 firing);
+
+            /**
+             * @brief Compute recursively the upward rank of a task.
+             * @example:
+             *         input graph:
+             *             A (100) -> B(200)
+             *                     -> C(100) -> D(100)
+             *         result:
+             *           rank(B) = 200, rank(D) = 100
+             *           rank(C) = 100 + rank(D) = 200
+             *           rank(A) = 100 + max(rank(B); rank(C)) = 300
+             * @param task  Reference to the task.
+             * @return upward rank of the task.
+             */
+            i64 computeUpwardRank(HEFTTask &task);
+
+            /**
+             * @brief Compute the average execution time of a vertex over the hardware types it can be mapped on.
+             * @param rtInfo  Runtime information of the vertex.
+             * @param params  Parameters of the vertex.
+             * @return average execution time.
+             */
+            i64 computeAverageExecTime(const RTInfo *rtInfo, const spider::vector<std::shared_ptr<pisdf::Param>> &params);
+        };
+    }
+}
+#endif //SPIDER2_PISDFHEFTSCHEDULER_H
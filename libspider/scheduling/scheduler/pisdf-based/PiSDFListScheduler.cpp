@@ -39,6 +39,7 @@
 #include <scheduling/task/PiSDFTask.h>
 #include <graphs/pisdf/Graph.h>
 #include <graphs/pisdf/Vertex.h>
+#include <graphs/pisdf/Param.h>
 #include <graphs-tools/transformation/pisdf/GraphHandler.h>
 #include <graphs-tools/transformation/pisdf/GraphFiring.h>
 
@@ -49,13 +50,25 @@
 
 namespace {
     constexpr auto NON_SCHEDULABLE_LEVEL = 314159265; /* = Value is arbitrary, just needed something unique = */
+
+    /**
+     * @brief Dependency counts of the firings of a static graph are kept from one iteration to the other, they are
+     *        reset for dynamic graphs every time the graph is resolved.
+     */
+    bool hasVolatileDepCounts(const spider::pisdf::GraphFiring *handler) {
+        return !handler->getParent()->isStatic();
+    }
 }
 
 /* === Method(s) implementation === */
 
 spider::sched::PiSDFListScheduler::PiSDFListScheduler() :
         Scheduler(),
-        sortedTaskVector_{ factory::vector<ListTask>(StackID::SCHEDULE) } {
+        sortedTaskVector_{ factory::vector<ListTask>(StackID::GENERAL) },
+        firingCaches_{ factory::unordered_map<const pisdf::GraphFiring *, FiringCache>(StackID::GENERAL) },
+        seenFirings_{ factory::vector<const pisdf::GraphFiring *>(StackID::GENERAL) },
+        cachedOrder_{ factory::vector<ListTask>(StackID::GENERAL) },
+        cachedOrderFirings_{ factory::vector<const pisdf::GraphFiring *>(StackID::GENERAL) } {
 
 }
 
@@ -63,15 +76,30 @@ void spider::sched::PiSDFListScheduler::schedule(pisdf::GraphHandler *graphHandl
     /* == Reset previous non-schedulable tasks == */
     resetUnScheduledTasks();
     /* == Creates ListTasks == */
+    pass_++;
+    seenFirings_.clear();
     recursiveAddVertices(graphHandler);
-    /* == Compute the schedule level == */
-    for (auto &task : sortedTaskVector_) {
-        computeScheduleLevel(sortedTaskVector_, task);
+    propagateDirtyFirings();
+    /* == Compute the schedule level (only for tasks of firings that changed) == */
+    const auto cachedTaskCount = applyCachedLevels();
+    const auto useCachedOrder = isCachedOrderValid(cachedTaskCount);
+    if (useCachedOrder) {
+        std::copy(std::begin(cachedOrder_), std::end(cachedOrder_), std::begin(sortedTaskVector_));
+    } else {
+        for (auto &task : sortedTaskVector_) {
+            computeScheduleLevel(task);
+        }
+        /* == Sort the vector == */
+        sortVertices();
+        storeLevels();
     }
-    /* == Sort the vector == */
-    sortVertices();
     /* == Remove the non-executable hierarchical vertex == */
     const auto nonSchedulableTaskCount = countNonSchedulableTasks();
+    if (firstPass_ && !useCachedOrder && !nonSchedulableTaskCount) {
+        cachedOrder_.assign(std::begin(sortedTaskVector_), std::end(sortedTaskVector_));
+        cachedOrderFirings_.assign(std::begin(seenFirings_), std::end(seenFirings_));
+    }
+    firstPass_ = false;
     /* == Update last schedulable vertex == */
     const auto lastSchedulable = sortedTaskVector_.size() - nonSchedulableTaskCount;
     /* == Create the list of tasks to be scheduled == */
@@ -97,6 +125,16 @@ void spider::sched::PiSDFListScheduler::schedule(pisdf::GraphHandler *graphHandl
 void spider::sched::PiSDFListScheduler::clear() {
     Scheduler::clear();
     sortedTaskVector_.clear();
+    /* == Forget the firings that were not seen during the iteration (they may have been destroyed) == */
+    for (auto it = std::begin(firingCaches_); it != std::end(firingCaches_);) {
+        if (it->second.iteration_ != iteration_) {
+            it = firingCaches_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    iteration_++;
+    firstPass_ = true;
 }
 
 /* === Private method(s) implementation === */
@@ -111,6 +149,7 @@ void spider::sched::PiSDFListScheduler::resetUnScheduledTasks() {
 void spider::sched::PiSDFListScheduler::recursiveAddVertices(pisdf::GraphHandler *graphHandler) {
     for (auto &firingHandler : graphHandler->firings()) {
         if (firingHandler->isResolved()) {
+            updateFiringCache(firingHandler);
             for (const auto &vertex : graphHandler->graph()->vertices()) {
                 if (vertex->subtype() != spider::pisdf::VertexType::DELAY) {
                     const auto vertexRV = firingHandler->getRV(vertex.get());
@@ -131,13 +170,136 @@ void spider::sched::PiSDFListScheduler::recursiveAddVertices(pisdf::GraphHandler
     }
 }
 
+void spider::sched::PiSDFListScheduler::updateFiringCache(const pisdf::GraphFiring *handler) {
+    const auto &params = handler->getParams();
+    auto &cache = firingCaches_[handler];
+    bool dirty = (cache.graph_ != handler->getParent()->graph()) || (cache.firing_ != handler->firingValue()) ||
+                 (cache.params_.size() != params.size());
+    for (size_t i = 0; !dirty && (i < params.size()); ++i) {
+        dirty = cache.params_[i] != params[i]->value(params);
+    }
+    cache.dirty_ = dirty;
+    cache.pass_ = pass_;
+    cache.iteration_ = iteration_;
+    seenFirings_.emplace_back(handler);
+}
+
+void spider::sched::PiSDFListScheduler::propagateDirtyFirings() {
+    const auto isDirty = [this](const pisdf::GraphFiring *handler) {
+        const auto it = firingCaches_.find(handler);
+        /* == Firings not resolved in this pass only feed non-schedulable tasks == */
+        return (it != std::end(firingCaches_)) && (it->second.pass_ == pass_) && it->second.dirty_;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto *handler : seenFirings_) {
+            auto &cache = firingCaches_[handler];
+            if (cache.dirty_) {
+                continue;
+            }
+            const auto *parent = handler->getParent()->base();
+            cache.dirty_ = parent && isDirty(parent);
+            for (size_t i = 0; !cache.dirty_ && (i < cache.producers_.size()); ++i) {
+                cache.dirty_ = isDirty(cache.producers_[i]);
+            }
+            changed |= cache.dirty_;
+        }
+    }
+    /* == Reset the cache of dirty firings == */
+    for (const auto *handler : seenFirings_) {
+        auto &cache = firingCaches_[handler];
+        if (!cache.dirty_) {
+            continue;
+        }
+        const auto *graph = handler->getParent()->graph();
+        const auto &params = handler->getParams();
+        cache.graph_ = graph;
+        cache.firing_ = handler->firingValue();
+        cache.params_.clear();
+        for (const auto &param : params) {
+            cache.params_.emplace_back(param->value(params));
+        }
+        cache.producers_.clear();
+        cache.levelOffsets_.assign(graph->vertexCount() + 1, 0);
+        cache.depOffsets_.assign(graph->vertexCount() + 1, 0);
+        for (const auto &vertex : graph->vertices()) {
+            const auto ix = vertex->ix();
+            const auto rv = vertex->subtype() != pisdf::VertexType::DELAY ? handler->getRV(vertex.get()) : 0;
+            cache.levelOffsets_[ix + 1] = cache.levelOffsets_[ix] + rv;
+            cache.depOffsets_[ix + 1] = cache.depOffsets_[ix] + rv * static_cast<u32>(vertex->inputEdgeCount());
+        }
+        cache.levels_.assign(cache.levelOffsets_.back(), -1);
+        cache.depCounts_.assign(hasVolatileDepCounts(handler) ? cache.depOffsets_.back() : 0, 0);
+    }
+}
+
+size_t spider::sched::PiSDFListScheduler::applyCachedLevels() {
+    size_t count = 0;
+    const pisdf::GraphFiring *lastHandler = nullptr;
+    FiringCache *cache = nullptr;
+    for (auto &task : sortedTaskVector_) {
+        if (task.level_ >= 0) {
+            continue;
+        }
+        if (task.handler_ != lastHandler) {
+            lastHandler = task.handler_;
+            cache = &firingCaches_[lastHandler];
+        }
+        const auto *vertex = task.vertex_;
+        const auto level = cache->dirty_ ? -1 : cache->levels_[cache->levelOffsets_[vertex->ix()] + task.firing_];
+        if (level < 0) {
+            continue;
+        }
+        task.level_ = level;
+        task.complete_ = true;
+        if (!cache->depCounts_.empty()) {
+            const auto *depCounts = cache->depCounts_.data() + cache->depOffsets_[vertex->ix()] +
+                                    task.firing_ * vertex->inputEdgeCount();
+            for (const auto *edge : vertex->inputEdges()) {
+                task.handler_->setEdgeDepCount(vertex, edge, task.firing_, depCounts[edge->sinkPortIx()]);
+            }
+        }
+        count++;
+    }
+    return count;
+}
+
+void spider::sched::PiSDFListScheduler::storeLevels() {
+    const pisdf::GraphFiring *lastHandler = nullptr;
+    FiringCache *cache = nullptr;
+    for (const auto &task : sortedTaskVector_) {
+        if (!task.complete_ || (task.level_ < 0) || (task.level_ == NON_SCHEDULABLE_LEVEL)) {
+            continue;
+        }
+        if (task.handler_ != lastHandler) {
+            lastHandler = task.handler_;
+            cache = &firingCaches_[lastHandler];
+        }
+        const auto *vertex = task.vertex_;
+        cache->levels_[cache->levelOffsets_[vertex->ix()] + task.firing_] = task.level_;
+        if (!cache->depCounts_.empty()) {
+            auto *depCounts = cache->depCounts_.data() + cache->depOffsets_[vertex->ix()] +
+                              task.firing_ * vertex->inputEdgeCount();
+            for (const auto *edge : vertex->inputEdges()) {
+                depCounts[edge->sinkPortIx()] = task.handler_->getEdgeDepCount(vertex, edge, task.firing_);
+            }
+        }
+    }
+}
+
+bool spider::sched::PiSDFListScheduler::isCachedOrderValid(size_t cachedTaskCount) const {
+    return firstPass_ && (cachedTaskCount == sortedTaskVector_.size()) &&
+           (cachedOrder_.size() == sortedTaskVector_.size()) && (seenFirings_ == cachedOrderFirings_);
+}
+
 void spider::sched::PiSDFListScheduler::createListTask(pisdf::Vertex *vertex,
                                                        u32 firing,
                                                        pisdf::GraphFiring *handler) {
     if (vertex->executable()) {
         const auto vertexTaskIx = handler->getTaskIx(vertex, firing);
         if (vertexTaskIx == UINT32_MAX) {
-            sortedTaskVector_.push_back({ vertex, handler, -1, firing });
+            sortedTaskVector_.push_back({ vertex, handler, -1, firing, false });
             handler->setTaskIx(vertex, firing, static_cast<u32>(sortedTaskVector_.size() - 1));
         }
     }
@@ -163,31 +325,45 @@ void spider::sched::PiSDFListScheduler::recursiveSetNonSchedulable(spider::vecto
     }
 }
 
-i32 spider::sched::PiSDFListScheduler::computeScheduleLevel(spider::vector<ListTask> &sortedTaskVector,
-                                                            ListTask &listTask) {
+i32 spider::sched::PiSDFListScheduler::computeScheduleLevel(ListTask &listTask) {
     const auto *vertex = listTask.vertex_;
     const auto firing = listTask.firing_;
     auto *handler = listTask.handler_;
     if (listTask.level_ == NON_SCHEDULABLE_LEVEL) {
-        recursiveSetNonSchedulable(sortedTaskVector, handler, vertex, firing);
+        recursiveSetNonSchedulable(sortedTaskVector_, handler, vertex, firing);
     } else if (listTask.level_ < 0) {
+        const auto it = firingCaches_.find(handler);
+        auto *cache = it != std::end(firingCaches_) ? &(it->second) : nullptr;
+        const auto levelForDep = [this](const pisdf::DependencyInfo &dep, i32 &level, bool &complete,
+                                        FiringCache *depCache) {
+            computeLevelForDep(dep, level, complete, depCache);
+        };
         i32 level = 0;
+        bool complete = true;
         for (const auto *edge : vertex->inputEdges()) {
-            const auto count = pisdf::detail::computeExecDependency(handler, edge, firing, computeLevelForDep,
-                                                                    sortedTaskVector, level);
+            const auto count = pisdf::detail::computeExecDependency(handler, edge, firing, levelForDep,
+                                                                    level, complete, cache);
             handler->setEdgeDepCount(vertex, edge, firing, static_cast<u32>(count > 0 ? count : 1));
         }
         listTask.level_ = level;
+        listTask.complete_ = complete;
     }
     return listTask.level_;
 }
 
 void spider::sched::PiSDFListScheduler::computeLevelForDep(const pisdf::DependencyInfo &dep,
-                                                           spider::vector<ListTask> &sortedTaskVector,
-                                                           i32 &level) {
+                                                           i32 &level,
+                                                           bool &complete,
+                                                           FiringCache *cache) {
     if (!dep.vertex_ || dep.rate_ <= 0) {
         return;
     }
+    if (cache) {
+        auto &producers = cache->producers_;
+        if (std::find(std::begin(producers), std::end(producers), dep.handler_) == std::end(producers)) {
+            producers.emplace_back(dep.handler_);
+        }
+    }
     const auto *sourceRTInfo = dep.vertex_->runtimeInformation();
     const auto *srcTaskIxArray = dep.handler_->getTaskIndexes(dep.vertex_);
     for (auto k = dep.firingStart_; k <= dep.firingEnd_; ++k) {
@@ -195,14 +371,19 @@ void spider::sched::PiSDFListScheduler::computeLevelForDep(const pisdf::Dependen
         const auto sourceTaskIx = srcTaskIxArray[k];
         /* == In case of dynamic applications, the task index may not be the one set by the scheduler,
          *    so we must check if it is the proper task == */
-        if (sourceTaskIx < sortedTaskVector.size()) {
-            auto &srcTask = sortedTaskVector[sourceTaskIx];
+        if (sourceTaskIx < sortedTaskVector_.size()) {
+            auto &srcTask = sortedTaskVector_[sourceTaskIx];
             if (srcTask.vertex_ == dep.vertex_ && srcTask.firing_ == k) {
-                const auto sourceLevel = computeScheduleLevel(sortedTaskVector, srcTask);
+                const auto sourceLevel = computeScheduleLevel(srcTask);
                 if (sourceLevel != NON_SCHEDULABLE_LEVEL) {
                     level = std::max(level, sourceLevel + static_cast<i32>(minExecutionTime));
                 }
+                complete &= srcTask.complete_ && (srcTask.handler_ == dep.handler_);
+            } else {
+                complete = false;
             }
+        } else {
+            complete = false;
         }
     }
 }
@@ -257,6 +438,7 @@ size_t spider::sched::PiSDFListScheduler::countNonSchedulableTasks() {
         count++;
         it->handler_->setTaskIx(it->vertex_, it->firing_, UINT32_MAX);
         it->level_ = -1; /* = Reset the schedule level = */
+        it->complete_ = false;
     }
     return count;
 }
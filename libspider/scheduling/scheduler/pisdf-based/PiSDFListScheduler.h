@@ -38,12 +38,15 @@
 /* === Include(s) === */
 
 #include <scheduling/scheduler/Scheduler.h>
+#include <containers/unordered_map.h>
 
 namespace spider {
 
     class RTInfo;
 
     namespace pisdf {
+        class Graph;
+
         struct DependencyIterator;
         struct DependencyInfo;
 
@@ -54,6 +57,13 @@ namespace spider {
 
         /* === Class definition === */
 
+        /**
+         * @brief List scheduler working directly on the PiSDF graph.
+         * @remark Schedule levels of the tasks are cached per @refitem pisdf::GraphFiring and reused from one
+         *         iteration to the next as long as the parameter values of the firing, of its parent and of the
+         *         firings it depends on did not change. The sorted order is reused as well when every firing is
+         *         unchanged (static graphs).
+         */
         class PiSDFListScheduler final : public Scheduler {
         public:
 
@@ -80,11 +90,33 @@ namespace spider {
                 pisdf::GraphFiring *handler_;
                 i32 level_;
                 u32 firing_;
+                bool complete_; /* = Level accounts for every producer (it can be cached) = */
+            };
+
+            struct FiringCache {
+                spider::vector<int64_t> params_;                       /* = Parameter values of the firing = */
+                spider::vector<const pisdf::GraphFiring *> producers_; /* = Firings the tasks depend on = */
+                spider::vector<u32> levelOffsets_;                     /* = Offset of each vertex in levels_ = */
+                spider::vector<i32> levels_;                           /* = Cached level of each task (-1 if none) = */
+                spider::vector<u32> depOffsets_;                       /* = Offset of each vertex in depCounts_ = */
+                spider::vector<u32> depCounts_;                        /* = Cached dependency count of each input = */
+                const pisdf::Graph *graph_ = nullptr;
+                u32 firing_ = UINT32_MAX;
+                u32 pass_ = UINT32_MAX;                                /* = Last schedule pass the firing was seen = */
+                u32 iteration_ = UINT32_MAX;                           /* = Last iteration the firing was seen = */
+                bool dirty_ = true;
             };
 
             /* === Members === */
 
             spider::vector<ListTask> sortedTaskVector_;
+            spider::unordered_map<const pisdf::GraphFiring *, FiringCache> firingCaches_;
+            spider::vector<const pisdf::GraphFiring *> seenFirings_;        /* = Resolved firings of current pass = */
+            spider::vector<ListTask> cachedOrder_;                          /* = Sorted tasks of previous iteration = */
+            spider::vector<const pisdf::GraphFiring *> cachedOrderFirings_; /* = Firings of cachedOrder_ = */
+            u32 pass_ = 0;
+            u32 iteration_ = 0;
+            bool firstPass_ = true;
 
             /* == Private method(s) === */
 
@@ -99,6 +131,38 @@ namespace spider {
              */
             void recursiveAddVertices(spider::pisdf::GraphHandler *graphHandler);
 
+            /**
+             * @brief Register a resolved firing for the current pass and check if its parameters changed.
+             * @param handler Pointer to the firing.
+             */
+            void updateFiringCache(const pisdf::GraphFiring *handler);
+
+            /**
+             * @brief Mark as dirty every firing whose parent or producer firings are dirty, then reset the cache of
+             *        the dirty firings.
+             */
+            void propagateDirtyFirings();
+
+            /**
+             * @brief Set the cached schedule level (and dependency counts) of the tasks of unchanged firings.
+             * @return number of tasks whose level was set from the cache.
+             */
+            size_t applyCachedLevels();
+
+            /**
+             * @brief Save the schedule level (and dependency counts) of every schedulable task in its firing cache.
+             * @remark Levels computed while some producers were already scheduled by a previous pass of the iteration
+             *         are not saved, they would not keep the order between producers and consumers on reuse.
+             */
+            void storeLevels();
+
+            /**
+             * @brief Check if the sorted order of the previous iteration can be used for current pass.
+             * @param cachedTaskCount Number of tasks whose level was set from the cache.
+             * @return true if every task was cached and the resolved firings are the same, false else.
+             */
+            bool isCachedOrderValid(size_t cachedTaskCount) const;
+
             /**
              * @brief Create @refitem ListScheduler::ListTask for every non-scheduled vertex.
              * @remark The attribute @refitem pisdf::Vertex::scheduleTaskIx_ of the vertex is set to the last position of
@@ -139,9 +203,16 @@ namespace spider {
              * @param listTask  Reference to the current @refitem ListVertex evaluated.
              * @return level value of the vertex for its given firing.
              */
-            static i32 computeScheduleLevel(spider::vector<ListTask> &sortedTaskVector, ListTask &listTask);
+            i32 computeScheduleLevel(ListTask &listTask);
 
-            static void computeLevelForDep(const pisdf::DependencyInfo &dep, spider::vector<ListTask> &sortedTaskVector, i32 &level);
+            /**
+             * @brief Update the level of a task with the one of a given dependency.
+             * @param dep    Dependency of the task.
+             * @param level     Level of the task to update.
+             * @param complete  Set to false if the producer is not in the list or has an incomplete level.
+             * @param cache     Cache of the firing of the task (producer firing is recorded in it), may be nullptr.
+             */
+            void computeLevelForDep(const pisdf::DependencyInfo &dep, i32 &level, bool &complete, FiringCache *cache);
 
             static i64
             computeMinExecTime(const RTInfo *rtInfo, const spider::vector<std::shared_ptr<pisdf::Param>> &params);
@@ -52,7 +52,7 @@ namespace {
 /* === Method(s) implementation === */
 
 spider::sched::ListScheduler::ListScheduler() : Scheduler(),
-                                                sortedTaskVector_{ factory::vector<ListTask>(StackID::SCHEDULE) } {
+                                                sortedTaskVector_{ factory::vector<ListTask>(StackID::GENERAL) } {
 
 }
 
@@ -69,7 +69,7 @@ void spider::sched::PiSDFTask::setOnFiring(u32 firing) {
     currentFiring_ = firing;
 }
 
-bool spider::sched::PiSDFTask::receiveParams(const spider::array<i64> &values) {
+bool spider::sched::PiSDFTask::receiveParams(const spider::vector<i64> &values) {
     const auto *vertex = this->vertex();
     if (vertex->subtype() != pisdf::VertexType::CONFIG) {
         throwSpiderException("Only config vertices can update parameter values.");
@@ -69,7 +69,7 @@ namespace spider {
              * @brief Update output params based on received values.
              * @param values Values of the params.
              */
-            bool receiveParams(const spider::array<i64> &values) final;
+            bool receiveParams(const spider::vector<i64> &values) final;
 
             /**
              * @brief Set task on a given firing (can be used anywhere as long as you know what you're doing).
@@ -66,7 +66,7 @@ void spider::sched::SRDAGTask::visit(TaskLauncher *launcher) {
     launcher->visit(this);
 }
 
-bool spider::sched::SRDAGTask::receiveParams(const spider::array<i64> &values) {
+bool spider::sched::SRDAGTask::receiveParams(const spider::vector<i64> &values) {
     if (vertex_->subtype() != pisdf::VertexType::CONFIG) {
         throwSpiderException("Only config vertices can update parameter values.");
     }
@@ -88,12 +88,12 @@ i64 spider::sched::SRDAGTask::inputRate(size_t ix) const {
 
 spider::sched::Task *spider::sched::SRDAGTask::previousTask(size_t ix, const spider::sched::Schedule *schedule) const {
     const auto *source = vertex_->inputEdge(ix)->source();
-    return schedule->task(source->scheduleTaskIx());
+    return schedule->task(source->scheduleTaskIx(), source->scheduleTask(), 0);
 }
 
 spider::sched::Task *spider::sched::SRDAGTask::nextTask(size_t ix, const spider::sched::Schedule *schedule) const {
     const auto *sink = vertex_->outputEdge(ix)->sink();
-    return schedule->task(sink->scheduleTaskIx());
+    return schedule->task(sink->scheduleTaskIx(), sink->scheduleTask(), 0);
 }
 
 u32 spider::sched::SRDAGTask::color() const {
@@ -65,15 +65,25 @@ namespace spider {
 
             /* === Getter(s) === */
 
-            inline bool receiveParams(const spider::array<i64> &) final { return true; }
+            inline bool receiveParams(const spider::vector<i64> &) final { return true; }
 
             /* === Getter(s) === */
 
             inline i64 inputRate(size_t) const final { return 0; };
 
-            inline Task *previousTask(size_t, const Schedule *) const final { return dependency_; }
+            inline Task *previousTask(size_t, const Schedule *) const final {
+                if (dependency_) {
+                    dependency_->setOnFiring(dependencyFiring_);
+                }
+                return dependency_;
+            }
 
-            inline Task *nextTask(size_t, const Schedule *) const final { return successor_; }
+            inline Task *nextTask(size_t, const Schedule *) const final {
+                if (successor_) {
+                    successor_->setOnFiring(successorFiring_);
+                }
+                return successor_;
+            }
 
             inline u32 color() const final {
                 /* ==  SEND    -> vivid tangerine color == */
@@ -85,7 +95,7 @@ namespace spider {
 
             inline u32 ix() const noexcept final { return ix_; }
 
-            inline bool isMappableOnPE(const PE *) const final { return true; }
+            inline bool isMappableOnPE(const PE *pe) const final { return !mappablePE_ || (pe == mappablePE_); }
 
             u64 timingOnPE(const PE *) const final;
 
@@ -103,7 +113,9 @@ namespace spider {
 
             inline u32 jobExecIx() const noexcept final { return jobExecIx_; }
 
-            inline u32 syncExecIxOnLRT(size_t) const final { return syncExecTaskIx_; }
+            inline u32 syncExecIxOnLRT(size_t lrtIx) const final {
+                return lrtIx == syncExecLRTIx_ ? syncExecTaskIx_ : UINT32_MAX;
+            }
 
             inline TaskState state() const noexcept final { return state_; }
 
@@ -117,24 +129,34 @@ namespace spider {
 
             /**
              * @brief Set the task succeeding to this task.
+             * @remark The current firing of the task is the one succeeding to this task.
              * @param successor pointer to the successor.
              */
             inline void setSuccessor(Task *task) {
                 if (task) {
                     successor_ = task;
+                    successorFiring_ = task->firing();
                 }
             }
 
             /**
-             * @brief Set the task succeeding to this task.
-             * @param successor pointer to the successor.
+             * @brief Set the task preceding this task.
+             * @remark The current firing of the task is the one preceding this task.
+             * @param successor pointer to the predecessor.
              */
             inline void setPredecessor(Task *task) {
                 if (task) {
                     dependency_ = task;
+                    dependencyFiring_ = task->firing();
                 }
             }
 
+            /**
+             * @brief Restrict the mapping of this task to a single PE.
+             * @param pe Pointer to the PE (nullptr to allow any PE).
+             */
+            inline void setMappablePE(const PE *pe) { mappablePE_ = pe; }
+
             inline void setIx(u32 ix) noexcept final { ix_ = ix; }
 
             inline void setDepIx(u32 depIx) { depIx_ = depIx; }
@@ -149,10 +171,14 @@ namespace spider {
 
             inline void setMappedPE(const spider::PE *pe) final;
 
-            inline void setSyncExecIxOnLRT(size_t, u32 value) final {
-                if (syncExecTaskIx_ == UINT32_MAX || value > syncExecTaskIx_) {
-                    syncExecTaskIx_ = value;
-                }
+            /**
+             * @brief Set the task this task waits for (synchronization tasks have a single dependency).
+             * @param lrtIx Virtual index of the LRT of the dependency.
+             * @param value Index of the dependency in the schedule.
+             */
+            inline void setSyncExecIxOnLRT(size_t lrtIx, u32 value) final {
+                syncExecLRTIx_ = lrtIx;
+                syncExecTaskIx_ = value;
             }
 
         private:
@@ -161,9 +187,13 @@ namespace spider {
             Task *successor_{ nullptr };      /*!< Successor task */
             Task *dependency_{ nullptr };     /*!< Successor task */
             const MemoryBus *bus_{ nullptr }; /*!< Memory bus used by the task */
+            const PE *mappablePE_{ nullptr }; /*!< Only PE the task may be mapped on (any if nullptr) */
+            size_t syncExecLRTIx_{ SIZE_MAX }; /*!< LRT of the task this task waits for */
             u32 depIx_ = UINT32_MAX;
             u32 ix_ = UINT32_MAX;
             u32 syncExecTaskIx_{ UINT32_MAX };
+            u32 successorFiring_{ 0 };
+            u32 dependencyFiring_{ 0 };
             u32 mappedPEIx_ = UINT32_MAX;     /*!< Mapping PE of the vertexTask */
             u32 jobExecIx_{ UINT32_MAX };     /*!< Index of the job sent to the PE */
             TaskState state_{ TaskState::NOT_SCHEDULABLE }; /*!< State of the vertexTask */
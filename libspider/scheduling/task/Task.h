@@ -38,7 +38,7 @@
 /* === Include(s) === */
 
 #include <common/Types.h>
-#include <containers/array.h>
+#include <containers/vector.h>
 #include <string>
 
 namespace spider {
@@ -90,7 +90,7 @@ namespace spider {
              * @brief Update output params based on received values.
              * @param values Values of the params.
              */
-            virtual bool receiveParams(const spider::array<i64> &values) = 0;
+            virtual bool receiveParams(const spider::vector<i64> &values) = 0;
 
             /* === Getter(s) === */
 
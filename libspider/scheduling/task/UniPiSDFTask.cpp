@@ -51,7 +51,7 @@
 spider::sched::UniPiSDFTask::UniPiSDFTask(pisdf::GraphFiring *handler, const pisdf::Vertex *vertex) :
         PiSDFTask(handler, vertex) {
     const auto lrtCount = archi::platform()->LRTCount();
-    syncInfoArray_ = spider::make_unique(make_n<u32, StackID::SCHEDULE>(lrtCount, UINT32_MAX));
+    syncInfoArray_ = spider::make_unique(make_n<u32, StackID::GENERAL>(lrtCount, UINT32_MAX));
 }
 
 void spider::sched::UniPiSDFTask::reset() {
@@ -54,15 +54,14 @@ namespace {
 
 spider::sched::VectPiSDFTask::VectPiSDFTask(pisdf::GraphFiring *handler, const pisdf::Vertex *vertex) :
         PiSDFTask(handler, vertex) {
-    if (LRT_COUNT == UINT32_MAX) {
-        LRT_COUNT = static_cast<u32>(archi::platform()->LRTCount());
-    }
+    /* == Refreshed on every task since the platform may change between two runtime contexts == */
+    LRT_COUNT = static_cast<u32>(archi::platform()->LRTCount());
     const auto rv = handler->getRV(vertex);
-    syncInfoArray_ = spider::make_unique(make_n<u32, StackID::SCHEDULE>(LRT_COUNT * rv, UINT32_MAX));
-    endTimeArray_ = spider::make_unique(make_n<u64, StackID::SCHEDULE>(rv, 0));
-    mappedPEIxArray_ = spider::make_unique(make_n<u32, StackID::SCHEDULE>(rv, UINT32_MAX));
-    jobExecIxArray_ = spider::make_unique(make_n<u32, StackID::SCHEDULE>(rv, UINT32_MAX));
-    stateArray_ = spider::make_unique(make_n<TaskState, StackID::SCHEDULE>(rv, TaskState::NOT_SCHEDULABLE));
+    syncInfoArray_ = spider::make_unique(make_n<u32, StackID::GENERAL>(LRT_COUNT * rv, UINT32_MAX));
+    endTimeArray_ = spider::make_unique(make_n<u64, StackID::GENERAL>(rv, 0));
+    mappedPEIxArray_ = spider::make_unique(make_n<u32, StackID::GENERAL>(rv, UINT32_MAX));
+    jobExecIxArray_ = spider::make_unique(make_n<u32, StackID::GENERAL>(rv, UINT32_MAX));
+    stateArray_ = spider::make_unique(make_n<TaskState, StackID::GENERAL>(rv, TaskState::NOT_SCHEDULABLE));
 }
 
 void spider::sched::VectPiSDFTask::reset() {
@@ -38,7 +38,6 @@
 /* === Include(s) === */
 
 #include <mutex>
-#include <containers/queue.h>
 #include <containers/vector.h>
 
 namespace spider {
@@ -67,33 +66,35 @@ namespace spider {
         /* === Method(s) === */
 
         /**
-         * @brief Push data through copy ctor into the queue.
-         * @param value  Pointer to the load to push.
+         * @brief Push data through copy assignment into the queue.
+         * @remark Reused slots are copy assigned, so they keep the memory they already own (if any).
+         * @param value  Load to push.
          * @return Index of the item pushed in the queue (for latter retrieval).
          */
-        inline size_t push(T value) {
+        inline size_t push(const T &value) {
             std::lock_guard<std::mutex> lock{ mutex_ };
             auto index = getFreeIndex();
             if (index == SIZE_MAX) {
-                queue_.emplace_back(std::move(value));
+                queue_.emplace_back(value);
                 return queue_.size() - 1;
             }
-            queue_[index] = std::move(value);
+            queue_[index] = value;
             return index;
         }
 
         /**
-         * @brief Pop element and move it to (*load) using std::move (if move assignment is available).
-         * @param load  Pointer to the load to be filled.
+         * @brief Pop element and copy it to load.
+         * @remark The slot is copied and not moved so that it keeps its memory for the next push.
+         * @param load  Load to be filled.
          * @param ix    Ix of the item to fetch in the queue
          * @return true on success, false if ix < 0 || ix >= queue_.size().
          */
         inline bool pop(T &load, size_t ix) {
             std::lock_guard<std::mutex> lock{ mutex_ };
             /* == std::vector are thread-safe in read-only only if no other thread is writing == */
-            load = std::move(queue_.at(ix)); /* = use move assignment if available = */
+            load = queue_.at(ix);
             /* == Push index as available one == */
-            freeIndexQueue_.push(ix);
+            freeIndexStack_.push_back(ix);
             return true;
         }
 
@@ -102,8 +103,8 @@ namespace spider {
         /* === Setter(s) === */
 
     private:
-        spider::queue<size_t> freeIndexQueue_;                /* = Keeping track of available space in vector = */
-        spider::vector<T> queue_ = factory::vector<T>(stack); /* = Actual queue = */
+        spider::vector<size_t> freeIndexStack_ = factory::vector<size_t>(stack); /* = Keeping track of available space in vector = */
+        spider::vector<T> queue_ = factory::vector<T>(stack);                   /* = Actual queue = */
         std::mutex mutex_;
 
         /* === Private method(s) === */
@@ -113,10 +114,10 @@ namespace spider {
          * @return index of available location, -1 if none
          */
         inline size_t getFreeIndex() {
-            if (!freeIndexQueue_.empty()) {
-                auto front = freeIndexQueue_.front();
-                freeIndexQueue_.pop();
-                return front;
+            if (!freeIndexStack_.empty()) {
+                auto back = freeIndexStack_.back();
+                freeIndexStack_.pop_back();
+                return back;
             }
             return SIZE_MAX;
         }
@@ -0,0 +1,243 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SPIDER2_MPSCQUEUE_H
+#define SPIDER2_MPSCQUEUE_H
+
+/* === Include(s) === */
+
+#include <containers/queue.h>
+#include <memory/memory.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace spider {
+
+    /* === Class definition === */
+
+    /**
+     * @brief Lock-free bounded multiple producers / single consumer queue.
+     * @remark The ring follows the sequence-numbered cells design of D. Vyukov.
+     *         When the ring is full, producers fall back to a locked overflow queue so that push never blocks.
+     *         Once an element went to the overflow queue, every following push also goes there until the consumer
+     *         drained it, this keeps the FIFO order of each producer.
+     * @remark The consumer only parks (on a std::condition_variable) when both the ring and the overflow are empty.
+     * @tparam T     Type of the elements.
+     * @tparam stack Stack on which the ring buffer is allocated.
+     */
+    template<class T, StackID stack = StackID::GENERAL>
+    class MPSCQueue {
+    public:
+
+        explicit MPSCQueue(size_t capacity = 1024) {
+            capacity_ = 2;
+            while (capacity_ < capacity) {
+                capacity_ <<= 1;
+            }
+            buffer_ = spider::allocate<Cell, stack>(capacity_);
+            for (size_t i = 0; i < capacity_; ++i) {
+                new(&buffer_[i]) Cell();
+                buffer_[i].sequence_.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MPSCQueue(const MPSCQueue &) = delete;
+
+        MPSCQueue(MPSCQueue &&) = delete;
+
+        MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+        MPSCQueue &operator=(MPSCQueue &&) = delete;
+
+        ~MPSCQueue() {
+            for (size_t i = 0; i < capacity_; ++i) {
+                buffer_[i].~Cell();
+            }
+            spider::deallocate(buffer_);
+        }
+
+        /* === Method(s) === */
+
+        /**
+         * @brief Clear the queue.
+         * @warning Should only be called by the consumer.
+         */
+        inline void clear() {
+            T data;
+            while (try_pop(data)) { }
+        }
+
+        /**
+         * @brief Pop an element from the queue.
+         * @remark Call to pop will block until an element is pushed in the queue.
+         * @warning Should only be called by the consumer.
+         * @param data Reference to be filled with front element of the queue.
+         * @return true.
+         */
+        inline bool pop(T &data) {
+            while (!try_pop(data)) {
+                std::unique_lock<std::mutex> lock{ mutex_ };
+                sleeping_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (try_pop(data)) {
+                    sleeping_.store(false, std::memory_order_relaxed);
+                    return true;
+                }
+                cond_.wait(lock);
+                sleeping_.store(false, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Pop an element from the queue.
+         * @remark If queue is empty, function calls return immediately with value false.
+         * @warning Should only be called by the consumer.
+         * @param data Reference to be filled with front element of the queue.
+         * @return true if success, false if the queue was empty.
+         */
+        inline bool try_pop(T &data) {
+            if (tryPopRing(data)) {
+                return true;
+            }
+            if (enqueuePos_.load(std::memory_order_acquire) != dequeuePos_) {
+                /* == A producer claimed the next cell but did not publish it yet, taking an element from the
+                 *    overflow now could break the FIFO order of the producers that pushed after it in the ring == */
+                return false;
+            }
+            if (!overflowCount_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock{ overflowMutex_ };
+            if (overflowQueue_.empty()) {
+                return false;
+            }
+            data = std::move(overflowQueue_.front());
+            overflowQueue_.pop();
+            overflowCount_.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Push data into the queue.
+         * @remark Thread-safe, can be called by any number of producers (including the consumer itself).
+         * @param data Data to be pushed.
+         */
+        inline void push(T data) {
+            if (overflowCount_.load(std::memory_order_acquire) || !tryPushRing(data)) {
+                std::lock_guard<std::mutex> lock{ overflowMutex_ };
+                overflowQueue_.push(std::move(data));
+                overflowCount_.fetch_add(1, std::memory_order_release);
+            }
+            /* == Wake up the consumer only if it is actually parked == */
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock{ mutex_ };
+                cond_.notify_one();
+            }
+        }
+
+        /* === Getter(s) === */
+
+        /**
+         * @brief Get the capacity of the lock-free ring (overflow excluded).
+         * @return capacity of the ring.
+         */
+        inline size_t capacity() const {
+            return capacity_;
+        }
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        struct Cell {
+            std::atomic<size_t> sequence_{ 0 };
+            T data_{ };
+        };
+
+        Cell *buffer_ = nullptr;
+        size_t capacity_ = 0;
+        char padding0_[CACHE_LINE_SIZE]{ };
+        std::atomic<size_t> enqueuePos_{ 0 };     /* = Shared by producers = */
+        char padding1_[CACHE_LINE_SIZE]{ };
+        size_t dequeuePos_ = 0;                   /* = Owned by the consumer = */
+        std::atomic<bool> sleeping_{ false };
+        char padding2_[CACHE_LINE_SIZE]{ };
+        std::atomic<size_t> overflowCount_{ 0 };
+        spider::queue<T> overflowQueue_;
+        std::mutex overflowMutex_;
+        std::condition_variable cond_;
+        std::mutex mutex_;
+
+        /* === Private method(s) === */
+
+        inline bool tryPushRing(T &data) {
+            const auto mask = capacity_ - 1;
+            auto pos = enqueuePos_.load(std::memory_order_relaxed);
+            for (;;) {
+                auto &cell = buffer_[pos & mask];
+                const auto sequence = cell.sequence_.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (!diff) {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.data_ = std::move(data);
+                        cell.sequence_.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    /* == Ring is full == */
+                    return false;
+                } else {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        inline bool tryPopRing(T &data) {
+            auto &cell = buffer_[dequeuePos_ & (capacity_ - 1)];
+            const auto sequence = cell.sequence_.load(std::memory_order_acquire);
+            if (sequence != dequeuePos_ + 1) {
+                /* == Ring is empty (or the next producer has not published yet) == */
+                return false;
+            }
+            data = std::move(cell.data_);
+            cell.sequence_.store(dequeuePos_ + capacity_, std::memory_order_release);
+            dequeuePos_++;
+            return true;
+        }
+    };
+}
+
+#endif //SPIDER2_MPSCQUEUE_H
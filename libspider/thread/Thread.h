@@ -99,6 +99,20 @@ namespace spider {
         inline std::thread::id get_id() {
             return std::this_thread::get_id();
         }
+
+        /**
+         * @brief Hint the processor that the thread is in a spin-wait loop (pause / yield instruction).
+         * @remark Falls back on std::this_thread::yield if no such instruction is available.
+         */
+        inline void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+            asm volatile("yield");
+#else
+            std::this_thread::yield();
+#endif
+        }
     }
 
 }
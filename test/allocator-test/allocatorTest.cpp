@@ -44,10 +44,24 @@
 #include <common/Exception.h>
 #include <memory/allocator.h>
 #include <memory/memory.h>
+#include <containers/vector.h>
 #include <memory/dynamic-policies/FreeListAllocatorPolicy.h>
 #include <memory/dynamic-policies/GenericAllocatorPolicy.h>
 #include <memory/static-policies/LinearStaticAllocator.h>
+#include <memory/dynamic-policies/ArenaAllocatorPolicy.h>
+#include <memory/dynamic-policies/TLSFAllocatorPolicy.h>
+#include <memory/MappedMemory.h>
+#include <memory/PageMap.h>
 #include <api/spider.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <algorithm>
 
 class allocatorTest : public ::testing::Test {
 protected:
@@ -283,6 +297,371 @@ TEST_F(allocatorTest, genericAllocTest) {
 
 }
 
+TEST_F(allocatorTest, arenaCtorTest) {
+    ASSERT_THROW(ArenaAllocatorPolicy(0, nullptr, 2), spider::Exception)
+                                << "ArenaAllocatorPolicy should throw with alignement < 8.";
+    char tmp[1000];
+    ASSERT_THROW(ArenaAllocatorPolicy(0, tmp), spider::Exception)
+                                << "ArenaAllocatorPolicy should throw with null size and external buffer.";
+    ASSERT_NO_THROW(ArenaAllocatorPolicy(1000)) << "ArenaAllocatorPolicy should not throw with default ctor.";
+    ASSERT_NO_THROW(ArenaAllocatorPolicy(1000, tmp))
+                                << "ArenaAllocatorPolicy should not throw with default ctor and external buffer.";
+}
+
+TEST_F(allocatorTest, arenaAllocTest) {
+    auto allocator = ArenaAllocatorPolicy(ArenaAllocatorPolicy::MIN_CHUNK_SIZE, nullptr, 64);
+    ASSERT_EQ(allocator.allocate(0), nullptr) << "ArenaAllocatorPolicy: 0-size allocation should return nullptr.";
+    ASSERT_NO_THROW(allocator.deallocate(nullptr));
+    ASSERT_THROW(allocator.deallocate(reinterpret_cast<void *>(allocator.chunkCount())), spider::Exception)
+                                << "ArenaAllocatorPolicy: deallocate should throw with no memory allocated.";
+    auto *first = allocator.allocate(100);
+    auto *second = allocator.allocate(100);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % 64, 0) << "ArenaAllocatorPolicy: buffers should be aligned.";
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % 64, 0) << "ArenaAllocatorPolicy: buffers should be aligned.";
+    ASSERT_GT(reinterpret_cast<uintptr_t>(second), reinterpret_cast<uintptr_t>(first))
+                                << "ArenaAllocatorPolicy: buffers should be bump allocated.";
+    allocator.deallocate(first);
+    ASSERT_NE(allocator.allocate(100), first) << "ArenaAllocatorPolicy: memory should not be reused before reset.";
+    ASSERT_EQ(allocator.reset(), 1) << "ArenaAllocatorPolicy: reset should count the chunk holding live buffers.";
+    ASSERT_EQ(allocator.usage(), 0) << "ArenaAllocatorPolicy: reset should release live buffers too.";
+    ASSERT_EQ(allocator.allocate(100), first) << "ArenaAllocatorPolicy: reset should rewind every chunk.";
+    /* == Fill the first chunk to force extra chunks == */
+    auto *big = allocator.allocate(ArenaAllocatorPolicy::MIN_CHUNK_SIZE);
+    auto *bigger = allocator.allocate(4 * ArenaAllocatorPolicy::MIN_CHUNK_SIZE);
+    ASSERT_NE(bigger, nullptr);
+    ASSERT_EQ(allocator.chunkCount(), 3);
+    allocator.deallocate(big);
+    ASSERT_EQ(allocator.reset(), 2) << "ArenaAllocatorPolicy: only the chunk of big was empty.";
+    ASSERT_EQ(allocator.chunkCount(), 1) << "ArenaAllocatorPolicy: every chunk should be merged on reset.";
+}
+
+TEST_F(allocatorTest, arenaResetTest) {
+    auto allocator = ArenaAllocatorPolicy(ArenaAllocatorPolicy::MIN_CHUNK_SIZE);
+    spider::vector<void *> buffers;
+    for (size_t i = 0; i < 64; ++i) {
+        buffers.emplace_back(allocator.allocate(4096));
+    }
+    ASSERT_GT(allocator.chunkCount(), 1);
+    for (auto *buffer : buffers) {
+        allocator.deallocate(buffer);
+    }
+    ASSERT_EQ(allocator.usage(), 0);
+    ASSERT_EQ(allocator.reset(), 0) << "ArenaAllocatorPolicy: every chunk should be empty.";
+    ASSERT_EQ(allocator.chunkCount(), 1) << "ArenaAllocatorPolicy: empty chunks should be merged on reset.";
+    for (auto &buffer : buffers) {
+        buffer = allocator.allocate(4096);
+    }
+    ASSERT_EQ(allocator.chunkCount(), 1) << "ArenaAllocatorPolicy: merged chunk should fit a whole iteration.";
+    for (auto *buffer : buffers) {
+        allocator.deallocate(buffer);
+    }
+    allocator.reset();
+    ASSERT_EQ(allocator.allocate(4096), buffers[0]) << "ArenaAllocatorPolicy: reset should rewind the chunk.";
+}
+
+TEST_F(allocatorTest, arenaChunkTest) {
+    auto allocator = ArenaAllocatorPolicy(ArenaAllocatorPolicy::MIN_CHUNK_SIZE);
+    auto *first = allocator.allocate(ArenaAllocatorPolicy::MIN_CHUNK_SIZE / 2);
+    auto *second = allocator.allocate(ArenaAllocatorPolicy::MIN_CHUNK_SIZE);
+    ASSERT_EQ(allocator.chunkCount(), 2);
+    allocator.deallocate(second);
+    ASSERT_EQ(allocator.allocate(ArenaAllocatorPolicy::MIN_CHUNK_SIZE), second)
+                                << "ArenaAllocatorPolicy: released chunks should be reused before creating a new one.";
+    ASSERT_EQ(allocator.chunkCount(), 2);
+    allocator.deallocate(first);
+    /* == Chunk sizes should stop doubling: with no cap, later chunks would fit several of these buffers == */
+    const auto maxChunkSize = ArenaAllocatorPolicy::MAX_ALLOC_SCALE * ArenaAllocatorPolicy::MIN_CHUNK_SIZE;
+    for (size_t i = 0; i < 16; ++i) {
+        ASSERT_NE(allocator.allocate(maxChunkSize - 1024), nullptr);
+    }
+    ASSERT_EQ(allocator.chunkCount(), 18) << "ArenaAllocatorPolicy: chunk size should be capped.";
+}
+
+TEST_F(allocatorTest, arenaStackResetTest) {
+    auto *stack = spider::stackArray()[static_cast<uint64_t>(StackID::TRANSFO)];
+    spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::ARENA, 16, 8192);
+    void *firstBuffer = nullptr;
+    for (size_t iter = 0; iter < 4; ++iter) {
+        spider::vector<double *> buffers;
+        for (size_t i = 0; i < 256; ++i) {
+            buffers.emplace_back(spider::allocate<double, StackID::TRANSFO>(1 + i % 1024));
+            ASSERT_EQ(spider::Stack::owner(buffers.back()), stack);
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(buffers.back()) % 16, 0)
+                                        << "Stack: arena buffers should keep slab alignment.";
+        }
+        ASSERT_NE(stack->policy()->usage(), 0) << "Stack: arena buffers should bypass the slabs.";
+        if (iter > 1) {
+            ASSERT_EQ(buffers[0], firstBuffer) << "Stack: reset should rewind the merged chunk of the arena.";
+        }
+        firstBuffer = buffers[0];
+        for (auto *buffer : buffers) {
+            spider::deallocate(buffer);
+        }
+        ASSERT_EQ(stack->liveCount(), 0);
+        ASSERT_EQ(stack->reset(), 0);
+        ASSERT_EQ(stack->policy()->usage(), 0) << "Stack: every buffer should be given back to the arena.";
+    }
+    auto *buffer = spider::allocate<double, StackID::TRANSFO>(8);
+    ASSERT_THROW(spider::stackArray()[static_cast<uint64_t>(StackID::SCHEDULE)]->deallocate(buffer),
+                 spider::Exception) << "Stack: arena buffers should only be freed by their stack.";
+    spider::deallocate(buffer);
+    ASSERT_EQ(stack->reset(), 0);
+}
+
+TEST_F(allocatorTest, tlsfCtorTest) {
+    ASSERT_THROW(TLSFAllocatorPolicy(0, nullptr, 2), spider::Exception)
+                                << "TLSFAllocatorPolicy should throw with alignement < 8.";
+    char tmp[1000];
+    ASSERT_THROW(TLSFAllocatorPolicy(16, tmp), spider::Exception)
+                                << "TLSFAllocatorPolicy should throw with too small external buffer.";
+    ASSERT_NO_THROW(TLSFAllocatorPolicy(1000)) << "TLSFAllocatorPolicy should not throw with default ctor.";
+    ASSERT_NO_THROW(TLSFAllocatorPolicy(1000, tmp))
+                                << "TLSFAllocatorPolicy should not throw with default ctor and external buffer.";
+}
+
+TEST_F(allocatorTest, tlsfAllocTest) {
+    TLSFAllocatorPolicy allocator{ TLSFAllocatorPolicy::MIN_CHUNK_SIZE };
+    {
+        char tmp[10];
+        ASSERT_THROW(allocator.deallocate(tmp), spider::Exception)
+                                    << "TLSFAllocatorPolicy::deallocate should throw when deallocating with no memory allocated.";
+    }
+    ASSERT_EQ(nullptr, allocator.allocate(0)) << "Allocator: 0 size allocation should result in nullptr.";
+    ASSERT_NO_THROW(allocator.deallocate(nullptr)) << "Allocator: deallocate for nullptr should not throw";
+
+    /* == Payloads are rounded to 16 bytes and follow a 16 bytes header == */
+    auto *buffer = reinterpret_cast<char *>(allocator.allocate(1));
+    ASSERT_EQ(allocator.lastAllocatedSize(), 16);
+    auto *buffer2 = reinterpret_cast<char *>(allocator.allocate(17));
+    ASSERT_EQ(allocator.lastAllocatedSize(), 32);
+    ASSERT_EQ(buffer + 32, buffer2) << "Allocator: blocks should be contiguous.";
+    ASSERT_EQ(allocator.usage(), 48);
+    ASSERT_THROW(allocator.deallocate(buffer + 2 * TLSFAllocatorPolicy::MIN_CHUNK_SIZE), spider::Exception)
+                                << "Allocator: deallocation out of the pools should throw.";
+    ASSERT_EQ(allocator.deallocate(buffer), 16);
+    ASSERT_THROW(allocator.deallocate(buffer), spider::Exception) << "Allocator: double free should throw.";
+
+    /* == Freed blocks are merged back into a single block == */
+    ASSERT_EQ(allocator.deallocate(buffer2), 32);
+    ASSERT_EQ(allocator.usage(), 0);
+    auto *whole = reinterpret_cast<char *>(allocator.allocate(TLSFAllocatorPolicy::MIN_CHUNK_SIZE));
+    ASSERT_EQ(whole, buffer) << "Allocator: free blocks should be coalesced.";
+
+    /* == Growth through extra buffers == */
+    void *extra = nullptr;
+    ASSERT_NO_THROW(extra = allocator.allocate(3 * TLSFAllocatorPolicy::MIN_CHUNK_SIZE))
+                                << "Allocator: extra buffer should not throw at allocation.";
+    ASSERT_NE(extra, nullptr);
+    ASSERT_NO_THROW(allocator.deallocate(extra)) << "Allocator: extra buffer should not throw at deallocation.";
+    ASSERT_NO_THROW(allocator.deallocate(whole)) << "Allocator: deallocation should not throw.";
+    ASSERT_EQ(allocator.usage(), 0);
+}
+
+TEST_F(allocatorTest, tlsfAlignTest) {
+    TLSFAllocatorPolicy allocator{ 8192, nullptr, 64 };
+    std::vector<void *> buffers;
+    for (size_t size = 1; size < 4096; size += 37) {
+        auto *buffer = allocator.allocate(size);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer) % 64, 0) << "Allocator: buffer should be aligned on 64 bytes.";
+        std::memset(buffer, 0xFF, size);
+        buffers.emplace_back(buffer);
+    }
+    for (size_t i = 0; i < buffers.size(); i += 2) {
+        ASSERT_NO_THROW(allocator.deallocate(buffers[i]));
+    }
+    for (size_t i = 1; i < buffers.size(); i += 2) {
+        ASSERT_NO_THROW(allocator.deallocate(buffers[i]));
+    }
+    ASSERT_EQ(allocator.usage(), 0);
+}
+
+TEST_F(allocatorTest, tlsfExternalAlloc) {
+    char buffer[1024];
+    TLSFAllocatorPolicy allocator{ 1024, buffer };
+    auto *inside = allocator.allocate(512);
+    ASSERT_GE(reinterpret_cast<char *>(inside), buffer);
+    ASSERT_LT(reinterpret_cast<char *>(inside), buffer + 1024) << "Allocator: should use the external buffer.";
+    auto *outside = allocator.allocate(1024);
+    ASSERT_NE(outside, nullptr) << "Allocator: should grow with an extra buffer.";
+    ASSERT_NO_THROW(allocator.deallocate(inside));
+    ASSERT_NO_THROW(allocator.deallocate(outside));
+    char extern_buffer[512];
+    ASSERT_THROW(allocator.deallocate(extern_buffer), spider::Exception)
+                                << "Allocator: extern buffer deallocation should throw";
+}
+
+TEST_F(allocatorTest, tlsfStackTest) {
+    auto *stack = spider::stackArray()[static_cast<uint64_t>(StackID::TRANSFO)];
+    spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::TLSF, 16, 8192);
+    spider::vector<double *> buffers;
+    for (size_t i = 0; i < 512; ++i) {
+        buffers.emplace_back(spider::allocate<double, StackID::TRANSFO>(1 + (i * 97) % 2048));
+    }
+    for (auto *buffer : buffers) {
+        ASSERT_EQ(spider::Stack::owner(buffer), stack);
+        spider::deallocate(buffer);
+    }
+    stack->flushCaches();
+    ASSERT_EQ(stack->policy()->usage(), 0) << "Stack: every slab should be given back to the policy.";
+}
+
+TEST_F(allocatorTest, mappedBackingTest) {
+    constexpr size_t SIZE = 3 * 1024 * 1024 + 17;
+    for (auto backing : { spider::MemoryBacking::MALLOC, spider::MemoryBacking::MMAP,
+                          spider::MemoryBacking::HUGE_PAGES }) {
+        auto actualBacking = backing;
+        auto *buffer = reinterpret_cast<char *>(spider::detail::allocateMappedBuffer(SIZE, actualBacking));
+        ASSERT_NE(buffer, nullptr) << "allocateMappedBuffer: should fall back to an available backing.";
+        ASSERT_LE(static_cast<int>(actualBacking), static_cast<int>(backing))
+                                    << "allocateMappedBuffer: fallback should only go from HUGE_PAGES to MALLOC.";
+        std::memset(buffer, 0x5A, SIZE);
+        ASSERT_EQ(buffer[SIZE - 1], 0x5A);
+        ASSERT_NO_THROW(spider::detail::deallocateMappedBuffer(buffer, SIZE, actualBacking));
+        /* == Policies owning a static buffer == */
+        {
+            auto allocator = LinearStaticAllocator(SIZE, nullptr, sizeof(int64_t), backing);
+            auto *data = reinterpret_cast<char *>(allocator.allocate(SIZE / 2));
+            ASSERT_NE(data, nullptr) << "LinearStaticAllocator: failed to allocate in mapped buffer.";
+            std::memset(data, 0, SIZE / 2);
+        }
+        {
+            auto allocator = FreeListAllocatorPolicy(SIZE, nullptr, FreeListPolicy::FIND_FIRST, sizeof(int64_t),
+                                                     backing);
+            auto *data = allocator.allocate(SIZE / 2);
+            ASSERT_NE(data, nullptr) << "FreeListAllocatorPolicy: failed to allocate in mapped buffer.";
+            std::memset(data, 0, SIZE / 2);
+            allocator.deallocate(data);
+            ASSERT_EQ(allocator.usage(), 0);
+        }
+        {
+            TLSFAllocatorPolicy allocator{ SIZE, nullptr, sizeof(int64_t), backing };
+            auto *data = allocator.allocate(SIZE / 2);
+            ASSERT_NE(data, nullptr) << "TLSFAllocatorPolicy: failed to allocate in mapped buffer.";
+            std::memset(data, 0, SIZE / 2);
+            allocator.deallocate(data);
+            ASSERT_EQ(allocator.usage(), 0);
+        }
+    }
+}
+
+/* === Random allocation mix helpers === */
+
+/**
+ * @brief Run a random mix of allocations / deallocations and check that buffers are aligned, never overlap and are
+ *        all given back to the policy.
+ */
+static void allocStress(AbstractAllocatorPolicy &allocator, const char *name) {
+    constexpr size_t OP_COUNT = 20000;
+    constexpr size_t SLOT_COUNT = 512;
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<size_t> slotDistribution{ 0, SLOT_COUNT - 1 };
+    std::uniform_int_distribution<size_t> smallDistribution{ 16, 512 };
+    std::uniform_int_distribution<size_t> largeDistribution{ 512, 16384 };
+    std::vector<std::pair<char *, size_t>> slots(SLOT_COUNT, std::make_pair(nullptr, 0));
+    /* == Every live buffer is filled with the index of its slot, so overlapping buffers are detected on free == */
+    const auto check = [&slots, name](size_t ix) {
+        const auto &slot = slots[ix];
+        const auto value = static_cast<char>(ix & 0xFF);
+        ASSERT_EQ(std::count(slot.first, slot.first + slot.second, value), static_cast<std::ptrdiff_t>(slot.second))
+                                    << name << ": live buffers should not overlap.";
+    };
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        const auto ix = slotDistribution(generator);
+        auto &slot = slots[ix];
+        const auto size = (i % 5) ? smallDistribution(generator) : largeDistribution(generator);
+        if (slot.first) {
+            check(ix);
+            allocator.deallocate(slot.first);
+            slot = std::make_pair(nullptr, 0);
+        } else {
+            slot = std::make_pair(reinterpret_cast<char *>(allocator.allocate(size)), size);
+            ASSERT_NE(slot.first, nullptr) << name << ": allocation should not fail.";
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(slot.first) % allocator.alignment(), 0)
+                                        << name << ": buffers should be aligned.";
+            std::memset(slot.first, static_cast<int>(ix & 0xFF), size);
+        }
+    }
+    for (size_t ix = 0; ix < SLOT_COUNT; ++ix) {
+        check(ix);
+        allocator.deallocate(slots[ix].first);
+    }
+    ASSERT_EQ(allocator.usage(), 0) << name << ": every buffer should have been freed.";
+}
+
+/**
+ * @brief Run the same random mix of allocations / deallocations and report the latency percentiles of each operation.
+ */
+static void allocLatency(AbstractAllocatorPolicy &allocator, const char *name) {
+    constexpr size_t OP_COUNT = 200000;
+    constexpr size_t SLOT_COUNT = 512;
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<size_t> slotDistribution{ 0, SLOT_COUNT - 1 };
+    std::uniform_int_distribution<size_t> smallDistribution{ 16, 512 };
+    std::uniform_int_distribution<size_t> largeDistribution{ 512, 16384 };
+    std::vector<void *> slots(SLOT_COUNT, nullptr);
+    std::vector<double> latencies;
+    latencies.reserve(OP_COUNT);
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        auto &slot = slots[slotDistribution(generator)];
+        const auto size = (i % 5) ? smallDistribution(generator) : largeDistribution(generator);
+        const auto start = std::chrono::steady_clock::now();
+        if (slot) {
+            allocator.deallocate(slot);
+            slot = nullptr;
+        } else {
+            slot = allocator.allocate(size);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        latencies.emplace_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    for (auto *slot : slots) {
+        allocator.deallocate(slot);
+    }
+    EXPECT_EQ(allocator.usage(), 0) << name << ": every buffer should have been freed.";
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1,
+                                  static_cast<size_t>(p * static_cast<double>(latencies.size())))];
+    };
+    fprintf(stderr, "%-22s -- p50: %8.1lf ns -- p99: %8.1lf ns -- p99.9: %8.1lf ns -- max: %10.1lf ns\n", name,
+            percentile(.5), percentile(.99), percentile(.999), latencies.back());
+}
+
+/**
+ * @brief Run a random allocation mix on every dynamic policy.
+ */
+static void runOnDynamicPolicies(void (*mix)(AbstractAllocatorPolicy &, const char *)) {
+    {
+        auto allocator = GenericAllocatorPolicy(8);
+        mix(allocator, "Generic");
+    }
+    {
+        auto allocator = FreeListAllocatorPolicy(65536, nullptr, FreeListPolicy::FIND_FIRST);
+        mix(allocator, "FreeList (FIND_FIRST)");
+    }
+    {
+        auto allocator = FreeListAllocatorPolicy(65536, nullptr, FreeListPolicy::FIND_BEST);
+        mix(allocator, "FreeList (FIND_BEST)");
+    }
+    {
+        auto allocator = ArenaAllocatorPolicy(65536);
+        mix(allocator, "Arena");
+    }
+    {
+        TLSFAllocatorPolicy allocator{ 65536 };
+        mix(allocator, "TLSF");
+    }
+}
+
+TEST_F(allocatorTest, allocStressTest) {
+    runOnDynamicPolicies(allocStress);
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(allocatorTest, DISABLED_allocLatencyBenchmarkTest) {
+    runOnDynamicPolicies(allocLatency);
+}
+
 TEST_F(allocatorTest, allocTest) {
     ASSERT_NO_THROW(spider::allocate<double>(StackID::GENERAL, 0));
     ASSERT_EQ(spider::allocate<double>(StackID::GENERAL, 0), nullptr)
@@ -309,6 +688,145 @@ TEST_F(allocatorTest, allocatorTest) {
     ASSERT_NE(spider::allocator<double>(StackID::PISDF), spider::allocator<double>());
 }
 
+TEST_F(allocatorTest, stackCacheStatsTest) {
+    auto *stack = spider::stackArray()[static_cast<uint64_t>(StackID::OPTIMS)];
+    /* == 16 doubles = 128 bytes class, no header is added == */
+    auto *first = spider::allocate<double, StackID::OPTIMS>(16);
+    auto *second = spider::allocate<double, StackID::OPTIMS>(16);
+    ASSERT_EQ(stack->usage(), 256) << "Stack: usage should account for both buffers.";
+    ASSERT_EQ(stack->peak(), 256) << "Stack: peak should account for both buffers.";
+    ASSERT_EQ(stack->average(), 192) << "Stack: average should be computed at every allocation.";
+    const auto slabUsage = stack->policy()->usage();
+    ASSERT_GT(slabUsage, 0) << "Stack: small buffers should be carved out of a slab of the policy.";
+    spider::deallocate(first);
+    spider::deallocate(second);
+    ASSERT_EQ(stack->policy()->usage(), slabUsage) << "Stack: freed small buffers should be kept in the thread cache.";
+    auto *third = spider::allocate<double, StackID::OPTIMS>(16);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(third), reinterpret_cast<uintptr_t>(second))
+                                << "Stack: thread cache should reuse the last freed block.";
+    spider::deallocate(third);
+    stack->flushCaches();
+    ASSERT_EQ(stack->usage(), 0) << "Stack: usage should be 0 once every buffer is freed.";
+    ASSERT_EQ(stack->peak(), 256) << "Stack: peak should not be affected by deallocations.";
+    ASSERT_EQ(stack->policy()->usage(), 0) << "Stack: flushCaches should give back empty slabs to the policy.";
+}
+
+TEST_F(allocatorTest, stackCacheThreadsTest) {
+    auto *stack = spider::stackArray()[static_cast<uint64_t>(StackID::RUNTIME)];
+    auto worker = [](size_t seed) {
+        spider::vector<int64_t *> buffers;
+        for (size_t i = 0; i < 4096; ++i) {
+            buffers.emplace_back(spider::allocate<int64_t, StackID::RUNTIME>(1 + (i * seed) % 60));
+            if (i % 3 == 0) {
+                spider::deallocate(buffers.back());
+                buffers.pop_back();
+            }
+        }
+        for (auto &buffer : buffers) {
+            spider::deallocate(buffer);
+        }
+    };
+    spider::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back(worker, i + 1);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    stack->flushCaches();
+    ASSERT_EQ(stack->usage(), 0) << "Stack: usage should be 0 once every thread freed its buffers.";
+    ASSERT_GT(stack->peak(), 0) << "Stack: peak should account for allocations of every thread.";
+    ASSERT_EQ(stack->policy()->usage(), 0) << "Stack: exiting threads should give back their cached blocks.";
+}
+
+TEST_F(allocatorTest, stackConcurrentStatsTest) {
+    auto *stack = spider::stackArray()[static_cast<uint64_t>(StackID::RUNTIME)];
+    constexpr size_t THREAD_COUNT = 4;
+    constexpr size_t BUFFER_COUNT = 10;
+    const auto usage = stack->usage();
+    std::atomic<size_t> readyCount{ 0 };
+    std::atomic<bool> release{ false };
+    auto worker = [&]() {
+        /* == 8 int64_t = 64 bytes class, fewer operations than a thread cache can hold == */
+        int64_t *buffers[BUFFER_COUNT];
+        for (auto &buffer : buffers) {
+            buffer = spider::allocate<int64_t, StackID::RUNTIME>(8);
+        }
+        readyCount.fetch_add(1);
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        for (auto &buffer : buffers) {
+            spider::deallocate(buffer);
+        }
+    };
+    spider::vector<std::thread> threads;
+    for (size_t i = 0; i < THREAD_COUNT; ++i) {
+        threads.emplace_back(worker);
+    }
+    while (readyCount.load() < THREAD_COUNT) {
+        std::this_thread::yield();
+    }
+    /* == No flush: statistics should not lag behind the threads == */
+    ASSERT_EQ(stack->usage(), usage + THREAD_COUNT * BUFFER_COUNT * 64)
+                                << "Stack: usage should account for live buffers of every thread.";
+    ASSERT_GE(stack->peak(), usage + THREAD_COUNT * BUFFER_COUNT * 64)
+                                << "Stack: peak should account for live buffers of every thread.";
+    release.store(true);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(stack->usage(), usage) << "Stack: usage should be restored once every thread freed its buffers.";
+}
+
+TEST_F(allocatorTest, stackPageLookupTest) {
+    auto *pisdf = spider::stackArray()[static_cast<uint64_t>(StackID::PISDF)];
+    auto *schedule = spider::stackArray()[static_cast<uint64_t>(StackID::SCHEDULE)];
+    spider::vector<std::pair<void *, spider::Stack *>> buffers;
+    for (size_t size = 1; size <= 3 * spider::Stack::SLAB_MAX_SIZE; size += 37) {
+        buffers.emplace_back(spider::allocate<char, StackID::PISDF>(size), pisdf);
+        buffers.emplace_back(spider::allocate<char, StackID::SCHEDULE>(size), schedule);
+        const auto address = reinterpret_cast<uintptr_t>(buffers.back().first);
+        ASSERT_EQ(address % 16, 0) << "Stack: every buffer should be 16 bytes aligned.";
+        if (size > spider::Stack::SLAB_MAX_SIZE) {
+            ASSERT_EQ(address % spider::Stack::LARGE_ALIGNMENT, 0) << "Stack: large buffers should be 64 bytes aligned.";
+        }
+    }
+    for (size_t i = 0; i < 64; ++i) {
+        auto *buffer = spider::allocate<char, StackID::PISDF>(64);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer) % 64, 0) << "Stack: 64 bytes buffers should be 64 bytes aligned.";
+        buffers.emplace_back(buffer, pisdf);
+    }
+    for (auto &buffer : buffers) {
+        ASSERT_EQ(spider::Stack::owner(buffer.first), buffer.second) << "Stack: owner should be found from the address.";
+        ASSERT_NO_THROW(spider::deallocate(buffer.first));
+    }
+    pisdf->flushCaches();
+    schedule->flushCaches();
+    ASSERT_EQ(pisdf->usage(), 0);
+    ASSERT_EQ(pisdf->policy()->usage(), 0) << "Stack: every slab should be released once empty.";
+    ASSERT_EQ(schedule->policy()->usage(), 0) << "Stack: every slab should be released once empty.";
+    int value = 0;
+    ASSERT_EQ(spider::Stack::owner(&value), nullptr) << "Stack: foreign address should not have an owner.";
+    ASSERT_THROW(spider::deallocate(&value), spider::Exception) << "deallocate should throw on foreign address.";
+    auto *buffer = spider::allocate<char, StackID::PISDF>(32);
+    ASSERT_THROW(schedule->deallocate(buffer), spider::Exception) << "Stack: deallocate should check ownership.";
+    spider::deallocate(buffer);
+}
+
+TEST_F(allocatorTest, pageMapReleaseTest) {
+    spider::deallocate(spider::allocate<char, StackID::PISDF>(32));
+    ASSERT_GT(spider::detail::pageMapLevelCount(), 0U);
+    /* == Every page is cleared when the stacks are destroyed, so quit frees the page map == */
+    spider::quit();
+    ASSERT_EQ(spider::detail::setPageCount(), 0U);
+    ASSERT_EQ(spider::detail::pageMapLevelCount(), 0U);
+    spider::start();
+    auto *buffer = spider::allocate<char, StackID::PISDF>(32);
+    ASSERT_EQ(spider::Stack::owner(buffer), spider::stackArray()[static_cast<uint64_t>(StackID::PISDF)]);
+    spider::deallocate(buffer);
+}
+
 TEST_F(allocatorTest, errorUsageTest) {
     void *tmp = nullptr;
     ASSERT_NO_THROW((tmp = spider::allocate<double, StackID::GENERAL>()));
@@ -42,12 +42,28 @@
 
 #include <common/Logger.h>
 #include <graphs/pisdf/Graph.h>
+#include <archi/Platform.h>
+#include <archi/PE.h>
+#include <archi/Cluster.h>
+#include <archi/MemoryInterface.h>
+#include <scheduling/memory/FifoAllocator.h>
 #include <runtime/algorithm/srdag-based/SRDAGJITMSRuntime.h>
 #include <runtime/algorithm/pisdf-based/PiSDFJITMSRuntime.h>
+#include <scheduling/schedule/ScheduleCache.h>
 #include "RuntimeTestCases.h"
+#include <atomic>
 
 extern bool spider2StopRunning;
 
+/* === Static function(s) === */
+
+static spider::test::MemoryFootprint footprint(const spider::RuntimeContext &context) {
+    spider::test::MemoryFootprint result;
+    result.virtualSize_ = context.algorithm_->fifoAllocator()->peakVirtualMemorySize();
+    result.physicalSize_ = spider::archi::platform()->spiderGRTPE()->cluster()->memoryInterface()->allocatedSize();
+    return result;
+}
+
 /* === Function(s) definition === */
 
 void spider::test::runtimeStaticFlat(spider::RuntimeConfig cfg) {
@@ -79,7 +95,7 @@ void spider::test::runtimeStaticFlat(spider::RuntimeConfig cfg) {
     api::destroyGraph(graph);
 }
 
-void spider::test::runtimeStaticHierarchical(spider::RuntimeConfig cfg) {
+spider::test::MemoryFootprint spider::test::runtimeStaticHierarchical(spider::RuntimeConfig cfg) {
     spider::api::createThreadRTPlatform();
     auto *graph = spider::api::createGraph("topgraph", 1, 0, 0);
     auto *vertex_0 = spider::api::createVertex(graph, "vertex_0", 0, 1);
@@ -106,9 +122,11 @@ void spider::test::runtimeStaticHierarchical(spider::RuntimeConfig cfg) {
 
     auto context = spider::createRuntimeContext(graph, cfg);
     spider::run(context);
+    const auto result = footprint(context);
     spider::destroyRuntimeContext(context);
 
     api::destroyGraph(graph);
+    return result;
 }
 
 void spider::test::runtimeStaticFlatNoExec(spider::RuntimeConfig cfg) {
@@ -185,8 +203,80 @@ void spider::test::runtimeStaticHierarchicalNoExec(spider::RuntimeConfig cfg) {
     api::destroyGraph(graph);
 }
 
-void spider::test::runtimeDynamicHierarchical(spider::RuntimeConfig cfg) {
-    auto *graph = spider::api::createGraph("topgraph", 15, 15, 1);
+static std::atomic<int64_t> multiRateErrors{ 0 };
+static std::atomic<int64_t> multiRateChecksum{ 0 };
+
+spider::test::MemoryFootprint spider::test::runtimeStaticMultiRate(spider::RuntimeConfig cfg) {
+    /* == vertex_2 reads data of two firings of vertex_1 for its second firing, vertex_3 and vertex_4 run once
+     *    the buffers of the first vertices are dead (a lifetime aware allocator may reuse them) == */
+    auto *graph = spider::api::createGraph("topgraph", 5, 4, 0);
+    auto *vertex_0 = spider::api::createVertex(graph, "vertex_0", 0, 1);
+    auto *vertex_1 = spider::api::createVertex(graph, "vertex_1", 1, 1);
+    auto *vertex_2 = spider::api::createVertex(graph, "vertex_2", 1, 1);
+    auto *vertex_3 = spider::api::createVertex(graph, "vertex_3", 1, 1);
+    auto *vertex_4 = spider::api::createVertex(graph, "vertex_4", 1, 0);
+    spider::api::createEdge(vertex_0, 0, 4, vertex_1, 0, 2);
+    spider::api::createEdge(vertex_1, 0, 3, vertex_2, 0, 2);
+    spider::api::createEdge(vertex_2, 0, 1, vertex_3, 0, 3);
+    spider::api::createEdge(vertex_3, 0, 1, vertex_4, 0, 1);
+    spider::api::createThreadRTPlatform();
+    multiRateErrors = 0;
+    multiRateChecksum = 0;
+    spider::api::createRuntimeKernel(vertex_0,
+                                     [](const int64_t *, int64_t *, void *[], void *output[]) -> void {
+                                         auto *buffer = reinterpret_cast<char *>(output[0]);
+                                         buffer[0] = 0;
+                                         buffer[2] = 1;
+                                     });
+
+    spider::api::createRuntimeKernel(vertex_1,
+                                     [](const int64_t *, int64_t *, void *input[], void *output[]) -> void {
+                                         /* == Firing k writes values 3k, 3k + 1 and 3k + 2 == */
+                                         const auto firing = reinterpret_cast<char *>(input[0])[0];
+                                         auto *buffer = reinterpret_cast<char *>(output[0]);
+                                         for (int i = 0; i < 3; ++i) {
+                                             buffer[i] = static_cast<char>(3 * firing + i);
+                                         }
+                                     });
+
+    spider::api::createRuntimeKernel(vertex_2,
+                                     [](const int64_t *, int64_t *, void *input[], void *output[]) -> void {
+                                         /* == Firing k reads values 2k and 2k + 1 and writes k == */
+                                         auto *buffer = reinterpret_cast<char *>(input[0]);
+                                         multiRateErrors += (buffer[0] % 2) || (buffer[1] != buffer[0] + 1);
+                                         multiRateChecksum += (1 << buffer[0]) + (1 << buffer[1]);
+                                         reinterpret_cast<char *>(output[0])[0] = static_cast<char>(buffer[0] / 2);
+                                     });
+
+    spider::api::createRuntimeKernel(vertex_3,
+                                     [](const int64_t *, int64_t *, void *input[], void *output[]) -> void {
+                                         /* == Writes the firings of vertex_2 it read as a bit field == */
+                                         auto *buffer = reinterpret_cast<char *>(input[0]);
+                                         char firings = 0;
+                                         for (int i = 0; i < 3; ++i) {
+                                             firings = static_cast<char>(firings | (1 << buffer[i]));
+                                         }
+                                         reinterpret_cast<char *>(output[0])[0] = firings;
+                                     });
+
+    spider::api::createRuntimeKernel(vertex_4,
+                                     [](const int64_t *, int64_t *, void *input[], void *[]) -> void {
+                                         multiRateErrors += reinterpret_cast<char *>(input[0])[0] != 7;
+                                     });
+
+    auto context = spider::createRuntimeContext(graph, cfg);
+    spider::run(context);
+    const auto result = footprint(context);
+    spider::destroyRuntimeContext(context);
+    api::destroyGraph(graph);
+    if (multiRateErrors || (multiRateChecksum != 63 * static_cast<int64_t>(cfg.loopCount_))) {
+        throwSpiderException("a vertex did not read the data produced by its producer.");
+    }
+    return result;
+}
+
+spider::pisdf::Graph *spider::test::dynamicHierarchicalGraph() {
+    auto *graph = spider::api::createGraph("topgraph", 16, 16, 1);
 
     /* === Creating vertices === */
 
@@ -197,13 +287,14 @@ void spider::test::runtimeDynamicHierarchical(spider::RuntimeConfig cfg) {
     auto *output = spider::api::setOutputInterfaceName(subgraph, 0, "output");
     auto *vertex_2 = spider::api::createVertex(subgraph, "vertex_2", 1, 2);
     auto *vertex_3 = spider::api::createVertex(subgraph, "vertex_3", 1, 1);
-    auto *vertex_4 = spider::api::createVertex(graph, "vertex_4", 2);
+    auto *vertex_4 = spider::api::createVertex(graph, "vertex_4", 2, 1);
     auto *vertex_5 = spider::api::createVertex(graph, "vertex_5", 0, 1);
     auto *width_setter = spider::api::createConfigActor(subgraph, "width_setter");
     auto *subsubgraph = spider::api::createSubgraph(subgraph, "subsubgraph", 2, 4, 2, 1);
     auto *sub_setter = spider::api::createConfigActor(subsubgraph, "sub_setter");
     auto *vertex_6 = spider::api::createVertex(subsubgraph, "vertex_6", 1, 0);
     auto *sub_input = spider::api::setInputInterfaceName(subsubgraph, 0, "sub_input");
+    auto *vertex_7 = spider::api::createVertex(graph, "vertex_7", 1, 0);
     /* === Create the runtime kernels === */
     spider::api::createThreadRTPlatform();
 
@@ -267,6 +358,11 @@ void spider::test::runtimeDynamicHierarchical(spider::RuntimeConfig cfg) {
                                          spider::printer::printf("vertex_6: hello %" PRId64".\n", inputParam[0]);
                                      });
 
+    spider::api::createRuntimeKernel(vertex_7,
+                                     [](const int64_t *, int64_t *, void *[], void *[]) -> void {
+//                                             spider::printer::printf("vertex_7: hello.\n");
+                                     });
+
 
     /* === Creating param === */
     spider::api::createStaticParam(subgraph, "height", 10);
@@ -294,9 +390,87 @@ void spider::test::runtimeDynamicHierarchical(spider::RuntimeConfig cfg) {
     spider::api::createEdge(vertex_5, 0, 1, vertex_4, 0, 1);
     spider::api::createEdge(vertex_2, 1, "10", subsubgraph, 0, "10");
     spider::api::createEdge(sub_input, 0, "10", vertex_6, 0, "sub_width");
+    spider::api::createEdge(vertex_4, 0, 4, vertex_7, 0, 4);
+    return graph;
+}
+
+spider::test::MemoryFootprint spider::test::runtimeDynamicHierarchical(spider::RuntimeConfig cfg) {
+    auto *graph = dynamicHierarchicalGraph();
+    auto context = spider::createRuntimeContext(graph, cfg);
+    spider::run(context);
+    const auto result = footprint(context);
+    spider::destroyRuntimeContext(context);
+    api::destroyGraph(graph);
+    return result;
+}
+
+static std::atomic<int64_t> cyclingIteration{ 0 };
+static std::atomic<int64_t> cyclingChecksum{ 0 };
+
+void spider::test::runtimeDynamicCycling(spider::RuntimeConfig cfg) {
+    /* == The width of the subgraph cycles between 2 and 3 along the iterations == */
+    auto *graph = spider::api::createGraph("topgraph", 1, 0, 0);
+    auto *subgraph = spider::api::createSubgraph(graph, "subgraph", 3, 1, 1, 0, 0, 1);
+    auto *setter = spider::api::createConfigActor(subgraph, "setter");
+    auto *producer = spider::api::createVertex(subgraph, "producer", 0, 1);
+    auto *consumer = spider::api::createVertex(subgraph, "consumer", 1, 0);
+    auto width = spider::api::createDynamicParam(subgraph, "width");
+    spider::api::addOutputParamsToVertex(setter, { width });
+    spider::api::addInputParamsToVertex(producer, { width });
+    spider::api::addInputRefinementParamToVertex(producer, width);
+    spider::api::createEdge(producer, 0, "width", consumer, 0, "1");
+    spider::api::createThreadRTPlatform();
+    cyclingIteration = 0;
+    cyclingChecksum = 0;
+    spider::api::createRuntimeKernel(setter,
+                                     [](const int64_t *, int64_t *out, void *[], void *[]) -> void {
+                                         out[0] = 2 + (cyclingIteration++ % 2);
+                                     });
+
+    spider::api::createRuntimeKernel(producer,
+                                     [](const int64_t *inputParams, int64_t *, void *[], void *output[]) -> void {
+                                         auto *buffer = reinterpret_cast<char *>(output[0]);
+                                         for (int64_t i = 0; i < inputParams[0]; ++i) {
+                                             buffer[i] = static_cast<char>(i);
+                                         }
+                                     });
+
+    spider::api::createRuntimeKernel(consumer,
+                                     [](const int64_t *, int64_t *, void *input[], void *[]) -> void {
+                                         cyclingChecksum += reinterpret_cast<char *>(input[0])[0];
+                                     });
 
     auto context = spider::createRuntimeContext(graph, cfg);
     spider::run(context);
+    const auto *cache = cfg.scheduleCacheCapacity_ ?
+                        static_cast<PiSDFJITMSRuntime *>(context.algorithm_)->scheduleCache() : nullptr;
+    const auto hitCount = cache ? cache->hitCount() : 0;
+    const auto missCount = cache ? cache->missCount() : 0;
     spider::destroyRuntimeContext(context);
     api::destroyGraph(graph);
+    /* == Every pair of iterations reads 0 + 1 then 0 + 1 + 2 == */
+    const auto loopCount = static_cast<int64_t>(cfg.loopCount_);
+    if (cyclingChecksum != (loopCount / 2) * 4 + (loopCount % 2)) {
+        throwSpiderException("consumer did not read the data produced by producer.");
+    }
+    /* == Both rounds of the first two iterations are scheduled, except for the first round of the second one == */
+    if ((cfg.scheduleCacheCapacity_ > 1) && ((missCount != 3) || (hitCount != 2 * cfg.loopCount_ - 3))) {
+        throwSpiderException("unexpected schedule cache statistics: %zu hits, %zu misses.", hitCount, missCount);
+    }
+    /* == With a single cached iteration, only the first round of the iterations after the first one is replayed == */
+    if ((cfg.scheduleCacheCapacity_ == 1) && ((missCount != cfg.loopCount_ + 1) || (hitCount != cfg.loopCount_ - 1))) {
+        throwSpiderException("unexpected schedule cache statistics: %zu hits, %zu misses.", hitCount, missCount);
+    }
+}
+
+std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint>
+spider::test::compareFootprints(MemoryFootprint (*testCase)(spider::RuntimeConfig),
+                                spider::RuntimeConfig cfg,
+                                const std::function<void()> &restart) {
+    cfg.allocType_ = spider::FifoAllocatorType::DEFAULT;
+    const auto reference = testCase(cfg);
+    /* == Same graph on a fresh platform, reused ranges should shrink both footprints == */
+    restart();
+    cfg.allocType_ = spider::FifoAllocatorType::LIFETIME_AWARE;
+    return { reference, testCase(cfg) };
 }
@@ -43,20 +43,47 @@
 /* === Include(s) === */
 
 #include <api/spider.h>
+#include <functional>
+#include <utility>
 
 /* === Function(s) prototype === */
 
 namespace spider {
     namespace test {
+        struct MemoryFootprint {
+            size_t virtualSize_ = 0;    /* = Largest virtual address space of an iteration = */
+            uint64_t physicalSize_ = 0; /* = Physical memory allocated by the memory interface of the GRT = */
+        };
+
         void runtimeStaticFlat(spider::RuntimeConfig cfg);
 
-        void runtimeStaticHierarchical(spider::RuntimeConfig cfg);
+        MemoryFootprint runtimeStaticHierarchical(spider::RuntimeConfig cfg);
 
         void runtimeStaticFlatNoExec(spider::RuntimeConfig cfg);
 
         void runtimeStaticHierarchicalNoExec(spider::RuntimeConfig cfg);
 
-        void runtimeDynamicHierarchical(spider::RuntimeConfig cfg);
+        MemoryFootprint runtimeStaticMultiRate(spider::RuntimeConfig cfg);
+
+        /**
+         * @brief Create the dynamic hierarchical graph run by runtimeDynamicHierarchical (the platform is created too).
+         */
+        spider::pisdf::Graph *dynamicHierarchicalGraph();
+
+        MemoryFootprint runtimeDynamicHierarchical(spider::RuntimeConfig cfg);
+
+        void runtimeDynamicCycling(spider::RuntimeConfig cfg);
+
+        /**
+         * @brief Run a test case with the DEFAULT then with the LIFETIME_AWARE FIFO allocator.
+         * @param testCase Test case returning its memory footprint.
+         * @param cfg      Runtime configuration (the allocator type is overridden).
+         * @param restart  Function giving a fresh platform between both runs.
+         * @return footprints with the DEFAULT and with the LIFETIME_AWARE allocator.
+         */
+        std::pair<MemoryFootprint, MemoryFootprint> compareFootprints(MemoryFootprint (*testCase)(spider::RuntimeConfig),
+                                                                      spider::RuntimeConfig cfg,
+                                                                      const std::function<void()> &restart);
     }
 }
 
@@ -42,6 +42,14 @@
 #include <graphs/pisdf/Graph.h>
 #include <scheduling/scheduler/Scheduler.h>
 #include <runtime/algorithm/srdag-based/SRDAGJITMSRuntime.h>
+#include <archi/Platform.h>
+#include <archi/Cluster.h>
+#include <archi/MemoryInterface.h>
+#include <archi/NUMATopology.h>
+#include <thread/Thread.h>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
 #include "appTest/stabilization/spider2-stabilization.h"
 #include "appTest/reinforcement/spider2-reinforcement.h"
 
@@ -122,6 +130,196 @@ TEST_F(runtimeAppTest, TestStabilizationJIT) {
     spider::api::destroyGraph(graph);
 }
 
+TEST_F(runtimeAppTest, TestStabilizationPipelined) {
+    auto *graph = spider::stab::createStabilization();
+    spider::stab::createUserApplicationKernels();
+    auto config = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    };
+    config.pipelineIterations_ = true;
+    auto context = spider::createRuntimeContext(graph, config);
+    ASSERT_NO_THROW(spider::run(context));
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
+TEST_F(runtimeAppTest, TestStabilizationBufferPool) {
+    auto *graph = spider::stab::createStabilization();
+    spider::stab::createUserApplicationKernels();
+    auto *memoryInterface = spider::archi::platform()->cluster(0)->memoryInterface();
+    spider::api::enableMemoryInterfacePool(memoryInterface);
+    auto context = spider::createRuntimeContext(graph, spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    });
+    ASSERT_NO_THROW(spider::run(context));
+    /* == FIFO sizes repeat from one iteration to the other, buffers should be reused == */
+    const auto stats = memoryInterface->poolStats();
+    ASSERT_GT(stats.requestCount_, 0U);
+    ASSERT_GT(stats.hitCount_, 0U);
+    ASSERT_GT(stats.retainedSize_, 0U);
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+    spider::api::disableMemoryInterfacePool(memoryInterface);
+    ASSERT_EQ(memoryInterface->poolStats().retainedSize_, 0U);
+}
+
+TEST_F(runtimeAppTest, TestStabilizationBufferPoolReserved) {
+    auto *graph = spider::stab::createStabilization();
+    spider::stab::createUserApplicationKernels();
+    auto *memoryInterface = spider::archi::platform()->cluster(0)->memoryInterface();
+    /* == Pool misses are served from a pre-faulted region instead of the allocation routine == */
+    std::atomic<size_t> routineCount{ 0 };
+    spider::api::setMemoryInterfaceAllocateRoutine(memoryInterface, [&routineCount](uint_least64_t size) -> void * {
+        routineCount++;
+        return std::malloc(static_cast<size_t>(size));
+    });
+    spider::api::enableMemoryInterfacePool(memoryInterface, UINT64_MAX, 64 * 1024 * 1024, spider::MemoryBacking::MMAP);
+    auto context = spider::createRuntimeContext(graph, spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    });
+    ASSERT_NO_THROW(spider::run(context));
+    const auto stats = memoryInterface->poolStats();
+    ASSERT_GT(stats.hitCount_, 0U);
+    ASSERT_EQ(routineCount, 0U);
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+    spider::api::disableMemoryInterfacePool(memoryInterface);
+}
+
+TEST_F(runtimeAppTest, TestStabilizationBufferPoolNUMA) {
+    auto *graph = spider::stab::createStabilization();
+    spider::stab::createUserApplicationKernels();
+    auto *memoryInterface = spider::archi::platform()->cluster(0)->memoryInterface();
+    ASSERT_THROW(spider::api::setMemoryInterfaceNUMANode(memoryInterface,
+                                                         static_cast<int32_t>(spider::numa::nodeIndexBound())),
+                 spider::Exception);
+    /* == Region is first-touched by the runners of the cluster before being used == */
+    spider::api::setMemoryInterfaceNUMANode(memoryInterface, 0);
+    spider::api::enableMemoryInterfacePool(memoryInterface, UINT64_MAX, 64 * 1024 * 1024, spider::MemoryBacking::MMAP);
+    auto context = spider::createRuntimeContext(graph, spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    });
+    ASSERT_NO_THROW(spider::run(context));
+    ASSERT_GT(memoryInterface->poolStats().hitCount_, 0U);
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+    spider::api::disableMemoryInterfacePool(memoryInterface);
+    spider::api::setMemoryInterfaceNUMANode(memoryInterface, -1);
+}
+
+TEST_F(runtimeAppTest, TestMemoryInterfacePoolOrigin) {
+    auto *memoryInterface = spider::make<spider::MemoryInterface, StackID::ARCHI>(1024 * 1024);
+    std::vector<uint64_t> allocatedSizes;
+    size_t freeCount = 0;
+    memoryInterface->setAllocateRoutine([&allocatedSizes](uint64_t size) -> void * {
+        allocatedSizes.push_back(size);
+        return std::malloc(static_cast<size_t>(size));
+    });
+    memoryInterface->setDeallocateRoutine([&freeCount](void *buffer) {
+        freeCount++;
+        std::free(buffer);
+    });
+    /* == Buffer allocated at its exact size before the pool is enabled is not retained by the pool == */
+    ASSERT_NE(memoryInterface->allocate(0, 100, 1), nullptr);
+    ASSERT_EQ(allocatedSizes.back(), 100U);
+    memoryInterface->enablePool();
+    memoryInterface->deallocate(0, 100);
+    ASSERT_EQ(freeCount, 1U);
+    ASSERT_EQ(memoryInterface->poolStats().retainedSize_, 0U);
+    /* == Buffer allocated by the pool is allocated at the size of its class, then retained and reused == */
+    ASSERT_NE(memoryInterface->allocate(0, 100, 1), nullptr);
+    ASSERT_EQ(allocatedSizes.size(), 2U);
+    const auto classSize = allocatedSizes.back();
+    ASSERT_GT(classSize, 100U);
+    memoryInterface->deallocate(0, 100);
+    ASSERT_EQ(freeCount, 1U);
+    ASSERT_EQ(memoryInterface->poolStats().retainedSize_, classSize);
+    ASSERT_NE(memoryInterface->allocate(64, classSize, 1), nullptr);
+    ASSERT_EQ(allocatedSizes.size(), 2U);
+    ASSERT_EQ(memoryInterface->poolStats().hitCount_, 1U);
+    memoryInterface->deallocate(64, classSize);
+    memoryInterface->disablePool();
+    ASSERT_EQ(freeCount, 2U);
+    spider::destroy(memoryInterface);
+}
+
+TEST_F(runtimeAppTest, TestMemoryInterfacePoolRegion) {
+    auto *memoryInterface = spider::make<spider::MemoryInterface, StackID::ARCHI>(1024 * 1024);
+    size_t allocCount = 0;
+    size_t freeCount = 0;
+    memoryInterface->setAllocateRoutine([&allocCount](uint64_t size) -> void * {
+        allocCount++;
+        return std::malloc(static_cast<size_t>(size));
+    });
+    memoryInterface->setDeallocateRoutine([&freeCount](void *buffer) {
+        freeCount++;
+        std::free(buffer);
+    });
+    memoryInterface->enablePool(UINT64_MAX, 4096);
+    /* == Buffer is carved out of the region: the pool can not be disabled (nor replaced) while it is in use == */
+    ASSERT_NE(memoryInterface->allocate(0, 100, 1), nullptr);
+    ASSERT_EQ(allocCount, 0U);
+    ASSERT_THROW(memoryInterface->disablePool(), spider::Exception);
+    ASSERT_THROW(memoryInterface->enablePool(), spider::Exception);
+    memoryInterface->deallocate(0, 100);
+    /* == Reused from the free list, the buffer is still in the region == */
+    ASSERT_NE(memoryInterface->allocate(64, 100, 1), nullptr);
+    ASSERT_EQ(memoryInterface->poolStats().hitCount_, 1U);
+    ASSERT_THROW(memoryInterface->disablePool(), spider::Exception);
+    memoryInterface->deallocate(64, 100);
+    ASSERT_NO_THROW(memoryInterface->disablePool());
+    /* == Region pointers are never given to the deallocation routine == */
+    ASSERT_EQ(allocCount, 0U);
+    ASSERT_EQ(freeCount, 0U);
+    /* == Buffers forgotten by clear do not keep the region alive == */
+    memoryInterface->enablePool(UINT64_MAX, 4096);
+    ASSERT_NE(memoryInterface->allocate(0, 100, 1), nullptr);
+    memoryInterface->clear();
+    ASSERT_NO_THROW(memoryInterface->disablePool());
+    ASSERT_EQ(freeCount, 0U);
+    spider::destroy(memoryInterface);
+}
+
+TEST_F(runtimeAppTest, TestNUMATopology) {
+    const auto nodeIndexBound = spider::numa::nodeIndexBound();
+    ASSERT_GE(nodeIndexBound, 1U);
+    ASSERT_EQ(spider::numa::nodeOfCPU(-1), -1);
+    ASSERT_FALSE(spider::numa::bindThreadToNode(-1));
+    ASSERT_FALSE(spider::numa::bindThreadToNode(static_cast<i32>(nodeIndexBound)));
+    const auto node = spider::numa::nodeOfCPU(0);
+    ASSERT_LT(node, static_cast<i32>(nodeIndexBound));
+    if (node >= 0) {
+        spider::thread thread{ [node]() {
+            ASSERT_TRUE(spider::numa::bindThreadToNode(node));
+        }};
+        thread.join();
+    }
+}
+
 TEST_F(runtimeAppTest, TestStabilizationSRLess) {
     auto *graph = spider::stab::createStabilization();
     spider::stab::createUserApplicationKernels();
@@ -156,6 +354,23 @@ TEST_F(runtimeAppTest, TestStabilizationSRLessJIT) {
     spider::api::destroyGraph(graph);
 }
 
+TEST_F(runtimeAppTest, TestStabilizationSRLessHEFT) {
+    auto *graph = spider::stab::createStabilization();
+    spider::stab::createUserApplicationKernels();
+    auto context = spider::createRuntimeContext(graph, spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::HEFT,
+            spider::MappingPolicy::INSERTION,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    });
+    ASSERT_NO_THROW(spider::run(context));
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
 TEST_F(runtimeAppTest, TestStabilizationNoSync) {
     auto *graph = spider::stab::createStabilization();
     spider::stab::createUserApplicationKernels();
@@ -241,6 +456,80 @@ TEST_F(runtimeAppTest, TestReinforcementSRLessJIT) {
     spider::api::destroyGraph(graph);
 }
 
+TEST_F(runtimeAppTest, TestReinforcementSRLessHEFT) {
+    auto *graph = spider::rl::createReinforcementLearning();
+    spider::rl::createUserApplicationKernels();
+    auto context = spider::createRuntimeContext(graph, spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::HEFT,
+            spider::MappingPolicy::INSERTION,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    });
+    ASSERT_NO_THROW(spider::run(context));
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
+TEST_F(runtimeAppTest, TestReinforcementSRLessPipelined) {
+    auto *graph = spider::rl::createReinforcementLearning();
+    spider::rl::createUserApplicationKernels();
+    auto config = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    };
+    config.pipelineIterations_ = true;
+    auto context = spider::createRuntimeContext(graph, config);
+    ASSERT_NO_THROW(spider::run(context));
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
+TEST_F(runtimeAppTest, TestReinforcementSRLessScheduleCache) {
+    auto *graph = spider::rl::createReinforcementLearning();
+    spider::rl::createUserApplicationKernels();
+    auto config = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    };
+    config.scheduleCacheCapacity_ = 4;
+    auto context = spider::createRuntimeContext(graph, config);
+    ASSERT_NO_THROW(spider::run(context));
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
+TEST_F(runtimeAppTest, TestStabilizationSRLessScheduleCacheJIT) {
+    auto *graph = spider::stab::createStabilization();
+    spider::stab::createUserApplicationKernels();
+    auto config = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            LOOP_COUNT,
+    };
+    config.scheduleCacheCapacity_ = 4;
+    auto context = spider::createRuntimeContext(graph, config);
+    ASSERT_NO_THROW(spider::run(context));
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
 TEST_F(runtimeAppTest, TestReinforcementNoSync) {
     auto *graph = spider::rl::createReinforcementLearning();
     spider::rl::createUserApplicationKernels();
@@ -48,6 +48,20 @@
 #include <memory/dynamic-policies/GenericAllocatorPolicy.h>
 #include <memory/static-policies/LinearStaticAllocator.h>
 #include <api/spider.h>
+#include <runtime/platform/RTPlatform.h>
+#include <runtime/runner/RTRunner.h>
+#include <runtime/communicator/ThreadRTCommunicator.h>
+#include <archi/PE.h>
+#include <graphs/pisdf/Graph.h>
+#include <graphs-tools/transformation/pisdf/GraphHandler.h>
+#include <scheduling/ResourcesAllocator.h>
+#include <scheduling/memory/FifoAllocator.h>
+#include <scheduling/schedule/Schedule.h>
+#include <scheduling/task/Task.h>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
 #include "RuntimeTestCases.h"
 
 class runtimeMonoTestPiSDFBF : public ::testing::Test {
@@ -173,6 +187,19 @@ TEST_F(runtimeMonoTestPiSDFBF, TestStaticNoExecHierarchicalNoSync) {
     ASSERT_NO_THROW(spider::test::runtimeStaticHierarchicalNoExec(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestPiSDFBF, TestStaticMultiRate) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(spider::test::runtimeStaticMultiRate(runtimeConfig));
+}
+
 TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchical) {
     const auto runtimeConfig = spider::RuntimeConfig{
             spider::RunMode::LOOP,
@@ -186,6 +213,52 @@ TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchical) {
     ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchicalArena) {
+    spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::ARENA);
+    spider::api::setStackAllocatorPolicy(StackID::SCHEDULE, spider::AllocatorPolicy::ARENA);
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchicalPipelined) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.pipelineIterations_ = true;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchicalArenaPipelined) {
+    /* == Stacks are reset while the runners finish the iteration, before the next one is prepared == */
+    spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::ARENA);
+    spider::api::setStackAllocatorPolicy(StackID::SCHEDULE, spider::AllocatorPolicy::ARENA);
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.pipelineIterations_ = true;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
 TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchicalNoSync) {
     const auto runtimeConfig = spider::RuntimeConfig{
             spider::RunMode::LOOP,
@@ -199,6 +272,150 @@ TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchicalNoSync) {
     ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestPiSDFBF, TestDynamicCycling) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(spider::test::runtimeDynamicCycling(runtimeConfig));
+}
+
+class runtimeMonoTestPiSDFBFCache : public runtimeMonoTestPiSDFBF {
+protected:
+    void SetUp() override {
+        runtimeMonoTestPiSDFBF::SetUp();
+        /* == The cache is not used when the gantt is exported == */
+        spider::api::disableExportGantt();
+    }
+};
+
+TEST_F(runtimeMonoTestPiSDFBFCache, TestDynamicCyclingScheduleCache) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.scheduleCacheCapacity_ = 4;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicCycling(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBFCache, TestDynamicCyclingScheduleCacheEviction) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.scheduleCacheCapacity_ = 1;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicCycling(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBFCache, TestDynamicCyclingScheduleCachePipelined) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.scheduleCacheCapacity_ = 4;
+    runtimeConfig.pipelineIterations_ = true;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicCycling(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBFCache, TestDynamicCyclingScheduleCacheJIT) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::LIFETIME_AWARE,
+            10U,
+    };
+    runtimeConfig.scheduleCacheCapacity_ = 4;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicCycling(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBFCache, TestDynamicHierarchicalScheduleCache) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.scheduleCacheCapacity_ = 2;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestStaticHierarchicalLifetimeAware) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint> footprints;
+    ASSERT_NO_THROW(footprints = spider::test::compareFootprints(spider::test::runtimeStaticHierarchical, runtimeConfig,
+                                                                 [this]() { TearDown(); SetUp(); }));
+    ASSERT_LT(footprints.second.virtualSize_, footprints.first.virtualSize_);
+    ASSERT_LT(footprints.second.physicalSize_, footprints.first.physicalSize_);
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestStaticMultiRateLifetimeAware) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint> footprints;
+    ASSERT_NO_THROW(footprints = spider::test::compareFootprints(spider::test::runtimeStaticMultiRate, runtimeConfig,
+                                                                 [this]() { TearDown(); SetUp(); }));
+    ASSERT_LT(footprints.second.virtualSize_, footprints.first.virtualSize_);
+    ASSERT_LT(footprints.second.physicalSize_, footprints.first.physicalSize_);
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestDynamicHierarchicalLifetimeAware) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint> footprints;
+    ASSERT_NO_THROW(footprints = spider::test::compareFootprints(spider::test::runtimeDynamicHierarchical, runtimeConfig,
+                                                                 [this]() { TearDown(); SetUp(); }));
+    ASSERT_LT(footprints.second.virtualSize_, footprints.first.virtualSize_);
+    ASSERT_LT(footprints.second.physicalSize_, footprints.first.physicalSize_);
+}
+
 TEST_F(runtimeMonoTestPiSDFBF, TestGreedyStaticFlat) {
     const auto runtimeConfig = spider::RuntimeConfig{
             spider::RunMode::LOOP,
@@ -329,3 +546,208 @@ TEST_F(runtimeMonoTestPiSDFBF, TestGreedyDynamicHierarchicalNoSync) {
     ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestPiSDFBF, TestJobMessageRecycling) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            100U,
+    };
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+    const auto *communicator = static_cast<spider::ThreadRTCommunicator *>(spider::rt::platform()->communicator());
+    ASSERT_NE(communicator, nullptr);
+    const auto &pool = communicator->jobMessagePool();
+    /* == Every message has been recycled, only the initial slab was ever allocated == */
+    ASSERT_GT(pool.acquireCount(), pool.capacity());
+    ASSERT_EQ(pool.allocationCount(), 1U);
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestJobMessageSteadyStateAllocation) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::EXTERN_LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            1U,
+    };
+    /* == The graph is dynamic so that every iteration dispatches its jobs and sends its parameters == */
+    auto *graph = spider::test::dynamicHierarchicalGraph();
+    auto context = spider::createRuntimeContext(graph, runtimeConfig);
+    auto *stack = spider::stackArray()[static_cast<size_t>(StackID::RUNTIME)];
+    ASSERT_NO_THROW(spider::run(context));
+    const auto *communicator = static_cast<spider::ThreadRTCommunicator *>(spider::rt::platform()->communicator());
+    const auto &pool = communicator->jobMessagePool();
+    stack->flushCaches();
+    const auto allocationCount = stack->allocationCount();
+    for (size_t i = 0; i < 10; ++i) {
+        const auto acquireCount = pool.acquireCount();
+        ASSERT_NO_THROW(spider::run(context));
+        ASSERT_GT(pool.acquireCount(), acquireCount) << "no job dispatched during iteration " << i + 1;
+        /* == Once warm, dispatching the jobs of an iteration does not call the allocator of the RUNTIME stack == */
+        stack->flushCaches();
+        ASSERT_EQ(stack->allocationCount(), allocationCount) << "allocation during iteration " << i + 1;
+    }
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
+/* === Schedule order cache of the list scheduler === */
+
+/**
+ * @brief Get the names of the tasks of a schedule, in schedule order.
+ */
+static std::vector<std::string> scheduleOrder(const spider::sched::Schedule *schedule) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < schedule->size(); ++i) {
+        names.emplace_back(schedule->task(i)->name());
+    }
+    return names;
+}
+
+TEST_F(runtimeMonoTestPiSDFBF, TestListSchedulerCache) {
+    constexpr int64_t FORK_WIDTH = 8;
+    auto *graph = spider::api::createGraph("topgraph", 3, 2, 0);
+    auto *fork = spider::api::createVertex(graph, "fork", 0, 1);
+    auto *subgraph = spider::api::createSubgraph(graph, "subgraph", 2, 3, 0, 1, 1);
+    auto *join = spider::api::createVertex(graph, "join", 1, 0);
+    auto *a = spider::api::createVertex(subgraph, "a", 1, 1);
+    auto *b = spider::api::createVertex(subgraph, "b", 1, 1);
+    spider::api::createEdge(spider::api::getInputInterface(subgraph, 0), 0, 1, a, 0, 1);
+    spider::api::createEdge(a, 0, 1, b, 0, 1);
+    spider::api::createEdge(b, 0, 1, spider::api::getOutputInterface(subgraph, 0), 0, 1);
+    spider::api::createEdge(fork, 0, FORK_WIDTH, subgraph, 0, 1);
+    spider::api::createEdge(subgraph, 0, 1, join, 0, FORK_WIDTH);
+    {
+        spider::pisdf::GraphHandler handler{ graph, graph->params(), 1u };
+        /* == Reference order, computed without cache by a new scheduler every iteration == */
+        std::vector<std::string> reference;
+        {
+            spider::sched::ResourcesAllocator allocator{ spider::SchedulingPolicy::LIST,
+                                                         spider::MappingPolicy::BEST_FIT,
+                                                         spider::ExecutionPolicy::DELAYED,
+                                                         spider::FifoAllocatorType::DEFAULT, false };
+            ASSERT_NO_THROW(allocator.prepare(&handler));
+            reference = scheduleOrder(allocator.schedule());
+            allocator.clear();
+            handler.clear();
+        }
+        ASSERT_EQ(reference.size(), static_cast<size_t>(2 + 2 * FORK_WIDTH));
+        /* == Cached levels and order are reused from the second iteration == */
+        spider::sched::ResourcesAllocator allocator{ spider::SchedulingPolicy::LIST,
+                                                     spider::MappingPolicy::BEST_FIT,
+                                                     spider::ExecutionPolicy::DELAYED,
+                                                     spider::FifoAllocatorType::DEFAULT, false };
+        for (size_t i = 0; i < 4; ++i) {
+            ASSERT_NO_THROW(allocator.prepare(&handler));
+            ASSERT_EQ(scheduleOrder(allocator.schedule()), reference);
+            allocator.clear();
+            handler.clear();
+        }
+    }
+    spider::api::destroyGraph(graph);
+}
+
+/* === Wait policies of the runners (two cores sharing the job stamp table) === */
+
+constexpr size_t iterationCount = 10;
+
+class runtimeDualCoreTestPiSDFBF : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spider::start();
+        spider::api::createPlatform(1, 2);
+        auto *memoryInterface = spider::api::createMemoryInterface(1024 * 1024);
+        auto *cluster = spider::api::createCluster(2, memoryInterface);
+        core0_ = spider::api::createProcessingElement(0, 0, cluster, "Core0", spider::PEType::LRT);
+        core1_ = spider::api::createProcessingElement(0, 1, cluster, "Core1", spider::PEType::LRT);
+        spider::api::setSpiderGRTPE(core0_);
+    }
+
+    void TearDown() override {
+        spider::quit();
+    }
+
+    /**
+     * @brief Run a producer on the first core and a consumer on the second one, so that the runner of the second
+     *        core has to wait for the (slow) job of the first one at every iteration.
+     * @return wait statistics of the runner of the second core.
+     */
+    spider::RunnerWaitStats runWaitingConsumer(spider::RunnerWaitPolicy waitPolicy, size_t spinCount) {
+        auto runtimeConfig = spider::RuntimeConfig{
+                spider::RunMode::LOOP,
+                spider::RuntimeType::PISDF_BASED,
+                spider::ExecutionPolicy::DELAYED,
+                spider::SchedulingPolicy::LIST,
+                spider::MappingPolicy::BEST_FIT,
+                spider::FifoAllocatorType::DEFAULT,
+                iterationCount,
+        };
+        runtimeConfig.waitPolicy_ = waitPolicy;
+        runtimeConfig.spinCount_ = spinCount;
+        auto *graph = spider::api::createGraph("topgraph", 2, 1, 0);
+        auto *producer = spider::api::createVertex(graph, "producer", 0, 1);
+        auto *consumer = spider::api::createVertex(graph, "consumer", 1, 0);
+        spider::api::createEdge(producer, 0, 1, consumer, 0, 1);
+        spider::api::setVertexMappableOnAllPE(producer, false);
+        spider::api::setVertexMappableOnPE(producer, core0_);
+        spider::api::setVertexMappableOnAllPE(consumer, false);
+        spider::api::setVertexMappableOnPE(consumer, core1_);
+        spider::api::createThreadRTPlatform();
+        spider::api::createRuntimeKernel(producer, [](const int64_t *, int64_t *, void *[], void *output[]) -> void {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            reinterpret_cast<char *>(output[0])[0] = 42;
+        });
+        spider::api::createRuntimeKernel(consumer, [](const int64_t *, int64_t *, void *input[], void *[]) -> void {
+            if (reinterpret_cast<char *>(input[0])[0] != 42) {
+                throwSpiderException("consumer ran before its producer.");
+            }
+        });
+        auto context = spider::createRuntimeContext(graph, runtimeConfig);
+        spider::run(context);
+        spider::destroyRuntimeContext(context);
+        spider::api::destroyGraph(graph);
+        return spider::rt::platform()->runner(core1_->attachedLRT()->virtualIx())->waitStats();
+    }
+
+    spider::PE *core0_ = nullptr;
+    spider::PE *core1_ = nullptr;
+};
+
+TEST_F(runtimeDualCoreTestPiSDFBF, TestBlockingWaitPolicy) {
+    spider::RunnerWaitStats stats;
+    ASSERT_NO_THROW(stats = runWaitingConsumer(spider::RunnerWaitPolicy::BLOCKING, 0));
+    /* == Consumer parks right away and is woken up by the notification of the producer == */
+    ASSERT_GE(stats.parkCount_, iterationCount);
+    ASSERT_EQ(stats.spinTime_, 0U);
+    ASSERT_EQ(stats.spinWakeCount_ + stats.stampWakeCount_, 0U);
+}
+
+TEST_F(runtimeDualCoreTestPiSDFBF, TestSpinThenParkWaitPolicy) {
+    spider::RunnerWaitStats stats;
+    /* == Spin budget is way shorter than the producer, consumer parks after spinning == */
+    ASSERT_NO_THROW(stats = runWaitingConsumer(spider::RunnerWaitPolicy::SPIN_THEN_PARK, 16U));
+    ASSERT_GE(stats.parkCount_, iterationCount);
+    ASSERT_GT(stats.spinTime_, 0U);
+}
+
+TEST_F(runtimeDualCoreTestPiSDFBF, TestSpinThenParkWaitPolicyLargeBudget) {
+    spider::RunnerWaitStats stats;
+    /* == Spin budget is way longer than the producer, consumer never parks == */
+    ASSERT_NO_THROW(stats = runWaitingConsumer(spider::RunnerWaitPolicy::SPIN_THEN_PARK, SIZE_MAX));
+    ASSERT_EQ(stats.parkCount_, 0U);
+    ASSERT_GE(stats.spinWakeCount_ + stats.stampWakeCount_, iterationCount);
+}
+
+TEST_F(runtimeDualCoreTestPiSDFBF, TestBusyPollWaitPolicy) {
+    spider::RunnerWaitStats stats;
+    ASSERT_NO_THROW(stats = runWaitingConsumer(spider::RunnerWaitPolicy::BUSY_POLL, 0));
+    /* == A busy polling runner never parks, it sees the job stamp of the producer in the table == */
+    ASSERT_EQ(stats.parkCount_, 0U);
+    ASSERT_EQ(stats.parkTime_, 0U);
+    ASSERT_GE(stats.stampWakeCount_, iterationCount);
+}
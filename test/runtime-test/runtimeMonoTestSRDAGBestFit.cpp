@@ -173,6 +173,19 @@ TEST_F(runtimeMonoTestSRDAGBF, TestStaticNoExecHierarchicalNoSync) {
     ASSERT_NO_THROW(spider::test::runtimeStaticHierarchicalNoExec(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestSRDAGBF, TestStaticMultiRate) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(spider::test::runtimeStaticMultiRate(runtimeConfig));
+}
+
 TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchical) {
     const auto runtimeConfig = spider::RuntimeConfig{
             spider::RunMode::LOOP,
@@ -186,6 +199,52 @@ TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchical) {
     ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchicalArena) {
+    spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::ARENA);
+    spider::api::setStackAllocatorPolicy(StackID::SCHEDULE, spider::AllocatorPolicy::ARENA);
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchicalPipelined) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.pipelineIterations_ = true;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
+TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchicalArenaPipelined) {
+    /* == Stacks are reset while the runners finish the iteration, before the next one is prepared == */
+    spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::ARENA);
+    spider::api::setStackAllocatorPolicy(StackID::SCHEDULE, spider::AllocatorPolicy::ARENA);
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    runtimeConfig.pipelineIterations_ = true;
+    ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
+}
+
 TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchicalNoSync) {
     const auto runtimeConfig = spider::RuntimeConfig{
             spider::RunMode::LOOP,
@@ -199,6 +258,57 @@ TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchicalNoSync) {
     ASSERT_NO_THROW(spider::test::runtimeDynamicHierarchical(runtimeConfig));
 }
 
+TEST_F(runtimeMonoTestSRDAGBF, TestStaticHierarchicalLifetimeAware) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint> footprints;
+    ASSERT_NO_THROW(footprints = spider::test::compareFootprints(spider::test::runtimeStaticHierarchical, runtimeConfig,
+                                                                 [this]() { TearDown(); SetUp(); }));
+    ASSERT_LT(footprints.second.virtualSize_, footprints.first.virtualSize_);
+    ASSERT_LT(footprints.second.physicalSize_, footprints.first.physicalSize_);
+}
+
+TEST_F(runtimeMonoTestSRDAGBF, TestStaticMultiRateLifetimeAware) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint> footprints;
+    ASSERT_NO_THROW(footprints = spider::test::compareFootprints(spider::test::runtimeStaticMultiRate, runtimeConfig,
+                                                                 [this]() { TearDown(); SetUp(); }));
+    ASSERT_LT(footprints.second.virtualSize_, footprints.first.virtualSize_);
+    ASSERT_LT(footprints.second.physicalSize_, footprints.first.physicalSize_);
+}
+
+TEST_F(runtimeMonoTestSRDAGBF, TestDynamicHierarchicalLifetimeAware) {
+    const auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    std::pair<spider::test::MemoryFootprint, spider::test::MemoryFootprint> footprints;
+    ASSERT_NO_THROW(footprints = spider::test::compareFootprints(spider::test::runtimeDynamicHierarchical, runtimeConfig,
+                                                                 [this]() { TearDown(); SetUp(); }));
+    ASSERT_LT(footprints.second.virtualSize_, footprints.first.virtualSize_);
+    ASSERT_LT(footprints.second.physicalSize_, footprints.first.physicalSize_);
+}
+
 TEST_F(runtimeMonoTestSRDAGBF, TestGreedyStaticFlat) {
     const auto runtimeConfig = spider::RuntimeConfig{
             spider::RunMode::LOOP,
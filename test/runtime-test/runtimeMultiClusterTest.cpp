@@ -0,0 +1,478 @@
+/*
+ * Copyright or © or Copr. IETR/INSA - Rennes (2013 - 2019) :
+ *
+ * Antoine Morvan <antoine.morvan@insa-rennes.fr> (2018)
+ * Clément Guy <clement.guy@insa-rennes.fr> (2014)
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2017-2019)
+ * Hugo Miomandre <hugo.miomandre@insa-rennes.fr> (2017)
+ * Julien Heulot <julien.heulot@insa-rennes.fr> (2013 - 2015)
+ * Yaset Oliva <yaset.oliva@insa-rennes.fr> (2013 - 2014)
+ *
+ * Spider is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* === Include(s) === */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <api/spider.h>
+#include <common/Logger.h>
+#include <memory/memory.h>
+#include <archi/Platform.h>
+#include <archi/Cluster.h>
+#include <archi/PE.h>
+#include <graphs/pisdf/Graph.h>
+#include <graphs-tools/transformation/pisdf/GraphHandler.h>
+#include <scheduling/ResourcesAllocator.h>
+#include <scheduling/memory/FifoAllocator.h>
+#include <scheduling/schedule/PEAvailability.h>
+#include <scheduling/schedule/Schedule.h>
+#include <scheduling/task/Task.h>
+
+#ifndef _SPIDER_SINGLE_CLUSTER
+
+static std::atomic<int> multiClusterErrorCount{ 0 };
+
+class runtimeMultiClusterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spider::start();
+        /* == Create a platform with two single core clusters == */
+        spider::api::createPlatform(2, 2);
+        auto *memoryInterface0 = spider::api::createMemoryInterface(1024 * 1024);
+        auto *memoryInterface1 = spider::api::createMemoryInterface(1024 * 1024);
+        auto *cluster0 = spider::api::createCluster(1, memoryInterface0);
+        auto *cluster1 = spider::api::createCluster(1, memoryInterface1);
+        auto core0 = spider::api::createProcessingElement(0, 0, cluster0, "Core0", spider::PEType::LRT);
+        spider::api::createProcessingElement(0, 1, cluster1, "Core1", spider::PEType::LRT);
+        spider::api::setSpiderGRTPE(core0);
+        const auto copy = [](int_least64_t size, void *src, void *dst) {
+            if (src != dst) {
+                std::memcpy(dst, src, static_cast<size_t>(size));
+            }
+        };
+        auto *bus0To1 = spider::api::createMemoryBus(copy, copy);
+        auto *bus1To0 = spider::api::createMemoryBus(copy, copy);
+        spider::api::createInterClusterMemoryBus(cluster0, cluster1, bus0To1, bus1To0);
+        multiClusterErrorCount = 0;
+    }
+
+    void TearDown() override {
+        spider::quit();
+    }
+};
+
+/* === Static function(s) === */
+
+static void runtimeForkJoin(spider::RuntimeConfig cfg) {
+    auto *graph = spider::api::createGraph("topgraph", 3, 2, 0);
+    auto *vertex_0 = spider::api::createVertex(graph, "vertex_0", 0, 1);
+    auto *vertex_1 = spider::api::createVertex(graph, "vertex_1", 1, 1);
+    auto *vertex_2 = spider::api::createVertex(graph, "vertex_2", 1, 0);
+    spider::api::createEdge(vertex_0, 0, 8, vertex_1, 0, 1);
+    spider::api::createEdge(vertex_1, 0, 1, vertex_2, 0, 8);
+
+    spider::api::createThreadRTPlatform();
+    spider::api::createRuntimeKernel(vertex_0, [](const int64_t *, int64_t *, void *[], void *output[]) -> void {
+        auto *buffer = reinterpret_cast<char *>(output[0]);
+        for (int i = 0; i < 8; ++i) {
+            buffer[i] = static_cast<char>(i);
+        }
+    });
+    spider::api::createRuntimeKernel(vertex_1, [](const int64_t *, int64_t *, void *input[], void *output[]) -> void {
+        const auto *in = reinterpret_cast<char *>(input[0]);
+        auto *out = reinterpret_cast<char *>(output[0]);
+        out[0] = static_cast<char>(in[0] * 2);
+    });
+    spider::api::createRuntimeKernel(vertex_2, [](const int64_t *, int64_t *, void *input[], void *[]) -> void {
+        const auto *buffer = reinterpret_cast<char *>(input[0]);
+        for (int i = 0; i < 8; ++i) {
+            if (buffer[i] != 2 * i) {
+                multiClusterErrorCount++;
+            }
+        }
+    });
+
+    auto context = spider::createRuntimeContext(graph, cfg);
+    spider::run(context);
+    spider::destroyRuntimeContext(context);
+    spider::api::destroyGraph(graph);
+}
+
+/* === Test(s) === */
+
+TEST_F(runtimeMultiClusterTest, TestPiSDFArchiAware) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestPiSDFArchiAwareJIT) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestSRDAGArchiAware) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestSRDAGArchiAwareJIT) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestPiSDFLookahead) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::LOOKAHEAD,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestPiSDFLookaheadJIT) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::LOOKAHEAD,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestSRDAGLookahead) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::LOOKAHEAD,
+            spider::FifoAllocatorType::ARCHI_AWARE,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestPiSDFDefault) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestPiSDFDefaultJIT) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::PISDF_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestSRDAGDefault) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::DELAYED,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+TEST_F(runtimeMultiClusterTest, TestSRDAGDefaultJIT) {
+    auto runtimeConfig = spider::RuntimeConfig{
+            spider::RunMode::LOOP,
+            spider::RuntimeType::SRDAG_BASED,
+            spider::ExecutionPolicy::JIT,
+            spider::SchedulingPolicy::LIST,
+            spider::MappingPolicy::BEST_FIT,
+            spider::FifoAllocatorType::DEFAULT,
+            10U,
+    };
+    ASSERT_NO_THROW(runtimeForkJoin(runtimeConfig));
+    ASSERT_EQ(multiClusterErrorCount, 0);
+}
+
+/* === Availability index of the best fit mapper === */
+
+class runtimeMultiClusterMappingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spider::start();
+    }
+
+    void TearDown() override {
+        spider::quit();
+    }
+};
+
+TEST_F(runtimeMultiClusterMappingTest, TestAvailabilityIndex) {
+    /* == 2 clusters of 8 PEs: 2 hardware types per cluster, the GRT being alone in its bucket == */
+    spider::api::createPlatform(2, 16);
+    for (uint32_t i = 0; i < 2; ++i) {
+        auto *cluster = spider::api::createCluster(8, spider::api::createMemoryInterface(1024));
+        for (uint32_t j = 0; j < 8; ++j) {
+            const auto ix = 8 * i + j;
+            auto *pe = spider::api::createProcessingElement(j % 2, ix, cluster, "Core" + std::to_string(ix),
+                                                            spider::PEType::LRT);
+            if (!ix) {
+                spider::api::setSpiderGRTPE(pe);
+            }
+        }
+    }
+    const auto *platform = spider::archi::platform();
+    spider::PEAvailability availability;
+    ASSERT_EQ(availability.clusterBuckets(0).second - availability.clusterBuckets(0).first, 3U);
+    ASSERT_EQ(availability.clusterBuckets(1).second - availability.clusterBuckets(1).first, 2U);
+    std::vector<uint64_t> endTimes(16, 0);
+    uint64_t seed = 42;
+    const auto random = [&seed](uint64_t max) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 33) % max;
+    };
+    for (size_t k = 0; k < 1000; ++k) {
+        const auto peIx = random(16);
+        const auto time = random(20);
+        availability.update(peIx, endTimes[peIx], time);
+        endTimes[peIx] = time;
+        const auto minStartTime = random(20);
+        const auto mask = random(1 << 16);
+        const auto filter = [mask](const spider::PE *pe) { return (mask >> pe->virtualIx()) & 1; };
+        for (size_t clusterIx = 0; clusterIx < 2; ++clusterIx) {
+            const auto buckets = availability.clusterBuckets(clusterIx);
+            for (auto bucketIx = buckets.first; bucketIx < buckets.second; ++bucketIx) {
+                const auto *pe = availability.bestFit(bucketIx, minStartTime, filter);
+                /* == Brute force: least idle time then earliest available time then lowest index == */
+                const spider::PE *expected = nullptr;
+                const auto *reference = pe ? pe : platform->cluster(clusterIx)->peArray()[0];
+                for (const auto *candidate : platform->cluster(clusterIx)->peArray()) {
+                    const auto sameBucket = (candidate->hardwareType() == reference->hardwareType()) &&
+                                            ((candidate == platform->spiderGRTPE()) ==
+                                             (reference == platform->spiderGRTPE()));
+                    if (!sameBucket || !filter(candidate)) {
+                        continue;
+                    }
+                    if (!expected) {
+                        expected = candidate;
+                        continue;
+                    }
+                    const auto ready = endTimes[candidate->virtualIx()];
+                    const auto bestReady = endTimes[expected->virtualIx()];
+                    const auto end = std::max<uint64_t>(ready, minStartTime);
+                    const auto bestEnd = std::max<uint64_t>(bestReady, minStartTime);
+                    if ((end < bestEnd) || ((end == bestEnd) && (ready > bestReady))) {
+                        expected = candidate;
+                    }
+                }
+                if (pe) {
+                    ASSERT_EQ(pe, expected) << "iteration " << k << ", bucket " << bucketIx;
+                }
+            }
+        }
+    }
+}
+
+/* === Inter cluster communications of the lookahead mapper === */
+
+/**
+ * @brief Schedule and map one iteration of a graph and count the SEND tasks inserted between clusters.
+ * @return number of inter cluster communications.
+ */
+static size_t countInterClusterSends(const spider::pisdf::Graph *graph,
+                                     spider::MappingPolicy mappingPolicy,
+                                     spider::FifoAllocatorType allocatorType = spider::FifoAllocatorType::DEFAULT) {
+    spider::sched::ResourcesAllocator allocator{ spider::SchedulingPolicy::LIST, mappingPolicy,
+                                                 spider::ExecutionPolicy::DELAYED, allocatorType, false };
+    spider::pisdf::GraphHandler handler{ graph, graph->params(), 1u };
+    const auto *stack = spider::stackArray()[static_cast<size_t>(StackID::SCHEDULE)];
+    const auto liveCount = stack->liveCount();
+    allocator.prepare(&handler);
+    const auto *schedule = allocator.schedule();
+    size_t count = 0;
+    for (size_t i = 0; i < schedule->size(); ++i) {
+        count += schedule->task(i)->name() == "send";
+    }
+    allocator.clear();
+    EXPECT_EQ(stack->liveCount(), liveCount) << "synchronization tasks should be destroyed with the schedule.";
+    handler.clear();
+    return count;
+}
+
+TEST_F(runtimeMultiClusterMappingTest, TestLookaheadMapping) {
+    /* == 2 clusters of 2 PEs of the same hardware type, sending and receiving cost 100 per byte == */
+    spider::api::createPlatform(2, 4);
+    spider::Cluster *clusters[2];
+    for (uint32_t i = 0; i < 2; ++i) {
+        clusters[i] = spider::api::createCluster(2, spider::api::createMemoryInterface(1024 * 1024));
+        for (uint32_t j = 0; j < 2; ++j) {
+            const auto ix = 2 * i + j;
+            auto *pe = spider::api::createProcessingElement(0, ix, clusters[i], "Core" + std::to_string(ix),
+                                                            spider::PEType::LRT);
+            if (!ix) {
+                spider::api::setSpiderGRTPE(pe);
+            }
+        }
+    }
+    const auto copy = [](int_least64_t size, void *src, void *dst) {
+        std::memcpy(dst, src, static_cast<size_t>(size));
+    };
+    const auto cost = [](uint64_t size) { return size * 100; };
+    auto *bus0To1 = spider::api::createMemoryBus(copy, copy);
+    auto *bus1To0 = spider::api::createMemoryBus(copy, copy);
+    for (auto *bus : { bus0To1, bus1To0 }) {
+        spider::api::setMemoryBusSendCostRoutine(bus, cost);
+        spider::api::setMemoryBusReceiveCostRoutine(bus, cost);
+    }
+    spider::api::createInterClusterMemoryBus(clusters[0], clusters[1], bus0To1, bus1To0);
+    /* == Every x broadcasts its data to 3 y which also read a large buffer produced on the second cluster == */
+    auto *graph = spider::api::createGraph("topgraph", 4, 3, 0);
+    auto *p = spider::api::createVertex(graph, "p", 0, 1);
+    auto *x = spider::api::createVertex(graph, "x", 1, 1);
+    auto *q = spider::api::createVertex(graph, "q", 0, 1);
+    auto *y = spider::api::createVertex(graph, "y", 2, 0);
+    spider::api::createEdge(p, 0, 8, x, 0, 1);
+    spider::api::createEdge(x, 0, 3, y, 0, 1);
+    spider::api::createEdge(q, 0, 24 * 64, y, 1, 64);
+    spider::api::setVertexMappableOnCluster(p, 1u, false);
+    spider::api::setVertexMappableOnCluster(q, 0u, false);
+    size_t bestFitCount = 0;
+    size_t lookaheadCount = 0;
+    ASSERT_NO_THROW(bestFitCount = countInterClusterSends(graph, spider::MappingPolicy::BEST_FIT));
+    ASSERT_NO_THROW(lookaheadCount = countInterClusterSends(graph, spider::MappingPolicy::LOOKAHEAD));
+    ASSERT_LT(lookaheadCount, bestFitCount);
+    spider::api::destroyGraph(graph);
+}
+
+TEST_F(runtimeMultiClusterMappingTest, TestArchiAwareSyncTasks) {
+    /* == 2 single core clusters == */
+    spider::api::createPlatform(2, 2);
+    spider::Cluster *clusters[2];
+    for (uint32_t i = 0; i < 2; ++i) {
+        clusters[i] = spider::api::createCluster(1, spider::api::createMemoryInterface(1024 * 1024));
+        auto *pe = spider::api::createProcessingElement(0, i, clusters[i], "Core" + std::to_string(i),
+                                                        spider::PEType::LRT);
+        if (!i) {
+            spider::api::setSpiderGRTPE(pe);
+        }
+    }
+    const auto copy = [](int_least64_t size, void *src, void *dst) {
+        std::memcpy(dst, src, static_cast<size_t>(size));
+    };
+    auto *bus0To1 = spider::api::createMemoryBus(copy, copy);
+    auto *bus1To0 = spider::api::createMemoryBus(copy, copy);
+    spider::api::createInterClusterMemoryBus(clusters[0], clusters[1], bus0To1, bus1To0);
+    /* == Every y reads a part of the buffer of x (second cluster) and its whole buffer is read by z (first one) == */
+    auto *graph = spider::api::createGraph("topgraph", 3, 2, 0);
+    auto *x = spider::api::createVertex(graph, "x", 0, 1);
+    auto *y = spider::api::createVertex(graph, "y", 1, 1);
+    auto *z = spider::api::createVertex(graph, "z", 1, 0);
+    spider::api::createEdge(x, 0, 4, y, 0, 1);
+    spider::api::createEdge(y, 0, 1, z, 0, 1);
+    spider::api::setVertexMappableOnCluster(x, 1u, false);
+    spider::api::setVertexMappableOnCluster(y, 0u, false);
+    spider::api::setVertexMappableOnCluster(z, 1u, false);
+    size_t defaultCount = 0;
+    size_t archiAwareCount = 0;
+    ASSERT_NO_THROW(defaultCount = countInterClusterSends(graph, spider::MappingPolicy::BEST_FIT));
+    ASSERT_NO_THROW(archiAwareCount = countInterClusterSends(graph, spider::MappingPolicy::BEST_FIT,
+                                                             spider::FifoAllocatorType::ARCHI_AWARE));
+    ASSERT_EQ(defaultCount, 8U);
+    /* == Buffers of y are placed with z, the parts of the buffer of x are still copied == */
+    ASSERT_EQ(archiAwareCount, 4U);
+    spider::api::destroyGraph(graph);
+}
+
+#endif
@@ -0,0 +1,629 @@
+/*
+ * Copyright or © or Copr. IETR/INSA - Rennes (2013 - 2019) :
+ *
+ * Antoine Morvan <antoine.morvan@insa-rennes.fr> (2018)
+ * Clément Guy <clement.guy@insa-rennes.fr> (2014)
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2017-2019)
+ * Hugo Miomandre <hugo.miomandre@insa-rennes.fr> (2017)
+ * Julien Heulot <julien.heulot@insa-rennes.fr> (2013 - 2015)
+ * Yaset Oliva <yaset.oliva@insa-rennes.fr> (2013 - 2014)
+ *
+ * Spider is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* === Include(s) === */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <api/spider.h>
+#include <graphs/pisdf/Graph.h>
+#include <graphs-tools/transformation/pisdf/GraphHandler.h>
+#include <scheduling/ResourcesAllocator.h>
+#include <scheduling/mapper/BestFitMapper.h>
+#include <scheduling/memory/FifoAllocator.h>
+#include <scheduling/schedule/Schedule.h>
+#include <scheduling/schedule/exporter/SchedStatsExporter.h>
+#include <scheduling/task/SyncTask.h>
+#include <scheduling/task/Task.h>
+#include <scheduling/task/PiSDFTask.h>
+#include <graphs/pisdf/Vertex.h>
+#include <archi/Platform.h>
+#include <archi/PE.h>
+#include <string>
+#include <vector>
+#include "appTest/stabilization/spider2-stabilization.h"
+#include "appTest/reinforcement/spider2-reinforcement.h"
+
+class runtimeSchedulingBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spider::start();
+    }
+
+    void TearDown() override {
+        spider::quit();
+    }
+};
+
+/* === Static function(s) === */
+
+/**
+ * @brief Create a platform with clusterCount clusters of peCount processing elements each.
+ * @remark Every PE has its own hardware type unless sharedHardwareType is set.
+ */
+static void createBenchmarkPlatform(size_t clusterCount, size_t peCount, bool sharedHardwareType = false) {
+    spider::api::createPlatform(clusterCount, clusterCount * peCount);
+    spider::vector<spider::Cluster *> clusters;
+    for (size_t i = 0; i < clusterCount; ++i) {
+        auto *memoryInterface = spider::api::createMemoryInterface(1024 * 1024);
+        clusters.emplace_back(spider::api::createCluster(peCount, memoryInterface));
+        for (size_t j = 0; j < peCount; ++j) {
+            const auto ix = static_cast<uint32_t>(i * peCount + j);
+            auto *pe = spider::api::createProcessingElement(sharedHardwareType ? 0 : ix, ix, clusters.back(),
+                                                            "Core" + std::to_string(ix), spider::PEType::LRT);
+            if (!ix) {
+                spider::api::setSpiderGRTPE(pe);
+            }
+        }
+    }
+    const auto copy = [](int_least64_t size, void *src, void *dst) {
+        std::memcpy(dst, src, static_cast<size_t>(size));
+    };
+    for (size_t i = 0; i < clusterCount; ++i) {
+        for (size_t j = i + 1; j < clusterCount; ++j) {
+            auto *busIToJ = spider::api::createMemoryBus(copy, copy);
+            auto *busJToI = spider::api::createMemoryBus(copy, copy);
+            spider::api::createInterClusterMemoryBus(clusters[i], clusters[j], busIToJ, busJToI);
+        }
+    }
+}
+
+/**
+ * @brief Create a fork / join graph: a fork feeding width chains of two stages joined by a single vertex.
+ * @return pointer to the graph.
+ */
+static spider::pisdf::Graph *createForkJoinGraph(int64_t width) {
+    auto *graph = spider::api::createGraph("topgraph", 4, 3, 0);
+    auto *fork = spider::api::createVertex(graph, "fork", 0, 1);
+    auto *stage0 = spider::api::createVertex(graph, "stage0", 1, 1);
+    auto *stage1 = spider::api::createVertex(graph, "stage1", 1, 1);
+    auto *join = spider::api::createVertex(graph, "join", 1, 0);
+    spider::api::createEdge(fork, 0, width, stage0, 0, 1);
+    spider::api::createEdge(stage0, 0, 1, stage1, 0, 1);
+    spider::api::createEdge(stage1, 0, 1, join, 0, width);
+    return graph;
+}
+
+/**
+ * @brief Measure the average scheduling and mapping time per task of a fork / join graph.
+ * @return average time per task in nanoseconds.
+ */
+static double benchmarkScheduling(spider::SchedulingPolicy schedulingPolicy, spider::MappingPolicy mappingPolicy) {
+    constexpr size_t ITERATION_COUNT = 10;
+    auto *graph = createForkJoinGraph(512);
+    double elapsed = 0.;
+    size_t taskCount = 0;
+    {
+        spider::sched::ResourcesAllocator allocator{ schedulingPolicy, mappingPolicy,
+                                                     spider::ExecutionPolicy::DELAYED,
+                                                     spider::FifoAllocatorType::DEFAULT, false };
+        spider::pisdf::GraphHandler handler{ graph, graph->params(), 1u };
+        for (size_t i = 0; i < ITERATION_COUNT; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            allocator.prepare(&handler);
+            const auto end = std::chrono::steady_clock::now();
+            elapsed += std::chrono::duration<double, std::nano>(end - start).count();
+            taskCount += allocator.schedule()->size();
+            allocator.clear();
+            handler.clear();
+        }
+    }
+    spider::api::destroyGraph(graph);
+    return elapsed / static_cast<double>(taskCount);
+}
+
+/**
+ * @brief Schedule and map one iteration of a graph and count the synchronization tasks inserted in the schedule.
+ * @remark Also checks that every other task got mapped.
+ * @return number of SEND / RECEIVE tasks of the schedule.
+ */
+static size_t countSyncTasks(const spider::pisdf::Graph *graph, spider::MappingPolicy mappingPolicy) {
+    spider::sched::ResourcesAllocator allocator{ spider::SchedulingPolicy::LIST, mappingPolicy,
+                                                 spider::ExecutionPolicy::DELAYED,
+                                                 spider::FifoAllocatorType::DEFAULT, false };
+    spider::pisdf::GraphHandler handler{ graph, graph->params(), 1u };
+    allocator.prepare(&handler);
+    const auto *schedule = allocator.schedule();
+    size_t count = 0;
+    for (size_t i = 0; i < schedule->size(); ++i) {
+        const auto *task = schedule->task(i);
+        const auto name = task->name();
+        if (name == "send" || name == "receive") {
+            count++;
+        } else {
+            EXPECT_NE(task->mappedPe(), nullptr) << "task [" << name << "] should be mapped.";
+        }
+    }
+    allocator.clear();
+    handler.clear();
+    return count;
+}
+
+/**
+ * @brief Task counting the accesses of the schedule and of its exporters to the tasks.
+ * @remark An access is either setting the task on its firing (done on every lookup) or rewriting its index.
+ */
+class CountingTask : public spider::sched::Task {
+public:
+    static size_t accessCount_;
+
+    void visit(spider::sched::TaskLauncher *) final { }
+
+    void setOnFiring(u32) final { accessCount_++; }
+
+    bool receiveParams(const spider::vector<i64> &) final { return true; }
+
+    i64 inputRate(size_t) const final { return 0; }
+
+    Task *previousTask(size_t, const spider::sched::Schedule *) const final { return nullptr; }
+
+    Task *nextTask(size_t, const spider::sched::Schedule *) const final { return nullptr; }
+
+    u32 color() const final { return 0; }
+
+    std::string name() const final { return "counting"; }
+
+    bool isMappableOnPE(const spider::PE *) const override { return true; }
+
+    u64 timingOnPE(const spider::PE *) const override { return 1; }
+
+    size_t dependencyCount() const final { return 0; }
+
+    size_t successorCount() const final { return 0; }
+
+    u64 startTime() const final { return startTime_; }
+
+    u64 endTime() const final { return endTime_; }
+
+    const spider::PE *mappedPe() const final { return pe_; }
+
+    const spider::PE *mappedLRT() const final { return pe_; }
+
+    spider::sched::TaskState state() const noexcept final { return state_; }
+
+    u32 ix() const noexcept final { return ix_; }
+
+    u32 jobExecIx() const noexcept final { return jobExecIx_; }
+
+    u32 syncExecIxOnLRT(size_t) const final { return UINT32_MAX; }
+
+    void setStartTime(u64 time) final { startTime_ = time; }
+
+    void setEndTime(u64 time) final { endTime_ = time; }
+
+    void setMappedPE(const spider::PE *pe) final { pe_ = pe; }
+
+    void setState(spider::sched::TaskState state) noexcept final { state_ = state; }
+
+    void setJobExecIx(u32 ix) noexcept final { jobExecIx_ = ix; }
+
+    void setIx(u32 ix) noexcept final {
+        ix_ = ix;
+        accessCount_++;
+    }
+
+    void setSyncExecIxOnLRT(size_t, u32) final { }
+
+private:
+    u64 startTime_ = UINT64_MAX;
+    u64 endTime_ = UINT64_MAX;
+    const spider::PE *pe_ = nullptr;
+    u32 ix_ = UINT32_MAX;
+    u32 jobExecIx_ = UINT32_MAX;
+    spider::sched::TaskState state_ = spider::sched::TaskState::NOT_SCHEDULABLE;
+};
+
+size_t CountingTask::accessCount_ = 0;
+
+/**
+ * @brief Task only mappable on the PEs of a mask, its timing grows with the hardware type of the PE.
+ */
+class MaskedTask final : public CountingTask {
+public:
+    MaskedTask(uint64_t mask, u64 timing) : mask_{ mask }, timing_{ timing } { }
+
+    bool isMappableOnPE(const spider::PE *pe) const final { return (mask_ >> pe->virtualIx()) & 1; }
+
+    u64 timingOnPE(const spider::PE *pe) const final { return timing_ * (pe->hardwareType() + 1); }
+
+private:
+    uint64_t mask_;
+    u64 timing_;
+};
+
+/**
+ * @brief Insert synchronization tasks while walking a schedule, as done by the mappers, then export the statistics of
+ *        the schedule.
+ * @remark A send / receive pair is inserted before every fourth task.
+ * @param taskCount Number of tasks of the schedule before the insertions.
+ * @param makeTask  Function creating a task of a given synchronization type.
+ * @return average time per task of the walk and of the export in nanoseconds.
+ */
+template<class MakeTask>
+static double walkSchedule(size_t taskCount, MakeTask &&makeTask) {
+    auto tasks = std::vector<spider::sched::Task *>{ };
+    tasks.reserve(taskCount + taskCount / 2);
+    const auto make = [&tasks, &makeTask](spider::sched::SyncType type) {
+        tasks.push_back(makeTask(type));
+        return tasks.back();
+    };
+    double elapsed = 0.;
+    {
+        spider::sched::Schedule schedule;
+        for (size_t i = 0; i < taskCount; ++i) {
+            schedule.addTask(make(spider::sched::SyncType::SEND));
+        }
+        const auto *platform = spider::archi::platform();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < schedule.size(); ++i) {
+            auto *task = schedule.walk(i);
+            if (!(i % 4)) {
+                auto *sndTask = make(spider::sched::SyncType::SEND);
+                auto *rcvTask = make(spider::sched::SyncType::RECEIVE);
+                schedule.insertTasks(task->ix(), { { sndTask, 0 }, { rcvTask, 0 }});
+                for (auto *syncTask : { sndTask, rcvTask }) {
+                    const auto *pe = platform->peFromVirtualIx(syncTask->ix() % platform->PECount());
+                    const auto time = schedule.endTime(pe->virtualIx());
+                    schedule.updateTaskAndSetReady(syncTask, pe, time, time + 1);
+                }
+                i += 2;
+            }
+            const auto *pe = platform->peFromVirtualIx(task->ix() % platform->PECount());
+            const auto time = schedule.endTime(pe->virtualIx());
+            schedule.updateTaskAndSetReady(task, pe, time, time + 1);
+        }
+        schedule.updateIndexes();
+        auto *file = std::fopen("/dev/null", "w");
+        spider::SchedStatsExporter{ &schedule }.printFromFile(file);
+        std::fclose(file);
+        const auto end = std::chrono::steady_clock::now();
+        elapsed = std::chrono::duration<double, std::nano>(end - start).count();
+        size_t outdatedCount = 0;
+        for (size_t i = 0; i < schedule.size(); ++i) {
+            outdatedCount += schedule.task(i)->ix() != i;
+        }
+        EXPECT_EQ(outdatedCount, 0U) << "every task should have an up to date index.";
+        EXPECT_EQ(schedule.size(), tasks.size());
+    }
+    for (auto *task : tasks) {
+        spider::destroy(task);
+    }
+    return elapsed / static_cast<double>(tasks.size());
+}
+
+/**
+ * @brief Measure the average time per task to insert synchronization tasks while walking a schedule and to export the
+ *        statistics of the schedule.
+ * @return average time per task in nanoseconds.
+ */
+static double benchmarkScheduleScaling(size_t taskCount) {
+    return walkSchedule(taskCount, [](spider::sched::SyncType type) {
+        return spider::make<spider::sched::SyncTask, StackID::SCHEDULE>(type, nullptr);
+    });
+}
+
+/**
+ * @brief Count the average number of accesses per task to insert synchronization tasks while walking a schedule and
+ *        to export the statistics of the schedule (creating the schedule and checking the indexes included).
+ * @return average number of accesses per task.
+ */
+static double countScheduleScaling(size_t taskCount) {
+    CountingTask::accessCount_ = 0;
+    const auto tasks = taskCount + 2 * ((taskCount + 3) / 4);
+    walkSchedule(taskCount, [](spider::sched::SyncType) {
+        return spider::make<CountingTask, StackID::SCHEDULE>();
+    });
+    return static_cast<double>(CountingTask::accessCount_) / static_cast<double>(tasks);
+}
+
+/**
+ * @brief Check that a schedule is valid: tasks mapped on a same PE do not overlap and every task starts after the end
+ *        of all its dependencies.
+ */
+static void checkSchedule(const spider::sched::Schedule *schedule) {
+    auto slots = std::vector<std::vector<std::pair<uint64_t, uint64_t>>>(spider::archi::platform()->PECount());
+    for (size_t i = 0; i < schedule->size(); ++i) {
+        const auto *task = schedule->task(i);
+        const auto startTime = task->startTime();
+        const auto name = task->name();
+        slots[task->mappedPe()->virtualIx()].emplace_back(startTime, task->endTime());
+        for (size_t ix = 0; ix < task->dependencyCount(); ++ix) {
+            const auto *srcTask = task->previousTask(ix, schedule);
+            if (srcTask) {
+                EXPECT_GE(startTime, srcTask->endTime()) << "task [" << name << "] starts before its dependency ["
+                                                         << srcTask->name() << "] ends.";
+            }
+        }
+    }
+    for (auto &peSlots : slots) {
+        std::sort(std::begin(peSlots), std::end(peSlots));
+        for (size_t i = 1; i < peSlots.size(); ++i) {
+            EXPECT_GE(peSlots[i].first, peSlots[i - 1].second) << "tasks overlap on a PE.";
+        }
+    }
+}
+
+/**
+ * @brief Schedule and map one iteration of a graph, check the schedule and get its makespan.
+ * @remark Tasks are not executed, config actors set every dynamic parameter to the value paramValue.
+ * @return makespan of the schedule.
+ */
+static uint64_t benchmarkMakespan(const spider::pisdf::Graph *graph,
+                                  spider::SchedulingPolicy schedulingPolicy,
+                                  spider::MappingPolicy mappingPolicy,
+                                  int64_t paramValue) {
+    spider::sched::ResourcesAllocator allocator{ schedulingPolicy, mappingPolicy,
+                                                 spider::ExecutionPolicy::DELAYED,
+                                                 spider::FifoAllocatorType::DEFAULT, false };
+    spider::pisdf::GraphHandler handler{ graph, graph->params(), 1u };
+    /* == Schedule until every graph firing is resolved == */
+    const auto *schedule = allocator.schedule();
+    size_t offset = 0;
+    allocator.prepare(&handler);
+    while (offset != schedule->size()) {
+        for (; offset < schedule->size(); ++offset) {
+            /* == SEND / RECEIVE tasks inserted on multi cluster platforms are not PiSDF tasks == */
+            const auto name = schedule->task(offset)->name();
+            if (name == "send" || name == "receive") {
+                continue;
+            }
+            auto *task = static_cast<spider::sched::PiSDFTask *>(schedule->task(offset));
+            const auto *vertex = task->vertex();
+            if (vertex->subtype() == spider::pisdf::VertexType::CONFIG) {
+                auto values = spider::factory::vector<int64_t>(StackID::RUNTIME);
+                values.assign(vertex->outputParamIxVector().size(), paramValue);
+                task->receiveParams(values);
+            }
+        }
+        allocator.prepare(&handler);
+    }
+    checkSchedule(schedule);
+    const auto makespan = schedule->stats().makespan();
+    allocator.clear();
+    handler.clear();
+    return makespan;
+}
+
+/**
+ * @brief Schedule the applications of the test suite with LIST / BEST_FIT and with HEFT / INSERTION.
+ * @param compare Function called with the name of every application and both of its makespans.
+ */
+template<class Compare>
+static void compareMakespans(Compare &&compare) {
+    struct {
+        const char *name;
+        spider::pisdf::Graph *graph;
+    } apps[2] = {
+            { "stabilization", spider::stab::createStabilization() },
+            { "reinforcement", spider::rl::createReinforcementLearning() },
+    };
+    for (const auto &app : apps) {
+        uint64_t listMakespan = 0;
+        uint64_t heftMakespan = 0;
+        EXPECT_NO_THROW(listMakespan = benchmarkMakespan(app.graph, spider::SchedulingPolicy::LIST,
+                                                         spider::MappingPolicy::BEST_FIT, 40));
+        EXPECT_NO_THROW(heftMakespan = benchmarkMakespan(app.graph, spider::SchedulingPolicy::HEFT,
+                                                         spider::MappingPolicy::INSERTION, 40));
+        EXPECT_NE(listMakespan, 0u);
+        EXPECT_NE(heftMakespan, 0u);
+        compare(app.name, listMakespan, heftMakespan);
+        spider::api::destroyGraph(app.graph);
+    }
+}
+
+/**
+ * @brief Print the makespans of the applications of the test suite and check that HEFT / INSERTION does not do worse
+ *        than LIST / BEST_FIT on them.
+ * @param platformName Name of the platform printed with the makespans.
+ */
+static void printMakespans(const char *platformName) {
+    compareMakespans([platformName](const char *appName, uint64_t listMakespan, uint64_t heftMakespan) {
+        fprintf(stderr, "%-22s -- %-14s -- LIST / BEST_FIT: %8" PRIu64" -- HEFT / INSERTION: %8" PRIu64"\n",
+                platformName, appName, listMakespan, heftMakespan);
+        EXPECT_LE(heftMakespan, listMakespan);
+    });
+}
+
+/**
+ * @brief Print the average scheduling and mapping time per task on a single cluster of peCount PEs.
+ */
+static void printLargePlatformBenchmark(size_t peCount) {
+    createBenchmarkPlatform(1, peCount, true);
+    double result = 0.;
+    ASSERT_NO_THROW(result = benchmarkScheduling(spider::SchedulingPolicy::LIST, spider::MappingPolicy::BEST_FIT));
+    const auto name = "1 cluster x " + std::to_string(peCount) + " PE";
+    fprintf(stderr, "%-22s -- %8.1lf ns / task\n", name.c_str(), result);
+}
+
+/* === Test(s) === */
+
+TEST_F(runtimeSchedulingBenchmark, singleClusterMappingTest) {
+    createBenchmarkPlatform(1, 4);
+    auto *graph = createForkJoinGraph(64);
+    /* == Every PE shares the same memory: no communication to evaluate nor any SEND / RECEIVE task to insert == */
+    size_t count = SIZE_MAX;
+    ASSERT_NO_THROW(count = countSyncTasks(graph, spider::MappingPolicy::BEST_FIT));
+    ASSERT_EQ(count, 0U) << "single cluster mapping should not insert synchronization tasks.";
+    spider::api::destroyGraph(graph);
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_singleClusterMappingBenchmarkTest) {
+    createBenchmarkPlatform(1, 4);
+    double result = 0.;
+    ASSERT_NO_THROW(result = benchmarkScheduling(spider::SchedulingPolicy::LIST, spider::MappingPolicy::BEST_FIT));
+    fprintf(stderr, "%-22s -- %8.1lf ns / task\n", "1 cluster x 4 PE", result);
+}
+
+TEST_F(runtimeSchedulingBenchmark, bestFitMappingTest) {
+    /* == 1 cluster of 8 PEs of 3 hardware types, the GRT sharing its type with other PEs == */
+    spider::api::createPlatform(1, 8);
+    auto *cluster = spider::api::createCluster(8, spider::api::createMemoryInterface(1024));
+    for (uint32_t j = 0; j < 8; ++j) {
+        auto *pe = spider::api::createProcessingElement(j % 3, j, cluster, "Core" + std::to_string(j),
+                                                        spider::PEType::LRT);
+        if (!j) {
+            spider::api::setSpiderGRTPE(pe);
+        }
+    }
+    const auto *platform = spider::archi::platform();
+    spider::sched::BestFitMapper mapper;
+    spider::sched::Schedule schedule;
+    uint64_t seed = 42;
+    const auto random = [&seed](uint64_t max) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 33) % max;
+    };
+    for (size_t k = 0; k < 1000; ++k) {
+        const auto minStartTime = random(100);
+        auto *task = spider::make<MaskedTask, StackID::SCHEDULE>(1 + random(255), 1 + random(5));
+        schedule.addTask(task);
+        schedule.ownTask(task);
+        /* == Linear scan: earliest end time, then least idle time, then lowest index, the GRT paying a penalty == */
+        const spider::PE *expected = nullptr;
+        uint64_t bestEnd = UINT64_MAX;
+        uint64_t bestIdle = UINT64_MAX;
+        for (const auto *pe : cluster->peArray()) {
+            if (!task->isMappableOnPE(pe)) {
+                continue;
+            }
+            const auto ready = schedule.stats().endTime(pe->virtualIx()) + (pe == platform->spiderGRTPE()) * 10;
+            const auto start = std::max<uint64_t>(ready, minStartTime);
+            const auto end = start + task->timingOnPE(pe);
+            if ((end < bestEnd) || ((end == bestEnd) && (start - ready < bestIdle))) {
+                expected = pe;
+                bestEnd = end;
+                bestIdle = start - ready;
+            }
+        }
+        mapper.setStartTime(minStartTime);
+        ASSERT_NO_THROW(mapper.map(task, &schedule));
+        ASSERT_EQ(task->mappedPe(), expected) << "iteration " << k;
+    }
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_largePlatformMappingBenchmarkTest) {
+    printLargePlatformBenchmark(64);
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_largerPlatformMappingBenchmarkTest) {
+    printLargePlatformBenchmark(128);
+}
+
+TEST_F(runtimeSchedulingBenchmark, scheduleScalingTest) {
+    createBenchmarkPlatform(1, 8, true);
+    /* == Number of accesses per task should not depend on the size of the schedule == */
+    auto reference = 0.;
+    for (const size_t taskCount : { 1000, 10000, 100000, 1000000 }) {
+        double result = 0.;
+        ASSERT_NO_THROW(result = countScheduleScaling(taskCount));
+        if (taskCount == 1000) {
+            reference = result;
+        } else {
+            ASSERT_LT(result, 2. * reference) << "accesses per task grow with the schedule (" << taskCount << ").";
+        }
+    }
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_scheduleScalingBenchmarkTest) {
+    createBenchmarkPlatform(1, 8, true);
+    /* == Time per task should not depend on the size of the schedule == */
+    auto reference = 0.;
+    for (const size_t taskCount : { 1000, 10000, 100000, 1000000 }) {
+        double result = 0.;
+        ASSERT_NO_THROW(result = benchmarkScheduleScaling(taskCount));
+        fprintf(stderr, "%8zu tasks -- %8.1lf ns / task\n", taskCount, result);
+        if (taskCount == 10000) {
+            reference = result;
+        } else if (taskCount > 10000) {
+            ASSERT_LT(result, 10. * reference);
+        }
+    }
+}
+
+TEST_F(runtimeSchedulingBenchmark, makespanTest) {
+    createBenchmarkPlatform(1, 4);
+    compareMakespans([](const char *, uint64_t, uint64_t) { });
+}
+
+/* == Makespan comparison, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_makespanBenchmarkTest) {
+    createBenchmarkPlatform(1, 4);
+    printMakespans("1 cluster x 4 PE");
+}
+
+#ifndef _SPIDER_SINGLE_CLUSTER
+
+TEST_F(runtimeSchedulingBenchmark, multiClusterMakespanTest) {
+    createBenchmarkPlatform(2, 2);
+    compareMakespans([](const char *, uint64_t, uint64_t) { });
+}
+
+/* == Makespan comparison, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_multiClusterMakespanBenchmarkTest) {
+    createBenchmarkPlatform(2, 2);
+    printMakespans("2 clusters x 2 PE");
+}
+
+TEST_F(runtimeSchedulingBenchmark, multiClusterMappingTest) {
+    createBenchmarkPlatform(2, 2);
+    auto *graph = createForkJoinGraph(64);
+    /* == Same graph spread over two clusters does need synchronization tasks == */
+    size_t count = 0;
+    ASSERT_NO_THROW(count = countSyncTasks(graph, spider::MappingPolicy::BEST_FIT));
+    ASSERT_NE(count, 0U);
+    spider::api::destroyGraph(graph);
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(runtimeSchedulingBenchmark, DISABLED_multiClusterMappingBenchmarkTest) {
+    createBenchmarkPlatform(2, 2);
+    double result = 0.;
+    ASSERT_NO_THROW(result = benchmarkScheduling(spider::SchedulingPolicy::LIST, spider::MappingPolicy::BEST_FIT));
+    fprintf(stderr, "%-22s -- %8.1lf ns / task\n", "2 clusters x 2 PE", result);
+}
+
+#endif
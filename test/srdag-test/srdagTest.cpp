@@ -41,6 +41,9 @@
 /* === Include(s) === */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
 #include <common/Exception.h>
 #include <memory/memory.h>
 #include <graphs/pisdf/Graph.h>
@@ -604,4 +607,56 @@ TEST_F(srdagTest, srdagHTest6) {
     ASSERT_NO_THROW(srdag->exportToDOT("srdag.dot"));
     spider::destroy(srdag);
     spider::destroy(graph);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Measure the average time taken to build and to tear down the single rate graph of a wide fork / join graph.
+ * @return pair of the average build and tear down time per iteration in microseconds.
+ */
+static std::pair<double, double> benchmarkIteration(spider::pisdf::Graph *graph, size_t iterationCount) {
+    std::chrono::nanoseconds buildTime{ 0 };
+    std::chrono::nanoseconds teardownTime{ 0 };
+    for (size_t i = 0; i < iterationCount; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto *srdag = spider::make<spider::srdag::Graph, StackID::TRANSFO>(graph);
+        spider::srdag::TransfoJob rootJob{ graph };
+        spider::srdag::singleRateTransformation(rootJob, srdag);
+        auto end = std::chrono::steady_clock::now();
+        buildTime += end - start;
+        start = end;
+        spider::destroy(srdag);
+        for (const auto id : { StackID::TRANSFO, StackID::SCHEDULE }) {
+            spider::stackArray()[static_cast<size_t>(id)]->reset();
+        }
+        teardownTime += std::chrono::steady_clock::now() - start;
+    }
+    const auto count = static_cast<double>(iterationCount) * 1000.;
+    return { static_cast<double>(buildTime.count()) / count, static_cast<double>(teardownTime.count()) / count };
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(srdagTest, DISABLED_srdagArenaBenchmarkTest) {
+    constexpr size_t ITERATION_COUNT = 50;
+    for (const auto useArena : { false, true }) {
+        if (useArena) {
+            spider::api::setStackAllocatorPolicy(StackID::TRANSFO, spider::AllocatorPolicy::ARENA);
+            spider::api::setStackAllocatorPolicy(StackID::SCHEDULE, spider::AllocatorPolicy::ARENA);
+        }
+        for (const int64_t width : { 256, 4096 }) {
+            auto *graph = spider::api::createGraph("topgraph", 4, 3);
+            auto *fork = spider::api::createVertex(graph, "fork", 0, 1);
+            auto *stage0 = spider::api::createVertex(graph, "stage0", 1, 1);
+            auto *stage1 = spider::api::createVertex(graph, "stage1", 1, 1);
+            auto *join = spider::api::createVertex(graph, "join", 1, 0);
+            spider::api::createEdge(fork, 0, width, stage0, 0, 1);
+            spider::api::createEdge(stage0, 0, 1, stage1, 0, 1);
+            spider::api::createEdge(stage1, 0, 1, join, 0, width);
+            /* == Warm up the stacks == */
+            benchmarkIteration(graph, 2);
+            const auto result = benchmarkIteration(graph, ITERATION_COUNT);
+            fprintf(stderr, "%-8s -- width %5" PRId64" -- build: %9.1lf us -- teardown: %9.1lf us\n",
+                    useArena ? "ARENA" : "DEFAULT", width, result.first, result.second);
+            spider::destroy(graph);
+        }
+    }
+}
@@ -0,0 +1,317 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2019 - 2020) :
+ *
+ * Florian Arrestier <florian.arrestier@insa-rennes.fr> (2019 - 2020)
+ *
+ * Spider 2.0 is a dataflow based runtime used to execute dynamic PiSDF
+ * applications. The Preesm tool may be used to design PiSDF applications.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* === Include(s) === */
+
+#include <gtest/gtest.h>
+#include <thread/Queue.h>
+#include <thread/MPSCQueue.h>
+#include <thread/Thread.h>
+#include <runtime/message/Notification.h>
+#include <runtime/common/JobStampTable.h>
+#include <archi/MemoryInterface.h>
+#include <api/spider.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+class threadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spider::start();
+    }
+
+    void TearDown() override {
+        spider::quit();
+    }
+};
+
+/* === Contention helper === */
+
+/**
+ * @brief Push notifications concurrently from several producers and check what the single consumer receives.
+ * @remark Every producer must have its notifications received exactly once and in the order they were pushed.
+ */
+template<class Q>
+static void checkContention(Q &queue, size_t producerCount, size_t countPerProducer) {
+    std::vector<size_t> receivedCount(producerCount, 0);
+    std::vector<spider::thread> producers;
+    for (size_t p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&queue, p, countPerProducer]() {
+            for (size_t i = 0; i < countPerProducer; ++i) {
+                queue.push(spider::Notification{ spider::NotificationType::JOB_UPDATE_JOBSTAMP, p, i });
+            }
+        });
+    }
+    spider::Notification notification;
+    for (size_t i = 0; i < producerCount * countPerProducer; ++i) {
+        ASSERT_TRUE(queue.pop(notification));
+        ASSERT_LT(notification.senderIx_, producerCount) << "queue returned a notification of an unknown producer.";
+        auto &count = receivedCount[notification.senderIx_];
+        ASSERT_EQ(notification.notificationIx_, count) << "queue did not preserve the order of producer "
+                                                       << notification.senderIx_ << ".";
+        count++;
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    for (size_t p = 0; p < producerCount; ++p) {
+        ASSERT_EQ(receivedCount[p], countPerProducer) << "notifications of producer " << p << " were lost.";
+    }
+    ASSERT_FALSE(queue.try_pop(notification)) << "queue should be empty.";
+}
+
+/**
+ * @brief Measure the average time per notification for a single consumer to receive the notifications pushed
+ *        concurrently by several producers.
+ * @return average time per notification in nanoseconds.
+ */
+template<class Q>
+static double timeContention(Q &queue, size_t producerCount, size_t countPerProducer) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<spider::thread> producers;
+    for (size_t p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&queue, p, countPerProducer]() {
+            for (size_t i = 0; i < countPerProducer; ++i) {
+                queue.push(spider::Notification{ spider::NotificationType::JOB_UPDATE_JOBSTAMP, p, i });
+            }
+        });
+    }
+    spider::Notification notification;
+    const auto total = producerCount * countPerProducer;
+    size_t receivedCount = 0;
+    for (size_t i = 0; i < total; ++i) {
+        receivedCount += queue.pop(notification);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(receivedCount, total);
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(total);
+}
+
+TEST_F(threadTest, mpscQueueTest) {
+    spider::MPSCQueue<spider::Notification> queue{ 4 };
+    ASSERT_EQ(queue.capacity(), 4) << "MPSCQueue: capacity should be rounded to power of 2.";
+    spider::Notification notification;
+    ASSERT_EQ(queue.try_pop(notification), false) << "MPSCQueue: try_pop on empty queue should return false.";
+    /* == Exceeding the capacity spills into the overflow queue without losing the order == */
+    for (size_t i = 0; i < 10; ++i) {
+        queue.push(spider::Notification{ spider::NotificationType::JOB_ADD, 0, i });
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(queue.try_pop(notification), true) << "MPSCQueue: try_pop should succeed.";
+        ASSERT_EQ(notification.notificationIx_, i) << "MPSCQueue: wrong order.";
+    }
+    ASSERT_EQ(queue.try_pop(notification), false) << "MPSCQueue: queue should be empty.";
+    queue.push(spider::Notification{ spider::NotificationType::LRT_STOP });
+    queue.clear();
+    ASSERT_EQ(queue.try_pop(notification), false) << "MPSCQueue: clear failed.";
+    /* == Blocking pop must be woken up by a later push == */
+    spider::thread producer{ [&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.push(spider::Notification{ spider::NotificationType::LRT_STOP });
+    }};
+    ASSERT_EQ(queue.pop(notification), true);
+    ASSERT_EQ(notification.type_, spider::NotificationType::LRT_STOP);
+    producer.join();
+}
+
+TEST_F(threadTest, queueContentionTest) {
+    constexpr size_t countPerProducer = 20000;
+    for (size_t producerCount : { 1, 2, 4 }) {
+        spider::Queue<spider::Notification> lockedQueue;
+        spider::MPSCQueue<spider::Notification> ringQueue;
+        spider::MPSCQueue<spider::Notification> smallRingQueue{ 16 };
+        checkContention(lockedQueue, producerCount, countPerProducer);
+        checkContention(ringQueue, producerCount, countPerProducer);
+        /* == Small ring spills into its overflow queue under contention == */
+        checkContention(smallRingQueue, producerCount, countPerProducer);
+    }
+}
+
+/* == Wall clock measure, opt-in with --gtest_also_run_disabled_tests == */
+TEST_F(threadTest, DISABLED_queueContentionBenchmark) {
+    constexpr size_t countPerProducer = 100000;
+    for (size_t producerCount : { 1, 2, 4 }) {
+        spider::Queue<spider::Notification> lockedQueue;
+        spider::MPSCQueue<spider::Notification> ringQueue;
+        spider::MPSCQueue<spider::Notification> smallRingQueue{ 16 };
+        const auto lockedTime = timeContention(lockedQueue, producerCount, countPerProducer);
+        const auto ringTime = timeContention(ringQueue, producerCount, countPerProducer);
+        const auto smallRingTime = timeContention(smallRingQueue, producerCount, countPerProducer);
+        fprintf(stderr, "producers: %zu -- spider::Queue: %8.1lf ns/op -- spider::MPSCQueue: %8.1lf ns/op "
+                        "-- spider::MPSCQueue (ring of 16): %8.1lf ns/op\n", producerCount,
+                lockedTime, ringTime, smallRingTime);
+    }
+}
+
+TEST_F(threadTest, jobStampTableTest) {
+    spider::JobStampTable table{ 4 };
+    std::vector<size_t> woken;
+    const auto release = [&table, &woken](size_t producerIx, size_t value) {
+        woken.clear();
+        table.releaseWaiting(producerIx, value, [&woken](size_t lrtIx) { woken.push_back(lrtIx); });
+        return woken;
+    };
+    ASSERT_EQ(table.size(), 4U);
+    for (size_t i = 0; i < table.size(); ++i) {
+        ASSERT_EQ(table.get(i), SIZE_MAX) << "job stamps should be initialized to SIZE_MAX.";
+    }
+    table.set(1, 3);
+    ASSERT_EQ(table.get(1), 3U);
+    /* == Only the LRTs waiting on the producer for a reached job stamp are released, and only once == */
+    table.setWaiting(0, 1, 5);
+    table.setWaiting(2, 1, 4);
+    table.setWaiting(3, 2, 0);
+    ASSERT_TRUE(release(1, 3).empty());
+    ASSERT_EQ(release(1, 4), std::vector<size_t>{ 2 });
+    ASSERT_TRUE(release(1, 4).empty());
+    ASSERT_EQ(release(1, 5), std::vector<size_t>{ 0 });
+    ASSERT_EQ(release(2, 0), std::vector<size_t>{ 3 });
+    /* == Registration moves to the new producer, un-registered LRTs are not released == */
+    table.setWaiting(0, 2, 7);
+    ASSERT_TRUE(release(1, 10).empty());
+    ASSERT_EQ(release(2, 7), std::vector<size_t>{ 0 });
+    table.setWaiting(2, 1, 6);
+    table.setWaiting(2, SIZE_MAX, SIZE_MAX);
+    ASSERT_TRUE(release(1, 100).empty());
+    table.setWaiting(1, 3, 0);
+    table.reset();
+    ASSERT_EQ(table.get(1), SIZE_MAX) << "reset should clear the job stamps.";
+    ASSERT_TRUE(release(3, 100).empty()) << "reset should clear the registrations.";
+    /* == Waiter masks span several words == */
+    spider::JobStampTable largeTable{ 130 };
+    largeTable.setWaiting(129, 0, 1);
+    largeTable.setWaiting(64, 0, 2);
+    largeTable.setWaiting(3, 0, 1);
+    woken.clear();
+    largeTable.releaseWaiting(0, 1, [&woken](size_t lrtIx) { woken.push_back(lrtIx); });
+    ASSERT_EQ(woken, (std::vector<size_t>{ 3, 129 }));
+}
+
+TEST_F(threadTest, jobStampTableConcurrencyTest) {
+    constexpr size_t jobCount = 20000;
+    static constexpr size_t producerIx = 0;
+    static constexpr size_t consumerIx = 1;
+    spider::JobStampTable table{ 2 };
+    spider::MPSCQueue<spider::Notification> queue;
+    std::vector<size_t> data(jobCount, SIZE_MAX);
+    /* == Producer publishes its data then its job stamp, and wakes the consumer if it waits on it == */
+    spider::thread producer{ [&table, &queue, &data]() {
+        for (size_t job = 0; job < jobCount; ++job) {
+            data[job] = job;
+            table.set(producerIx, job);
+            table.releaseWaiting(producerIx, job, [&queue, job](size_t lrtIx) {
+                queue.push(spider::Notification{ spider::NotificationType::JOB_UPDATE_JOBSTAMP, producerIx, job });
+                ASSERT_EQ(lrtIx, consumerIx);
+            });
+        }
+    }};
+    /* == Consumer follows the protocol of the runners: register, check again, then park == */
+    size_t lastStamp = 0;
+    size_t wakeCount = 0;
+    for (size_t job = 0; job < jobCount; job += 7) {
+        auto stamp = table.get(producerIx);
+        while ((stamp == SIZE_MAX) || (stamp < job)) {
+            table.setWaiting(consumerIx, producerIx, job);
+            stamp = table.get(producerIx);
+            if ((stamp != SIZE_MAX) && (stamp >= job)) {
+                table.setWaiting(consumerIx, SIZE_MAX, SIZE_MAX);
+                break;
+            }
+            spider::Notification notification;
+            ASSERT_TRUE(queue.pop(notification));
+            ASSERT_GE(notification.notificationIx_, job) << "consumer woken up before its job stamp was reached.";
+            wakeCount++;
+            stamp = table.get(producerIx);
+        }
+        ASSERT_GE(stamp, lastStamp) << "job stamps should never decrease.";
+        ASSERT_EQ(data[job], job) << "data written before the job stamp should be visible.";
+        lastStamp = stamp;
+    }
+    producer.join();
+    spider::Notification notification;
+    while (queue.try_pop(notification)) {
+        wakeCount++;
+    }
+    ASSERT_LE(wakeCount, jobCount / 7 + 1) << "consumer should be woken up at most once per waited job.";
+}
+
+TEST_F(threadTest, memoryInterfaceConcurrencyTest) {
+    constexpr size_t bufferCount = 1000;
+    constexpr size_t bufferSize = 16;
+    constexpr size_t threadCount = 4;
+    auto *memoryInterface = spider::make<spider::MemoryInterface, StackID::ARCHI>(bufferCount * bufferSize);
+    /* == Concurrent allocations of dense virtual addresses (forces the tables to grow) == */
+    std::vector<spider::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([memoryInterface, t]() {
+            for (size_t i = t; i < bufferCount; i += threadCount) {
+                memoryInterface->allocate(i * bufferSize, bufferSize, 1);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    ASSERT_EQ(memoryInterface->used(), bufferCount * bufferSize);
+    ASSERT_THROW(memoryInterface->allocate(bufferCount * bufferSize, 1), spider::Exception);
+    /* == Concurrent lifetime updates on shared buffers == */
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([memoryInterface]() {
+            for (size_t i = 0; i < bufferCount; ++i) {
+                memoryInterface->update(i * bufferSize, 1);
+                ASSERT_NE(memoryInterface->read(i * bufferSize), nullptr);
+                memoryInterface->deallocate(i * bufferSize, bufferSize);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(memoryInterface->used(), bufferCount * bufferSize);
+    for (size_t i = 0; i < bufferCount; ++i) {
+        memoryInterface->deallocate(i * bufferSize, bufferSize);
+    }
+    ASSERT_EQ(memoryInterface->used(), 0U);
+    /* == Virtual addresses are reused by the next iteration == */
+    ASSERT_NE(memoryInterface->allocate(0, bufferSize, 1), nullptr);
+    memoryInterface->deallocate(0, bufferSize);
+    ASSERT_EQ(memoryInterface->used(), 0U);
+    spider::destroy(memoryInterface);
+}